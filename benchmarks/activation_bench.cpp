@@ -0,0 +1,82 @@
+#include "activation.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace axon;
+
+namespace
+{
+    // Whole-layer activation kernels over `range(0)` values, in the math mode given by
+    // `range(1)` (0 for exact, 1 for fast).
+    template <std::floating_point Scalar, typename ActivationPolicy>
+    auto apply(benchmark::State& state) -> void
+    {
+        const auto size = static_cast<std::size_t>(state.range(0));
+        const auto mode =
+            state.range(1) == 0 ? activation::MathMode::exact : activation::MathMode::fast;
+
+        std::vector<Scalar> inputs(size);
+        for (std::size_t i{0}; i < size; ++i)
+        {
+            inputs[i] = static_cast<Scalar>(4.0 * std::sin(static_cast<double>(i)));
+        }
+
+        std::vector<Scalar> outputs(size);
+        for (auto _ : state)
+        {
+            ActivationPolicy::template apply<Scalar>(inputs, outputs, mode);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(size));
+    }
+
+    template <std::floating_point Scalar, typename ActivationPolicy>
+    auto apply_derivative(benchmark::State& state) -> void
+    {
+        const auto size = static_cast<std::size_t>(state.range(0));
+
+        std::vector<Scalar> outputs(size);
+        for (std::size_t i{0}; i < size; ++i)
+        {
+            outputs[i] = static_cast<Scalar>(0.9 * std::sin(static_cast<double>(i)));
+        }
+
+        std::vector<Scalar> gradients(size, Scalar{1});
+        for (auto _ : state)
+        {
+            ActivationPolicy::template apply_derivative<Scalar>(outputs, gradients);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(size));
+    }
+
+    auto sizes_and_modes(benchmark::internal::Benchmark* benchmark) -> void
+    {
+        benchmark->ArgNames({"size", "fast"})->ArgsProduct({{1 << 10, 1 << 16}, {0, 1}});
+    }
+
+    auto sizes(benchmark::internal::Benchmark* benchmark) -> void
+    {
+        benchmark->ArgName("size")->Arg(1 << 10)->Arg(1 << 16);
+    }
+
+} // namespace
+
+BENCHMARK(apply<double, activation::Sigmoid>)->Apply(sizes_and_modes);
+BENCHMARK(apply<float, activation::Sigmoid>)->Apply(sizes_and_modes);
+BENCHMARK(apply<double, activation::Tanh>)->Apply(sizes_and_modes);
+BENCHMARK(apply<float, activation::Tanh>)->Apply(sizes_and_modes);
+BENCHMARK(apply<double, activation::ReLU>)->Apply(sizes_and_modes);
+BENCHMARK(apply<float, activation::ReLU>)->Apply(sizes_and_modes);
+
+BENCHMARK(apply_derivative<double, activation::Sigmoid>)->Apply(sizes);
+BENCHMARK(apply_derivative<double, activation::Tanh>)->Apply(sizes);
+BENCHMARK(apply_derivative<double, activation::ReLU>)->Apply(sizes);
+BENCHMARK(apply_derivative<float, activation::Tanh>)->Apply(sizes);
@@ -0,0 +1,88 @@
+#include "activation.hpp"
+#include "autograd.hpp"
+#include "criterion.hpp"
+#include "network.hpp"
+
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace axon;
+
+namespace
+{
+    // The topologies of `network_bench.cpp`, indexed by the first benchmark argument.
+    const std::array<std::vector<std::size_t>, 3> topologies{{
+        {16, 32, 1},
+        {784, 128, 10},
+        {512, 1024, 1024, 10},
+    }};
+
+    template <std::floating_point Scalar>
+    auto make_values(std::size_t size) -> std::vector<Scalar>
+    {
+        std::vector<Scalar> values(size);
+        for (std::size_t i{0}; i < size; ++i)
+        {
+            values[i] = static_cast<Scalar>(0.5 * std::sin(0.37 * static_cast<double>(i)));
+        }
+
+        return values;
+    }
+
+    // One training iteration of an MLP, either through the hand-written backward pass
+    // (`taped` false) or recorded on a tape and differentiated by it. Both apply the same
+    // momentum update, so the gap between them is the cost of the tape.
+    template <std::floating_point Scalar, bool taped>
+    auto train(benchmark::State& state) -> void
+    {
+        const auto& topology = topologies.at(static_cast<std::size_t>(state.range(0)));
+        const auto batch_size = static_cast<std::size_t>(state.range(1));
+        const auto criterion = Criterion::of<criterion::MSE>();
+
+        BasicNetwork<Scalar> network(topology, Activation::of<activation::Tanh>(), criterion);
+        const auto inputs = make_values<Scalar>(batch_size * topology.front());
+        const auto targets = make_values<Scalar>(batch_size * topology.back());
+
+        auto gradients = network.make_workspace();
+        autograd::BasicTape<Scalar> tape;
+        const auto seed = static_cast<Scalar>(topology.back());
+
+        for (auto _ : state)
+        {
+            if constexpr (taped)
+            {
+                const auto outputs = autograd::record(tape, network, inputs, batch_size, gradients);
+                tape.backward(tape.loss(outputs, targets, criterion), seed);
+                network.apply_gradients(gradients, Scalar{1e-4}, Scalar{0.9});
+            }
+            else
+            {
+                network.feed_forward_batch(inputs, batch_size);
+                network.back_propagate(targets);
+                network.step(Scalar{1e-4}, Scalar{0.9});
+            }
+
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch_size));
+    }
+
+    auto full_matrix(benchmark::internal::Benchmark* benchmark) -> void
+    {
+        benchmark->ArgNames({"topology", "batch"})
+            ->ArgsProduct({{0, 1, 2}, {1, 32, 256}})
+            ->Unit(benchmark::kMicrosecond);
+    }
+
+} // namespace
+
+BENCHMARK(train<double, false>)->Name("hand_train<double>")->Apply(full_matrix);
+BENCHMARK(train<double, true>)->Name("tape_train<double>")->Apply(full_matrix);
+BENCHMARK(train<float, false>)->Name("hand_train<float>")->Apply(full_matrix);
+BENCHMARK(train<float, true>)->Name("tape_train<float>")->Apply(full_matrix);
@@ -0,0 +1,66 @@
+#include "activation.hpp"
+#include "batcher.hpp"
+#include "criterion.hpp"
+#include "network.hpp"
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+using namespace axon;
+
+namespace
+{
+    // Synthetic load: every benchmark thread is a client that submits one sample and waits for
+    // its output, so the number of threads is the number of requests in flight. The first
+    // argument is the maximum batch size and the second the maximum wait in microseconds.
+    const Network network({784, 128, 10}, Activation::of<activation::ReLU>(),
+                          Criterion::of<criterion::MSE>());
+
+    std::unique_ptr<Batcher> batcher;
+
+    auto batched_inference(benchmark::State& state) -> void
+    {
+        if (state.thread_index() == 0)
+        {
+            batcher = std::make_unique<Batcher>(
+                network,
+                BatcherOptions{.max_batch_size = static_cast<std::size_t>(state.range(0)),
+                               .max_wait = std::chrono::microseconds{state.range(1)}});
+        }
+
+        std::vector<double> input(784);
+        for (std::size_t i{0}; i < input.size(); ++i)
+        {
+            input[i] = 0.5 * std::sin(static_cast<double>(i + state.thread_index()));
+        }
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(batcher->submit(input).get());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+        if (state.thread_index() == 0)
+        {
+            const auto stats = batcher->get_stats();
+            state.counters["mean_batch"] = stats.mean_batch_size();
+            state.counters["p50_us"] = static_cast<double>(stats.p50.count()) / 1e3;
+            state.counters["p99_us"] = static_cast<double>(stats.p99.count()) / 1e3;
+            batcher.reset();
+        }
+    }
+
+    auto load_matrix(benchmark::internal::Benchmark* benchmark) -> void
+    {
+        benchmark->ArgNames({"max_batch", "max_wait_us"});
+        benchmark->Args({1, 0})->Args({32, 100})->Args({32, 1000});
+        benchmark->ThreadRange(1, 32)->UseRealTime();
+    }
+
+} // namespace
+
+BENCHMARK(batched_inference)->Apply(load_matrix);
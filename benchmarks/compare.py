@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""Compares two axon_bench JSON reports and flags regressions.
+
+Usage:
+    ./bin/axon_bench --benchmark_out=baseline.json --benchmark_out_format=json
+    ... change the code and rebuild ...
+    ./bin/axon_bench --benchmark_out=current.json --benchmark_out_format=json
+    benchmarks/compare.py [baseline.json] current.json [--threshold 0.05]
+
+Without an explicit baseline, the report is compared against the stored reference in
+benchmarks/baseline.json, when there is one (see the README for how to record it).
+Runs with --benchmark_repetitions are compared on their median. The exit status is 1 when any
+benchmark got slower than the threshold allows, so the script can gate CI jobs, and 2 when the
+reports come from different machines or benchmark library builds, whose timings do not compare.
+"""
+
+import argparse
+import json
+import sys
+from pathlib import Path
+
+DEFAULT_BASELINE = Path(__file__).resolve().parent / "baseline.json"
+
+TIME_UNITS = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+# Fields of a report's context that must agree for its timings to compare with another's.
+MATCHING_CONTEXT = ("host_name", "num_cpus", "library_build_type")
+
+
+def load(path, metric):
+    """Returns the context and {benchmark name: time in seconds} of one report."""
+    with open(path, encoding="utf-8") as file:
+        report = json.load(file)
+
+    iterations = {}
+    medians = {}
+    for run in report.get("benchmarks", []):
+        if run.get("error_occurred") or run.get("skipped"):
+            continue
+
+        name = run.get("run_name", run["name"])
+        seconds = run[metric] * TIME_UNITS[run.get("time_unit", "ns")]
+        if run.get("run_type") == "aggregate":
+            if run.get("aggregate_name") == "median":
+                medians[name] = seconds
+        else:
+            iterations.setdefault(name, []).append(seconds)
+
+    times = {name: sum(values) / len(values) for name, values in iterations.items()}
+    times.update(medians)
+    return report.get("context", {}), times
+
+
+def check_context(path, context):
+    """Warns about conditions that make the timings of one report unreliable."""
+    if context.get("library_build_type") == "debug":
+        print(
+            f"warning: {path} was recorded with a debug build of Google Benchmark",
+            file=sys.stderr,
+        )
+
+    load_avg = context.get("load_avg", [])
+    num_cpus = context.get("num_cpus", 0)
+    if load_avg and num_cpus and load_avg[0] >= num_cpus:
+        print(
+            f"warning: {path} was recorded under a load of {load_avg[0]:.2f}"
+            f" on {num_cpus} CPU(s)",
+            file=sys.stderr,
+        )
+
+
+def context_mismatches(baseline, contender):
+    """Returns the MATCHING_CONTEXT fields that differ between two reports."""
+    return [
+        f"{key}: {baseline.get(key)!r} != {contender.get(key)!r}"
+        for key in MATCHING_CONTEXT
+        if baseline.get(key) != contender.get(key)
+    ]
+
+
+def format_time(seconds):
+    for unit, scale in (("s", 1.0), ("ms", 1e-3), ("us", 1e-6)):
+        if seconds >= scale:
+            return f"{seconds / scale:.3f} {unit}"
+
+    return f"{seconds / 1e-9:.1f} ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument(
+        "reports",
+        nargs="+",
+        metavar="report",
+        help="JSON reports of the reference build and of the build under test, in that order;"
+        f" with only one, the reference is {DEFAULT_BASELINE.name}",
+    )
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.05,
+        help="relative slowdown reported as a regression (default: 0.05)",
+    )
+    parser.add_argument(
+        "--metric",
+        choices=("real_time", "cpu_time"),
+        default="real_time",
+        help="time compared between the reports (default: real_time)",
+    )
+    parser.add_argument(
+        "--ignore-context",
+        action="store_true",
+        help="compare reports recorded on different machines or benchmark library builds",
+    )
+    args = parser.parse_args()
+    if len(args.reports) > 2:
+        parser.error("expected at most two reports")
+
+    baseline_path = args.reports[0] if len(args.reports) == 2 else DEFAULT_BASELINE
+    if not Path(baseline_path).exists():
+        parser.error(f"no baseline given and {DEFAULT_BASELINE} does not exist")
+
+    baseline_context, baseline = load(baseline_path, args.metric)
+    contender_context, contender = load(args.reports[-1], args.metric)
+
+    check_context(baseline_path, baseline_context)
+    check_context(args.reports[-1], contender_context)
+    mismatches = context_mismatches(baseline_context, contender_context)
+    if mismatches:
+        severity = "warning" if args.ignore_context else "error"
+        print(
+            f"{severity}: the reports come from different machines or benchmark library builds:",
+            file=sys.stderr,
+        )
+        for mismatch in mismatches:
+            print(f"    {mismatch}", file=sys.stderr)
+
+        if not args.ignore_context:
+            print("Pass --ignore-context to compare them anyway.", file=sys.stderr)
+            return 2
+
+    names = [name for name in baseline if name in contender]
+    width = max((len(name) for name in names), default=len("Benchmark"))
+    print(f"{'Benchmark':<{width}}  {'Baseline':>12}  {'Contender':>12}  {'Change':>8}")
+
+    regressions = []
+    for name in names:
+        before = baseline[name]
+        after = contender[name]
+        change = (after - before) / before if before > 0 else 0.0
+
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions.append(name)
+        elif change < -args.threshold:
+            flag = "  improved"
+
+        print(
+            f"{name:<{width}}  {format_time(before):>12}  {format_time(after):>12}"
+            f"  {change:>+8.1%}{flag}"
+        )
+
+    for name in sorted(baseline.keys() - contender.keys()):
+        print(f"missing from contender: {name}")
+
+    for name in sorted(contender.keys() - baseline.keys()):
+        print(f"new in contender: {name}")
+
+    if regressions:
+        print(f"\n{len(regressions)} regression(s) above {args.threshold:.0%}.")
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
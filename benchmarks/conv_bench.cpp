@@ -0,0 +1,97 @@
+#include "conv.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+using namespace axon;
+
+namespace
+{
+    // Forward and backward-data passes of a 3 x 3, stride 1, padding 1 convolution from
+    // `range(0)` to as many channels over a batch of 8 square images of `range(1)` pixels,
+    // forced onto the algorithm given by `range(2)` (1 im2col, 2 direct). The channel count
+    // where the direct kernel stops winning sets `conv::prefers_direct`.
+    template <std::floating_point Scalar>
+    auto conv3x3(benchmark::State& state) -> void
+    {
+        constexpr std::size_t batch_size{8};
+        const auto channels = static_cast<std::size_t>(state.range(0));
+        const auto size = static_cast<std::size_t>(state.range(1));
+        const auto algorithm = static_cast<ConvAlgorithm>(state.range(2));
+
+        BasicConv2D<Scalar> conv({.in_channels = channels,
+                                  .out_channels = channels,
+                                  .kernel_size = 3,
+                                  .stride = 1,
+                                  .padding = 1});
+        conv.set_algorithm(algorithm);
+
+        BasicTensor<Scalar> inputs(Shape{batch_size, channels, size, size});
+        for (std::size_t i{0}; i < inputs.size(); ++i)
+        {
+            inputs.span()[i] = static_cast<Scalar>(std::sin(0.37 * static_cast<double>(i)));
+        }
+        BasicTensor<Scalar> outputs(conv.output_shape(inputs.shape()));
+        BasicTensor<Scalar> input_gradients(inputs.shape());
+
+        for (auto _ : state)
+        {
+            conv.forward(inputs, outputs);
+            conv.backward_data(outputs, input_gradients);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch_size));
+        state.counters["flops"] = benchmark::Counter(
+            static_cast<double>(4 * batch_size * channels * channels * 9 * size * size),
+            benchmark::Counter::kIsIterationInvariantRate);
+    }
+
+    auto conv_matrix(benchmark::internal::Benchmark* benchmark) -> void
+    {
+        benchmark->ArgNames({"channels", "size", "algorithm"});
+        for (const std::int64_t channels : {1, 3, 8, 16, 32, 64})
+        {
+            for (const std::int64_t size : {28, 64})
+            {
+                for (const std::int64_t algorithm : {1, 2})
+                {
+                    benchmark->Args({channels, size, algorithm});
+                }
+            }
+        }
+    }
+
+    // Training step of a 2 x 2 max pooling layer over 8 x 32 x 64 x 64 activations.
+    template <std::floating_point Scalar>
+    auto max_pool(benchmark::State& state) -> void
+    {
+        BasicPool2D<Scalar> pool({});
+        BasicTensor<Scalar> inputs(Shape{8, 32, 64, 64});
+        for (std::size_t i{0}; i < inputs.size(); ++i)
+        {
+            inputs.span()[i] = static_cast<Scalar>(std::sin(0.37 * static_cast<double>(i)));
+        }
+        BasicTensor<Scalar> outputs(pool.output_shape(inputs.shape()));
+        BasicTensor<Scalar> input_gradients(inputs.shape());
+
+        for (auto _ : state)
+        {
+            pool.forward(inputs, outputs);
+            pool.backward(outputs, input_gradients);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetBytesProcessed(state.iterations()
+                                * static_cast<std::int64_t>(2 * inputs.size() * sizeof(Scalar)));
+    }
+
+} // namespace
+
+BENCHMARK(conv3x3<double>)->Apply(conv_matrix);
+BENCHMARK(conv3x3<float>)->Apply(conv_matrix);
+BENCHMARK(max_pool<double>);
+BENCHMARK(max_pool<float>);
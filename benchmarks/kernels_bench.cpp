@@ -0,0 +1,151 @@
+#include "kernels.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using namespace axon;
+
+namespace
+{
+    // Square `range(0)` matrix products on every instruction set the host supports, reported
+    // in floating-point operations per second.
+    template <typename Scalar>
+    auto gemm(benchmark::State& state) -> void
+    {
+        const auto isa = static_cast<kernels::Isa>(state.range(1));
+        if (!kernels::is_supported(isa))
+        {
+            state.SkipWithError("Instruction set not supported by this CPU.");
+            return;
+        }
+
+        const auto n = static_cast<std::size_t>(state.range(0));
+        std::vector<Scalar> a(n * n, Scalar{0.5});
+        std::vector<Scalar> b(n * n, Scalar{0.25});
+        std::vector<Scalar> c(n * n);
+
+        const auto previous = kernels::get_isa();
+        kernels::set_isa(isa);
+        for (auto _ : state)
+        {
+            kernels::gemm(kernels::Transpose::no, kernels::Transpose::no, n, n, n, Scalar{1},
+                          a.data(), n, b.data(), n, Scalar{0}, c.data(), n);
+            benchmark::ClobberMemory();
+        }
+
+        kernels::set_isa(previous);
+        state.counters["flops"] = benchmark::Counter(
+            2.0 * static_cast<double>(n * n * n) * static_cast<double>(state.iterations()),
+            benchmark::Counter::kIsRate);
+    }
+
+    // Dense-layer forward step, outputs = relu(inputs * weights^T + biases), for `range(0)`
+    // samples, 1024 outputs and `range(1)` inputs: with the biases and the activation in the
+    // epilogue of the GEMM when `Fused`, or in a second pass over the outputs otherwise. The
+    // activation is cheap on purpose, so that the difference is the traffic of that pass.
+    template <typename Scalar, bool Fused>
+    auto gemm_bias_relu(benchmark::State& state) -> void
+    {
+        const auto m = static_cast<std::size_t>(state.range(0));
+        const auto k = static_cast<std::size_t>(state.range(1));
+        constexpr std::size_t n{1024};
+        std::vector<Scalar> a(m * k, Scalar{0.5});
+        std::vector<Scalar> b(n * k, Scalar{-0.25});
+        std::vector<Scalar> bias(n, Scalar{0.125});
+        std::vector<Scalar> c(m * n);
+
+        const auto relu = [](std::span<Scalar> values)
+        {
+            for (Scalar& value : values)
+            {
+                value = value > Scalar{0} ? value : Scalar{0};
+            }
+        };
+
+        const kernels::Epilogue<Scalar> epilogue{
+            .bias = bias.data(),
+            .apply = [](std::span<Scalar> values,
+                        [[maybe_unused]] const void* context) { decltype(relu){}(values); },
+        };
+
+        for (auto _ : state)
+        {
+            if constexpr (Fused)
+            {
+                kernels::gemm(kernels::Transpose::no, kernels::Transpose::yes, m, n, k, Scalar{1},
+                              a.data(), k, b.data(), k, Scalar{0}, c.data(), n, epilogue);
+            }
+            else
+            {
+                kernels::gemm(kernels::Transpose::no, kernels::Transpose::yes, m, n, k, Scalar{1},
+                              a.data(), k, b.data(), k, Scalar{0}, c.data(), n);
+                for (std::size_t row{0}; row < m; ++row)
+                {
+                    Scalar* outputs = c.data() + (row * n);
+                    for (std::size_t col{0}; col < n; ++col)
+                    {
+                        outputs[col] += bias[col];
+                    }
+                }
+                relu(c);
+            }
+            benchmark::ClobberMemory();
+        }
+
+        state.counters["flops"] = benchmark::Counter(
+            2.0 * static_cast<double>(m * n * k) * static_cast<double>(state.iterations()),
+            benchmark::Counter::kIsRate);
+    }
+
+    auto gemm_u8s8(benchmark::State& state) -> void
+    {
+        const auto n = static_cast<std::size_t>(state.range(0));
+        std::vector<std::uint8_t> a(n * n, 3);
+        std::vector<std::int8_t> b(n * n, -2);
+        std::vector<std::int32_t> c(n * n);
+
+        for (auto _ : state)
+        {
+            kernels::gemm_u8s8(n, n, n, a.data(), n, b.data(), n, c.data(), n);
+            benchmark::ClobberMemory();
+        }
+
+        state.counters["ops"] = benchmark::Counter(
+            2.0 * static_cast<double>(n * n * n) * static_cast<double>(state.iterations()),
+            benchmark::Counter::kIsRate);
+    }
+
+    auto sizes_and_isas(benchmark::internal::Benchmark* benchmark) -> void
+    {
+        benchmark->ArgNames({"n", "isa"})
+            ->ArgsProduct({{64, 256, 512},
+                           {static_cast<std::int64_t>(kernels::Isa::scalar),
+                            static_cast<std::int64_t>(kernels::Isa::avx2),
+                            static_cast<std::int64_t>(kernels::Isa::avx512)}})
+            ->Unit(benchmark::kMicrosecond);
+    }
+
+} // namespace
+
+BENCHMARK(gemm<double>)->Apply(sizes_and_isas);
+BENCHMARK(gemm<float>)->Apply(sizes_and_isas);
+BENCHMARK(gemm_bias_relu<double, false>)
+    ->ArgNames({"m", "k"})
+    ->ArgsProduct({{32, 256}, {64, 512}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(gemm_bias_relu<double, true>)
+    ->ArgNames({"m", "k"})
+    ->ArgsProduct({{32, 256}, {64, 512}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(gemm_bias_relu<float, false>)
+    ->ArgNames({"m", "k"})
+    ->ArgsProduct({{32, 256}, {64, 512}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(gemm_bias_relu<float, true>)
+    ->ArgNames({"m", "k"})
+    ->ArgsProduct({{32, 256}, {64, 512}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(gemm_u8s8)->ArgName("n")->Arg(256)->Arg(512)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,193 @@
+#include "activation.hpp"
+#include "criterion.hpp"
+#include "network.hpp"
+
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace axon;
+
+namespace
+{
+    // Topologies are indexed by the first benchmark argument, so that the matrix can be given
+    // as plain integer ranges.
+    const std::array<std::vector<std::size_t>, 3> topologies{{
+        {16, 32, 1},
+        {784, 128, 10},
+        {512, 1024, 1024, 10},
+    }};
+
+    template <std::floating_point Scalar>
+    auto make_values(std::size_t size) -> std::vector<Scalar>
+    {
+        std::vector<Scalar> values(size);
+        for (std::size_t i{0}; i < size; ++i)
+        {
+            values[i] = static_cast<Scalar>(0.5 * std::sin(0.37 * static_cast<double>(i)));
+        }
+
+        return values;
+    }
+
+    // Network and one batch of inputs and targets for the topology and batch size given by the
+    // benchmark arguments. The name of the topology is added to the label.
+    template <std::floating_point Scalar, typename ActivationPolicy>
+    struct Setup
+    {
+        explicit Setup(benchmark::State& state)
+            : topology(topologies.at(static_cast<std::size_t>(state.range(0)))),
+              batch_size(static_cast<std::size_t>(state.range(1))),
+              network(topology, Activation::of<ActivationPolicy>(),
+                      Criterion::of<criterion::MSE>()),
+              inputs(make_values<Scalar>(batch_size * topology.front())),
+              targets(make_values<Scalar>(batch_size * topology.back()))
+        {
+            std::string label;
+            for (const auto size : topology)
+            {
+                label += (label.empty() ? "" : "-") + std::to_string(size);
+            }
+
+            state.SetLabel(label);
+        }
+
+        auto finish(benchmark::State& state) const -> void
+        {
+            state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch_size));
+        }
+
+        std::vector<std::size_t> topology;
+        std::size_t batch_size;
+        BasicNetwork<Scalar> network;
+        std::vector<Scalar> inputs;
+        std::vector<Scalar> targets;
+    };
+
+    template <std::floating_point Scalar, typename ActivationPolicy>
+    auto forward(benchmark::State& state) -> void
+    {
+        Setup<Scalar, ActivationPolicy> setup(state);
+        for (auto _ : state)
+        {
+            setup.network.feed_forward_batch(setup.inputs, setup.batch_size);
+            benchmark::ClobberMemory();
+        }
+
+        setup.finish(state);
+    }
+
+    template <std::floating_point Scalar, typename ActivationPolicy>
+    auto backward(benchmark::State& state) -> void
+    {
+        Setup<Scalar, ActivationPolicy> setup(state);
+        setup.network.feed_forward_batch(setup.inputs, setup.batch_size);
+        for (auto _ : state)
+        {
+            setup.network.back_propagate(setup.targets);
+            benchmark::ClobberMemory();
+        }
+
+        setup.finish(state);
+    }
+
+    // NOTE(abi): a zero learning rate keeps the parameters fixed, so that every iteration
+    // does the same work.
+    template <std::floating_point Scalar, typename ActivationPolicy>
+    auto step(benchmark::State& state) -> void
+    {
+        Setup<Scalar, ActivationPolicy> setup(state);
+        setup.network.feed_forward_batch(setup.inputs, setup.batch_size);
+        setup.network.back_propagate(setup.targets);
+        for (auto _ : state)
+        {
+            setup.network.step(Scalar{0}, Scalar{0.9});
+            benchmark::ClobberMemory();
+        }
+
+        setup.finish(state);
+    }
+
+    template <std::floating_point Scalar, typename ActivationPolicy>
+    auto train(benchmark::State& state) -> void
+    {
+        Setup<Scalar, ActivationPolicy> setup(state);
+        for (auto _ : state)
+        {
+            setup.network.feed_forward_batch(setup.inputs, setup.batch_size);
+            setup.network.back_propagate(setup.targets);
+            setup.network.step(Scalar{1e-4}, Scalar{0.9});
+            benchmark::ClobberMemory();
+        }
+
+        setup.finish(state);
+    }
+
+    // The same iteration as `train` through the fused backward-and-update pass.
+    template <std::floating_point Scalar, typename ActivationPolicy>
+    auto train_step(benchmark::State& state) -> void
+    {
+        Setup<Scalar, ActivationPolicy> setup(state);
+        for (auto _ : state)
+        {
+            setup.network.train_step(setup.inputs, setup.targets, setup.batch_size, Scalar{1e-4},
+                                     Scalar{0.9});
+            benchmark::ClobberMemory();
+        }
+
+        setup.finish(state);
+    }
+
+    template <std::floating_point Scalar>
+    auto loss(benchmark::State& state) -> void
+    {
+        Setup<Scalar, activation::Linear> setup(state);
+        setup.network.feed_forward_batch(setup.inputs, setup.batch_size);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(setup.network.compute_loss(setup.targets));
+        }
+
+        setup.finish(state);
+    }
+
+    // Every topology with batch sizes of one (single-sample training) up to 256.
+    auto full_matrix(benchmark::internal::Benchmark* benchmark) -> void
+    {
+        benchmark->ArgNames({"topology", "batch"})
+            ->ArgsProduct({{0, 1, 2}, {1, 32, 256}})
+            ->Unit(benchmark::kMicrosecond);
+    }
+
+    // Only the mid-sized topology, for the cheaper activation comparisons.
+    auto activation_matrix(benchmark::internal::Benchmark* benchmark) -> void
+    {
+        benchmark->ArgNames({"topology", "batch"})
+            ->ArgsProduct({{1}, {1, 32}})
+            ->Unit(benchmark::kMicrosecond);
+    }
+
+} // namespace
+
+BENCHMARK(forward<double, activation::Tanh>)->Apply(full_matrix);
+BENCHMARK(forward<float, activation::Tanh>)->Apply(full_matrix);
+BENCHMARK(backward<double, activation::Tanh>)->Apply(full_matrix);
+BENCHMARK(backward<float, activation::Tanh>)->Apply(full_matrix);
+BENCHMARK(step<double, activation::Tanh>)->Apply(full_matrix);
+BENCHMARK(step<float, activation::Tanh>)->Apply(full_matrix);
+BENCHMARK(train<double, activation::Tanh>)->Apply(full_matrix);
+BENCHMARK(train<float, activation::Tanh>)->Apply(full_matrix);
+BENCHMARK(train_step<double, activation::Tanh>)->Apply(full_matrix);
+BENCHMARK(train_step<float, activation::Tanh>)->Apply(full_matrix);
+
+BENCHMARK(train<double, activation::Linear>)->Apply(activation_matrix);
+BENCHMARK(train<double, activation::Sigmoid>)->Apply(activation_matrix);
+BENCHMARK(train<double, activation::ReLU>)->Apply(activation_matrix);
+
+BENCHMARK(loss<double>)->Apply(full_matrix);
+BENCHMARK(loss<float>)->Apply(full_matrix);
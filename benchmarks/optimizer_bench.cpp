@@ -0,0 +1,82 @@
+#include "optimizer.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace axon;
+
+namespace
+{
+    // One optimizer step over `range(0)` parameters. Each one streams the parameters, gradients
+    // and its state, so the byte counter is the figure to compare with the memory bandwidth.
+    template <std::floating_point Scalar, typename OptimizerType, typename Options>
+    auto update(benchmark::State& state, std::size_t num_buffers) -> void
+    {
+        const auto size = static_cast<std::size_t>(state.range(0));
+
+        std::vector<Scalar> parameters(size);
+        std::vector<Scalar> gradients(size);
+        for (std::size_t i{0}; i < size; ++i)
+        {
+            parameters[i] = static_cast<Scalar>(0.5 * std::sin(0.37 * static_cast<double>(i)));
+            gradients[i] = static_cast<Scalar>(0.1 * std::cos(0.11 * static_cast<double>(i)));
+        }
+
+        OptimizerType optimizer(Options{});
+        for (auto _ : state)
+        {
+            optimizer.step(parameters, gradients);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(size));
+        state.SetBytesProcessed(state.iterations()
+                                * static_cast<std::int64_t>(num_buffers * size * sizeof(Scalar)));
+    }
+
+    // Reads and writes the parameters and velocities, reads the gradients.
+    template <std::floating_point Scalar>
+    auto sgd(benchmark::State& state) -> void
+    {
+        update<Scalar, BasicSgd<Scalar>, SgdOptions>(state, 5);
+    }
+
+    // Reads and writes the parameters and both moments, reads the gradients.
+    template <std::floating_point Scalar>
+    auto adam(benchmark::State& state) -> void
+    {
+        update<Scalar, BasicAdam<Scalar>, AdamOptions>(state, 7);
+    }
+
+    template <std::floating_point Scalar>
+    auto adamw(benchmark::State& state) -> void
+    {
+        update<Scalar, BasicAdam<Scalar>, AdamWOptions>(state, 7);
+    }
+
+    template <std::floating_point Scalar>
+    auto rmsprop(benchmark::State& state) -> void
+    {
+        update<Scalar, BasicRMSprop<Scalar>, RMSpropOptions>(state, 5);
+    }
+
+    // From a small MLP that fits in cache up to one with a few million parameters.
+    auto sizes(benchmark::internal::Benchmark* benchmark) -> void
+    {
+        benchmark->RangeMultiplier(16)->Range(1 << 12, 1 << 22);
+    }
+
+} // namespace
+
+BENCHMARK(sgd<double>)->Apply(sizes);
+BENCHMARK(sgd<float>)->Apply(sizes);
+BENCHMARK(adam<double>)->Apply(sizes);
+BENCHMARK(adam<float>)->Apply(sizes);
+BENCHMARK(adamw<double>)->Apply(sizes);
+BENCHMARK(adamw<float>)->Apply(sizes);
+BENCHMARK(rmsprop<double>)->Apply(sizes);
+BENCHMARK(rmsprop<float>)->Apply(sizes);
@@ -0,0 +1,71 @@
+#include "activation.hpp"
+#include "criterion.hpp"
+#include "network.hpp"
+#include "sparse.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace axon;
+
+namespace
+{
+    // Forward pass of a pruned 1024 x 1024 layer at `range(0)` percent sparsity over a batch of
+    // `range(1)` samples, forced onto the format given by `range(2)` (0 dense, 1 CSR, 2 blocks).
+    // Block runs prune whole blocks, so their blocks are full. The crossover points of these
+    // runs set `sparse::default_threshold` and `sparse::max_batch_size`.
+    template <std::floating_point Scalar>
+    auto pruned_forward(benchmark::State& state) -> void
+    {
+        constexpr std::size_t width{1024};
+        const double sparsity = static_cast<double>(state.range(0)) / 100.0;
+        const auto batch_size = static_cast<std::size_t>(state.range(1));
+        const auto format = static_cast<SparseFormat>(state.range(2));
+
+        BasicNetwork<Scalar> network({width, width}, Activation::of<activation::Linear>(),
+                                     Criterion::of<criterion::MSE>());
+        network.prune(sparsity,
+                      format == SparseFormat::block ? BasicBlockSparseMatrix<Scalar>::block_size
+                                                    : 1);
+        network.set_sparse_threshold(format == SparseFormat::dense ? 2.0 : 0.0);
+
+        std::vector<Scalar> inputs(batch_size * width);
+        for (std::size_t i{0}; i < inputs.size(); ++i)
+        {
+            inputs[i] = static_cast<Scalar>(std::sin(0.37 * static_cast<double>(i)));
+        }
+
+        for (auto _ : state)
+        {
+            network.feed_forward_batch(inputs, batch_size);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch_size));
+        state.counters["weight_bytes"] = static_cast<double>(
+            sparse::storage_bytes(network.get_sparse_weights(0), width, width));
+    }
+
+    auto sparsity_matrix(benchmark::internal::Benchmark* benchmark) -> void
+    {
+        benchmark->ArgNames({"sparsity", "batch", "format"});
+        for (const std::int64_t sparsity : {50, 70, 80, 90, 95})
+        {
+            for (const std::int64_t batch : {1, 16, 64})
+            {
+                for (const std::int64_t format : {0, 1, 2})
+                {
+                    benchmark->Args({sparsity, batch, format});
+                }
+            }
+        }
+    }
+
+} // namespace
+
+BENCHMARK(pruned_forward<double>)->Apply(sparsity_matrix);
+BENCHMARK(pruned_forward<float>)->Apply(sparsity_matrix);
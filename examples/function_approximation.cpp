@@ -44,13 +44,14 @@ auto main() -> int
 
     const std::vector<std::size_t> topology = {1, 32, 16, 1};
 
-    Activation activation{.function = activation::tanh, .derivative = activation::tanh_derivative};
-    Criterion criterion{.function = criterion::mse, .derivative = criterion::mse_derivative};
+    const auto activation = Activation::of<activation::Tanh>();
+    const auto criterion = Criterion::of<criterion::MSE>();
 
     Network net(topology, activation, criterion);
 
     constexpr std::size_t num_train_samples = 1500;
-    constexpr double learning_rate = 0.01;
+    constexpr std::size_t batch_size = 16;
+    constexpr double learning_rate = 0.05;
     constexpr double momentum = 0.75;
     constexpr std::size_t num_epochs = 500;
 
@@ -58,6 +59,7 @@ auto main() -> int
 
     std::println("- Generated {} training samples", train_dataset.size());
     std::println("- Training hyperparameters:");
+    std::println("\tBatch size: {}", batch_size);
     std::println("\tLearning rate: {}", learning_rate);
     std::println("\tMomentum: {}", momentum);
     std::println("\tEpochs: {}\n", num_epochs);
@@ -68,20 +70,38 @@ auto main() -> int
     constexpr int bar_width = 30;
     const int epoch_width = static_cast<int>(std::log10(num_epochs)) + 1;
 
+    std::vector<double> batch_inputs;
+    std::vector<double> batch_targets;
+    batch_inputs.reserve(batch_size);
+    batch_targets.reserve(batch_size);
+
     for (std::size_t epoch = 0; epoch < num_epochs; ++epoch)
     {
         std::ranges::shuffle(train_dataset, rng);
         double epoch_loss = 0.0;
+        std::size_t num_batches = 0;
 
-        for (const auto& [inputs, targets] : train_dataset)
+        for (std::size_t first = 0; first < train_dataset.size(); first += batch_size)
         {
-            net.feed_forward(inputs);
-            epoch_loss += net.compute_loss(targets);
-            net.back_propagate(targets);
+            const std::size_t last = std::min(first + batch_size, train_dataset.size());
+
+            batch_inputs.clear();
+            batch_targets.clear();
+            for (std::size_t i = first; i < last; ++i)
+            {
+                const auto& [inputs, targets] = train_dataset[i];
+                batch_inputs.insert(batch_inputs.end(), inputs.begin(), inputs.end());
+                batch_targets.insert(batch_targets.end(), targets.begin(), targets.end());
+            }
+
+            net.feed_forward_batch(batch_inputs, last - first);
+            epoch_loss += net.compute_loss(batch_targets);
+            net.back_propagate(batch_targets);
             net.step(learning_rate, momentum);
+            ++num_batches;
         }
 
-        epoch_loss /= static_cast<double>(train_dataset.size());
+        epoch_loss /= static_cast<double>(num_batches);
 
         const int filled = static_cast<int>(bar_width * (epoch + 1) / num_epochs);
         const int pct = static_cast<int>(100.0 * (epoch + 1) / num_epochs);
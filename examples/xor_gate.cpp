@@ -2,15 +2,15 @@
 #include "activation.hpp"
 #include "criterion.hpp"
 
+#include <array>
 #include <print>
 
 using namespace axon;
 
 auto main() -> int
 {
-    Activation activation{.function = activation::sigmoid,
-                          .derivative = activation::sigmoid_derivative};
-    Criterion criterion{.function = criterion::mse, .derivative = criterion::mse_derivative};
+    const auto activation = Activation::of<activation::Sigmoid>();
+    const auto criterion = Criterion::of<criterion::MSE>();
     Network net({2, 4, 1}, activation, criterion);
 
     // Training dataset (XOR truth table)
@@ -29,9 +29,9 @@ auto main() -> int
 
         for (const auto& [inputs, targets] : training_data)
         {
-            net.feed_forward({inputs[0], inputs[1]});
-            epoch_loss += net.compute_loss({targets[0]});
-            net.back_propagate({targets[0]});
+            net.feed_forward(inputs);
+            epoch_loss += net.compute_loss(targets);
+            net.back_propagate(targets);
             net.step(0.3, 0.75);
         }
 
@@ -41,11 +41,13 @@ auto main() -> int
 
     // Test results
     std::println("\n--- Testing trained network ---\n");
+    std::array<double, 1> output{};
     for (const auto& [inputs, targets] : training_data)
     {
-        net.feed_forward({inputs[0], inputs[1]});
-        std::println("[{}, {}] -> {:.4f} (target: {:.1f})", inputs[0], inputs[1],
-                     net.get_output()[0], targets[0]);
+        net.feed_forward(inputs);
+        net.get_output(output);
+        std::println("[{}, {}] -> {:.4f} (target: {:.1f})", inputs[0], inputs[1], output[0],
+                     targets[0]);
     }
 
     return 0;
@@ -1,10 +1,22 @@
 #pragma once
 
 #include <cmath>
+#include <concepts>
+#include <functional>
+#include <span>
 
 namespace axon::activation
 {
 
+    enum class Kind
+    {
+        custom,
+        linear,
+        sigmoid,
+        tanh,
+        relu,
+    };
+
     // Identity function
     [[nodiscard]] constexpr auto linear(double x) -> double
     {
@@ -49,4 +61,266 @@ namespace axon::activation
         return output > 0.0 ? 1.0 : 0.0;
     }
 
+    // Whether whole-layer kernels evaluate exponentials exactly through the standard library or
+    // through a SIMD polynomial approximation.
+    enum class MathMode
+    {
+        exact,
+        fast,
+    };
+
+    // Whole-layer kernels. `inputs` and `outputs` must have the same size and may alias. The
+    // `*_derivative` kernels implement the chain-rule step of backprop: they scale `gradients`
+    // in place by the derivative evaluated at the matching activation `outputs`.
+    //
+    // In fast mode, exponentials use a degree-6 polynomial after Cody-Waite range reduction
+    // (relative error below 2e-7), which bounds the absolute error of sigmoid by 1e-7 and that
+    // of tanh by 2e-7. Linear and ReLU are exact in both modes.
+    namespace vectorized
+    {
+        auto linear(std::span<const double> inputs, std::span<double> outputs) -> void;
+        auto sigmoid(std::span<const double> inputs, std::span<double> outputs,
+                     MathMode mode = MathMode::exact) -> void;
+        auto tanh(std::span<const double> inputs, std::span<double> outputs,
+                  MathMode mode = MathMode::exact) -> void;
+        auto relu(std::span<const double> inputs, std::span<double> outputs) -> void;
+
+        auto linear_derivative(std::span<const double> outputs, std::span<double> gradients)
+            -> void;
+        auto sigmoid_derivative(std::span<const double> outputs, std::span<double> gradients)
+            -> void;
+        auto tanh_derivative(std::span<const double> outputs, std::span<double> gradients)
+            -> void;
+        auto relu_derivative(std::span<const double> outputs, std::span<double> gradients)
+            -> void;
+
+        // Single-precision counterparts. Fast mode keeps the same scheme with float constants
+        // and stays within the same absolute bounds, i.e. within a couple of float ulps.
+        auto linear(std::span<const float> inputs, std::span<float> outputs) -> void;
+        auto sigmoid(std::span<const float> inputs, std::span<float> outputs,
+                     MathMode mode = MathMode::exact) -> void;
+        auto tanh(std::span<const float> inputs, std::span<float> outputs,
+                  MathMode mode = MathMode::exact) -> void;
+        auto relu(std::span<const float> inputs, std::span<float> outputs) -> void;
+
+        auto linear_derivative(std::span<const float> outputs, std::span<float> gradients)
+            -> void;
+        auto sigmoid_derivative(std::span<const float> outputs, std::span<float> gradients)
+            -> void;
+        auto tanh_derivative(std::span<const float> outputs, std::span<float> gradients) -> void;
+        auto relu_derivative(std::span<const float> outputs, std::span<float> gradients) -> void;
+
+    } // namespace vectorized
+
+    // Policy types wrapping the functions above, so that whole-layer loops can be instantiated
+    // with the activation known at compile time. They are generic over the scalar type of the
+    // network; derivatives take the activation's output.
+    template <typename T>
+    concept Policy = requires(double value, float narrow_value, std::span<double> values,
+                              std::span<float> narrow_values, MathMode mode) {
+        { T::kind } -> std::convertible_to<Kind>;
+        { T::function(value) } -> std::same_as<double>;
+        { T::derivative(value) } -> std::same_as<double>;
+        { T::function(narrow_value) } -> std::same_as<float>;
+        { T::derivative(narrow_value) } -> std::same_as<float>;
+        T::template apply<double>(values, values, mode);
+        T::template apply_derivative<double>(values, values);
+        T::template apply<float>(narrow_values, narrow_values, mode);
+        T::template apply_derivative<float>(narrow_values, narrow_values);
+    };
+
+    struct Linear
+    {
+        static constexpr Kind kind{Kind::linear};
+
+        template <std::floating_point Scalar>
+        [[nodiscard]] static constexpr auto function(Scalar x) -> Scalar
+        {
+            return x;
+        }
+
+        template <std::floating_point Scalar>
+        [[nodiscard]] static constexpr auto derivative([[maybe_unused]] Scalar output) -> Scalar
+        {
+            return Scalar{1};
+        }
+
+        template <std::floating_point Scalar>
+        static auto apply(std::span<const Scalar> inputs, std::span<Scalar> outputs,
+                          [[maybe_unused]] MathMode mode) -> void
+        {
+            vectorized::linear(inputs, outputs);
+        }
+
+        template <std::floating_point Scalar>
+        static auto apply_derivative(std::span<const Scalar> outputs, std::span<Scalar> gradients)
+            -> void
+        {
+            vectorized::linear_derivative(outputs, gradients);
+        }
+    };
+
+    struct Sigmoid
+    {
+        static constexpr Kind kind{Kind::sigmoid};
+
+        template <std::floating_point Scalar>
+        [[nodiscard]] static constexpr auto function(Scalar x) -> Scalar
+        {
+            return Scalar{1} / (Scalar{1} + std::exp(-x));
+        }
+
+        template <std::floating_point Scalar>
+        [[nodiscard]] static constexpr auto derivative(Scalar output) -> Scalar
+        {
+            return output * (Scalar{1} - output);
+        }
+
+        template <std::floating_point Scalar>
+        static auto apply(std::span<const Scalar> inputs, std::span<Scalar> outputs,
+                          MathMode mode) -> void
+        {
+            vectorized::sigmoid(inputs, outputs, mode);
+        }
+
+        template <std::floating_point Scalar>
+        static auto apply_derivative(std::span<const Scalar> outputs, std::span<Scalar> gradients)
+            -> void
+        {
+            vectorized::sigmoid_derivative(outputs, gradients);
+        }
+    };
+
+    struct Tanh
+    {
+        static constexpr Kind kind{Kind::tanh};
+
+        template <std::floating_point Scalar>
+        [[nodiscard]] static constexpr auto function(Scalar x) -> Scalar
+        {
+            return std::tanh(x);
+        }
+
+        template <std::floating_point Scalar>
+        [[nodiscard]] static constexpr auto derivative(Scalar output) -> Scalar
+        {
+            return Scalar{1} - (output * output);
+        }
+
+        template <std::floating_point Scalar>
+        static auto apply(std::span<const Scalar> inputs, std::span<Scalar> outputs,
+                          MathMode mode) -> void
+        {
+            vectorized::tanh(inputs, outputs, mode);
+        }
+
+        template <std::floating_point Scalar>
+        static auto apply_derivative(std::span<const Scalar> outputs, std::span<Scalar> gradients)
+            -> void
+        {
+            vectorized::tanh_derivative(outputs, gradients);
+        }
+    };
+
+    struct ReLU
+    {
+        static constexpr Kind kind{Kind::relu};
+
+        template <std::floating_point Scalar>
+        [[nodiscard]] static constexpr auto function(Scalar x) -> Scalar
+        {
+            return x > Scalar{0} ? x : Scalar{0};
+        }
+
+        template <std::floating_point Scalar>
+        [[nodiscard]] static constexpr auto derivative(Scalar output) -> Scalar
+        {
+            return output > Scalar{0} ? Scalar{1} : Scalar{0};
+        }
+
+        template <std::floating_point Scalar>
+        static auto apply(std::span<const Scalar> inputs, std::span<Scalar> outputs,
+                          [[maybe_unused]] MathMode mode) -> void
+        {
+            vectorized::relu(inputs, outputs);
+        }
+
+        template <std::floating_point Scalar>
+        static auto apply_derivative(std::span<const Scalar> outputs, std::span<Scalar> gradients)
+            -> void
+        {
+            vectorized::relu_derivative(outputs, gradients);
+        }
+    };
+
 } // namespace axon::activation
+
+namespace axon
+{
+
+    // Runtime description of an activation. Built-in activations carry their `kind`, which lets
+    // the network dispatch once per layer to an inlined loop; user-supplied callables fall back
+    // to calling through `std::function` for every unit. Callables work in double precision
+    // whatever the scalar type of the network. They are never called from the scheduler's
+    // worker threads, only from the thread running the forward or backward pass; the
+    // data-parallel trainer runs the shards of such networks serially for that reason.
+    struct Activation
+    {
+        using Function = std::function<double(double)>;
+
+        Function function;
+        Function derivative;
+        activation::Kind kind{activation::Kind::custom};
+
+        template <activation::Policy P>
+        [[nodiscard]] static auto of() -> Activation
+        {
+            return {.function = &P::template function<double>,
+                    .derivative = &P::template derivative<double>,
+                    .kind = P::kind};
+        }
+
+        // Recognises the built-in free functions when they are passed as plain function
+        // pointers, e.g. `Activation{.function = activation::tanh, ...}`.
+        [[nodiscard]] auto resolve_kind() const -> activation::Kind
+        {
+            if (kind != activation::Kind::custom)
+            {
+                return kind;
+            }
+
+            const auto* const function_ptr = function.target<double (*)(double)>();
+            const auto* const derivative_ptr = derivative.target<double (*)(double)>();
+            if (function_ptr == nullptr || derivative_ptr == nullptr)
+            {
+                return activation::Kind::custom;
+            }
+
+            const auto matches = [&](auto* fn, auto* derivative_fn)
+            { return *function_ptr == fn && *derivative_ptr == derivative_fn; };
+
+            if (matches(&activation::linear, &activation::linear_derivative))
+            {
+                return activation::Kind::linear;
+            }
+
+            if (matches(&activation::sigmoid, &activation::sigmoid_derivative))
+            {
+                return activation::Kind::sigmoid;
+            }
+
+            if (matches(&activation::tanh, &activation::tanh_derivative))
+            {
+                return activation::Kind::tanh;
+            }
+
+            if (matches(&activation::relu, &activation::relu_derivative))
+            {
+                return activation::Kind::relu;
+            }
+
+            return activation::Kind::custom;
+        }
+    };
+
+} // namespace axon
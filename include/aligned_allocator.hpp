@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace axon
+{
+
+    inline constexpr std::size_t cache_line_size{64};
+
+    // Minimal allocator handing out cache-line aligned blocks, so that every parameter buffer
+    // starts on its own line and can be loaded with aligned vector instructions.
+    template <typename T, std::size_t Alignment = cache_line_size>
+    struct AlignedAllocator
+    {
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+
+        template <typename U>
+        AlignedAllocator([[maybe_unused]] const AlignedAllocator<U, Alignment>& other) noexcept
+        {
+        }
+
+        [[nodiscard]] auto allocate(std::size_t count) -> T*
+        {
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+        }
+
+        auto deallocate(T* pointer, std::size_t count) noexcept -> void
+        {
+            ::operator delete(pointer, count * sizeof(T), std::align_val_t{Alignment});
+        }
+
+        template <typename U>
+        [[nodiscard]] auto operator==(
+            [[maybe_unused]] const AlignedAllocator<U, Alignment>& other) const noexcept -> bool
+        {
+            return true;
+        }
+    };
+
+    template <typename T>
+    using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+} // namespace axon
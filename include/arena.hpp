@@ -0,0 +1,97 @@
+#pragma once
+
+#include "aligned_allocator.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+
+namespace axon
+{
+
+    // Number of `T` elements reserved for a buffer of `count` elements, rounded up to whole cache
+    // lines so that the next buffer carved after it starts on its own line.
+    template <typename T>
+    [[nodiscard]] constexpr auto padded_size(std::size_t count) -> std::size_t
+    {
+        constexpr std::size_t line_elements{cache_line_size / sizeof(T)};
+        return ((count + line_elements - 1) / line_elements) * line_elements;
+    }
+
+    // Single cache-line aligned block that a network carves all of its buffers from, so that
+    // building one costs one allocation and copying one costs one `memcpy`. The memory comes
+    // from a `std::pmr::memory_resource`, which lets callers supply e.g. huge pages or
+    // NUMA-local memory; copies draw from the same resource as their source.
+    //
+    // Buffers are handed out as spans at byte offsets chosen by the owner, which keeps the
+    // layout deterministic: two arenas filled the same way hold every buffer at the same offset,
+    // and `rebase` translates a view into one arena into the matching view into another.
+    class Arena
+    {
+    public:
+        explicit Arena(std::size_t size = 0,
+                       std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+        ~Arena();
+
+        Arena(const Arena& other);
+        Arena(Arena&& other) noexcept;
+
+        // NOTE(abi): assigning an arena of the same size reuses the block, so refreshing a
+        // snapshot of a network never allocates.
+        auto operator=(const Arena& other) -> Arena&;
+        auto operator=(Arena&& other) noexcept -> Arena&;
+
+        [[nodiscard]] auto size() const -> std::size_t
+        {
+            return size_;
+        }
+
+        [[nodiscard]] auto data() -> std::byte*
+        {
+            return data_;
+        }
+
+        [[nodiscard]] auto data() const -> const std::byte*
+        {
+            return data_;
+        }
+
+        [[nodiscard]] auto get_resource() const -> std::pmr::memory_resource*
+        {
+            return resource_;
+        }
+
+        // Reallocates the block to `size` bytes. The first `min(size, this->size())` bytes keep
+        // their contents and the rest are zeroed; views into the old block become dangling.
+        auto resize(std::size_t size) -> void;
+
+        // `count` elements starting `offset` bytes into the block.
+        template <typename T>
+        [[nodiscard]] auto view(std::size_t offset, std::size_t count) -> std::span<T>
+        {
+            return {reinterpret_cast<T*>(data_ + offset), count};
+        }
+
+        // The view into this arena at the offset `view` has in `source`.
+        template <typename T>
+        [[nodiscard]] auto rebase(std::span<T> view, const Arena& source) -> std::span<T>
+        {
+            if (view.data() == nullptr)
+            {
+                return {};
+            }
+
+            const auto offset = static_cast<std::size_t>(
+                reinterpret_cast<const std::byte*>(view.data()) - source.data_);
+            return this->view<T>(offset, view.size());
+        }
+
+    private:
+        auto release() noexcept -> void;
+
+        std::pmr::memory_resource* resource_;
+        std::byte* data_{nullptr};
+        std::size_t size_{0};
+    };
+
+} // namespace axon
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "activation.hpp"
+#include "arena.hpp"
+#include "criterion.hpp"
+#include "network.hpp"
+#include "workspace.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace axon::autograd
+{
+
+    // Handle to a matrix recorded on a tape. Only meaningful for the tape and the graph that
+    // produced it.
+    struct Var
+    {
+        std::uint32_t index{0};
+    };
+
+    // Reverse-mode automatic differentiation over row-major matrices. Every op computes its
+    // value right away with the library's kernels (GEMM, whole-layer activations) and records
+    // itself on the tape; `backward` then walks the tape in reverse and applies the chain rule.
+    //
+    // Values and gradients live in a per-graph arena that is rewound, not freed, when the next
+    // graph starts, and the node list keeps its capacity, so recording the same graph again
+    // allocates nothing. The first graph sizes the arena; larger graphs grow it once.
+    //
+    // NOTE(abi): constants, parameters, targets and activation or criterion descriptors are
+    // referenced, not copied, and must stay alive until `backward` returns. Parameter gradients
+    // go straight to caller-owned buffers, e.g. the `weight_gradients` of a network workspace,
+    // and are overwritten, not accumulated across graphs.
+    template <std::floating_point Scalar>
+    class BasicTape
+    {
+    public:
+        explicit BasicTape(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        // Leaves. A constant takes no gradient; a parameter writes its gradient to `gradients`,
+        // which has the size of `values`.
+        [[nodiscard]] auto constant(std::span<const Scalar> values, std::size_t rows,
+                                    std::size_t cols) -> Var;
+        [[nodiscard]] auto parameter(std::span<const Scalar> values, std::span<Scalar> gradients,
+                                     std::size_t rows, std::size_t cols) -> Var;
+
+        // a (m x k) * b (k x n).
+        [[nodiscard]] auto matmul(Var a, Var b) -> Var;
+
+        // Elementwise, on matrices of the same shape.
+        [[nodiscard]] auto add(Var a, Var b) -> Var;
+        [[nodiscard]] auto multiply(Var a, Var b) -> Var;
+
+        // Adds the 1 x cols row `bias` to every row of `x`.
+        [[nodiscard]] auto add_bias(Var x, Var bias) -> Var;
+
+        [[nodiscard]] auto activate(Var x, const Activation& activation,
+                                    activation::MathMode mode = activation::MathMode::exact)
+            -> Var;
+
+        // activation(x * weights^T + bias) for x (batch x in), weights (out x in) and bias
+        // (1 x out): a fully-connected layer as one op, with the same kernels and memory
+        // traffic as `BasicNetwork`. `layer` labels its forward and backward trace events.
+        [[nodiscard]] auto linear(Var x, Var weights, Var bias, const Activation& activation,
+                                  activation::MathMode mode = activation::MathMode::exact,
+                                  std::int32_t layer = -1) -> Var;
+
+        // Mean of `criterion` over every entry of `prediction`, as a 1 x 1 matrix.
+        [[nodiscard]] auto loss(Var prediction, std::span<const Scalar> targets,
+                                const Criterion& criterion) -> Var;
+
+        // Propagates d(seed * output)/d(node) to every node `output` depends on and writes the
+        // gradients of the parameters; those the output does not depend on get zeros. `output`
+        // is usually a 1 x 1 loss.
+        auto backward(Var output, Scalar seed = Scalar{1}) -> void;
+
+        // Discards the graph and rewinds the arena. Recording after `backward` does it
+        // implicitly, so values and gradients stay readable until then.
+        auto reset() -> void;
+
+        [[nodiscard]] auto value(Var var) const -> std::span<const Scalar>;
+
+        // Empty for constants and for nodes that no gradient reached.
+        [[nodiscard]] auto gradient(Var var) const -> std::span<const Scalar>;
+
+        [[nodiscard]] auto rows(Var var) const -> std::size_t
+        {
+            return nodes_[var.index].rows;
+        }
+
+        [[nodiscard]] auto cols(Var var) const -> std::size_t
+        {
+            return nodes_[var.index].cols;
+        }
+
+        [[nodiscard]] auto size() const -> std::size_t
+        {
+            return nodes_.size();
+        }
+
+        // Bytes of the arena, kept across graphs.
+        [[nodiscard]] auto get_capacity() const -> std::size_t;
+
+    private:
+        enum class Op : std::uint8_t
+        {
+            constant,
+            parameter,
+            matmul,
+            add,
+            multiply,
+            add_bias,
+            activate,
+            linear,
+            loss,
+        };
+
+        struct Node
+        {
+            Op op{Op::constant};
+            bool requires_gradient{false};
+            bool has_gradient{false}; // set once a gradient was written during `backward`
+            activation::MathMode mode{activation::MathMode::exact};
+            std::int32_t layer{-1}; // trace label of a `linear` op
+            std::uint32_t inputs[3]{};
+            std::size_t rows{0};
+            std::size_t cols{0};
+            const Scalar* value{nullptr};
+            Scalar* gradient{nullptr};
+            const void* descriptor{nullptr}; // Activation or Criterion
+            const Scalar* targets{nullptr};
+        };
+
+        auto begin_op() -> void;
+        auto allocate(std::size_t count) -> Scalar*;
+        auto push(Node node) -> Var;
+        auto node_of(Var var) const -> const Node&;
+
+        // Adds `count` values to the gradient of `node`, or writes them if none arrived yet.
+        auto accumulate(Node& node, const Scalar* values) -> void;
+        auto backward_node(Node& node) -> void;
+
+        std::pmr::memory_resource* resource_;
+        std::pmr::vector<Node> nodes_;
+        std::vector<Arena> blocks_;
+        std::size_t offset_{0};
+        bool differentiated_{false};
+    };
+
+    // Records the forward pass of `network` over a row-major `batch_size x num_inputs` matrix,
+    // one `linear` op per layer, with the layer parameters' gradients going to `gradients`
+    // (e.g. `network.make_workspace()`). Returns the output node; recording the loss and
+    // calling `backward` with a seed of `num_outputs` then fills `gradients` exactly like
+    // `BasicNetwork::backward` with a `1 / batch_size` scale, ready for `apply_gradients`.
+    //
+    // NOTE(abi): `inputs` is kept out of deduction so that vectors and arrays convert to it.
+    template <std::floating_point Scalar>
+    auto record(BasicTape<Scalar>& tape, const BasicNetwork<Scalar>& network,
+                std::type_identity_t<std::span<const Scalar>> inputs, std::size_t batch_size,
+                BasicWorkspace<Scalar>& gradients) -> Var;
+
+    extern template class BasicTape<float>;
+    extern template class BasicTape<double>;
+
+    using Tape = BasicTape<double>;
+
+} // namespace axon::autograd
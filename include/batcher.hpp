@@ -0,0 +1,130 @@
+#pragma once
+
+#include "aligned_allocator.hpp"
+#include "inference_session.hpp"
+#include "network.hpp"
+
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace axon
+{
+
+    struct BatcherOptions
+    {
+        std::size_t max_batch_size{32};
+        std::chrono::microseconds max_wait{500}; // longest the oldest request waits for company
+        std::size_t latency_window{8192};        // most recent requests kept for the percentiles
+    };
+
+    // Snapshot of the counters of a batcher. Latencies run from `submit` until the output is
+    // available, and the percentiles cover the last `latency_window` requests.
+    struct BatcherStats
+    {
+        std::size_t num_requests{0}; // completed
+        std::size_t num_batches{0};
+        std::size_t queue_depth{0}; // pending when the snapshot was taken
+        std::size_t max_queue_depth{0};
+        std::vector<std::size_t> batch_sizes; // number of batches of each size, 0..max
+        std::chrono::nanoseconds p50{0};
+        std::chrono::nanoseconds p90{0};
+        std::chrono::nanoseconds p99{0};
+        std::chrono::nanoseconds max{0};
+
+        [[nodiscard]] auto mean_batch_size() const -> double
+        {
+            return num_batches == 0
+                       ? 0.0
+                       : static_cast<double>(num_requests) / static_cast<double>(num_batches);
+        }
+    };
+
+    // Dynamic micro-batching for request handlers that see one sample at a time. Callers submit
+    // single inputs from any thread and get a future; a dispatcher thread coalesces the pending
+    // requests into one batch once `max_batch_size` of them are queued or the oldest has waited
+    // `max_wait`, runs a single batched forward pass and hands every caller its row of the
+    // outputs. Raising `max_wait` buys throughput with tail latency, which the stats expose.
+    //
+    // NOTE(abi): the network is only read, through an inference session, and must outlive the
+    // batcher. Pending requests are still served when the batcher is destroyed.
+    template <std::floating_point Scalar>
+    class BasicBatcher
+    {
+    public:
+        explicit BasicBatcher(const BasicNetwork<Scalar>& network,
+                              const BatcherOptions& options = {});
+
+        BasicBatcher(const BasicBatcher&) = delete;
+        BasicBatcher(BasicBatcher&&) = delete;
+        auto operator=(const BasicBatcher&) -> BasicBatcher& = delete;
+        auto operator=(BasicBatcher&&) -> BasicBatcher& = delete;
+
+        ~BasicBatcher();
+
+        // Queues one sample of `num_inputs` values. The future holds its `num_outputs` outputs,
+        // or the exception thrown by the forward pass.
+        [[nodiscard]] auto submit(std::span<const Scalar> input)
+            -> std::future<std::vector<Scalar>>;
+
+        [[nodiscard]] auto get_stats() const -> BatcherStats;
+
+        [[nodiscard]] auto get_options() const -> const BatcherOptions&
+        {
+            return options_;
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Request
+        {
+            std::vector<Scalar> input;
+            std::promise<std::vector<Scalar>> output;
+            Clock::time_point submitted;
+        };
+
+        auto dispatch_loop() -> void;
+        auto run_batch() -> std::exception_ptr;
+        auto deliver(const std::exception_ptr& error) -> void;
+
+        BatcherOptions options_;
+        std::size_t num_inputs_{0};
+        std::size_t num_outputs_{0};
+
+        // Owned by the dispatcher thread.
+        BasicInferenceSession<Scalar> session_;
+        std::vector<Request> batch_;
+        AlignedVector<Scalar> inputs_;
+        AlignedVector<Scalar> outputs_;
+
+        // Shared with the callers.
+        mutable std::mutex mutex_;
+        std::condition_variable changed_;
+        std::deque<Request> queue_;
+        bool stopping_{false};
+        std::size_t num_requests_{0};
+        std::size_t num_batches_{0};
+        std::size_t max_queue_depth_{0};
+        std::vector<std::size_t> batch_sizes_;
+        std::vector<std::int64_t> latencies_; // nanoseconds, ring of `latency_window`
+        std::size_t latency_cursor_{0};
+
+        std::thread dispatcher_;
+    };
+
+    extern template class BasicBatcher<float>;
+    extern template class BasicBatcher<double>;
+
+    using Batcher = BasicBatcher<double>;
+
+} // namespace axon
@@ -0,0 +1,216 @@
+#pragma once
+
+#include "mapped_file.hpp"
+#include "network.hpp"
+#include "optimizer.hpp"
+#include "serialization.hpp"
+
+#include <array>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace axon
+{
+
+    // Training progress stored alongside the parameters of a checkpoint, so that a resumed run
+    // continues with the same schedule and data order.
+    struct TrainingState
+    {
+        std::uint64_t epoch{0};
+        std::uint64_t step{0};
+        std::uint64_t seed{0};
+        double learning_rate{0.0};
+        double momentum{0.0};
+    };
+
+    // State of a `StatefulOptimizer`, as stored in a checkpoint.
+    template <std::floating_point Scalar>
+    struct OptimizerState
+    {
+        std::span<const Scalar> values;
+        std::size_t num_steps{0};
+    };
+
+    namespace detail
+    {
+
+        // Cores of the checkpoint functions below, with the optimizer type erased; either
+        // optimizer pointer may be null. `restore_checkpoint` points the values into `file`.
+        template <std::floating_point Scalar>
+        auto save_checkpoint(const BasicNetwork<Scalar>& network,
+                             const OptimizerState<Scalar>* optimizer, const TrainingState& state,
+                             const std::filesystem::path& path) -> void;
+
+        template <std::floating_point Scalar>
+        auto restore_checkpoint(const MappedFile& file, BasicNetwork<Scalar>& network,
+                                OptimizerState<Scalar>* optimizer,
+                                serialization::Verification verification) -> TrainingState;
+
+        extern template auto save_checkpoint(const BasicNetwork<float>&,
+                                             const OptimizerState<float>*, const TrainingState&,
+                                             const std::filesystem::path&) -> void;
+        extern template auto save_checkpoint(const BasicNetwork<double>&,
+                                             const OptimizerState<double>*, const TrainingState&,
+                                             const std::filesystem::path&) -> void;
+        extern template auto restore_checkpoint(const MappedFile&, BasicNetwork<float>&,
+                                                OptimizerState<float>*,
+                                                serialization::Verification) -> TrainingState;
+        extern template auto restore_checkpoint(const MappedFile&, BasicNetwork<double>&,
+                                                OptimizerState<double>*,
+                                                serialization::Verification) -> TrainingState;
+
+    } // namespace detail
+
+    // Checkpoints use the layout of the model format (see `serialization.hpp`) under their own
+    // magic, with a `TrainingState` block after the layer sizes and the momentum velocities
+    // after the weights and biases of every layer. Checkpoints of pruned networks set the first
+    // bit of the header flags and store the mask of every layer, one byte per weight, after its
+    // velocities. Checkpoints taken with an optimizer set the second bit and end with its state.
+    // Everything is stored bit for bit, so restoring a checkpoint and training on resumes
+    // exactly where the run left off.
+    namespace serialization
+    {
+
+        // Synchronous counterparts of `BasicCheckpointer::save`.
+        template <std::floating_point Scalar>
+        auto save_checkpoint(const BasicNetwork<Scalar>& network, const TrainingState& state,
+                             const std::filesystem::path& path) -> void
+        {
+            detail::save_checkpoint<Scalar>(network, nullptr, state, path);
+        }
+
+        // Same, also storing the state of the optimizer the run updates the network with.
+        template <std::floating_point Scalar, StatefulOptimizer<Scalar> OptimizerType>
+        auto save_checkpoint(const BasicNetwork<Scalar>& network, const OptimizerType& optimizer,
+                             const TrainingState& state, const std::filesystem::path& path)
+            -> void
+        {
+            const OptimizerState<Scalar> saved{.values = optimizer.get_state(),
+                                               .num_steps = optimizer.get_num_steps()};
+            detail::save_checkpoint(network, &saved, state, path);
+        }
+
+        // Restores the parameters, velocities and pruning masks of `network`, which must have the
+        // topology the checkpoint was taken from, and returns the saved training state. A
+        // network restored from a checkpoint of an unpruned one is left unpruned.
+        template <std::floating_point Scalar>
+        auto restore_checkpoint(const std::filesystem::path& path, BasicNetwork<Scalar>& network,
+                                Verification verification = Verification::checksum)
+            -> TrainingState
+        {
+            const MappedFile file(path);
+            return detail::restore_checkpoint<Scalar>(file, network, nullptr, verification);
+        }
+
+        // Same, also restoring the state of `optimizer`. Throws `std::invalid_argument` when
+        // the checkpoint was taken without one.
+        template <std::floating_point Scalar, StatefulOptimizer<Scalar> OptimizerType>
+        auto restore_checkpoint(const std::filesystem::path& path, BasicNetwork<Scalar>& network,
+                                OptimizerType& optimizer,
+                                Verification verification = Verification::checksum)
+            -> TrainingState
+        {
+            const MappedFile file(path);
+            OptimizerState<Scalar> saved;
+            const auto state = detail::restore_checkpoint(file, network, &saved, verification);
+            optimizer.set_state(saved.values, saved.num_steps);
+            return state;
+        }
+
+    } // namespace serialization
+
+    // Periodic checkpoints written off the training thread. `save` only copies the parameters
+    // and velocities into one of two preallocated snapshot buffers and returns; a background
+    // thread checksums the snapshot and replaces the checkpoint file atomically. If the disk
+    // falls behind, a snapshot still waiting to be written is replaced by the newer one rather
+    // than blocking the training loop, so the cost of `save` stays one copy of the state.
+    //
+    // `save` and `wait` must not be called concurrently with each other.
+    template <std::floating_point Scalar>
+    class BasicCheckpointer
+    {
+    public:
+        explicit BasicCheckpointer(std::filesystem::path path);
+
+        BasicCheckpointer(const BasicCheckpointer&) = delete;
+        BasicCheckpointer(BasicCheckpointer&&) = delete;
+        auto operator=(const BasicCheckpointer&) -> BasicCheckpointer& = delete;
+        auto operator=(BasicCheckpointer&&) -> BasicCheckpointer& = delete;
+
+        // Writes any pending snapshot before returning.
+        ~BasicCheckpointer();
+
+        // Rethrows the error of a failed background write, if any.
+        auto save(const BasicNetwork<Scalar>& network, const TrainingState& state) -> void
+        {
+            save(network, nullptr, state);
+        }
+
+        // Same, also storing the state of `optimizer`.
+        template <StatefulOptimizer<Scalar> OptimizerType>
+        auto save(const BasicNetwork<Scalar>& network, const OptimizerType& optimizer,
+                  const TrainingState& state) -> void
+        {
+            const OptimizerState<Scalar> saved{.values = optimizer.get_state(),
+                                               .num_steps = optimizer.get_num_steps()};
+            save(network, &saved, state);
+        }
+
+        // Blocks until every snapshot taken so far is on disk (or was superseded), then rethrows
+        // the error of a failed write, if any.
+        auto wait() -> void;
+
+        [[nodiscard]] auto get_num_written() const -> std::size_t;
+        [[nodiscard]] auto get_num_superseded() const -> std::size_t;
+
+    private:
+        enum class BufferState
+        {
+            free,
+            filling,
+            pending,
+            writing,
+        };
+
+        // Layout of the snapshots in a buffer, kept until the topology, the pruning or the
+        // optimizer state size changes.
+        struct CachedLayout;
+
+        struct Buffer
+        {
+            std::vector<std::byte> bytes;
+            std::unique_ptr<CachedLayout> layout;
+            BufferState state{BufferState::free};
+        };
+
+        auto save(const BasicNetwork<Scalar>& network, const OptimizerState<Scalar>* optimizer,
+                  const TrainingState& state) -> void;
+        auto writer_loop() -> void;
+        auto rethrow_error() -> void;
+
+        std::filesystem::path path_;
+        std::array<Buffer, 2> buffers_;
+        mutable std::mutex mutex_;
+        std::condition_variable changed_;
+        std::exception_ptr error_;
+        std::size_t num_written_{0};
+        std::size_t num_superseded_{0};
+        bool stopping_{false};
+        std::thread writer_; // started last, once everything it reads is initialised
+    };
+
+    extern template class BasicCheckpointer<float>;
+    extern template class BasicCheckpointer<double>;
+
+    using Checkpointer = BasicCheckpointer<double>;
+
+} // namespace axon
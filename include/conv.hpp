@@ -0,0 +1,272 @@
+#pragma once
+
+#include "aligned_allocator.hpp"
+#include "tensor.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace axon
+{
+
+    // Square kernels over NCHW tensors: `batch x channels x height x width`, row-major, so that
+    // every channel of a sample is one contiguous plane.
+    struct Conv2DOptions
+    {
+        std::size_t in_channels{1};
+        std::size_t out_channels{1};
+        std::size_t kernel_size{3};
+        std::size_t stride{1};
+        std::size_t padding{0}; // zeros on every side
+    };
+
+    // How a convolution runs its forward pass (and, for `direct`, its backward-data pass).
+    enum class ConvAlgorithm
+    {
+        automatic, // `direct` where it applies and measured faster, `im2col` otherwise
+        im2col,    // unfold the receptive fields into a matrix and multiply with the GEMM
+        direct,    // 3 x 3, stride 1 only: sliding SIMD kernel over the zero-padded planes
+    };
+
+    namespace conv
+    {
+
+        // Output extent of a convolution along one dimension. Throws when the kernel does not
+        // fit in the padded input or the stride is zero.
+        [[nodiscard]] auto output_extent(std::size_t input, std::size_t kernel, std::size_t stride,
+                                         std::size_t padding) -> std::size_t;
+
+        // Output extent of a transpose convolution, the input extent of the convolution it
+        // inverts.
+        [[nodiscard]] auto transpose_extent(std::size_t input, std::size_t kernel,
+                                            std::size_t stride, std::size_t padding)
+            -> std::size_t;
+
+        // Whether `automatic` picks the direct kernel for these options: 3 x 3 at stride 1,
+        // with few enough channels that the GEMM cannot amortize unfolding nine copies of the
+        // input (see `benchmarks/conv_bench.cpp`).
+        [[nodiscard]] auto prefers_direct(const Conv2DOptions& options) -> bool;
+
+        // Unfolds a `channels x height x width` image into a `(channels * kernel * kernel) x
+        // (out_height * out_width)` matrix whose column `i` holds the receptive field of output
+        // pixel `i`, with zeros for padding.
+        template <std::floating_point Scalar>
+        auto im2col(const Scalar* image, std::size_t channels, std::size_t height,
+                    std::size_t width, std::size_t kernel, std::size_t stride, std::size_t padding,
+                    Scalar* columns) -> void;
+
+        // The adjoint of `im2col`: adds every column entry back onto the pixel it came from.
+        // `image` is accumulated into, so callers zero it first.
+        template <std::floating_point Scalar>
+        auto col2im(const Scalar* columns, std::size_t channels, std::size_t height,
+                    std::size_t width, std::size_t kernel, std::size_t stride, std::size_t padding,
+                    Scalar* image) -> void;
+
+    } // namespace conv
+
+    // 2-D convolution layer. The parameters live in one flat buffer, the weights (`out_channels
+    // x in_channels x kernel x kernel`) followed by the biases (`out_channels`), and the
+    // gradients of `backward_weights` in a second buffer with the same layout, so any
+    // `Optimizer` updates a layer with `optimizer.step(conv.get_parameters(),
+    // conv.get_gradients())`.
+    //
+    // Tensors must be contiguous NCHW. The layer keeps the scratch buffers of its passes and
+    // only grows them, so steady-state passes over the same shapes never allocate; one layer
+    // therefore runs one pass at a time.
+    template <std::floating_point Scalar>
+    class BasicConv2D
+    {
+    public:
+        // Weights and biases are drawn uniformly from [-1, 1], like those of dense layers.
+        explicit BasicConv2D(const Conv2DOptions& options);
+
+        [[nodiscard]] auto get_options() const -> const Conv2DOptions&
+        {
+            return options_;
+        }
+
+        [[nodiscard]] auto get_algorithm() const -> ConvAlgorithm
+        {
+            return algorithm_;
+        }
+
+        // Throws for `direct` when the options are not 3 x 3 at stride 1.
+        auto set_algorithm(ConvAlgorithm algorithm) -> void;
+
+        [[nodiscard]] auto get_parameters() -> std::span<Scalar>
+        {
+            return parameters_;
+        }
+
+        [[nodiscard]] auto get_parameters() const -> std::span<const Scalar>
+        {
+            return parameters_;
+        }
+
+        [[nodiscard]] auto get_gradients() const -> std::span<const Scalar>
+        {
+            return gradients_;
+        }
+
+        [[nodiscard]] auto get_weights() const -> std::span<const Scalar>
+        {
+            return std::span<const Scalar>{parameters_}.first(num_weights());
+        }
+
+        [[nodiscard]] auto get_biases() const -> std::span<const Scalar>
+        {
+            return std::span<const Scalar>{parameters_}.subspan(num_weights());
+        }
+
+        [[nodiscard]] auto get_weight_gradients() const -> std::span<const Scalar>
+        {
+            return std::span<const Scalar>{gradients_}.first(num_weights());
+        }
+
+        [[nodiscard]] auto get_bias_gradients() const -> std::span<const Scalar>
+        {
+            return std::span<const Scalar>{gradients_}.subspan(num_weights());
+        }
+
+        // `batch x out_channels x out_height x out_width` for an NCHW input of `shape`.
+        [[nodiscard]] auto output_shape(const Shape& shape) const -> Shape;
+
+        auto forward(BasicTensorView<const Scalar> inputs, BasicTensorView<Scalar> outputs)
+            -> void;
+
+        // Gradients with respect to the inputs, from those of the outputs.
+        auto backward_data(BasicTensorView<const Scalar> output_gradients,
+                           BasicTensorView<Scalar> input_gradients) -> void;
+
+        // Writes the gradients of the weights and biases summed over the batch, from the inputs
+        // of the forward pass and the gradients of its outputs.
+        auto backward_weights(BasicTensorView<const Scalar> inputs,
+                              BasicTensorView<const Scalar> output_gradients) -> void;
+
+    private:
+        [[nodiscard]] auto num_weights() const -> std::size_t
+        {
+            return options_.out_channels * options_.in_channels * options_.kernel_size
+                   * options_.kernel_size;
+        }
+
+        [[nodiscard]] auto use_direct() const -> bool;
+
+        Conv2DOptions options_;
+        ConvAlgorithm algorithm_{ConvAlgorithm::automatic};
+        AlignedVector<Scalar> parameters_;
+        AlignedVector<Scalar> gradients_;
+        AlignedVector<Scalar> columns_; // im2col matrix, or zero-padded planes for `direct`
+        AlignedVector<Scalar> flipped_; // weights of the backward-data pass of `direct`
+    };
+
+    // Transpose ("fractionally strided") convolution, which upsamples: its forward pass is the
+    // backward-data pass of the convolution with the same options, so `stride` spreads the
+    // input pixels apart. Weights are `in_channels x out_channels x kernel x kernel`, followed
+    // by `out_channels` biases.
+    template <std::floating_point Scalar>
+    class BasicConvTranspose2D
+    {
+    public:
+        explicit BasicConvTranspose2D(const Conv2DOptions& options);
+
+        [[nodiscard]] auto get_options() const -> const Conv2DOptions&
+        {
+            return options_;
+        }
+
+        [[nodiscard]] auto get_parameters() -> std::span<Scalar>
+        {
+            return parameters_;
+        }
+
+        [[nodiscard]] auto get_parameters() const -> std::span<const Scalar>
+        {
+            return parameters_;
+        }
+
+        [[nodiscard]] auto get_gradients() const -> std::span<const Scalar>
+        {
+            return gradients_;
+        }
+
+        [[nodiscard]] auto output_shape(const Shape& shape) const -> Shape;
+
+        auto forward(BasicTensorView<const Scalar> inputs, BasicTensorView<Scalar> outputs)
+            -> void;
+        auto backward_data(BasicTensorView<const Scalar> output_gradients,
+                           BasicTensorView<Scalar> input_gradients) -> void;
+        auto backward_weights(BasicTensorView<const Scalar> inputs,
+                              BasicTensorView<const Scalar> output_gradients) -> void;
+
+    private:
+        [[nodiscard]] auto num_weights() const -> std::size_t
+        {
+            return options_.in_channels * options_.out_channels * options_.kernel_size
+                   * options_.kernel_size;
+        }
+
+        Conv2DOptions options_;
+        AlignedVector<Scalar> parameters_;
+        AlignedVector<Scalar> gradients_;
+        AlignedVector<Scalar> columns_;
+    };
+
+    enum class PoolMode
+    {
+        max,
+        average,
+    };
+
+    struct Pool2DOptions
+    {
+        PoolMode mode{PoolMode::max};
+        std::size_t kernel_size{2};
+        std::size_t stride{2};
+    };
+
+    // Max or average pooling over every channel of NCHW tensors. Windows never leave the input;
+    // trailing rows and columns that do not fill one are dropped. Max pooling remembers where
+    // each maximum came from for the backward pass, so one layer runs one pass at a time.
+    template <std::floating_point Scalar>
+    class BasicPool2D
+    {
+    public:
+        explicit BasicPool2D(const Pool2DOptions& options);
+
+        [[nodiscard]] auto get_options() const -> const Pool2DOptions&
+        {
+            return options_;
+        }
+
+        [[nodiscard]] auto output_shape(const Shape& shape) const -> Shape;
+
+        auto forward(BasicTensorView<const Scalar> inputs, BasicTensorView<Scalar> outputs)
+            -> void;
+
+        // Routes every output gradient to the maximum of its window, or spreads it evenly over
+        // the window for average pooling. Needs the forward pass over the same batch first.
+        auto backward(BasicTensorView<const Scalar> output_gradients,
+                      BasicTensorView<Scalar> input_gradients) -> void;
+
+    private:
+        Pool2DOptions options_;
+        Shape input_shape_;
+        std::vector<std::uint32_t> argmax_; // offset of each maximum within its input plane
+    };
+
+    extern template class BasicConv2D<float>;
+    extern template class BasicConv2D<double>;
+    extern template class BasicConvTranspose2D<float>;
+    extern template class BasicConvTranspose2D<double>;
+    extern template class BasicPool2D<float>;
+    extern template class BasicPool2D<double>;
+
+    using Conv2D = BasicConv2D<double>;
+    using ConvTranspose2D = BasicConvTranspose2D<double>;
+    using Pool2D = BasicPool2D<double>;
+
+} // namespace axon
@@ -1,8 +1,17 @@
 #pragma once
 
+#include <concepts>
+#include <functional>
+
 namespace axon::criterion
 {
 
+    enum class Kind
+    {
+        custom,
+        mse,
+    };
+
     [[nodiscard]] inline auto mse(double target, double output) -> double
     {
         const double error = target - output;
@@ -14,4 +23,75 @@ namespace axon::criterion
         return 2 * (output - target);
     }
 
+    // Policy types wrapping the functions above, see `activation::Policy`.
+    template <typename T>
+    concept Policy = requires(double target, double output, float narrow_target,
+                              float narrow_output) {
+        { T::kind } -> std::convertible_to<Kind>;
+        { T::function(target, output) } -> std::same_as<double>;
+        { T::derivative(target, output) } -> std::same_as<double>;
+        { T::function(narrow_target, narrow_output) } -> std::same_as<float>;
+        { T::derivative(narrow_target, narrow_output) } -> std::same_as<float>;
+    };
+
+    struct MSE
+    {
+        static constexpr Kind kind{Kind::mse};
+
+        template <std::floating_point Scalar>
+        [[nodiscard]] static auto function(Scalar target, Scalar output) -> Scalar
+        {
+            const Scalar error = target - output;
+            return error * error;
+        }
+
+        template <std::floating_point Scalar>
+        [[nodiscard]] static auto derivative(Scalar target, Scalar output) -> Scalar
+        {
+            return Scalar{2} * (output - target);
+        }
+    };
+
 } // namespace axon::criterion
+
+namespace axon
+{
+
+    // Runtime description of a loss, mirroring `Activation`.
+    struct Criterion
+    {
+        using Function = std::function<double(double, double)>;
+
+        Function function;
+        Function derivative;
+        criterion::Kind kind{criterion::Kind::custom};
+
+        template <criterion::Policy P>
+        [[nodiscard]] static auto of() -> Criterion
+        {
+            return {.function = &P::template function<double>,
+                    .derivative = &P::template derivative<double>,
+                    .kind = P::kind};
+        }
+
+        [[nodiscard]] auto resolve_kind() const -> criterion::Kind
+        {
+            if (kind != criterion::Kind::custom)
+            {
+                return kind;
+            }
+
+            const auto* const function_ptr = function.target<double (*)(double, double)>();
+            const auto* const derivative_ptr = derivative.target<double (*)(double, double)>();
+            if (function_ptr != nullptr && derivative_ptr != nullptr
+                && *function_ptr == &criterion::mse
+                && *derivative_ptr == &criterion::mse_derivative)
+            {
+                return criterion::Kind::mse;
+            }
+
+            return criterion::Kind::custom;
+        }
+    };
+
+} // namespace axon
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "aligned_allocator.hpp"
+#include "mapped_file.hpp"
+#include "tensor.hpp"
+
+#include <array>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace axon
+{
+
+    // Binary dataset format, version 1:
+    //
+    //   Header                       64 bytes
+    //   per sample:
+    //     inputs                     num_inputs scalars
+    //     targets                    num_targets scalars
+    //
+    // Samples are packed back to back, so sample `i` starts at a fixed offset and a file can be
+    // read either at random through a mapping or sequentially. Fields are in host byte order.
+    namespace dataset
+    {
+
+        inline constexpr std::array<char, 8> magic{'A', 'X', 'O', 'N', 'D', 'A', 'T', '\0'};
+        inline constexpr std::uint32_t version{1};
+
+        struct Header
+        {
+            std::array<char, 8> magic{};
+            std::uint32_t version{0};
+            std::uint32_t scalar_bytes{0};
+            std::uint64_t num_inputs{0};
+            std::uint64_t num_targets{0};
+            std::uint64_t num_samples{0};
+            std::array<std::byte, 24> reserved{};
+        };
+
+        static_assert(sizeof(Header) == cache_line_size);
+
+        // How a `BasicDataLoader` reads its file. `mapped` shuffles the whole dataset by index
+        // and gathers samples from a mapping; `streaming` reads the file front to back and only
+        // shuffles within a bounded window of samples, for storage where random reads are slow.
+        enum class ReadMode
+        {
+            mapped,
+            streaming,
+        };
+
+    } // namespace dataset
+
+    // Appends samples to a dataset file without holding the dataset in memory. The sample count
+    // in the header is written by `close`, which the destructor calls if needed.
+    template <std::floating_point Scalar>
+    class BasicDatasetWriter
+    {
+    public:
+        BasicDatasetWriter(const std::filesystem::path& path, std::size_t num_inputs,
+                           std::size_t num_targets);
+
+        BasicDatasetWriter(const BasicDatasetWriter&) = delete;
+        auto operator=(const BasicDatasetWriter&) -> BasicDatasetWriter& = delete;
+
+        ~BasicDatasetWriter();
+
+        // Appends `n` samples from row-major `n x num_inputs` inputs and the matching
+        // `n x num_targets` targets.
+        auto append(std::span<const Scalar> inputs, std::span<const Scalar> targets) -> void;
+        auto close() -> void;
+
+        [[nodiscard]] auto get_num_samples() const -> std::size_t
+        {
+            return num_samples_;
+        }
+
+    private:
+        std::ofstream file_;
+        std::size_t num_inputs_{0};
+        std::size_t num_targets_{0};
+        std::size_t num_samples_{0};
+    };
+
+    struct DataLoaderOptions
+    {
+        std::size_t batch_size{32};
+        bool shuffle{true};
+        bool drop_last{false}; // skip the final, smaller batch of an epoch
+        std::uint64_t seed{0};
+        dataset::ReadMode mode{dataset::ReadMode::mapped};
+        std::size_t shuffle_buffer{65'536}; // samples; streaming mode only
+        std::size_t prefetch{2};            // batches assembled ahead of the consumer
+    };
+
+    // One mini-batch as contiguous, cache-line aligned row-major matrices, ready to be passed
+    // to `feed_forward_batch` and `back_propagate`.
+    template <std::floating_point Scalar>
+    struct BasicBatch
+    {
+        std::span<const Scalar> inputs;
+        std::span<const Scalar> targets;
+        std::size_t size{0};
+
+        // The same buffers as `size x num_inputs` and `size x num_targets` tensors, e.g. to
+        // reshape the inputs into images without copying them.
+        [[nodiscard]] auto input_view() const -> BasicTensorView<const Scalar>
+        {
+            return {inputs, Shape{size, size == 0 ? 0 : inputs.size() / size}};
+        }
+
+        [[nodiscard]] auto target_view() const -> BasicTensorView<const Scalar>
+        {
+            return {targets, Shape{size, size == 0 ? 0 : targets.size() / size}};
+        }
+    };
+
+    // Feeds mini-batches from a dataset file. A background thread assembles the next batches
+    // into a ring of `prefetch` preallocated buffers while the current one trains, so the
+    // training thread only waits when the storage cannot keep up. The order of an epoch only
+    // depends on the seed and the epoch number, so a resumed run sees the same batches.
+    //
+    //     loader.start_epoch(epoch);
+    //     while (const auto batch = loader.next())
+    //     {
+    //         net.feed_forward_batch(batch->inputs, batch->size);
+    //         ...
+    //     }
+    template <std::floating_point Scalar>
+    class BasicDataLoader
+    {
+    public:
+        BasicDataLoader(const std::filesystem::path& path, const DataLoaderOptions& options);
+
+        BasicDataLoader(const BasicDataLoader&) = delete;
+        BasicDataLoader(BasicDataLoader&&) = delete;
+        auto operator=(const BasicDataLoader&) -> BasicDataLoader& = delete;
+        auto operator=(BasicDataLoader&&) -> BasicDataLoader& = delete;
+
+        ~BasicDataLoader();
+
+        // Abandons the current epoch, if any, and starts assembling the batches of `epoch`.
+        auto start_epoch(std::uint64_t epoch) -> void;
+
+        // Returns the next batch of the epoch, or nothing once it is exhausted. The batch stays
+        // valid until the next call to `next` or `start_epoch`. Rethrows read errors.
+        [[nodiscard]] auto next() -> std::optional<BasicBatch<Scalar>>;
+
+        [[nodiscard]] auto get_num_samples() const -> std::size_t
+        {
+            return num_samples_;
+        }
+
+        [[nodiscard]] auto get_num_inputs() const -> std::size_t
+        {
+            return num_inputs_;
+        }
+
+        [[nodiscard]] auto get_num_targets() const -> std::size_t
+        {
+            return num_targets_;
+        }
+
+        [[nodiscard]] auto get_num_batches() const -> std::size_t;
+
+    private:
+        struct Slot
+        {
+            AlignedVector<Scalar> inputs;
+            AlignedVector<Scalar> targets;
+            std::size_t size{0};
+        };
+
+        // Only touched by the prefetch thread.
+        auto reset_source(std::uint64_t epoch) -> void;
+        auto fill(Slot& slot) -> std::size_t;
+        auto read_sample(std::byte* destination) -> void;
+        auto copy_sample(const std::byte* sample, Slot& slot, std::size_t row) const -> void;
+        auto prefetch_loop() -> void;
+
+        DataLoaderOptions options_;
+        std::size_t num_inputs_{0};
+        std::size_t num_targets_{0};
+        std::size_t num_samples_{0};
+        std::size_t sample_bytes_{0};
+
+        // Source state, owned by the prefetch thread.
+        MappedFile file_;                // mapped mode
+        std::vector<std::size_t> order_; // mapped mode
+        std::size_t cursor_{0};
+        std::ifstream stream_;            // streaming mode
+        std::vector<char> stream_buffer_; // streaming mode
+        std::vector<std::byte> window_;   // streaming mode: shuffle buffer
+        std::size_t num_buffered_{0};
+        std::size_t num_unread_{0};
+        std::mt19937_64 rng_;
+
+        // Ring of prefetched batches, shared with the consumer.
+        std::vector<Slot> slots_;
+        std::mutex mutex_;
+        std::condition_variable changed_;
+        std::size_t head_{0};      // oldest slot not yet released by the consumer
+        std::size_t num_ready_{0}; // filled slots from `head_`, including the one in use
+        bool in_use_{false};       // the consumer holds the slot at `head_`
+        bool exhausted_{true};
+        std::uint64_t generation_{0};
+        std::uint64_t epoch_{0};
+        std::exception_ptr error_;
+        bool stopping_{false};
+        std::thread prefetcher_; // started once everything it reads is initialised
+    };
+
+    extern template class BasicDatasetWriter<float>;
+    extern template class BasicDatasetWriter<double>;
+    extern template class BasicDataLoader<float>;
+    extern template class BasicDataLoader<double>;
+
+    using DatasetWriter = BasicDatasetWriter<double>;
+    using DataLoader = BasicDataLoader<double>;
+    using Batch = BasicBatch<double>;
+
+} // namespace axon
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "arena.hpp"
+#include "network.hpp"
+#include "tensor.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace axon
+{
+
+    // Forward passes against a network that is only ever read. A session owns nothing but two
+    // activation buffers of `batch_size x widest layer`, so a server can keep one copy of the
+    // weights and give each of its threads a session; any number of sessions may run
+    // concurrently on the same network as long as nobody trains it meanwhile.
+    //
+    // Unlike a `Workspace`, a session keeps no per-layer outputs and no parameter gradients,
+    // which would cost as much memory as the weights themselves.
+    // NOTE(abi): the session refers to the network, which must outlive it.
+    template <std::floating_point Scalar>
+    class BasicInferenceSession
+    {
+    public:
+        explicit BasicInferenceSession(const BasicNetwork<Scalar>& network,
+                                       std::size_t max_batch_size = 1);
+
+        BasicInferenceSession(const BasicInferenceSession&) = delete;
+        BasicInferenceSession(BasicInferenceSession&&) noexcept = default;
+        auto operator=(const BasicInferenceSession&) -> BasicInferenceSession& = delete;
+        auto operator=(BasicInferenceSession&&) noexcept -> BasicInferenceSession& = default;
+        ~BasicInferenceSession() = default;
+
+        [[nodiscard]] auto get_network() const -> const BasicNetwork<Scalar>&
+        {
+            return *network_;
+        }
+
+        // Largest batch the buffers currently hold; larger batches grow them once.
+        [[nodiscard]] auto get_max_batch_size() const -> std::size_t
+        {
+            return max_batch_size_;
+        }
+
+        // Forward pass over a row-major `batch_size x num_inputs` matrix into a caller-owned
+        // `batch_size x num_outputs` matrix. Never allocates for batches up to
+        // `get_max_batch_size`.
+        auto forward(std::span<const Scalar> inputs, std::size_t batch_size,
+                     std::span<Scalar> outputs) -> void;
+
+        [[nodiscard]] auto forward(const std::vector<Scalar>& inputs, std::size_t batch_size)
+            -> std::vector<Scalar>
+        {
+            std::vector<Scalar> outputs(batch_size * network_->get_layers().back().num_outputs);
+            forward(std::span<const Scalar>{inputs}, batch_size, std::span<Scalar>{outputs});
+            return outputs;
+        }
+
+        // Same, over a contiguous `batch x ...` input tensor whose inner dimensions flatten to
+        // `num_inputs`, writing a `batch x num_outputs` tensor.
+        auto forward(BasicTensorView<const Scalar> inputs, BasicTensorView<Scalar> outputs)
+            -> void
+        {
+            forward(inputs.span(), inputs.rank() == 0 ? 0 : inputs.extent(0), outputs.span());
+        }
+
+    private:
+        auto reserve(std::size_t batch_size) -> void;
+
+        const BasicNetwork<Scalar>* network_;
+        std::size_t max_width_{0};
+        std::size_t max_batch_size_{0};
+        Arena arena_;
+        std::array<std::span<Scalar>, 2> activations_; // alternating layer outputs
+    };
+
+    extern template class BasicInferenceSession<float>;
+    extern template class BasicInferenceSession<double>;
+
+    using InferenceSession = BasicInferenceSession<double>;
+
+} // namespace axon
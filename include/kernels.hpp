@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace axon::kernels
+{
+
+    // Instruction sets the kernels are specialised for. The best one supported by the host CPU
+    // is picked on first use; `set_isa` allows forcing a narrower one (e.g. in tests).
+    enum class Isa
+    {
+        scalar,
+        avx2,
+        avx512,
+    };
+
+    enum class Transpose
+    {
+        no,
+        yes,
+    };
+
+    // Elementwise work fused into `gemm`, applied to each block of C right after its last update
+    // while the block is still in cache, instead of in a separate pass over C: every row of C
+    // becomes `apply(row + bias)`, where `bias` has one entry per column of C. Either part may
+    // be null. `apply` runs on row segments of any length and from any worker thread, so it
+    // must be elementwise and thread-safe; `context` is passed through to it.
+    template <typename Scalar>
+    struct Epilogue
+    {
+        const Scalar* bias{nullptr};
+        void (*apply)(std::span<Scalar> values, const void* context){nullptr};
+        const void* context{nullptr};
+    };
+
+    [[nodiscard]] auto detect_isa() -> Isa;
+    [[nodiscard]] auto is_supported(Isa isa) -> bool;
+    [[nodiscard]] auto get_isa() -> Isa;
+    auto set_isa(Isa isa) -> void;
+
+    // Row-major general matrix product: C = alpha * op(A) * op(B) + beta * C, where op(A) is
+    // m x k, op(B) is k x n and C is m x n. Leading dimensions are the row strides of the
+    // matrices as stored, before any transposition.
+    auto gemm(Transpose trans_a, Transpose trans_b, std::size_t m, std::size_t n, std::size_t k,
+              double alpha, const double* a, std::size_t lda, const double* b, std::size_t ldb,
+              double beta, double* c, std::size_t ldc) -> void;
+    auto gemm(Transpose trans_a, Transpose trans_b, std::size_t m, std::size_t n, std::size_t k,
+              float alpha, const float* a, std::size_t lda, const float* b, std::size_t ldb,
+              float beta, float* c, std::size_t ldc) -> void;
+
+    // Same, then C = epilogue(C).
+    auto gemm(Transpose trans_a, Transpose trans_b, std::size_t m, std::size_t n, std::size_t k,
+              double alpha, const double* a, std::size_t lda, const double* b, std::size_t ldb,
+              double beta, double* c, std::size_t ldc, const Epilogue<double>& epilogue) -> void;
+    auto gemm(Transpose trans_a, Transpose trans_b, std::size_t m, std::size_t n, std::size_t k,
+              float alpha, const float* a, std::size_t lda, const float* b, std::size_t ldb,
+              float beta, float* c, std::size_t ldc, const Epilogue<float>& epilogue) -> void;
+
+    // Row-major matrix-vector product: y = alpha * op(A) * x + beta * y, where A is stored as
+    // m x n, so that y has m entries when A is not transposed and n entries when it is.
+    auto gemv(Transpose trans, std::size_t m, std::size_t n, double alpha, const double* a,
+              std::size_t lda, const double* x, double beta, double* y) -> void;
+    auto gemv(Transpose trans, std::size_t m, std::size_t n, float alpha, const float* a,
+              std::size_t lda, const float* x, float beta, float* y) -> void;
+
+    // Integer product for quantized inference: C = A * B^T, where A is m x k unsigned 8-bit,
+    // B is n x k signed 8-bit (one row per output, like a weight matrix) and C is m x n. Sums
+    // are accumulated exactly in 32 bits while 255 * 128 * k fits in an int32_t, i.e. for any
+    // k up to 65793, or up to 66311 with weights clamped to +-127 as `QuantizedLayer` does.
+    // Uses the AVX-512 VNNI byte dot products when the AVX-512 kernels are selected and the
+    // CPU has them.
+    auto gemm_u8s8(std::size_t m, std::size_t n, std::size_t k, const std::uint8_t* a,
+                   std::size_t lda, const std::int8_t* b, std::size_t ldb, std::int32_t* c,
+                   std::size_t ldc) -> void;
+
+} // namespace axon::kernels
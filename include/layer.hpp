@@ -0,0 +1,84 @@
+#pragma once
+
+#include "arena.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+namespace axon
+{
+
+    // Fully-connected layer stored as a single row-major weight matrix, so that the incoming
+    // weights of an output unit are contiguous in memory. Momentum state lives in parallel
+    // buffers instead of being interleaved with the weights.
+    //
+    // Only parameters and optimizer state live here; everything a forward or backward pass
+    // writes goes to a `Workspace`, so several passes can share the same layers. The buffers
+    // themselves belong to the arena of the owning network (see `carve_parameters`).
+    template <std::floating_point Scalar>
+    struct BasicLayer
+    {
+        std::size_t num_inputs{0};
+        std::size_t num_outputs{0};
+
+        std::span<Scalar> weights;         // num_outputs x num_inputs
+        std::span<Scalar> biases;          // num_outputs
+        std::span<Scalar> weight_velocity; // num_outputs x num_inputs
+        std::span<Scalar> bias_velocity;   // num_outputs
+
+        BasicLayer(std::size_t input_count, std::size_t output_count)
+            : num_inputs(input_count),
+              num_outputs(output_count)
+        {
+        }
+
+        [[nodiscard]] auto weight(std::size_t output, std::size_t input) const -> Scalar
+        {
+            return weights[(output * num_inputs) + input];
+        }
+    };
+
+    // Bytes that the weights and biases of one layer take in an arena, each buffer padded to
+    // whole cache lines. Parameters, velocities and parameter gradients are all laid out this way,
+    // one layer after the other, so their flat views line up element by element.
+    template <std::floating_point Scalar>
+    [[nodiscard]] constexpr auto parameter_bytes(std::size_t num_inputs, std::size_t num_outputs)
+        -> std::size_t
+    {
+        return (padded_size<Scalar>(num_inputs * num_outputs) + padded_size<Scalar>(num_outputs))
+               * sizeof(Scalar);
+    }
+
+    // Carves the weight and bias buffers of one layer from `arena` at `offset`, and returns the
+    // offset following them.
+    template <std::floating_point Scalar>
+    auto carve_parameters(Arena& arena, std::size_t offset, std::size_t num_inputs,
+                          std::size_t num_outputs, std::span<Scalar>& weights,
+                          std::span<Scalar>& biases) -> std::size_t
+    {
+        weights = arena.view<Scalar>(offset, num_inputs * num_outputs);
+        biases = arena.view<Scalar>(
+            offset + (padded_size<Scalar>(num_inputs * num_outputs) * sizeof(Scalar)), num_outputs);
+        return offset + parameter_bytes<Scalar>(num_inputs, num_outputs);
+    }
+
+    // Fills `values` with values drawn uniformly from [-1, 1].
+    template <std::floating_point Scalar>
+    auto randomize(std::span<Scalar> values) -> void;
+
+    // Same, for the weights and biases of a layer.
+    template <std::floating_point Scalar>
+    auto randomize(BasicLayer<Scalar>& layer) -> void;
+
+    extern template auto randomize(std::span<float> values) -> void;
+    extern template auto randomize(std::span<double> values) -> void;
+    extern template auto randomize(BasicLayer<float>& layer) -> void;
+    extern template auto randomize(BasicLayer<double>& layer) -> void;
+
+    extern template struct BasicLayer<float>;
+    extern template struct BasicLayer<double>;
+
+    using Layer = BasicLayer<double>;
+
+} // namespace axon
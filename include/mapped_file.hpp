@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace axon
+{
+
+    // Read-only view of a whole file. On POSIX systems the file is memory-mapped, so pages are
+    // only read from disk when first touched and are shared between processes mapping the same
+    // file; elsewhere it falls back to reading the file into memory. The data starts on a page
+    // (or at least cache-line) boundary.
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::filesystem::path& path);
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        ~MappedFile();
+
+        auto operator=(const MappedFile&) -> MappedFile& = delete;
+        auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+
+        [[nodiscard]] auto bytes() const -> std::span<const std::byte>
+        {
+            return {data_, size_};
+        }
+
+        [[nodiscard]] auto size() const -> std::size_t
+        {
+            return size_;
+        }
+
+    private:
+        auto release() noexcept -> void;
+
+        const std::byte* data_{nullptr};
+        std::size_t size_{0};
+    };
+
+    // Writes `bytes` to a temporary file next to `path`, flushes it to disk and renames it over
+    // `path`, so that readers only ever see the previous or the complete new contents.
+    auto write_file_atomically(const std::filesystem::path& path,
+                               std::span<const std::byte> bytes) -> void;
+
+} // namespace axon
@@ -1,43 +1,323 @@
 #pragma once
 
-#include "neuron.hpp"
+#include "activation.hpp"
+#include "arena.hpp"
+#include "criterion.hpp"
+#include "layer.hpp"
+#include "optimizer.hpp"
+#include "sparse.hpp"
+#include "tensor.hpp"
+#include "workspace.hpp"
 
+#include <concepts>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
 #include <vector>
 
 namespace axon
 {
 
-    struct Criterion
+    // Fully-connected network over `Scalar`. Weights, activations and gradients are all stored
+    // in that type, so `float` halves the memory traffic and doubles the SIMD width of every
+    // kernel; `Network` is the double precision instantiation.
+    //
+    // The parameters and velocities of every layer are carved from a single arena allocated
+    // from `resource`, and the workspaces of the network draw from the same resource.
+    template <std::floating_point Scalar>
+    class BasicNetwork
     {
-        using Function = std::function<double(double, double)>;
+    public:
+        using Layer = BasicLayer<Scalar>;
+        using Workspace = BasicWorkspace<Scalar>;
+        using SparseWeights = BasicSparseWeights<Scalar>;
 
-        Function function;
-        Function derivative;
-    };
+        explicit BasicNetwork(
+            const std::vector<std::size_t>& layer_sizes, Activation activation,
+            Criterion criterion,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
-    class Network
-    {
-    public:
-        explicit Network(const std::vector<std::size_t>& layer_sizes, Activation activation,
-                         Criterion criterion);
+        // NOTE(abi): copies duplicate the arena with a single `memcpy`, and assigning a network
+        // of the same topology reuses the existing buffers.
+        BasicNetwork(const BasicNetwork& other);
+        BasicNetwork(BasicNetwork&& other) noexcept = default;
+        auto operator=(const BasicNetwork& other) -> BasicNetwork&;
+        auto operator=(BasicNetwork&& other) noexcept -> BasicNetwork& = default;
+        ~BasicNetwork() = default;
 
-        [[nodiscard]] auto get_output() const -> std::vector<double>;
+        // Outputs of the last forward pass, one row of `num_outputs` values per sample. The span
+        // overload copies them into caller-owned storage of exactly that size.
+        [[nodiscard]] auto get_output() const -> std::vector<Scalar>;
+        auto get_output(std::span<Scalar> output) const -> void;
+
+        // The same outputs in place, as a `batch_size x num_outputs` tensor that stays valid
+        // until the next forward pass.
+        [[nodiscard]] auto get_output_view() const -> BasicTensorView<const Scalar>
+        {
+            const auto& outputs = workspace_.layers.back().outputs;
+            return {std::span<const Scalar>{outputs},
+                    Shape{workspace_.batch_size, layers_.back().num_outputs}};
+        }
 
-        [[nodiscard]] auto get_error() const -> double
+        [[nodiscard]] auto get_error() const -> Scalar
         {
             return error_;
         }
 
-        auto feed_forward(const std::vector<double>& inputs) -> void;
-        auto compute_loss(const std::vector<double>& targets) -> double;
-        auto back_propagate(const std::vector<double>& targets) -> void;
-        auto step(double learning_rate = 0.01, double momentum = 0.0) -> void;
+        [[nodiscard]] auto get_batch_size() const -> std::size_t
+        {
+            return workspace_.batch_size;
+        }
+
+        [[nodiscard]] auto get_layers() const -> const std::vector<Layer>&
+        {
+            return layers_;
+        }
+
+        // Mutable access to the parameters, e.g. to restore them from a file. The layers must
+        // keep their shapes.
+        [[nodiscard]] auto get_layers() -> std::vector<Layer>&
+        {
+            return layers_;
+        }
+
+        // Every weight and bias buffer as one span, layer after layer, e.g. for optimizers that
+        // update all parameters in a single loop or for snapshots. `get_velocities` and the
+        // `parameter_gradients` of a workspace share its layout element by element; the
+        // cache-line padding between buffers is zero and elementwise updates keep it so.
+        [[nodiscard]] auto get_parameters() const -> std::span<const Scalar>
+        {
+            return parameters_;
+        }
+
+        [[nodiscard]] auto get_parameters() -> std::span<Scalar>
+        {
+            return parameters_;
+        }
+
+        [[nodiscard]] auto get_velocities() const -> std::span<const Scalar>
+        {
+            return velocities_;
+        }
+
+        [[nodiscard]] auto get_velocities() -> std::span<Scalar>
+        {
+            return velocities_;
+        }
+
+        [[nodiscard]] auto get_resource() const -> std::pmr::memory_resource*
+        {
+            return arena_.get_resource();
+        }
+
+        [[nodiscard]] auto get_workspace() const -> const Workspace&
+        {
+            return workspace_;
+        }
+
+        [[nodiscard]] auto get_activation() const -> const Activation&
+        {
+            return activation_;
+        }
+
+        [[nodiscard]] auto get_criterion() const -> const Criterion&
+        {
+            return criterion_;
+        }
+
+        [[nodiscard]] auto get_math_mode() const -> activation::MathMode
+        {
+            return math_mode_;
+        }
+
+        // Opts the activations of this network into the fast approximations (see
+        // `activation::MathMode`).
+        auto set_math_mode(activation::MathMode mode) -> void
+        {
+            math_mode_ = mode;
+        }
+
+        // NOTE(abi): the span overloads never allocate once the buffers have been sized by a
+        // first call with the same batch size; the vector overloads only forward to them.
+        auto feed_forward(std::span<const Scalar> inputs) -> void;
+
+        // Forward pass over a row-major `batch_size x num_inputs` matrix. The loss and
+        // backward pass then expect a matching `batch_size x num_outputs` target matrix, and
+        // `step` applies the gradient averaged over the whole batch.
+        auto feed_forward_batch(std::span<const Scalar> inputs, std::size_t batch_size) -> void;
+
+        auto compute_loss(std::span<const Scalar> targets) -> Scalar;
+        auto back_propagate(std::span<const Scalar> targets) -> void;
+
+        auto feed_forward(const std::vector<Scalar>& inputs) -> void
+        {
+            feed_forward(std::span<const Scalar>{inputs});
+        }
+
+        auto feed_forward_batch(const std::vector<Scalar>& inputs, std::size_t batch_size)
+            -> void
+        {
+            feed_forward_batch(std::span<const Scalar>{inputs}, batch_size);
+        }
+
+        auto compute_loss(const std::vector<Scalar>& targets) -> Scalar
+        {
+            return compute_loss(std::span<const Scalar>{targets});
+        }
+
+        auto back_propagate(const std::vector<Scalar>& targets) -> void
+        {
+            back_propagate(std::span<const Scalar>{targets});
+        }
+
+        // Tensor overloads: the outermost dimension is the batch and the others are flattened
+        // into the features of a sample, so e.g. a `batch x 28 x 28` image tensor feeds a
+        // network with 784 inputs as it is. The tensors must be contiguous, which batch slices
+        // of a contiguous tensor are.
+        auto feed_forward_batch(BasicTensorView<const Scalar> inputs) -> void
+        {
+            feed_forward_batch(inputs.span(), inputs.rank() == 0 ? 0 : inputs.extent(0));
+        }
+
+        auto compute_loss(BasicTensorView<const Scalar> targets) -> Scalar
+        {
+            return compute_loss(targets.span());
+        }
+
+        auto back_propagate(BasicTensorView<const Scalar> targets) -> void
+        {
+            back_propagate(targets.span());
+        }
+
+        auto step(Scalar learning_rate = Scalar{0.01}, Scalar momentum = Scalar{0}) -> void;
+
+        // Applies the gradients of the last `back_propagate` with `optimizer`, e.g. an `Adam`,
+        // which updates every parameter in one pass over the flat buffers.
+        template <Optimizer<Scalar> OptimizerType>
+        auto step(OptimizerType& optimizer) -> void
+        {
+            optimizer.step(parameters_, std::span<const Scalar>{workspace_.parameter_gradients});
+            apply_masks();
+        }
+
+        // One momentum SGD iteration on a batch, equivalent to `feed_forward_batch`,
+        // `compute_loss`, `back_propagate` and `step`, and returning the loss measured before
+        // the update. Each layer is updated right after its gradients are computed, a block of
+        // weight rows at a time, so the weights, velocities and gradients are streamed from
+        // memory once instead of twice. Layers are visited from the output down, and each one
+        // hands its gradients to the layer below before its own weights change.
+        auto train_step(std::span<const Scalar> inputs, std::span<const Scalar> targets,
+                        std::size_t batch_size, Scalar learning_rate = Scalar{0.01},
+                        Scalar momentum = Scalar{0}) -> Scalar;
+
+        auto train_step(const std::vector<Scalar>& inputs, const std::vector<Scalar>& targets,
+                        std::size_t batch_size, Scalar learning_rate = Scalar{0.01},
+                        Scalar momentum = Scalar{0}) -> Scalar
+        {
+            return train_step(std::span<const Scalar>{inputs}, std::span<const Scalar>{targets},
+                              batch_size, learning_rate, momentum);
+        }
+
+        auto train_step(BasicTensorView<const Scalar> inputs,
+                        BasicTensorView<const Scalar> targets, Scalar learning_rate = Scalar{0.01},
+                        Scalar momentum = Scalar{0}) -> Scalar
+        {
+            return train_step(inputs.span(), targets.span(),
+                              inputs.rank() == 0 ? 0 : inputs.extent(0), learning_rate, momentum);
+        }
+
+        // Iterative magnitude pruning. Each call zeroes the smallest weights of every layer until
+        // at least `sparsity` of them are gone, never restoring one pruned before; raise the
+        // sparsity between rounds of training (see `sparse::pruning_schedule`). With a
+        // `block_size` above one, aligned runs of that many weights within a row are scored by
+        // their summed magnitude and pruned together.
+        //
+        // Pruned weights stay zero through every update of the network. Once a layer's sparsity
+        // reaches the sparse threshold, its forward pass and the gradients it hands down run on a
+        // sparse copy of its weights, in CSR or block-sparse format depending on how the
+        // surviving weights cluster, for batches of up to `sparse::max_batch_size` samples.
+        // NOTE(abi): the sparse copy is kept alongside the dense weights, which training keeps
+        // updating, so pruning makes the network faster but not smaller, in memory or on disk.
+        auto prune(double sparsity, std::size_t block_size = 1) -> void;
+
+        // Replaces the pruning masks, one per layer laid out as `get_mask`, and applies them;
+        // no masks leaves the network unpruned. Throws `std::invalid_argument` on a size
+        // mismatch.
+        auto set_masks(std::vector<std::vector<std::uint8_t>> masks) -> void;
+
+        // Re-zeroes the pruned weights and refreshes the sparse copies. The updates of the
+        // network call it; call it after writing to the weights directly, e.g. through
+        // `get_parameters` or a checkpoint restore.
+        auto apply_masks() -> void;
+
+        // One byte per weight of a layer, zero where it was pruned; empty before `prune`.
+        [[nodiscard]] auto get_mask(std::size_t layer_idx) const -> std::span<const std::uint8_t>
+        {
+            return masks_.empty() ? std::span<const std::uint8_t>{}
+                                  : std::span<const std::uint8_t>{masks_[layer_idx]};
+        }
+
+        [[nodiscard]] auto get_sparse_weights(std::size_t layer_idx) const -> const SparseWeights&
+        {
+            return sparse_[layer_idx];
+        }
+
+        [[nodiscard]] auto get_sparse_threshold() const -> double
+        {
+            return sparse_threshold_;
+        }
+
+        // Sparsity from which pruned layers switch to sparse kernels; above one keeps every
+        // layer dense.
+        auto set_sparse_threshold(double threshold) -> void;
+
+        // Building blocks of the methods above that run against a caller-owned workspace. They
+        // only read the layers, so any number of them may run concurrently on different
+        // workspaces; `backward` scales the summed parameter gradients by `gradient_scale`
+        // (one over the batch size gives the batch average).
+        [[nodiscard]] auto make_workspace() const -> Workspace;
+        auto forward(std::span<const Scalar> inputs, std::size_t batch_size,
+                     Workspace& workspace) const -> void;
+        [[nodiscard]] auto loss(std::span<const Scalar> targets, const Workspace& workspace) const
+            -> Scalar;
+        auto backward(std::span<const Scalar> targets, Workspace& workspace,
+                      Scalar gradient_scale) const -> void;
+
+        // Applies the parameter gradients held by `gradients` with momentum SGD.
+        auto apply_gradients(const Workspace& gradients, Scalar learning_rate, Scalar momentum)
+            -> void;
 
     private:
-        std::vector<std::vector<Neuron>> layers_;
+        auto output_gradients(std::span<const Scalar> targets, Workspace& workspace) const
+            -> void;
+        auto hidden_gradients(std::size_t layer_idx, Workspace& workspace) const -> void;
+        auto parameter_gradients(std::size_t layer_idx, Workspace& workspace,
+                                 Scalar gradient_scale) const -> void;
+        auto fused_update(std::size_t layer_idx, Workspace& workspace,
+                          Scalar gradient_scale, Scalar learning_rate, Scalar momentum) -> void;
+
+        auto rebase(const BasicNetwork& other) -> void;
+        auto update_sparse_formats() -> void;
+
+        // NOTE(abi): the input layer has no parameters, so `layers_` only holds the weighted
+        // layers and the raw inputs are kept in the workspace.
+        Arena arena_;
+        std::vector<Layer> layers_;
+        std::span<Scalar> parameters_;
+        std::span<Scalar> velocities_;
+        Workspace workspace_;
         Activation activation_;
         Criterion criterion_;
-        double error_{0.0};
+        activation::MathMode math_mode_{activation::MathMode::exact};
+        Scalar error_{0};
+        std::vector<std::vector<std::uint8_t>> masks_; // per layer, empty when never pruned
+        std::vector<SparseWeights> sparse_;            // per layer
+        double sparse_threshold_{sparse::default_threshold};
     };
 
+    extern template class BasicNetwork<float>;
+    extern template class BasicNetwork<double>;
+
+    using Network = BasicNetwork<double>;
+
 } // namespace axon
@@ -1,22 +1,14 @@
 #pragma once
 
+#include "activation.hpp"
 #include "connection.hpp"
 
 #include <vector>
-#include <functional>
 #include <optional>
 
 namespace axon
 {
 
-    struct Activation
-    {
-        using Function = std::function<double(double)>;
-
-        Function function;
-        Function derivative;
-    };
-
     class Neuron
     {
     public:
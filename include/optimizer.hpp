@@ -0,0 +1,271 @@
+#pragma once
+
+#include "aligned_allocator.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+namespace axon
+{
+
+    // Anything that updates a flat parameter buffer in place from gradients laid out the same
+    // way, such as `BasicNetwork::get_parameters` and `BasicWorkspace::parameter_gradients`.
+    // Optimizers keep their own state, sized on the first step.
+    template <typename T, typename Scalar>
+    concept Optimizer = std::floating_point<Scalar>
+                        && requires(T& optimizer, std::span<Scalar> parameters,
+                                    std::span<const Scalar> gradients) {
+                               optimizer.step(parameters, gradients);
+                           };
+
+    // Optimizers whose progress can be saved and restored, e.g. by checkpoints. `get_state`
+    // returns every per-parameter buffer as one span, empty before the first step, and
+    // `set_state` replaces it along with the number of steps taken. A state only restores into
+    // an optimizer of the same type and options; the next step rejects one of the wrong size.
+    template <typename T, typename Scalar>
+    concept StatefulOptimizer =
+        Optimizer<T, Scalar>
+        && requires(T& optimizer, const T& saved, std::span<const Scalar> state,
+                    std::size_t num_steps) {
+               { saved.get_state() } -> std::convertible_to<std::span<const Scalar>>;
+               { saved.get_num_steps() } -> std::convertible_to<std::size_t>;
+               optimizer.set_state(state, num_steps);
+           };
+
+    struct SgdOptions
+    {
+        double learning_rate{0.01};
+        double momentum{0.0};
+    };
+
+    struct AdamOptions
+    {
+        double learning_rate{1e-3};
+        double beta1{0.9};
+        double beta2{0.999};
+        double epsilon{1e-8};
+        double weight_decay{0.0}; // L2 penalty, added to the gradient
+    };
+
+    struct AdamWOptions
+    {
+        double learning_rate{1e-3};
+        double beta1{0.9};
+        double beta2{0.999};
+        double epsilon{1e-8};
+        double weight_decay{1e-2}; // decoupled, shrinks the parameters directly
+    };
+
+    struct RMSpropOptions
+    {
+        double learning_rate{1e-2};
+        double alpha{0.99}; // decay of the running mean of squared gradients
+        double epsilon{1e-8};
+        double weight_decay{0.0}; // L2 penalty, added to the gradient
+    };
+
+    // Fused update kernels. Each one streams its buffers once, reading the parameters,
+    // gradients and state and writing the parameters and state back, with the widest vector
+    // instructions `kernels::get_isa` allows. The optimizers below split the buffers into chunks
+    // that run on the library's scheduler; large models update on every thread, small ones stay
+    // on the caller's.
+    namespace optimizer
+    {
+
+        // Coefficients of one Adam step, with the bias corrections of step `t` folded in:
+        // `step_size = learning_rate / (1 - beta1^t)` and
+        // `correction = 1 / (1 - beta2^t)`. `shrink` is `1 - learning_rate * decoupled decay`.
+        template <std::floating_point Scalar>
+        struct AdamStep
+        {
+            Scalar beta1;
+            Scalar beta2;
+            Scalar epsilon;
+            Scalar step_size;
+            Scalar correction;
+            Scalar l2;
+            Scalar shrink;
+        };
+
+        template <std::floating_point Scalar>
+        struct RMSpropStep
+        {
+            Scalar learning_rate;
+            Scalar alpha;
+            Scalar epsilon;
+            Scalar l2;
+        };
+
+        // m = beta1 m + (1 - beta1) g, v = beta2 v + (1 - beta2) g^2 with g += l2 p, then
+        // p = shrink p - step_size m / (sqrt(correction v) + epsilon).
+        template <std::floating_point Scalar>
+        auto adam_update(std::span<Scalar> parameters, std::span<const Scalar> gradients,
+                         std::span<Scalar> first_moments, std::span<Scalar> second_moments,
+                         const AdamStep<Scalar>& step) -> void;
+
+        // v = alpha v + (1 - alpha) g^2 with g += l2 p, then p -= lr g / (sqrt(v) + epsilon).
+        template <std::floating_point Scalar>
+        auto rmsprop_update(std::span<Scalar> parameters, std::span<const Scalar> gradients,
+                            std::span<Scalar> mean_squares, const RMSpropStep<Scalar>& step)
+            -> void;
+
+        // v = lr g + momentum v, then p -= v; the update of `BasicNetwork::step`.
+        template <std::floating_point Scalar>
+        auto sgd_update(std::span<Scalar> parameters, std::span<const Scalar> gradients,
+                        std::span<Scalar> velocities, Scalar learning_rate, Scalar momentum)
+            -> void;
+
+    } // namespace optimizer
+
+    // Momentum SGD over flat buffers, equivalent to `BasicNetwork::step`.
+    template <std::floating_point Scalar>
+    class BasicSgd
+    {
+    public:
+        explicit BasicSgd(const SgdOptions& options = {})
+            : options_(options)
+        {
+        }
+
+        auto step(std::span<Scalar> parameters, std::span<const Scalar> gradients) -> void;
+
+        [[nodiscard]] auto get_options() const -> const SgdOptions&
+        {
+            return options_;
+        }
+
+        auto set_learning_rate(double learning_rate) -> void
+        {
+            options_.learning_rate = learning_rate;
+        }
+
+        // The velocities.
+        [[nodiscard]] auto get_state() const -> std::span<const Scalar>
+        {
+            return velocities_;
+        }
+
+        [[nodiscard]] auto get_num_steps() const -> std::size_t
+        {
+            return num_steps_;
+        }
+
+        auto set_state(std::span<const Scalar> state, std::size_t num_steps) -> void
+        {
+            velocities_.assign(state.begin(), state.end());
+            num_steps_ = num_steps;
+        }
+
+    private:
+        SgdOptions options_;
+        std::size_t num_steps_{0};
+        AlignedVector<Scalar> velocities_;
+    };
+
+    // Adam, or AdamW when built from `AdamWOptions`. Both run the same fused kernel; they only
+    // differ in how the weight decay enters it.
+    template <std::floating_point Scalar>
+    class BasicAdam
+    {
+    public:
+        explicit BasicAdam(const AdamOptions& options = {});
+        explicit BasicAdam(const AdamWOptions& options);
+
+        auto step(std::span<Scalar> parameters, std::span<const Scalar> gradients) -> void;
+
+        [[nodiscard]] auto get_num_steps() const -> std::size_t
+        {
+            return num_steps_;
+        }
+
+        [[nodiscard]] auto get_learning_rate() const -> double
+        {
+            return learning_rate_;
+        }
+
+        auto set_learning_rate(double learning_rate) -> void
+        {
+            learning_rate_ = learning_rate;
+        }
+
+        // The first moments of every parameter, then the second ones. The step count sets the
+        // bias correction of the next step.
+        [[nodiscard]] auto get_state() const -> std::span<const Scalar>
+        {
+            return moments_;
+        }
+
+        auto set_state(std::span<const Scalar> state, std::size_t num_steps) -> void
+        {
+            moments_.assign(state.begin(), state.end());
+            num_steps_ = num_steps;
+        }
+
+    private:
+        double learning_rate_;
+        double beta1_;
+        double beta2_;
+        double epsilon_;
+        double l2_{0.0};
+        double decoupled_decay_{0.0};
+        std::size_t num_steps_{0};
+        AlignedVector<Scalar> moments_; // first moments, then second moments
+    };
+
+    template <std::floating_point Scalar>
+    class BasicRMSprop
+    {
+    public:
+        explicit BasicRMSprop(const RMSpropOptions& options = {})
+            : options_(options)
+        {
+        }
+
+        auto step(std::span<Scalar> parameters, std::span<const Scalar> gradients) -> void;
+
+        [[nodiscard]] auto get_options() const -> const RMSpropOptions&
+        {
+            return options_;
+        }
+
+        auto set_learning_rate(double learning_rate) -> void
+        {
+            options_.learning_rate = learning_rate;
+        }
+
+        // The running means of the squared gradients.
+        [[nodiscard]] auto get_state() const -> std::span<const Scalar>
+        {
+            return mean_squares_;
+        }
+
+        [[nodiscard]] auto get_num_steps() const -> std::size_t
+        {
+            return num_steps_;
+        }
+
+        auto set_state(std::span<const Scalar> state, std::size_t num_steps) -> void
+        {
+            mean_squares_.assign(state.begin(), state.end());
+            num_steps_ = num_steps;
+        }
+
+    private:
+        RMSpropOptions options_;
+        std::size_t num_steps_{0};
+        AlignedVector<Scalar> mean_squares_;
+    };
+
+    extern template class BasicSgd<float>;
+    extern template class BasicSgd<double>;
+    extern template class BasicAdam<float>;
+    extern template class BasicAdam<double>;
+    extern template class BasicRMSprop<float>;
+    extern template class BasicRMSprop<double>;
+
+    using Sgd = BasicSgd<double>;
+    using Adam = BasicAdam<double>;
+    using RMSprop = BasicRMSprop<double>;
+
+} // namespace axon
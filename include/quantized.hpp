@@ -0,0 +1,142 @@
+#pragma once
+
+#include "activation.hpp"
+#include "aligned_allocator.hpp"
+#include "network.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace axon
+{
+
+    namespace quantization
+    {
+
+        // Whether weights share one scale per layer or get one per output unit. Per-channel
+        // scales follow the range of every row of the weight matrix and lose less precision
+        // when the rows differ in magnitude.
+        enum class Granularity
+        {
+            per_layer,
+            per_channel,
+        };
+
+        // Affine mapping between real values and 8-bit codes: real = scale * (code - zero_point).
+        struct Parameters
+        {
+            float scale{1.0F};
+            std::int32_t zero_point{0};
+        };
+
+        // Differences between a quantized model and the network it was converted from, measured
+        // over the same batch.
+        struct Report
+        {
+            double max_abs_error{0.0};
+            double mean_abs_error{0.0};
+            double reference_loss{0.0};
+            double quantized_loss{0.0};
+            // Fraction of samples whose largest output is the same unit in both models. Only
+            // meaningful for networks with more than one output.
+            double argmax_agreement{0.0};
+        };
+
+    } // namespace quantization
+
+    // Fully-connected layer in inference-only form. Weights are symmetric signed 8-bit codes
+    // (zero point 0) with a float scale per output; the layer inputs are unsigned 8-bit codes
+    // calibrated on sample data, and the 32-bit sums are mapped back to float before the bias
+    // and activation are applied.
+    struct QuantizedLayer
+    {
+        std::size_t num_inputs{0};
+        std::size_t num_outputs{0};
+        std::size_t stride{0}; // row length of `weights`, num_inputs padded to a cache line
+
+        AlignedVector<std::int8_t> weights;      // num_outputs x stride, zero padded
+        AlignedVector<float> weight_scales;      // num_outputs
+        AlignedVector<std::int32_t> weight_sums; // num_outputs, row sums of the codes
+        AlignedVector<float> biases;             // num_outputs
+        quantization::Parameters input;
+    };
+
+    // Post-training int8 conversion of a trained network. The input range of every layer is
+    // calibrated by running the original network over a sample batch, so the samples should be
+    // representative of the data seen in deployment; inputs outside the calibrated range are
+    // clamped. Layers with more than 66311 inputs are rejected, as their 32-bit sums could
+    // overflow.
+    class QuantizedNetwork
+    {
+    public:
+        template <std::floating_point Scalar>
+        QuantizedNetwork(const BasicNetwork<Scalar>& network,
+                         std::span<const Scalar> calibration_inputs, std::size_t num_samples,
+                         quantization::Granularity granularity =
+                             quantization::Granularity::per_channel);
+
+        [[nodiscard]] auto get_layers() const -> const std::vector<QuantizedLayer>&
+        {
+            return layers_;
+        }
+
+        [[nodiscard]] auto get_num_inputs() const -> std::size_t
+        {
+            return layers_.front().num_inputs;
+        }
+
+        [[nodiscard]] auto get_num_outputs() const -> std::size_t
+        {
+            return layers_.back().num_outputs;
+        }
+
+        // Bytes taken by the weights and the per-output parameters.
+        [[nodiscard]] auto get_parameter_bytes() const -> std::size_t;
+
+        // Forward pass over a row-major `batch_size x num_inputs` matrix into a caller-owned
+        // `batch_size x num_outputs` matrix. Scratch buffers are kept between calls, so
+        // steady-state passes with the same batch size do not allocate.
+        auto forward(std::span<const float> inputs, std::size_t batch_size,
+                     std::span<float> outputs) -> void;
+
+    private:
+        std::vector<QuantizedLayer> layers_;
+        Activation activation_;
+        activation::MathMode math_mode_{activation::MathMode::exact};
+
+        AlignedVector<std::uint8_t> codes_;               // batch_size x stride
+        AlignedVector<std::int32_t> accumulators_;        // batch_size x num_outputs
+        std::array<AlignedVector<float>, 2> activations_; // alternating layer outputs
+    };
+
+    extern template QuantizedNetwork::QuantizedNetwork(const BasicNetwork<float>&,
+                                                       std::span<const float>, std::size_t,
+                                                       quantization::Granularity);
+    extern template QuantizedNetwork::QuantizedNetwork(const BasicNetwork<double>&,
+                                                       std::span<const double>, std::size_t,
+                                                       quantization::Granularity);
+
+    namespace quantization
+    {
+
+        // Runs both models over the same `num_samples x num_inputs` batch and compares their
+        // outputs, and their losses against `targets` under the network's criterion.
+        template <std::floating_point Scalar>
+        auto evaluate(const BasicNetwork<Scalar>& network, QuantizedNetwork& quantized,
+                      std::span<const Scalar> inputs, std::span<const Scalar> targets,
+                      std::size_t num_samples) -> Report;
+
+        extern template auto evaluate(const BasicNetwork<float>&, QuantizedNetwork&,
+                                      std::span<const float>, std::span<const float>,
+                                      std::size_t) -> Report;
+        extern template auto evaluate(const BasicNetwork<double>&, QuantizedNetwork&,
+                                      std::span<const double>, std::span<const double>,
+                                      std::size_t) -> Report;
+
+    } // namespace quantization
+
+} // namespace axon
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace axon
+{
+
+    // Rough number of multiply-adds below which handing work to another thread costs more than
+    // it saves.
+    constexpr std::size_t min_task_cost{std::size_t{1} << 16};
+
+    // Smallest number of loop iterations worth running as one task, given the rough cost of a
+    // single iteration in multiply-adds. Loops no longer than this stay on the calling thread,
+    // which keeps small layers (e.g. the XOR network) serial.
+    [[nodiscard]] constexpr auto grain_size(std::size_t iteration_cost) -> std::size_t
+    {
+        iteration_cost = std::max<std::size_t>(iteration_cost, 1);
+        return (min_task_cost + iteration_cost - 1) / iteration_cost;
+    }
+
+    // Work-stealing scheduler behind every parallel loop in the library. Each thread owns a
+    // deque of pending ranges: a loop splits its range in halves, keeps working on one and
+    // pushes the other to the back of its deque, while idle threads steal the largest pending
+    // ranges from the front of the other deques. The calling thread takes part in its own
+    // loops, and threads waiting on a loop keep stealing, so loops may nest freely (e.g. a GEMM
+    // inside a data-parallel training shard). Up to `get_num_threads()` threads from outside
+    // may run loops at once, each on a deque of its own; any further callers run their loops
+    // serially.
+    class Scheduler
+    {
+    public:
+        explicit Scheduler(std::size_t num_threads = default_num_threads());
+        ~Scheduler();
+
+        Scheduler(const Scheduler&) = delete;
+        Scheduler(Scheduler&&) = delete;
+        auto operator=(const Scheduler&) -> Scheduler& = delete;
+        auto operator=(Scheduler&&) -> Scheduler& = delete;
+
+        // Scheduler shared by the library, started on first use.
+        [[nodiscard]] static auto instance() -> Scheduler&;
+
+        // Hardware concurrency, unless overridden by the `AXON_NUM_THREADS` environment
+        // variable.
+        [[nodiscard]] static auto default_num_threads() -> std::size_t;
+
+        [[nodiscard]] auto get_num_threads() const -> std::size_t
+        {
+            return workers_.size() + 1;
+        }
+
+        // Calls `body(begin, end)` on disjoint subranges covering [0, count), none shorter than
+        // `grain` except the last, and returns once all calls have finished. The first exception
+        // thrown by `body` is rethrown here and the ranges not yet started are skipped.
+        // NOTE(abi): the body is passed by reference through a plain function pointer and the
+        // loop state lives on the caller's stack, so a loop never allocates.
+        template <typename Body>
+        auto parallel_for(std::size_t count, std::size_t grain, Body&& body) -> void
+        {
+            using BodyType = std::remove_reference_t<Body>;
+            run(
+                count, grain,
+                [](void* context, std::size_t begin, std::size_t end)
+                { (*static_cast<BodyType*>(context))(begin, end); },
+                const_cast<void*>(static_cast<const void*>(std::addressof(body))));
+        }
+
+    private:
+        using Task = void (*)(void*, std::size_t, std::size_t);
+
+        struct Loop
+        {
+            Task task;
+            void* context;
+            std::size_t grain;
+            std::atomic<std::size_t> remaining;
+            std::atomic<bool> failed{false};
+            std::exception_ptr error;
+        };
+
+        struct Range
+        {
+            Loop* loop;
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        // Bounded deque of pending ranges. A full deque simply stops the splitting, so the
+        // capacity only needs to cover a few levels of nesting.
+        struct alignas(64) WorkQueue
+        {
+            static constexpr std::size_t capacity{256};
+
+            std::mutex mutex;
+            std::array<Range, capacity> ranges{};
+            std::size_t head{0};
+            std::size_t tail{0};
+
+            // Whether a thread from outside is using this deque; unused by workers.
+            std::atomic<bool> claimed{false};
+        };
+
+        auto run(std::size_t count, std::size_t grain, Task task, void* context) -> void;
+        auto run_loop(std::size_t count, std::size_t grain, Task task, void* context,
+                      std::size_t slot) -> void;
+        auto claim_slot() -> std::optional<std::size_t>;
+        auto execute(Range range, std::size_t slot) -> void;
+        auto push(std::size_t slot, const Range& range) -> bool;
+        auto pop(std::size_t slot) -> std::optional<Range>;
+        auto steal(std::size_t slot) -> std::optional<Range>;
+        auto find_work(std::size_t slot) -> std::optional<Range>;
+        auto worker_loop(std::size_t slot) -> void;
+
+        // Each worker owns one of the first slots; the rest are lent to threads from outside
+        // for the duration of their outermost loop.
+        std::size_t num_queues_;
+        std::unique_ptr<WorkQueue[]> queues_;
+        std::vector<std::thread> workers_;
+
+        // Idle workers and threads parked waiting on a loop both sleep on `work_available_`.
+        std::atomic<std::size_t> queued_{0};
+        std::atomic<std::size_t> sleeping_{0};
+        std::atomic<std::size_t> waiting_{0};
+        std::mutex sleep_mutex_;
+        std::condition_variable work_available_;
+        bool stopping_{false};
+    };
+
+} // namespace axon
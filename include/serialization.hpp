@@ -0,0 +1,162 @@
+#pragma once
+
+#include "activation.hpp"
+#include "aligned_allocator.hpp"
+#include "criterion.hpp"
+#include "mapped_file.hpp"
+#include "network.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace axon
+{
+
+    // Binary model format, version 1. Every block starts on a 64-byte boundary, so a mapped
+    // file can be used in place by the vectorized kernels:
+    //
+    //   Header                       64 bytes
+    //   layer sizes                  num_layer_sizes x uint64, padded
+    //   per weighted layer:
+    //     weights                    num_outputs x num_inputs scalars, row-major, padded
+    //     biases                     num_outputs scalars, padded
+    //
+    // Padding is zero. The checksum covers everything after the header. Fields are written in
+    // host byte order, so files only move between machines of the same endianness (a swapped
+    // file fails the version check).
+    namespace serialization
+    {
+
+        inline constexpr std::array<char, 8> magic{'A', 'X', 'O', 'N', 'N', 'E', 'T', '\0'};
+        inline constexpr std::uint32_t version{1};
+        inline constexpr std::size_t block_alignment{cache_line_size};
+
+        struct Header
+        {
+            std::array<char, 8> magic{};
+            std::uint32_t version{0};
+            std::uint32_t scalar_bytes{0};
+            std::uint32_t activation{0}; // activation::Kind
+            std::uint32_t criterion{0};  // criterion::Kind
+            std::uint64_t num_layer_sizes{0};
+            std::uint64_t payload_bytes{0};
+            std::uint64_t checksum{0};
+            std::uint32_t flags{0}; // checkpoints only, see `checkpoint.hpp`
+            std::array<std::byte, 12> reserved{};
+        };
+
+        static_assert(sizeof(Header) == block_alignment);
+
+        // How much of a file is checked when it is opened. `checksum` reads every page of the
+        // file once; `header` only validates the header and the layout, so that opening stays
+        // proportional to what inference later touches.
+        enum class Verification
+        {
+            header,
+            checksum,
+        };
+
+        // 64-bit hash used as the checksum of the format. Not cryptographic: it only guards
+        // against truncated or corrupted files.
+        [[nodiscard]] auto checksum(std::span<const std::byte> bytes) -> std::uint64_t;
+
+        // Writes the topology, the built-in activation and criterion, and the parameters of
+        // `network`. Momentum state is not saved. Throws `std::invalid_argument` for networks
+        // using custom callables, which have no identifier in the format.
+        template <std::floating_point Scalar>
+        auto save(const BasicNetwork<Scalar>& network, const std::filesystem::path& path)
+            -> void;
+
+        // Reads a file written by `save` into a new trainable network, copying the parameters.
+        template <std::floating_point Scalar>
+        [[nodiscard]] auto load(const std::filesystem::path& path,
+                                Verification verification = Verification::checksum)
+            -> BasicNetwork<Scalar>;
+
+        extern template auto save(const BasicNetwork<float>&, const std::filesystem::path&)
+            -> void;
+        extern template auto save(const BasicNetwork<double>&, const std::filesystem::path&)
+            -> void;
+        extern template auto load<float>(const std::filesystem::path&, Verification)
+            -> BasicNetwork<float>;
+        extern template auto load<double>(const std::filesystem::path&, Verification)
+            -> BasicNetwork<double>;
+
+    } // namespace serialization
+
+    // Inference-only network running directly on the parameter blocks of a mapped model file,
+    // without copying them. Opening a file only maps it; the weights of a layer are read from
+    // disk the first time a forward pass uses them.
+    template <std::floating_point Scalar>
+    class BasicMappedNetwork
+    {
+    public:
+        explicit BasicMappedNetwork(
+            const std::filesystem::path& path,
+            serialization::Verification verification = serialization::Verification::checksum);
+
+        [[nodiscard]] auto get_layer_sizes() const -> const std::vector<std::size_t>&
+        {
+            return layer_sizes_;
+        }
+
+        [[nodiscard]] auto get_activation() const -> const Activation&
+        {
+            return activation_;
+        }
+
+        [[nodiscard]] auto get_criterion() const -> const Criterion&
+        {
+            return criterion_;
+        }
+
+        // Row-major `num_outputs x num_inputs` weights and the biases of a weighted layer,
+        // pointing into the mapping.
+        [[nodiscard]] auto get_weights(std::size_t layer_idx) const -> std::span<const Scalar>
+        {
+            return weights_[layer_idx];
+        }
+
+        [[nodiscard]] auto get_biases(std::size_t layer_idx) const -> std::span<const Scalar>
+        {
+            return biases_[layer_idx];
+        }
+
+        [[nodiscard]] auto get_math_mode() const -> activation::MathMode
+        {
+            return math_mode_;
+        }
+
+        auto set_math_mode(activation::MathMode mode) -> void
+        {
+            math_mode_ = mode;
+        }
+
+        // Forward pass over a row-major `batch_size x num_inputs` matrix into a caller-owned
+        // `batch_size x num_outputs` matrix. Scratch buffers are kept between calls, so
+        // steady-state passes with the same batch size do not allocate.
+        auto forward(std::span<const Scalar> inputs, std::size_t batch_size,
+                     std::span<Scalar> outputs) -> void;
+
+    private:
+        MappedFile file_;
+        std::vector<std::size_t> layer_sizes_;
+        std::vector<std::span<const Scalar>> weights_;
+        std::vector<std::span<const Scalar>> biases_;
+        Activation activation_;
+        Criterion criterion_;
+        activation::MathMode math_mode_{activation::MathMode::exact};
+        std::array<AlignedVector<Scalar>, 2> activations_; // alternating layer outputs
+    };
+
+    extern template class BasicMappedNetwork<float>;
+    extern template class BasicMappedNetwork<double>;
+
+    using MappedNetwork = BasicMappedNetwork<double>;
+
+} // namespace axon
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "aligned_allocator.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace axon
+{
+
+    // How the weights of a layer are multiplied. Pruned layers switch to a sparse format once
+    // enough of their weights are gone (see `BasicNetwork::prune`).
+    enum class SparseFormat
+    {
+        dense,
+        csr,   // one entry per kept weight
+        block, // dense 1 x `block_size` runs of kept weights
+    };
+
+    // Compressed sparse rows of a `num_rows x num_cols` matrix: the kept entries of row `r` are
+    // `values[row_offsets[r] .. row_offsets[r + 1])`, at columns `column_indices[...]`.
+    template <std::floating_point Scalar>
+    struct BasicCsrMatrix
+    {
+        std::size_t num_rows{0};
+        std::size_t num_cols{0};
+        std::vector<std::uint32_t> row_offsets;
+        std::vector<std::uint32_t> column_indices;
+        AlignedVector<Scalar> values;
+    };
+
+    // Rows split into aligned 1 x `block_size` blocks, of which only the ones holding a kept
+    // weight are stored, densely. The inner products then run over contiguous inputs, which
+    // suits structured pruning where whole blocks go at once. Pruned entries inside a stored
+    // block are held as zero.
+    template <std::floating_point Scalar>
+    struct BasicBlockSparseMatrix
+    {
+        static constexpr std::size_t block_size{8};
+
+        std::size_t num_rows{0};
+        std::size_t num_cols{0};
+        std::vector<std::uint32_t> row_offsets;   // in blocks
+        std::vector<std::uint32_t> block_columns; // first column of each block
+        AlignedVector<Scalar> values;             // block_size per block
+    };
+
+    // Sparse copy of the weights of one layer, in whichever format was chosen for it.
+    template <std::floating_point Scalar>
+    struct BasicSparseWeights
+    {
+        SparseFormat format{SparseFormat::dense};
+        BasicCsrMatrix<Scalar> csr;
+        BasicBlockSparseMatrix<Scalar> blocks;
+    };
+
+    namespace sparse
+    {
+
+        // Sparsity from which pruned layers run sparse kernels, measured with
+        // `benchmarks/sparse_bench.cpp` on a 1024 x 1024 layer: CSR needs about 80% of the
+        // weights gone to beat the dense GEMV of a single sample, and blocks break even sooner.
+        inline constexpr double default_threshold{0.8};
+
+        // Largest batch for which the sparse kernels still beat the dense GEMM at 90% sparsity,
+        // from the same benchmark. Larger batches keep the dense path, which reuses every
+        // weight across the batch from registers.
+        inline constexpr std::size_t max_batch_size{16};
+
+        // Sparsity to prune to after `step` of `num_steps` rounds of iterative pruning, rising
+        // from `initial` to `final` quickly at first and slowly towards the end (the cubic
+        // schedule of Zhu and Gupta), so that training can recover from each round.
+        [[nodiscard]] auto pruning_schedule(std::size_t step, std::size_t num_steps,
+                                            double final, double initial = 0.0) -> double;
+
+        // Fraction of the entries of `mask` (one byte per weight, nonzero for kept) that are
+        // pruned.
+        [[nodiscard]] auto sparsity(std::span<const std::uint8_t> mask) -> double;
+
+        // Kept weights over the size of the blocks holding them, for a `num_rows x num_cols`
+        // mask; one when pruning removed whole blocks.
+        [[nodiscard]] auto block_fill(std::span<const std::uint8_t> mask, std::size_t num_rows,
+                                      std::size_t num_cols) -> double;
+
+        // Format for a layer with the given mask: dense below `threshold` sparsity, then blocks
+        // when they are mostly full and CSR otherwise.
+        [[nodiscard]] auto choose_format(std::span<const std::uint8_t> mask,
+                                         std::size_t num_rows, std::size_t num_cols,
+                                         double threshold) -> SparseFormat;
+
+        // Builds the structure of a matrix from `mask`, with zero values.
+        template <std::floating_point Scalar>
+        [[nodiscard]] auto make_csr(std::span<const std::uint8_t> mask, std::size_t num_rows,
+                                    std::size_t num_cols) -> BasicCsrMatrix<Scalar>;
+
+        template <std::floating_point Scalar>
+        [[nodiscard]] auto make_blocks(std::span<const std::uint8_t> mask, std::size_t num_rows,
+                                       std::size_t num_cols) -> BasicBlockSparseMatrix<Scalar>;
+
+        // Copies the kept entries of the row-major `dense` matrix into the existing structure.
+        template <std::floating_point Scalar>
+        auto gather(BasicCsrMatrix<Scalar>& matrix, std::span<const Scalar> dense) -> void;
+
+        template <std::floating_point Scalar>
+        auto gather(BasicBlockSparseMatrix<Scalar>& matrix, std::span<const Scalar> dense)
+            -> void;
+
+        // outputs = inputs * A^T, where `inputs` is batch_size x num_cols and `outputs` is
+        // batch_size x num_rows: the forward pass of a layer whose weights are A.
+        template <std::floating_point Scalar>
+        auto multiply(const BasicCsrMatrix<Scalar>& matrix, const Scalar* inputs,
+                      std::size_t batch_size, Scalar* outputs) -> void;
+
+        template <std::floating_point Scalar>
+        auto multiply(const BasicBlockSparseMatrix<Scalar>& matrix, const Scalar* inputs,
+                      std::size_t batch_size, Scalar* outputs) -> void;
+
+        // outputs = gradients * A, where `gradients` is batch_size x num_rows and `outputs` is
+        // batch_size x num_cols: the gradients a layer hands to the one below.
+        template <std::floating_point Scalar>
+        auto multiply_transposed(const BasicCsrMatrix<Scalar>& matrix, const Scalar* gradients,
+                                 std::size_t batch_size, Scalar* outputs) -> void;
+
+        template <std::floating_point Scalar>
+        auto multiply_transposed(const BasicBlockSparseMatrix<Scalar>& matrix,
+                                 const Scalar* gradients, std::size_t batch_size,
+                                 Scalar* outputs) -> void;
+
+        // Same, dispatching on the format of `weights`, which must not be dense.
+        template <std::floating_point Scalar>
+        auto multiply(const BasicSparseWeights<Scalar>& weights, const Scalar* inputs,
+                      std::size_t batch_size, Scalar* outputs) -> void
+        {
+            if (weights.format == SparseFormat::block)
+            {
+                multiply(weights.blocks, inputs, batch_size, outputs);
+            }
+            else
+            {
+                multiply(weights.csr, inputs, batch_size, outputs);
+            }
+        }
+
+        template <std::floating_point Scalar>
+        auto multiply_transposed(const BasicSparseWeights<Scalar>& weights,
+                                 const Scalar* gradients, std::size_t batch_size,
+                                 Scalar* outputs) -> void
+        {
+            if (weights.format == SparseFormat::block)
+            {
+                multiply_transposed(weights.blocks, gradients, batch_size, outputs);
+            }
+            else
+            {
+                multiply_transposed(weights.csr, gradients, batch_size, outputs);
+            }
+        }
+
+        // Bytes the weights take in their format, indices included.
+        template <std::floating_point Scalar>
+        [[nodiscard]] auto storage_bytes(const BasicSparseWeights<Scalar>& weights,
+                                         std::size_t num_rows, std::size_t num_cols)
+            -> std::size_t;
+
+    } // namespace sparse
+
+} // namespace axon
@@ -0,0 +1,547 @@
+#pragma once
+
+#include "aligned_allocator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <version>
+
+#if defined(__cpp_lib_mdspan)
+    #include <mdspan>
+#endif
+
+namespace axon
+{
+
+    inline constexpr std::size_t max_tensor_rank{6};
+
+    // Extents of a tensor, outermost first. The rank is bounded so that shapes and strides live
+    // inline and views never allocate.
+    class Shape
+    {
+    public:
+        // Rank zero: a single element.
+        Shape() = default;
+
+        Shape(std::initializer_list<std::size_t> extents)
+            : Shape(std::span<const std::size_t>{extents.begin(), extents.size()})
+        {
+        }
+
+        explicit Shape(std::span<const std::size_t> extents)
+            : rank_(extents.size())
+        {
+            if (extents.size() > max_tensor_rank)
+            {
+                throw std::invalid_argument("Tensor rank too large.");
+            }
+
+            std::ranges::copy(extents, extents_.begin());
+        }
+
+        [[nodiscard]] auto rank() const -> std::size_t
+        {
+            return rank_;
+        }
+
+        [[nodiscard]] auto operator[](std::size_t dim) const -> std::size_t
+        {
+            return extents_[dim];
+        }
+
+        // Number of elements.
+        [[nodiscard]] auto size() const -> std::size_t
+        {
+            std::size_t count{1};
+            for (const auto extent : extents())
+            {
+                count *= extent;
+            }
+
+            return count;
+        }
+
+        [[nodiscard]] auto extents() const -> std::span<const std::size_t>
+        {
+            return {extents_.data(), rank_};
+        }
+
+        [[nodiscard]] auto operator==(const Shape& other) const -> bool
+        {
+            return std::ranges::equal(extents(), other.extents());
+        }
+
+    private:
+        std::array<std::size_t, max_tensor_rank> extents_{};
+        std::size_t rank_{0};
+    };
+
+    // Non-owning, strided view of an N-dimensional array of `Element`, which is `Scalar` or
+    // `const Scalar`. Element `(i0, i1, ...)` lives at `data()[i0 * stride(0) + i1 * stride(1)
+    // + ...]`, with strides counted in elements.
+    //
+    // Slicing, batch sub-ranges, reshaping and transposing only rewrite the shape and strides,
+    // so they never copy. Code that needs contiguous memory takes `span()`, which throws for
+    // views that are not row-major contiguous, such as a transpose or a column slice; `copy`
+    // into a `BasicTensor` materializes those.
+    template <typename Element>
+        requires std::floating_point<std::remove_const_t<Element>>
+    class BasicTensorView
+    {
+    public:
+        using element_type = Element;
+        using value_type = std::remove_const_t<Element>;
+        using Strides = std::array<std::size_t, max_tensor_rank>;
+
+        BasicTensorView() = default;
+
+        // Row-major contiguous view of `values`, which must hold exactly `shape.size()`
+        // elements.
+        BasicTensorView(std::span<Element> values, const Shape& shape)
+            : data_(values.data()),
+              shape_(shape),
+              strides_(row_major_strides(shape))
+        {
+            if (values.size() != shape.size())
+            {
+                throw std::invalid_argument("Tensor shape does not match the number of values.");
+            }
+        }
+
+        // Arbitrary layout; the strides are trusted.
+        BasicTensorView(Element* data, const Shape& shape, const Strides& strides)
+            : data_(data),
+              shape_(shape),
+              strides_(strides)
+        {
+        }
+
+        // Mutable views convert to read-only ones.
+        template <typename Other>
+            requires(!std::same_as<Other, Element> && std::same_as<const Other, Element>)
+        BasicTensorView(const BasicTensorView<Other>& other) // NOLINT(google-explicit-constructor)
+            : data_(other.data()),
+              shape_(other.shape()),
+              strides_(other.strides())
+        {
+        }
+
+#if defined(__cpp_lib_mdspan)
+        template <typename Extents, typename Layout, typename Accessor>
+        BasicTensorView(const std::mdspan<Element, Extents, Layout, Accessor>& other) // NOLINT
+            : data_(other.data_handle())
+        {
+            std::array<std::size_t, Extents::rank()> extents{};
+            for (std::size_t dim{0}; dim < Extents::rank(); ++dim)
+            {
+                extents[dim] = other.extent(dim);
+                strides_[dim] = other.stride(dim);
+            }
+
+            shape_ = Shape{extents};
+        }
+#endif
+
+        [[nodiscard]] auto data() const -> Element*
+        {
+            return data_;
+        }
+
+        [[nodiscard]] auto shape() const -> const Shape&
+        {
+            return shape_;
+        }
+
+        [[nodiscard]] auto strides() const -> const Strides&
+        {
+            return strides_;
+        }
+
+        [[nodiscard]] auto rank() const -> std::size_t
+        {
+            return shape_.rank();
+        }
+
+        [[nodiscard]] auto extent(std::size_t dim) const -> std::size_t
+        {
+            return shape_[dim];
+        }
+
+        [[nodiscard]] auto stride(std::size_t dim) const -> std::size_t
+        {
+            return strides_[dim];
+        }
+
+        [[nodiscard]] auto size() const -> std::size_t
+        {
+            return shape_.size();
+        }
+
+        [[nodiscard]] auto empty() const -> bool
+        {
+            return size() == 0;
+        }
+
+        // Whether the elements are laid out row-major without gaps.
+        [[nodiscard]] auto is_contiguous() const -> bool
+        {
+            std::size_t expected{1};
+            for (std::size_t dim{rank()}; dim-- > 0;)
+            {
+                if (shape_[dim] != 1 && strides_[dim] != expected)
+                {
+                    return false;
+                }
+
+                expected *= shape_[dim];
+            }
+
+            return true;
+        }
+
+        // NOTE(abi): element access is unchecked, like indexing a span; pass one index per
+        // dimension.
+        template <std::convertible_to<std::size_t>... Indices>
+        [[nodiscard]] auto operator()(Indices... indices) const -> Element&
+        {
+            std::size_t offset{0};
+            std::size_t dim{0};
+            ((offset += static_cast<std::size_t>(indices) * strides_[dim++]), ...);
+            return data_[offset];
+        }
+
+        // The sub-tensor at `index` of the outermost dimension, one rank lower.
+        [[nodiscard]] auto operator[](std::size_t index) const -> BasicTensorView
+        {
+            if (rank() == 0 || index >= shape_[0])
+            {
+                throw std::out_of_range("Tensor index out of range.");
+            }
+
+            const auto extents = shape_.extents();
+            Strides strides{};
+            std::copy(strides_.begin() + 1, strides_.begin() + rank(), strides.begin());
+            return {data_ + (index * strides_[0]), Shape{extents.subspan(1)}, strides};
+        }
+
+        // Elements `[begin, end)` of dimension `dim`.
+        [[nodiscard]] auto slice(std::size_t dim, std::size_t begin, std::size_t end) const
+            -> BasicTensorView
+        {
+            if (dim >= rank() || begin > end || end > shape_[dim])
+            {
+                throw std::out_of_range("Tensor slice out of range.");
+            }
+
+            std::array<std::size_t, max_tensor_rank> extents{};
+            std::ranges::copy(shape_.extents(), extents.begin());
+            extents[dim] = end - begin;
+            return {data_ + (begin * strides_[dim]), Shape{std::span{extents}.first(rank())},
+                    strides_};
+        }
+
+        // Samples `[begin, end)` of a batch laid out along the outermost dimension.
+        [[nodiscard]] auto batch(std::size_t begin, std::size_t end) const -> BasicTensorView
+        {
+            return slice(0, begin, end);
+        }
+
+        // The same elements under a shape of the same size. Only contiguous views can be
+        // reshaped without a copy.
+        [[nodiscard]] auto reshape(const Shape& shape) const -> BasicTensorView
+        {
+            if (shape.size() != size())
+            {
+                throw std::invalid_argument("Tensor shape does not match the number of values.");
+            }
+
+            if (!is_contiguous())
+            {
+                throw std::invalid_argument("Tensor is not contiguous.");
+            }
+
+            return {data_, shape, row_major_strides(shape)};
+        }
+
+        // Swaps two dimensions; without arguments, the two innermost ones, which transposes a
+        // matrix or every matrix of a batch.
+        [[nodiscard]] auto transpose(std::size_t first, std::size_t second) const
+            -> BasicTensorView
+        {
+            if (first >= rank() || second >= rank())
+            {
+                throw std::out_of_range("Tensor dimension out of range.");
+            }
+
+            std::array<std::size_t, max_tensor_rank> extents{};
+            std::ranges::copy(shape_.extents(), extents.begin());
+            Strides strides = strides_;
+            std::swap(extents[first], extents[second]);
+            std::swap(strides[first], strides[second]);
+            return {data_, Shape{std::span{extents}.first(rank())}, strides};
+        }
+
+        [[nodiscard]] auto transpose() const -> BasicTensorView
+        {
+            if (rank() < 2)
+            {
+                throw std::invalid_argument("Tensor rank too small to transpose.");
+            }
+
+            return transpose(rank() - 2, rank() - 1);
+        }
+
+        // The elements as a span, for contiguous views.
+        [[nodiscard]] auto span() const -> std::span<Element>
+        {
+            if (!is_contiguous())
+            {
+                throw std::invalid_argument("Tensor is not contiguous.");
+            }
+
+            return {data_, size()};
+        }
+
+#if defined(__cpp_lib_mdspan)
+        // The view as a strided `std::mdspan` of rank `Rank`, which must match.
+        template <std::size_t Rank>
+        [[nodiscard]] auto to_mdspan() const
+            -> std::mdspan<Element, std::dextents<std::size_t, Rank>, std::layout_stride>
+        {
+            if (Rank != rank())
+            {
+                throw std::invalid_argument("Tensor rank mismatch.");
+            }
+
+            using Extents = std::dextents<std::size_t, Rank>;
+            std::array<std::size_t, Rank> extents{};
+            std::array<std::size_t, Rank> strides{};
+            for (std::size_t dim{0}; dim < Rank; ++dim)
+            {
+                extents[dim] = shape_[dim];
+                strides[dim] = strides_[dim];
+            }
+
+            return {data_, std::layout_stride::mapping<Extents>{Extents{extents}, strides}};
+        }
+#endif
+
+        [[nodiscard]] static auto row_major_strides(const Shape& shape) -> Strides
+        {
+            Strides strides{};
+            std::size_t stride{1};
+            for (std::size_t dim{shape.rank()}; dim-- > 0;)
+            {
+                strides[dim] = stride;
+                stride *= shape[dim];
+            }
+
+            return strides;
+        }
+
+    private:
+        Element* data_{nullptr};
+        Shape shape_;
+        Strides strides_{};
+    };
+
+    // Copies `source` into `destination` element by element; the shapes must match and either
+    // may be strided. Contiguous innermost rows are copied as blocks.
+    template <std::floating_point Scalar>
+    auto copy(BasicTensorView<const Scalar> source, BasicTensorView<Scalar> destination) -> void
+    {
+        if (!(source.shape() == destination.shape()))
+        {
+            throw std::invalid_argument("Mismatched tensor shapes.");
+        }
+
+        if (source.is_contiguous() && destination.is_contiguous())
+        {
+            std::ranges::copy(source.span(), destination.data());
+            return;
+        }
+
+        const std::size_t rank = source.rank();
+        if (rank == 0)
+        {
+            *destination.data() = *source.data();
+            return;
+        }
+
+        // Odometer over every dimension but the innermost.
+        std::array<std::size_t, max_tensor_rank> index{};
+        const std::size_t inner = source.extent(rank - 1);
+        const std::size_t num_rows = source.size() / std::max<std::size_t>(inner, 1);
+        for (std::size_t row{0}; row < num_rows && inner != 0; ++row)
+        {
+            std::size_t from{0};
+            std::size_t to{0};
+            for (std::size_t dim{0}; dim + 1 < rank; ++dim)
+            {
+                from += index[dim] * source.stride(dim);
+                to += index[dim] * destination.stride(dim);
+            }
+
+            const Scalar* input = source.data() + from;
+            Scalar* output = destination.data() + to;
+            const std::size_t input_stride = source.stride(rank - 1);
+            const std::size_t output_stride = destination.stride(rank - 1);
+            for (std::size_t i{0}; i < inner; ++i)
+            {
+                output[i * output_stride] = input[i * input_stride];
+            }
+
+            for (std::size_t dim{rank - 1}; dim-- > 0;)
+            {
+                if (++index[dim] < source.extent(dim))
+                {
+                    break;
+                }
+
+                index[dim] = 0;
+            }
+        }
+    }
+
+    // Owning tensor: row-major contiguous, cache-line aligned storage with a shape. Converts to
+    // views implicitly, so functions taking views accept tensors as they are.
+    template <std::floating_point Scalar>
+    class BasicTensor
+    {
+    public:
+        using View = BasicTensorView<Scalar>;
+        using ConstView = BasicTensorView<const Scalar>;
+
+        BasicTensor() = default;
+
+        // Zero-filled.
+        explicit BasicTensor(const Shape& shape)
+            : shape_(shape),
+              values_(shape.size())
+        {
+        }
+
+        BasicTensor(const Shape& shape, std::span<const Scalar> values)
+            : shape_(shape),
+              values_(values.begin(), values.end())
+        {
+            if (values.size() != shape.size())
+            {
+                throw std::invalid_argument("Tensor shape does not match the number of values.");
+            }
+        }
+
+        // Contiguous copy of any view, e.g. to materialize a transpose.
+        explicit BasicTensor(ConstView view)
+            : BasicTensor(view.shape())
+        {
+            copy(view, this->view());
+        }
+
+        [[nodiscard]] auto shape() const -> const Shape&
+        {
+            return shape_;
+        }
+
+        [[nodiscard]] auto rank() const -> std::size_t
+        {
+            return shape_.rank();
+        }
+
+        [[nodiscard]] auto extent(std::size_t dim) const -> std::size_t
+        {
+            return shape_[dim];
+        }
+
+        [[nodiscard]] auto size() const -> std::size_t
+        {
+            return values_.size();
+        }
+
+        [[nodiscard]] auto data() -> Scalar*
+        {
+            return values_.data();
+        }
+
+        [[nodiscard]] auto data() const -> const Scalar*
+        {
+            return values_.data();
+        }
+
+        [[nodiscard]] auto span() -> std::span<Scalar>
+        {
+            return values_;
+        }
+
+        [[nodiscard]] auto span() const -> std::span<const Scalar>
+        {
+            return values_;
+        }
+
+        [[nodiscard]] auto view() -> View
+        {
+            return {values_.data(), shape_, View::row_major_strides(shape_)};
+        }
+
+        [[nodiscard]] auto view() const -> ConstView
+        {
+            return {values_.data(), shape_, ConstView::row_major_strides(shape_)};
+        }
+
+        operator View() // NOLINT(google-explicit-constructor)
+        {
+            return view();
+        }
+
+        operator ConstView() const // NOLINT(google-explicit-constructor)
+        {
+            return view();
+        }
+
+        template <std::convertible_to<std::size_t>... Indices>
+        [[nodiscard]] auto operator()(Indices... indices) -> Scalar&
+        {
+            return view()(indices...);
+        }
+
+        template <std::convertible_to<std::size_t>... Indices>
+        [[nodiscard]] auto operator()(Indices... indices) const -> const Scalar&
+        {
+            return view()(indices...);
+        }
+
+        // Changes the shape in place. The storage only grows, so resizing back and forth between
+        // batch sizes stops allocating once the largest one was seen; the values are not kept.
+        auto resize(const Shape& shape) -> void
+        {
+            values_.resize(shape.size());
+            shape_ = shape;
+        }
+
+        // Reinterprets the values under a shape of the same size.
+        auto reshape(const Shape& shape) -> void
+        {
+            if (shape.size() != size())
+            {
+                throw std::invalid_argument("Tensor shape does not match the number of values.");
+            }
+
+            shape_ = shape;
+        }
+
+    private:
+        Shape shape_;
+        AlignedVector<Scalar> values_;
+    };
+
+    using Tensor = BasicTensor<double>;
+    using TensorView = BasicTensorView<double>;
+    using ConstTensorView = BasicTensorView<const double>;
+
+} // namespace axon
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+// Hot-path instrumentation. `AXON_TRACE_SCOPE(phase, name, layer, flops, bytes)` times the
+// enclosing scope and attributes the given work to a layer; the library marks every layer of
+// the forward and backward sweeps, the loss, the weight update and data loading this way.
+//
+// Scopes only exist when the library is configured with `AXON_ENABLE_TRACING`; otherwise the
+// macro expands to nothing and does not evaluate its arguments. When compiled in, a scope
+// costs one relaxed atomic load unless a recording is running.
+#if defined(AXON_ENABLE_TRACING)
+    #define AXON_TRACE_CONCAT_IMPL(a, b) a##b
+    #define AXON_TRACE_CONCAT(a, b) AXON_TRACE_CONCAT_IMPL(a, b)
+    #define AXON_TRACE_SCOPE(...)                                                                  \
+        const ::axon::trace::Scope AXON_TRACE_CONCAT(axon_trace_scope_, __LINE__){__VA_ARGS__}
+#else
+    #define AXON_TRACE_SCOPE(...) static_cast<void>(0)
+#endif
+
+namespace axon::trace
+{
+
+    inline constexpr bool enabled{
+#if defined(AXON_ENABLE_TRACING)
+        true
+#else
+        false
+#endif
+    };
+
+    enum class Phase
+    {
+        forward,
+        loss,
+        backward,
+        update,
+        data_loading,
+    };
+
+    [[nodiscard]] auto to_string(Phase phase) -> std::string_view;
+
+    [[nodiscard]] constexpr auto layer_id(std::size_t layer_idx) -> std::int32_t
+    {
+        return static_cast<std::int32_t>(layer_idx);
+    }
+
+    // One timed region. `layer` is -1 for work that belongs to no layer. `flops` and `bytes`
+    // are the arithmetic and the minimum memory traffic of the region, from which the summary
+    // derives achieved throughput and bandwidth.
+    struct Event
+    {
+        std::string_view name;
+        Phase phase{Phase::forward};
+        std::int32_t layer{-1};
+        std::uint32_t thread{0};
+        std::uint64_t begin_ns{0};
+        std::uint64_t end_ns{0};
+        std::uint64_t flops{0};
+        std::uint64_t bytes{0};
+    };
+
+    // Discards previous events and starts recording on every thread.
+    auto start() -> void;
+    auto stop() -> void;
+
+    // Events recorded between `start` and `stop`, ordered by start time. Timestamps are relative
+    // to `start`.
+    [[nodiscard]] auto collect() -> std::vector<Event>;
+
+    // Writes the events in the Chrome trace event format, readable by chrome://tracing and
+    // Perfetto.
+    auto write_chrome_trace(const std::filesystem::path& path) -> void;
+
+    // Writes one row per phase and layer: calls, total and mean time, share of the traced time,
+    // GFLOP/s and GB/s.
+    auto write_summary(std::ostream& stream) -> void;
+
+    namespace detail
+    {
+        inline std::atomic<bool> recording{false};
+
+        [[nodiscard]] auto now_ns() -> std::uint64_t;
+        auto record(const Event& event) -> void;
+
+    } // namespace detail
+
+    class Scope
+    {
+    public:
+        Scope(Phase phase, std::string_view name, std::int32_t layer = -1,
+              std::uint64_t flops = 0, std::uint64_t bytes = 0)
+        {
+            if (detail::recording.load(std::memory_order_relaxed))
+            {
+                event_ = {.name = name, .phase = phase, .layer = layer, .flops = flops,
+                          .bytes = bytes};
+                active_ = true;
+                event_.begin_ns = detail::now_ns();
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        auto operator=(const Scope&) -> Scope& = delete;
+
+        ~Scope()
+        {
+            if (active_)
+            {
+                event_.end_ns = detail::now_ns();
+                detail::record(event_);
+            }
+        }
+
+    private:
+        Event event_;
+        bool active_{false};
+    };
+
+} // namespace axon::trace
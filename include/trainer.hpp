@@ -0,0 +1,89 @@
+#pragma once
+
+#include "network.hpp"
+#include "optimizer.hpp"
+#include "scheduler.hpp"
+#include "tensor.hpp"
+#include "workspace.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace axon
+{
+
+    // Synchronous data-parallel training: every mini-batch is split into up to `num_shards`
+    // contiguous blocks of rows, each shard runs the forward and backward passes against the
+    // shared weights into its own workspace on the library's scheduler, and the per-shard
+    // gradients are summed before a single momentum SGD step is applied to the network. Networks
+    // with a custom activation or criterion run their shards serially on the calling thread.
+    template <std::floating_point Scalar>
+    class BasicDataParallelTrainer
+    {
+    public:
+        explicit BasicDataParallelTrainer(
+            BasicNetwork<Scalar>& network,
+            std::size_t num_shards = Scheduler::instance().get_num_threads());
+
+        [[nodiscard]] auto get_num_shards() const -> std::size_t
+        {
+            return workspaces_.size();
+        }
+
+        // Trains on a row-major `batch_size x num_inputs` input matrix and the matching
+        // `batch_size x num_outputs` targets. Returns the loss of the batch, measured before the
+        // update; the update itself equals the one of `back_propagate` followed by `step`.
+        // NOTE(abi): the network's own workspace is left untouched, so `get_output` keeps
+        // returning the outputs of its last `feed_forward`.
+        auto train_batch(std::span<const Scalar> inputs, std::span<const Scalar> targets,
+                         std::size_t batch_size, Scalar learning_rate = Scalar{0.01},
+                         Scalar momentum = Scalar{0}) -> Scalar;
+
+        auto train_batch(const std::vector<Scalar>& inputs, const std::vector<Scalar>& targets,
+                         std::size_t batch_size, Scalar learning_rate = Scalar{0.01},
+                         Scalar momentum = Scalar{0}) -> Scalar
+        {
+            return train_batch(std::span<const Scalar>{inputs}, std::span<const Scalar>{targets},
+                               batch_size, learning_rate, momentum);
+        }
+
+        // Same, over contiguous tensors whose outermost dimension is the batch, e.g. the
+        // `input_view` and `target_view` of a data loader batch.
+        auto train_batch(BasicTensorView<const Scalar> inputs,
+                         BasicTensorView<const Scalar> targets, Scalar learning_rate = Scalar{0.01},
+                         Scalar momentum = Scalar{0}) -> Scalar
+        {
+            return train_batch(inputs.span(), targets.span(),
+                               inputs.rank() == 0 ? 0 : inputs.extent(0), learning_rate, momentum);
+        }
+
+        // Same, but applies the averaged gradients with `optimizer` instead of momentum SGD.
+        template <Optimizer<Scalar> OptimizerType>
+        auto train_batch(std::span<const Scalar> inputs, std::span<const Scalar> targets,
+                         std::size_t batch_size, OptimizerType& optimizer) -> Scalar
+        {
+            const Scalar loss = compute_gradients(inputs, targets, batch_size);
+            optimizer.step(network_.get_parameters(),
+                           std::span<const Scalar>{workspaces_.front().parameter_gradients});
+            network_.apply_masks();
+            return loss;
+        }
+
+    private:
+        auto compute_gradients(std::span<const Scalar> inputs, std::span<const Scalar> targets,
+                               std::size_t batch_size) -> Scalar;
+        auto reduce_gradients(std::size_t num_shards) -> void;
+
+        BasicNetwork<Scalar>& network_;
+        std::vector<BasicWorkspace<Scalar>> workspaces_;
+        std::vector<double> shard_losses_;
+    };
+
+    extern template class BasicDataParallelTrainer<float>;
+    extern template class BasicDataParallelTrainer<double>;
+
+    using DataParallelTrainer = BasicDataParallelTrainer<double>;
+
+} // namespace axon
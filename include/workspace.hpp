@@ -0,0 +1,164 @@
+#pragma once
+
+#include "arena.hpp"
+#include "layer.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace axon
+{
+
+    // Per-layer state written by a pass over one batch: activations and deltas hold one row per
+    // sample, while the parameter gradients are already reduced over the batch.
+    template <std::floating_point Scalar>
+    struct BasicLayerWorkspace
+    {
+        std::span<Scalar> outputs;          // batch_size x num_outputs
+        std::span<Scalar> gradients;        // batch_size x num_outputs
+        std::span<Scalar> weight_gradients; // num_outputs x num_inputs
+        std::span<Scalar> bias_gradients;   // num_outputs
+    };
+
+    // Everything a forward/backward pass writes, kept apart from the layers so that passes over
+    // different batches can run concurrently against the same weights.
+    //
+    // All buffers are carved from one arena: the parameter gradients first, laid out like the
+    // parameters of the network, then the per-batch buffers.
+    template <std::floating_point Scalar>
+    struct BasicWorkspace
+    {
+        std::size_t batch_size{0};
+        std::span<Scalar> inputs; // batch_size x num_inputs
+        std::vector<BasicLayerWorkspace<Scalar>> layers;
+
+        // Every `weight_gradients` and `bias_gradients` buffer as one span, which lines up with
+        // `BasicNetwork::get_parameters`. The cache-line padding between buffers stays zero.
+        std::span<Scalar> parameter_gradients;
+
+        Arena arena;
+
+        BasicWorkspace() = default;
+
+        explicit BasicWorkspace(
+            const std::vector<BasicLayer<Scalar>>& network_layers,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : layers(network_layers.size()),
+              arena(gradient_bytes(network_layers), resource)
+        {
+            carve(network_layers);
+        }
+
+        BasicWorkspace(const BasicWorkspace& other)
+            : batch_size(other.batch_size),
+              layers(other.layers),
+              arena(other.arena)
+        {
+            rebase(other);
+        }
+
+        BasicWorkspace(BasicWorkspace&& other) noexcept = default;
+
+        auto operator=(const BasicWorkspace& other) -> BasicWorkspace&
+        {
+            if (this != &other)
+            {
+                batch_size = other.batch_size;
+                layers = other.layers;
+                arena = other.arena;
+                rebase(other);
+            }
+
+            return *this;
+        }
+
+        auto operator=(BasicWorkspace&& other) noexcept -> BasicWorkspace& = default;
+
+        ~BasicWorkspace() = default;
+
+        // NOTE(abi): resizing to the current batch size is a no-op and the arena only ever
+        // grows, so steady-state passes never touch the allocator. Growing keeps the parameter
+        // gradients.
+        auto resize_batch(const std::vector<BasicLayer<Scalar>>& network_layers, std::size_t size)
+            -> void
+        {
+            const std::size_t batch_offset = gradient_bytes(network_layers);
+            std::size_t required = batch_offset
+                                   + (padded_size<Scalar>(size * network_layers.front().num_inputs)
+                                      * sizeof(Scalar));
+            for (const auto& layer : network_layers)
+            {
+                required += 2 * padded_size<Scalar>(size * layer.num_outputs) * sizeof(Scalar);
+            }
+
+            if (size == batch_size && required <= arena.size())
+            {
+                return;
+            }
+
+            arena.resize(std::max(required, arena.size()));
+            carve(network_layers);
+
+            batch_size = size;
+            std::size_t offset = batch_offset;
+            inputs = arena.view<Scalar>(offset, size * network_layers.front().num_inputs);
+            offset += padded_size<Scalar>(inputs.size()) * sizeof(Scalar);
+
+            for (std::size_t i{0}; i < network_layers.size(); ++i)
+            {
+                const std::size_t count = size * network_layers[i].num_outputs;
+                layers[i].outputs = arena.view<Scalar>(offset, count);
+                offset += padded_size<Scalar>(count) * sizeof(Scalar);
+                layers[i].gradients = arena.view<Scalar>(offset, count);
+                offset += padded_size<Scalar>(count) * sizeof(Scalar);
+            }
+        }
+
+    private:
+        [[nodiscard]] static auto gradient_bytes(
+            const std::vector<BasicLayer<Scalar>>& network_layers) -> std::size_t
+        {
+            std::size_t bytes{0};
+            for (const auto& layer : network_layers)
+            {
+                bytes += parameter_bytes<Scalar>(layer.num_inputs, layer.num_outputs);
+            }
+
+            return bytes;
+        }
+
+        auto carve(const std::vector<BasicLayer<Scalar>>& network_layers) -> void
+        {
+            std::size_t offset{0};
+            for (std::size_t i{0}; i < network_layers.size(); ++i)
+            {
+                offset = carve_parameters(arena, offset, network_layers[i].num_inputs,
+                                          network_layers[i].num_outputs,
+                                          layers[i].weight_gradients, layers[i].bias_gradients);
+            }
+
+            parameter_gradients = arena.view<Scalar>(0, offset / sizeof(Scalar));
+        }
+
+        auto rebase(const BasicWorkspace& other) -> void
+        {
+            inputs = arena.rebase(other.inputs, other.arena);
+            parameter_gradients = arena.rebase(other.parameter_gradients, other.arena);
+            for (auto& layer : layers)
+            {
+                layer.outputs = arena.rebase(layer.outputs, other.arena);
+                layer.gradients = arena.rebase(layer.gradients, other.arena);
+                layer.weight_gradients = arena.rebase(layer.weight_gradients, other.arena);
+                layer.bias_gradients = arena.rebase(layer.bias_gradients, other.arena);
+            }
+        }
+    };
+
+    using LayerWorkspace = BasicLayerWorkspace<double>;
+    using Workspace = BasicWorkspace<double>;
+
+} // namespace axon
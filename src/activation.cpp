@@ -0,0 +1,539 @@
+#include "activation.hpp"
+
+#include "kernels.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace axon::activation::vectorized
+{
+
+    namespace
+    {
+        // Cody-Waite range reduction: x = n * ln(2) + r with |r| <= ln(2) / 2, where ln(2) is
+        // split so that n * ln2_hi is exact for every n reachable after clamping. The clamp
+        // keeps 2^n within the normal range, so the exponent can be built directly.
+        template <typename Scalar>
+        struct ExpConstants;
+
+        template <>
+        struct ExpConstants<double>
+        {
+            static constexpr double log2e{1.4426950408889634};
+            static constexpr double ln2_hi{0.693145751953125};
+            static constexpr double ln2_lo{1.4286068203094172321e-06};
+            static constexpr double min_input{-708.0};
+            static constexpr double max_input{708.0};
+        };
+
+        template <>
+        struct ExpConstants<float>
+        {
+            static constexpr float log2e{1.44269504F};
+            static constexpr float ln2_hi{0.693359375F};
+            static constexpr float ln2_lo{-2.12194440e-4F};
+            static constexpr float min_input{-87.0F};
+            static constexpr float max_input{87.0F};
+        };
+
+        // Taylor coefficients of e^r up to degree 6.
+        template <typename Scalar>
+        constexpr Scalar c2{Scalar{1} / 2};
+        template <typename Scalar>
+        constexpr Scalar c3{Scalar{1} / 6};
+        template <typename Scalar>
+        constexpr Scalar c4{Scalar{1} / 24};
+        template <typename Scalar>
+        constexpr Scalar c5{Scalar{1} / 120};
+        template <typename Scalar>
+        constexpr Scalar c6{Scalar{1} / 720};
+
+        template <typename Scalar>
+        auto fast_exp(Scalar x) -> Scalar
+        {
+            using Constants = ExpConstants<Scalar>;
+
+            x = std::clamp(x, Constants::min_input, Constants::max_input);
+
+            const Scalar n = std::nearbyint(x * Constants::log2e);
+            const Scalar r = (x - (n * Constants::ln2_hi)) - (n * Constants::ln2_lo);
+
+            Scalar p = c6<Scalar>;
+            p = (p * r) + c5<Scalar>;
+            p = (p * r) + c4<Scalar>;
+            p = (p * r) + c3<Scalar>;
+            p = (p * r) + c2<Scalar>;
+            p = (p * r) + Scalar{1};
+            p = (p * r) + Scalar{1};
+
+            return std::ldexp(p, static_cast<int>(n));
+        }
+
+        template <typename Scalar>
+        auto fast_sigmoid(Scalar x) -> Scalar
+        {
+            return Scalar{1} / (Scalar{1} + fast_exp(-x));
+        }
+
+        // tanh(x) = 2 * sigmoid(2x) - 1
+        template <typename Scalar>
+        auto fast_tanh(Scalar x) -> Scalar
+        {
+            return (Scalar{2} * fast_sigmoid(Scalar{2} * x)) - Scalar{1};
+        }
+
+        template <typename Scalar>
+        auto sigmoid_fast_scalar(const Scalar* inputs, Scalar* outputs, std::size_t count)
+            -> void
+        {
+            for (std::size_t i{0}; i < count; ++i)
+            {
+                outputs[i] = fast_sigmoid(inputs[i]);
+            }
+        }
+
+        template <typename Scalar>
+        auto tanh_fast_scalar(const Scalar* inputs, Scalar* outputs, std::size_t count) -> void
+        {
+            for (std::size_t i{0}; i < count; ++i)
+            {
+                outputs[i] = fast_tanh(inputs[i]);
+            }
+        }
+
+#if defined(AXON_SIMD_X86)
+
+        // AVX2 + FMA
+
+        AXON_TARGET_AVX2 auto exp_avx2(__m256d x) -> __m256d
+        {
+            using Constants = ExpConstants<double>;
+
+            // NOTE(abi): adding 1.5 * 2^52 rounds to the nearest integer and leaves it in the low
+            // mantissa bits, which is how we get a 64-bit integer without AVX-512DQ.
+            const __m256d shifter = _mm256_set1_pd(6755399441055744.0);
+
+            x = _mm256_max_pd(x, _mm256_set1_pd(Constants::min_input));
+            x = _mm256_min_pd(x, _mm256_set1_pd(Constants::max_input));
+
+            const __m256d shifted = _mm256_fmadd_pd(x, _mm256_set1_pd(Constants::log2e), shifter);
+            const __m256d n = _mm256_sub_pd(shifted, shifter);
+
+            __m256d r = _mm256_fnmadd_pd(n, _mm256_set1_pd(Constants::ln2_hi), x);
+            r = _mm256_fnmadd_pd(n, _mm256_set1_pd(Constants::ln2_lo), r);
+
+            __m256d p = _mm256_set1_pd(c6<double>);
+            p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(c5<double>));
+            p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(c4<double>));
+            p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(c3<double>));
+            p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(c2<double>));
+            p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0));
+            p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0));
+
+            const __m256i exponent = _mm256_slli_epi64(
+                _mm256_add_epi64(_mm256_castpd_si256(shifted), _mm256_set1_epi64x(1023)), 52);
+
+            return _mm256_mul_pd(p, _mm256_castsi256_pd(exponent));
+        }
+
+        AXON_TARGET_AVX2 auto exp_avx2(__m256 x) -> __m256
+        {
+            using Constants = ExpConstants<float>;
+
+            // Same trick with 1.5 * 2^23, for 32-bit lanes.
+            const __m256 shifter = _mm256_set1_ps(12582912.0F);
+
+            x = _mm256_max_ps(x, _mm256_set1_ps(Constants::min_input));
+            x = _mm256_min_ps(x, _mm256_set1_ps(Constants::max_input));
+
+            const __m256 shifted = _mm256_fmadd_ps(x, _mm256_set1_ps(Constants::log2e), shifter);
+            const __m256 n = _mm256_sub_ps(shifted, shifter);
+
+            __m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(Constants::ln2_hi), x);
+            r = _mm256_fnmadd_ps(n, _mm256_set1_ps(Constants::ln2_lo), r);
+
+            __m256 p = _mm256_set1_ps(c6<float>);
+            p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(c5<float>));
+            p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(c4<float>));
+            p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(c3<float>));
+            p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(c2<float>));
+            p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.0F));
+            p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.0F));
+
+            const __m256i exponent = _mm256_slli_epi32(
+                _mm256_add_epi32(_mm256_castps_si256(shifted), _mm256_set1_epi32(127)), 23);
+
+            return _mm256_mul_ps(p, _mm256_castsi256_ps(exponent));
+        }
+
+        AXON_TARGET_AVX2 auto sigmoid_avx2(__m256d x) -> __m256d
+        {
+            const __m256d one = _mm256_set1_pd(1.0);
+            const __m256d e = exp_avx2(_mm256_sub_pd(_mm256_setzero_pd(), x));
+            return _mm256_div_pd(one, _mm256_add_pd(one, e));
+        }
+
+        AXON_TARGET_AVX2 auto sigmoid_avx2(__m256 x) -> __m256
+        {
+            const __m256 one = _mm256_set1_ps(1.0F);
+            const __m256 e = exp_avx2(_mm256_sub_ps(_mm256_setzero_ps(), x));
+            return _mm256_div_ps(one, _mm256_add_ps(one, e));
+        }
+
+        AXON_TARGET_AVX2 auto tanh_avx2(__m256d x) -> __m256d
+        {
+            const __m256d two = _mm256_set1_pd(2.0);
+            const __m256d s = sigmoid_avx2(_mm256_mul_pd(two, x));
+            return _mm256_fmsub_pd(two, s, _mm256_set1_pd(1.0));
+        }
+
+        AXON_TARGET_AVX2 auto tanh_avx2(__m256 x) -> __m256
+        {
+            const __m256 two = _mm256_set1_ps(2.0F);
+            const __m256 s = sigmoid_avx2(_mm256_mul_ps(two, x));
+            return _mm256_fmsub_ps(two, s, _mm256_set1_ps(1.0F));
+        }
+
+        template <typename Scalar>
+        AXON_TARGET_AVX2 auto sigmoid_fast_avx2(const Scalar* inputs, Scalar* outputs,
+                                                std::size_t count) -> void
+        {
+            using Ops = simd::Avx2<Scalar>;
+
+            std::size_t i{0};
+            for (; i + Ops::width <= count; i += Ops::width)
+            {
+                Ops::store(outputs + i, sigmoid_avx2(Ops::load(inputs + i)));
+            }
+
+            sigmoid_fast_scalar(inputs + i, outputs + i, count - i);
+        }
+
+        template <typename Scalar>
+        AXON_TARGET_AVX2 auto tanh_fast_avx2(const Scalar* inputs, Scalar* outputs,
+                                             std::size_t count) -> void
+        {
+            using Ops = simd::Avx2<Scalar>;
+
+            std::size_t i{0};
+            for (; i + Ops::width <= count; i += Ops::width)
+            {
+                Ops::store(outputs + i, tanh_avx2(Ops::load(inputs + i)));
+            }
+
+            tanh_fast_scalar(inputs + i, outputs + i, count - i);
+        }
+
+        // AVX-512
+
+        AXON_TARGET_AVX512 auto exp_avx512(__m512d x) -> __m512d
+        {
+            using Constants = ExpConstants<double>;
+
+            x = _mm512_max_pd(x, _mm512_set1_pd(Constants::min_input));
+            x = _mm512_min_pd(x, _mm512_set1_pd(Constants::max_input));
+
+            const __m512d n =
+                _mm512_roundscale_pd(_mm512_mul_pd(x, _mm512_set1_pd(Constants::log2e)),
+                                     _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+            __m512d r = _mm512_fnmadd_pd(n, _mm512_set1_pd(Constants::ln2_hi), x);
+            r = _mm512_fnmadd_pd(n, _mm512_set1_pd(Constants::ln2_lo), r);
+
+            __m512d p = _mm512_set1_pd(c6<double>);
+            p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(c5<double>));
+            p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(c4<double>));
+            p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(c3<double>));
+            p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(c2<double>));
+            p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0));
+            p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0));
+
+            return _mm512_scalef_pd(p, n);
+        }
+
+        AXON_TARGET_AVX512 auto exp_avx512(__m512 x) -> __m512
+        {
+            using Constants = ExpConstants<float>;
+
+            x = _mm512_max_ps(x, _mm512_set1_ps(Constants::min_input));
+            x = _mm512_min_ps(x, _mm512_set1_ps(Constants::max_input));
+
+            const __m512 n =
+                _mm512_roundscale_ps(_mm512_mul_ps(x, _mm512_set1_ps(Constants::log2e)),
+                                     _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+            __m512 r = _mm512_fnmadd_ps(n, _mm512_set1_ps(Constants::ln2_hi), x);
+            r = _mm512_fnmadd_ps(n, _mm512_set1_ps(Constants::ln2_lo), r);
+
+            __m512 p = _mm512_set1_ps(c6<float>);
+            p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(c5<float>));
+            p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(c4<float>));
+            p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(c3<float>));
+            p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(c2<float>));
+            p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(1.0F));
+            p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(1.0F));
+
+            return _mm512_scalef_ps(p, n);
+        }
+
+        AXON_TARGET_AVX512 auto sigmoid_avx512(__m512d x) -> __m512d
+        {
+            const __m512d one = _mm512_set1_pd(1.0);
+            const __m512d e = exp_avx512(_mm512_sub_pd(_mm512_setzero_pd(), x));
+            return _mm512_div_pd(one, _mm512_add_pd(one, e));
+        }
+
+        AXON_TARGET_AVX512 auto sigmoid_avx512(__m512 x) -> __m512
+        {
+            const __m512 one = _mm512_set1_ps(1.0F);
+            const __m512 e = exp_avx512(_mm512_sub_ps(_mm512_setzero_ps(), x));
+            return _mm512_div_ps(one, _mm512_add_ps(one, e));
+        }
+
+        AXON_TARGET_AVX512 auto tanh_avx512(__m512d x) -> __m512d
+        {
+            const __m512d two = _mm512_set1_pd(2.0);
+            const __m512d s = sigmoid_avx512(_mm512_mul_pd(two, x));
+            return _mm512_fmsub_pd(two, s, _mm512_set1_pd(1.0));
+        }
+
+        AXON_TARGET_AVX512 auto tanh_avx512(__m512 x) -> __m512
+        {
+            const __m512 two = _mm512_set1_ps(2.0F);
+            const __m512 s = sigmoid_avx512(_mm512_mul_ps(two, x));
+            return _mm512_fmsub_ps(two, s, _mm512_set1_ps(1.0F));
+        }
+
+        template <typename Scalar>
+        AXON_TARGET_AVX512 auto sigmoid_fast_avx512(const Scalar* inputs, Scalar* outputs,
+                                                    std::size_t count) -> void
+        {
+            using Ops = simd::Avx512<Scalar>;
+
+            std::size_t i{0};
+            for (; i + Ops::width <= count; i += Ops::width)
+            {
+                Ops::store(outputs + i, sigmoid_avx512(Ops::load(inputs + i)));
+            }
+
+            if (i < count)
+            {
+                const auto mask = Ops::tail_mask(count - i);
+                Ops::store(outputs + i, mask, sigmoid_avx512(Ops::load(mask, inputs + i)));
+            }
+        }
+
+        template <typename Scalar>
+        AXON_TARGET_AVX512 auto tanh_fast_avx512(const Scalar* inputs, Scalar* outputs,
+                                                 std::size_t count) -> void
+        {
+            using Ops = simd::Avx512<Scalar>;
+
+            std::size_t i{0};
+            for (; i + Ops::width <= count; i += Ops::width)
+            {
+                Ops::store(outputs + i, tanh_avx512(Ops::load(inputs + i)));
+            }
+
+            if (i < count)
+            {
+                const auto mask = Ops::tail_mask(count - i);
+                Ops::store(outputs + i, mask, tanh_avx512(Ops::load(mask, inputs + i)));
+            }
+        }
+
+#endif // AXON_SIMD_X86
+
+        template <typename Scalar>
+        using FastKernel = void (*)(const Scalar* inputs, Scalar* outputs, std::size_t count);
+
+        template <typename Scalar>
+        struct FastKernels
+        {
+            FastKernel<Scalar> scalar;
+            FastKernel<Scalar> avx2;
+            FastKernel<Scalar> avx512;
+        };
+
+#if defined(AXON_SIMD_X86)
+        template <typename Scalar>
+        constexpr FastKernels<Scalar> sigmoid_kernels{
+            sigmoid_fast_scalar<Scalar>, sigmoid_fast_avx2<Scalar>, sigmoid_fast_avx512<Scalar>};
+        template <typename Scalar>
+        constexpr FastKernels<Scalar> tanh_kernels{tanh_fast_scalar<Scalar>, tanh_fast_avx2<Scalar>,
+                                                   tanh_fast_avx512<Scalar>};
+#else
+        template <typename Scalar>
+        constexpr FastKernels<Scalar> sigmoid_kernels{
+            sigmoid_fast_scalar<Scalar>, sigmoid_fast_scalar<Scalar>, sigmoid_fast_scalar<Scalar>};
+        template <typename Scalar>
+        constexpr FastKernels<Scalar> tanh_kernels{
+            tanh_fast_scalar<Scalar>, tanh_fast_scalar<Scalar>, tanh_fast_scalar<Scalar>};
+#endif
+
+        // NOTE(abi): follows the ISA chosen for the linear algebra kernels, so `set_isa` covers
+        // every vectorized path at once.
+        template <typename Scalar>
+        auto select(const FastKernels<Scalar>& candidates) -> FastKernel<Scalar>
+        {
+            switch (kernels::get_isa())
+            {
+            case kernels::Isa::avx512:
+                return candidates.avx512;
+            case kernels::Isa::avx2:
+                return candidates.avx2;
+            case kernels::Isa::scalar:
+                break;
+            }
+
+            return candidates.scalar;
+        }
+
+        template <typename Scalar>
+        auto linear_impl(std::span<const Scalar> inputs, std::span<Scalar> outputs) -> void
+        {
+            assert(inputs.size() == outputs.size());
+
+            if (inputs.data() != outputs.data())
+            {
+                std::ranges::copy(inputs, outputs.begin());
+            }
+        }
+
+        template <typename Scalar>
+        auto sigmoid_impl(std::span<const Scalar> inputs, std::span<Scalar> outputs,
+                          MathMode mode) -> void
+        {
+            assert(inputs.size() == outputs.size());
+
+            if (mode == MathMode::fast)
+            {
+                select(sigmoid_kernels<Scalar>)(inputs.data(), outputs.data(), inputs.size());
+                return;
+            }
+
+            std::ranges::transform(inputs, outputs.begin(), Sigmoid::function<Scalar>);
+        }
+
+        template <typename Scalar>
+        auto tanh_impl(std::span<const Scalar> inputs, std::span<Scalar> outputs, MathMode mode)
+            -> void
+        {
+            assert(inputs.size() == outputs.size());
+
+            if (mode == MathMode::fast)
+            {
+                select(tanh_kernels<Scalar>)(inputs.data(), outputs.data(), inputs.size());
+                return;
+            }
+
+            std::ranges::transform(inputs, outputs.begin(), Tanh::function<Scalar>);
+        }
+
+        template <typename Scalar>
+        auto relu_impl(std::span<const Scalar> inputs, std::span<Scalar> outputs) -> void
+        {
+            assert(inputs.size() == outputs.size());
+
+            std::ranges::transform(inputs, outputs.begin(), ReLU::function<Scalar>);
+        }
+
+        // Scales `gradients` in place by the policy's derivative at the matching outputs.
+        template <typename P, typename Scalar>
+        auto scale_by_derivative(std::span<const Scalar> outputs, std::span<Scalar> gradients)
+            -> void
+        {
+            assert(outputs.size() == gradients.size());
+
+            for (std::size_t i{0}; i < outputs.size(); ++i)
+            {
+                gradients[i] *= P::derivative(outputs[i]);
+            }
+        }
+
+    } // namespace
+
+    auto linear(std::span<const double> inputs, std::span<double> outputs) -> void
+    {
+        linear_impl(inputs, outputs);
+    }
+
+    auto sigmoid(std::span<const double> inputs, std::span<double> outputs, MathMode mode) -> void
+    {
+        sigmoid_impl(inputs, outputs, mode);
+    }
+
+    auto tanh(std::span<const double> inputs, std::span<double> outputs, MathMode mode) -> void
+    {
+        tanh_impl(inputs, outputs, mode);
+    }
+
+    auto relu(std::span<const double> inputs, std::span<double> outputs) -> void
+    {
+        relu_impl(inputs, outputs);
+    }
+
+    auto linear_derivative([[maybe_unused]] std::span<const double> outputs,
+                           [[maybe_unused]] std::span<double> gradients) -> void
+    {
+        assert(outputs.size() == gradients.size());
+    }
+
+    auto sigmoid_derivative(std::span<const double> outputs, std::span<double> gradients) -> void
+    {
+        scale_by_derivative<Sigmoid>(outputs, gradients);
+    }
+
+    auto tanh_derivative(std::span<const double> outputs, std::span<double> gradients) -> void
+    {
+        scale_by_derivative<Tanh>(outputs, gradients);
+    }
+
+    auto relu_derivative(std::span<const double> outputs, std::span<double> gradients) -> void
+    {
+        scale_by_derivative<ReLU>(outputs, gradients);
+    }
+
+    auto linear(std::span<const float> inputs, std::span<float> outputs) -> void
+    {
+        linear_impl(inputs, outputs);
+    }
+
+    auto sigmoid(std::span<const float> inputs, std::span<float> outputs, MathMode mode) -> void
+    {
+        sigmoid_impl(inputs, outputs, mode);
+    }
+
+    auto tanh(std::span<const float> inputs, std::span<float> outputs, MathMode mode) -> void
+    {
+        tanh_impl(inputs, outputs, mode);
+    }
+
+    auto relu(std::span<const float> inputs, std::span<float> outputs) -> void
+    {
+        relu_impl(inputs, outputs);
+    }
+
+    auto linear_derivative([[maybe_unused]] std::span<const float> outputs,
+                           [[maybe_unused]] std::span<float> gradients) -> void
+    {
+        assert(outputs.size() == gradients.size());
+    }
+
+    auto sigmoid_derivative(std::span<const float> outputs, std::span<float> gradients) -> void
+    {
+        scale_by_derivative<Sigmoid>(outputs, gradients);
+    }
+
+    auto tanh_derivative(std::span<const float> outputs, std::span<float> gradients) -> void
+    {
+        scale_by_derivative<Tanh>(outputs, gradients);
+    }
+
+    auto relu_derivative(std::span<const float> outputs, std::span<float> gradients) -> void
+    {
+        scale_by_derivative<ReLU>(outputs, gradients);
+    }
+
+} // namespace axon::activation::vectorized
@@ -0,0 +1,106 @@
+#include "arena.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace axon
+{
+
+    Arena::Arena(std::size_t size, std::pmr::memory_resource* resource)
+        : resource_(resource)
+    {
+        resize(size);
+    }
+
+    Arena::~Arena()
+    {
+        release();
+    }
+
+    Arena::Arena(const Arena& other)
+        : resource_(other.resource_)
+    {
+        *this = other;
+    }
+
+    Arena::Arena(Arena&& other) noexcept
+        : resource_(other.resource_),
+          data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    auto Arena::operator=(const Arena& other) -> Arena&
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        if (size_ != other.size_ || resource_ != other.resource_)
+        {
+            release();
+            resource_ = other.resource_;
+            resize(other.size_);
+        }
+
+        if (size_ > 0)
+        {
+            std::memcpy(data_, other.data_, size_);
+        }
+
+        return *this;
+    }
+
+    auto Arena::operator=(Arena&& other) noexcept -> Arena&
+    {
+        if (this != &other)
+        {
+            release();
+            resource_ = other.resource_;
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+
+        return *this;
+    }
+
+    auto Arena::resize(std::size_t size) -> void
+    {
+        if (size == size_)
+        {
+            return;
+        }
+
+        std::byte* data{nullptr};
+        if (size > 0)
+        {
+            data = static_cast<std::byte*>(resource_->allocate(size, cache_line_size));
+
+            const std::size_t kept = std::min(size, size_);
+            if (kept > 0)
+            {
+                std::memcpy(data, data_, kept);
+            }
+
+            std::memset(data + kept, 0, size - kept);
+        }
+
+        release();
+        data_ = data;
+        size_ = size;
+    }
+
+    auto Arena::release() noexcept -> void
+    {
+        if (data_ != nullptr)
+        {
+            resource_->deallocate(data_, size_, cache_line_size);
+        }
+
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+} // namespace axon
@@ -0,0 +1,663 @@
+#include "autograd.hpp"
+
+#include "dense.hpp"
+#include "dispatch.hpp"
+#include "kernels.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace axon::autograd
+{
+
+    using detail::dispatch;
+    using kernels::Transpose;
+
+    namespace
+    {
+        // Smallest block the arena grows by, so that small graphs settle in one block.
+        constexpr std::size_t min_block_bytes{std::size_t{64} << 10};
+
+        template <std::floating_point Scalar>
+        auto beta_for(bool has_gradient) -> Scalar
+        {
+            return has_gradient ? Scalar{1} : Scalar{0};
+        }
+
+    } // namespace
+
+    template <std::floating_point Scalar>
+    BasicTape<Scalar>::BasicTape(std::pmr::memory_resource* resource)
+        : resource_(resource),
+          nodes_(resource)
+    {
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::constant(std::span<const Scalar> values, std::size_t rows,
+                                     std::size_t cols) -> Var
+    {
+        if (values.size() != rows * cols)
+        {
+            throw std::invalid_argument("Invalid number of values.");
+        }
+
+        begin_op();
+        return push({.op = Op::constant, .rows = rows, .cols = cols, .value = values.data()});
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::parameter(std::span<const Scalar> values, std::span<Scalar> gradients,
+                                      std::size_t rows, std::size_t cols) -> Var
+    {
+        if (values.size() != rows * cols || gradients.size() != values.size())
+        {
+            throw std::invalid_argument("Invalid number of values.");
+        }
+
+        begin_op();
+        return push({.op = Op::parameter,
+                     .requires_gradient = true,
+                     .rows = rows,
+                     .cols = cols,
+                     .value = values.data(),
+                     .gradient = gradients.data()});
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::matmul(Var a, Var b) -> Var
+    {
+        begin_op();
+
+        const Node& left = node_of(a);
+        const Node& right = node_of(b);
+        if (left.cols != right.rows)
+        {
+            throw std::invalid_argument("Mismatched matrix shapes.");
+        }
+
+        const std::size_t m = left.rows;
+        const std::size_t n = right.cols;
+        const std::size_t k = left.cols;
+
+        Scalar* value = allocate(m * n);
+        kernels::gemm(Transpose::no, Transpose::no, m, n, k, Scalar{1}, left.value, k,
+                      right.value, n, Scalar{0}, value, n);
+
+        return push({.op = Op::matmul,
+                     .requires_gradient = left.requires_gradient || right.requires_gradient,
+                     .inputs = {a.index, b.index},
+                     .rows = m,
+                     .cols = n,
+                     .value = value});
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::add(Var a, Var b) -> Var
+    {
+        begin_op();
+
+        const Node& left = node_of(a);
+        const Node& right = node_of(b);
+        if (left.rows != right.rows || left.cols != right.cols)
+        {
+            throw std::invalid_argument("Mismatched matrix shapes.");
+        }
+
+        const std::size_t count = left.rows * left.cols;
+        Scalar* value = allocate(count);
+        for (std::size_t i{0}; i < count; ++i)
+        {
+            value[i] = left.value[i] + right.value[i];
+        }
+
+        return push({.op = Op::add,
+                     .requires_gradient = left.requires_gradient || right.requires_gradient,
+                     .inputs = {a.index, b.index},
+                     .rows = left.rows,
+                     .cols = left.cols,
+                     .value = value});
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::multiply(Var a, Var b) -> Var
+    {
+        begin_op();
+
+        const Node& left = node_of(a);
+        const Node& right = node_of(b);
+        if (left.rows != right.rows || left.cols != right.cols)
+        {
+            throw std::invalid_argument("Mismatched matrix shapes.");
+        }
+
+        const std::size_t count = left.rows * left.cols;
+        Scalar* value = allocate(count);
+        for (std::size_t i{0}; i < count; ++i)
+        {
+            value[i] = left.value[i] * right.value[i];
+        }
+
+        return push({.op = Op::multiply,
+                     .requires_gradient = left.requires_gradient || right.requires_gradient,
+                     .inputs = {a.index, b.index},
+                     .rows = left.rows,
+                     .cols = left.cols,
+                     .value = value});
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::add_bias(Var x, Var bias) -> Var
+    {
+        begin_op();
+
+        const Node& input = node_of(x);
+        const Node& row = node_of(bias);
+        if (row.rows != 1 || row.cols != input.cols)
+        {
+            throw std::invalid_argument("Mismatched matrix shapes.");
+        }
+
+        Scalar* value = allocate(input.rows * input.cols);
+        for (std::size_t r{0}; r < input.rows; ++r)
+        {
+            for (std::size_t c{0}; c < input.cols; ++c)
+            {
+                value[(r * input.cols) + c] = input.value[(r * input.cols) + c] + row.value[c];
+            }
+        }
+
+        return push({.op = Op::add_bias,
+                     .requires_gradient = input.requires_gradient || row.requires_gradient,
+                     .inputs = {x.index, bias.index},
+                     .rows = input.rows,
+                     .cols = input.cols,
+                     .value = value});
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::activate(Var x, const Activation& activation,
+                                     activation::MathMode mode) -> Var
+    {
+        begin_op();
+
+        const Node& input = node_of(x);
+        const std::size_t count = input.rows * input.cols;
+        Scalar* value = allocate(count);
+        const std::span<const Scalar> inputs{input.value, count};
+        const std::span<Scalar> outputs{value, count};
+        dispatch(activation,
+                 [&](const auto& policy) { policy.template apply<Scalar>(inputs, outputs, mode); });
+
+        return push({.op = Op::activate,
+                     .requires_gradient = input.requires_gradient,
+                     .mode = mode,
+                     .inputs = {x.index},
+                     .rows = input.rows,
+                     .cols = input.cols,
+                     .value = value,
+                     .descriptor = &activation});
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::linear(Var x, Var weights, Var bias, const Activation& activation,
+                                   activation::MathMode mode, std::int32_t layer) -> Var
+    {
+        begin_op();
+
+        const Node& input = node_of(x);
+        const Node& matrix = node_of(weights);
+        const Node& row = node_of(bias);
+        if (matrix.cols != input.cols || row.rows != 1 || row.cols != matrix.rows)
+        {
+            throw std::invalid_argument("Mismatched matrix shapes.");
+        }
+
+        const std::size_t batch_size = input.rows;
+        const std::size_t num_inputs = input.cols;
+        const std::size_t num_outputs = matrix.rows;
+
+        Scalar* value = allocate(batch_size * num_outputs);
+        AXON_TRACE_SCOPE(trace::Phase::forward, "tape_linear", layer,
+                         2 * batch_size * num_inputs * num_outputs,
+                         ((num_inputs + 1) * num_outputs
+                          + (batch_size * (num_inputs + num_outputs)))
+                             * sizeof(Scalar));
+        detail::dense_forward(input.value, batch_size, num_inputs, num_outputs, matrix.value,
+                              row.value, activation, mode, value);
+
+        return push({.op = Op::linear,
+                     .requires_gradient = input.requires_gradient || matrix.requires_gradient
+                                          || row.requires_gradient,
+                     .mode = mode,
+                     .layer = layer,
+                     .inputs = {x.index, weights.index, bias.index},
+                     .rows = batch_size,
+                     .cols = num_outputs,
+                     .value = value,
+                     .descriptor = &activation});
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::loss(Var prediction, std::span<const Scalar> targets,
+                                 const Criterion& criterion) -> Var
+    {
+        begin_op();
+
+        const Node& input = node_of(prediction);
+        const std::size_t count = input.rows * input.cols;
+        if (targets.size() != count)
+        {
+            throw std::invalid_argument("Invalid number of targets.");
+        }
+
+        // NOTE(abi): summed in double precision, like `BasicNetwork::loss`.
+        double error{0.0};
+        dispatch(criterion,
+                 [&](const auto& policy)
+                 {
+                     for (std::size_t i{0}; i < count; ++i)
+                     {
+                         error += policy.function(targets[i], input.value[i]);
+                     }
+                 });
+
+        Scalar* value = allocate(1);
+        value[0] = static_cast<Scalar>(error / static_cast<double>(count));
+
+        return push({.op = Op::loss,
+                     .requires_gradient = input.requires_gradient,
+                     .inputs = {prediction.index},
+                     .rows = 1,
+                     .cols = 1,
+                     .value = value,
+                     .descriptor = &criterion,
+                     .targets = targets.data()});
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::backward(Var output, Scalar seed) -> void
+    {
+        if (output.index >= nodes_.size())
+        {
+            throw std::invalid_argument("Unknown variable.");
+        }
+
+        for (auto& node : nodes_)
+        {
+            node.has_gradient = false;
+        }
+
+        if (Node& root = nodes_[output.index]; root.requires_gradient)
+        {
+            std::fill_n(root.gradient, root.rows * root.cols, seed);
+            root.has_gradient = true;
+        }
+
+        for (std::size_t index{output.index + std::size_t{1}}; index-- > 0;)
+        {
+            Node& node = nodes_[index];
+            if (node.has_gradient && node.op != Op::parameter && node.op != Op::constant)
+            {
+                backward_node(node);
+            }
+        }
+
+        for (auto& node : nodes_)
+        {
+            if (node.op == Op::parameter && !node.has_gradient)
+            {
+                std::fill_n(node.gradient, node.rows * node.cols, Scalar{0});
+            }
+        }
+
+        differentiated_ = true;
+    }
+
+    // Applies the chain rule for one node whose gradient is complete, pushing it to the inputs
+    // that take one. Activation derivatives are applied in place, so afterwards the gradient of
+    // an `activate` or `linear` node is that of its pre-activation.
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::backward_node(Node& node) -> void
+    {
+        const std::size_t count = node.rows * node.cols;
+        Scalar* gradient = node.gradient;
+
+        switch (node.op)
+        {
+        case Op::matmul:
+        {
+            Node& left = nodes_[node.inputs[0]];
+            Node& right = nodes_[node.inputs[1]];
+            const std::size_t m = node.rows;
+            const std::size_t n = node.cols;
+            const std::size_t k = left.cols;
+
+            // dA = dC * B^T, dB = A^T * dC
+            if (left.requires_gradient)
+            {
+                kernels::gemm(Transpose::no, Transpose::yes, m, k, n, Scalar{1}, gradient, n,
+                              right.value, n, beta_for<Scalar>(left.has_gradient),
+                              left.gradient, k);
+                left.has_gradient = true;
+            }
+
+            if (right.requires_gradient)
+            {
+                kernels::gemm(Transpose::yes, Transpose::no, k, n, m, Scalar{1}, left.value, k,
+                              gradient, n, beta_for<Scalar>(right.has_gradient), right.gradient,
+                              n);
+                right.has_gradient = true;
+            }
+            break;
+        }
+
+        case Op::add:
+            accumulate(nodes_[node.inputs[0]], gradient);
+            accumulate(nodes_[node.inputs[1]], gradient);
+            break;
+
+        case Op::multiply:
+        {
+            Node& left = nodes_[node.inputs[0]];
+            Node& right = nodes_[node.inputs[1]];
+            for (auto [target, other] : {std::pair{&left, &right}, std::pair{&right, &left}})
+            {
+                if (!target->requires_gradient)
+                {
+                    continue;
+                }
+
+                for (std::size_t i{0}; i < count; ++i)
+                {
+                    const Scalar product = gradient[i] * other->value[i];
+                    target->gradient[i] = target->has_gradient ? target->gradient[i] + product
+                                                               : product;
+                }
+
+                target->has_gradient = true;
+            }
+            break;
+        }
+
+        case Op::add_bias:
+        case Op::activate:
+        case Op::linear:
+        {
+            if (node.op != Op::add_bias)
+            {
+                const auto& activation = *static_cast<const Activation*>(node.descriptor);
+                const std::span<const Scalar> outputs{node.value, count};
+                const std::span<Scalar> gradients{gradient, count};
+                dispatch(activation, [&](const auto& policy)
+                         { policy.template apply_derivative<Scalar>(outputs, gradients); });
+            }
+
+            if (node.op == Op::activate)
+            {
+                accumulate(nodes_[node.inputs[0]], gradient);
+                break;
+            }
+
+            Node& input = nodes_[node.inputs[0]];
+            Node& bias = nodes_[node.inputs[node.op == Op::linear ? 2 : 1]];
+            const std::size_t batch_size = node.rows;
+            const std::size_t num_outputs = node.cols;
+
+            if (node.op == Op::add_bias)
+            {
+                accumulate(input, gradient);
+            }
+            else
+            {
+                Node& weights = nodes_[node.inputs[1]];
+                const std::size_t num_inputs = input.cols;
+
+                AXON_TRACE_SCOPE(trace::Phase::backward, "tape_linear", node.layer,
+                                 4 * batch_size * num_inputs * num_outputs,
+                                 ((num_inputs + 1) * num_outputs
+                                  + (batch_size * (num_inputs + num_outputs)))
+                                     * sizeof(Scalar));
+
+                // dW = G^T * X
+                if (weights.requires_gradient)
+                {
+                    kernels::gemm(Transpose::yes, Transpose::no, num_outputs, num_inputs,
+                                  batch_size, Scalar{1}, gradient, num_outputs, input.value,
+                                  num_inputs, beta_for<Scalar>(weights.has_gradient),
+                                  weights.gradient, num_inputs);
+                    weights.has_gradient = true;
+                }
+
+                // dX = G * W
+                if (input.requires_gradient)
+                {
+                    kernels::gemm(Transpose::no, Transpose::no, batch_size, num_inputs,
+                                  num_outputs, Scalar{1}, gradient, num_outputs, weights.value,
+                                  num_inputs, beta_for<Scalar>(input.has_gradient),
+                                  input.gradient, num_inputs);
+                    input.has_gradient = true;
+                }
+            }
+
+            if (bias.requires_gradient)
+            {
+                if (!bias.has_gradient)
+                {
+                    std::fill_n(bias.gradient, num_outputs, Scalar{0});
+                }
+
+                for (std::size_t sample{0}; sample < batch_size; ++sample)
+                {
+                    const Scalar* sample_gradients = gradient + (sample * num_outputs);
+                    for (std::size_t out{0}; out < num_outputs; ++out)
+                    {
+                        bias.gradient[out] += sample_gradients[out];
+                    }
+                }
+
+                bias.has_gradient = true;
+            }
+            break;
+        }
+
+        case Op::loss:
+        {
+            Node& input = nodes_[node.inputs[0]];
+            const std::size_t input_count = input.rows * input.cols;
+            const auto& criterion = *static_cast<const Criterion*>(node.descriptor);
+            const Scalar scale = gradient[0] / static_cast<Scalar>(input_count);
+
+            dispatch(criterion,
+                     [&](const auto& policy)
+                     {
+                         for (std::size_t i{0}; i < input_count; ++i)
+                         {
+                             const Scalar derivative =
+                                 policy.derivative(node.targets[i], input.value[i]) * scale;
+                             input.gradient[i] = input.has_gradient
+                                                     ? input.gradient[i] + derivative
+                                                     : derivative;
+                         }
+                     });
+
+            input.has_gradient = true;
+            break;
+        }
+
+        case Op::constant:
+        case Op::parameter:
+            break;
+        }
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::accumulate(Node& node, const Scalar* values) -> void
+    {
+        if (!node.requires_gradient)
+        {
+            return;
+        }
+
+        const std::size_t count = node.rows * node.cols;
+        if (node.has_gradient)
+        {
+            for (std::size_t i{0}; i < count; ++i)
+            {
+                node.gradient[i] += values[i];
+            }
+        }
+        else
+        {
+            std::copy_n(values, count, node.gradient);
+            node.has_gradient = true;
+        }
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::reset() -> void
+    {
+        nodes_.clear();
+
+        // NOTE(abi): a graph that outgrew the arena left it in several blocks; merging them
+        // into one of the combined size means the same graph fits without growing next time.
+        if (blocks_.size() > 1)
+        {
+            std::size_t total{0};
+            for (const auto& block : blocks_)
+            {
+                total += block.size();
+            }
+
+            blocks_.clear();
+            blocks_.emplace_back(total, resource_);
+        }
+
+        offset_ = 0;
+        differentiated_ = false;
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::value(Var var) const -> std::span<const Scalar>
+    {
+        const Node& node = node_of(var);
+        return {node.value, node.rows * node.cols};
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::gradient(Var var) const -> std::span<const Scalar>
+    {
+        const Node& node = node_of(var);
+        if (!node.requires_gradient || !node.has_gradient)
+        {
+            return {};
+        }
+
+        return {node.gradient, node.rows * node.cols};
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::get_capacity() const -> std::size_t
+    {
+        std::size_t total{0};
+        for (const auto& block : blocks_)
+        {
+            total += block.size();
+        }
+
+        return total;
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::begin_op() -> void
+    {
+        if (differentiated_)
+        {
+            reset();
+        }
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::allocate(std::size_t count) -> Scalar*
+    {
+        const std::size_t bytes = padded_size<Scalar>(count) * sizeof(Scalar);
+        if (blocks_.empty() || offset_ + bytes > blocks_.back().size())
+        {
+            const std::size_t previous = blocks_.empty() ? 0 : blocks_.back().size();
+            blocks_.emplace_back(std::max({bytes, 2 * previous, min_block_bytes}), resource_);
+            offset_ = 0;
+        }
+
+        Scalar* pointer = blocks_.back().template view<Scalar>(offset_, count).data();
+        offset_ += bytes;
+        return pointer;
+    }
+
+    // Gives nodes that take a gradient their buffer; parameters bring their own.
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::push(Node node) -> Var
+    {
+        if (nodes_.size() >= std::numeric_limits<std::uint32_t>::max())
+        {
+            throw std::runtime_error("Too many nodes on the tape.");
+        }
+
+        if (node.requires_gradient && node.gradient == nullptr)
+        {
+            node.gradient = allocate(node.rows * node.cols);
+        }
+
+        nodes_.push_back(node);
+        return Var{static_cast<std::uint32_t>(nodes_.size() - 1)};
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicTape<Scalar>::node_of(Var var) const -> const Node&
+    {
+        if (var.index >= nodes_.size())
+        {
+            throw std::invalid_argument("Unknown variable.");
+        }
+
+        return nodes_[var.index];
+    }
+
+    template <std::floating_point Scalar>
+    auto record(BasicTape<Scalar>& tape, const BasicNetwork<Scalar>& network,
+                std::type_identity_t<std::span<const Scalar>> inputs, std::size_t batch_size,
+                BasicWorkspace<Scalar>& gradients) -> Var
+    {
+        const auto& layers = network.get_layers();
+        if (batch_size == 0 || inputs.size() != batch_size * layers.front().num_inputs)
+        {
+            throw std::invalid_argument("Invalid number of inputs.");
+        }
+
+        Var x = tape.constant(inputs, batch_size, layers.front().num_inputs);
+        for (std::size_t layer_idx{0}; layer_idx < layers.size(); ++layer_idx)
+        {
+            const auto& layer = layers[layer_idx];
+            auto& state = gradients.layers[layer_idx];
+
+            const Var weights = tape.parameter(layer.weights, state.weight_gradients,
+                                               layer.num_outputs, layer.num_inputs);
+            const Var biases = tape.parameter(layer.biases, state.bias_gradients, 1,
+                                              layer.num_outputs);
+            x = tape.linear(x, weights, biases, network.get_activation(),
+                            network.get_math_mode(), trace::layer_id(layer_idx));
+        }
+
+        return x;
+    }
+
+    template class BasicTape<float>;
+    template class BasicTape<double>;
+
+    template auto record(BasicTape<float>&, const BasicNetwork<float>&, std::span<const float>,
+                         std::size_t, BasicWorkspace<float>&) -> Var;
+    template auto record(BasicTape<double>&, const BasicNetwork<double>&,
+                         std::span<const double>, std::size_t, BasicWorkspace<double>&) -> Var;
+
+} // namespace axon::autograd
@@ -0,0 +1,223 @@
+#include "batcher.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+namespace axon
+{
+
+    namespace
+    {
+        // Latency below which `quantile` of the sorted samples fall.
+        auto percentile(const std::vector<std::int64_t>& sorted, double quantile)
+            -> std::chrono::nanoseconds
+        {
+            if (sorted.empty())
+            {
+                return std::chrono::nanoseconds{0};
+            }
+
+            const auto rank = static_cast<std::size_t>(quantile
+                                                       * static_cast<double>(sorted.size() - 1));
+            return std::chrono::nanoseconds{sorted[rank]};
+        }
+
+    } // namespace
+
+    template <std::floating_point Scalar>
+    BasicBatcher<Scalar>::BasicBatcher(const BasicNetwork<Scalar>& network,
+                                       const BatcherOptions& options)
+        : options_(options),
+          num_inputs_(network.get_layers().front().num_inputs),
+          num_outputs_(network.get_layers().back().num_outputs),
+          session_(network, options.max_batch_size)
+    {
+        if (options_.max_batch_size == 0)
+        {
+            throw std::invalid_argument("The maximum batch size must be positive.");
+        }
+
+        options_.latency_window = std::max<std::size_t>(options_.latency_window, 1);
+
+        batch_.reserve(options_.max_batch_size);
+        inputs_.resize(options_.max_batch_size * num_inputs_);
+        outputs_.resize(options_.max_batch_size * num_outputs_);
+        batch_sizes_.assign(options_.max_batch_size + 1, 0);
+        latencies_.reserve(options_.latency_window);
+
+        dispatcher_ = std::thread([this] { dispatch_loop(); });
+    }
+
+    template <std::floating_point Scalar>
+    BasicBatcher<Scalar>::~BasicBatcher()
+    {
+        {
+            const std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+
+        changed_.notify_all();
+        dispatcher_.join();
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicBatcher<Scalar>::submit(std::span<const Scalar> input)
+        -> std::future<std::vector<Scalar>>
+    {
+        if (input.size() != num_inputs_)
+        {
+            throw std::invalid_argument("Invalid number of inputs.");
+        }
+
+        Request request{.input = {input.begin(), input.end()},
+                        .output = {},
+                        .submitted = Clock::now()};
+        auto output = request.output.get_future();
+
+        // NOTE(abi): the dispatcher only needs waking for the first request of a batch, which
+        // starts its deadline, and for the one that fills it.
+        bool wake{false};
+        {
+            const std::lock_guard lock(mutex_);
+            queue_.push_back(std::move(request));
+            max_queue_depth_ = std::max(max_queue_depth_, queue_.size());
+            wake = queue_.size() == 1 || queue_.size() >= options_.max_batch_size;
+        }
+
+        if (wake)
+        {
+            changed_.notify_one();
+        }
+
+        return output;
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicBatcher<Scalar>::get_stats() const -> BatcherStats
+    {
+        BatcherStats stats;
+        std::vector<std::int64_t> latencies;
+        {
+            const std::lock_guard lock(mutex_);
+            stats.num_requests = num_requests_;
+            stats.num_batches = num_batches_;
+            stats.queue_depth = queue_.size();
+            stats.max_queue_depth = max_queue_depth_;
+            stats.batch_sizes = batch_sizes_;
+            latencies = latencies_;
+        }
+
+        std::ranges::sort(latencies);
+        stats.p50 = percentile(latencies, 0.5);
+        stats.p90 = percentile(latencies, 0.9);
+        stats.p99 = percentile(latencies, 0.99);
+        stats.max = percentile(latencies, 1.0);
+        return stats;
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicBatcher<Scalar>::dispatch_loop() -> void
+    {
+        std::unique_lock lock(mutex_);
+        while (true)
+        {
+            changed_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty())
+            {
+                return;
+            }
+
+            const auto deadline = queue_.front().submitted + options_.max_wait;
+            changed_.wait_until(lock, deadline, [&]
+                                { return stopping_ || queue_.size() >= options_.max_batch_size; });
+
+            const std::size_t size = std::min(queue_.size(), options_.max_batch_size);
+            for (std::size_t i{0}; i < size; ++i)
+            {
+                batch_.push_back(std::move(queue_.front()));
+                queue_.pop_front();
+            }
+
+            lock.unlock();
+            const std::exception_ptr error = run_batch();
+            const auto completed = Clock::now();
+            lock.lock();
+
+            for (const auto& request : batch_)
+            {
+                const std::int64_t latency =
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(completed
+                                                                         - request.submitted)
+                        .count();
+                if (latencies_.size() < options_.latency_window)
+                {
+                    latencies_.push_back(latency);
+                }
+                else
+                {
+                    latencies_[latency_cursor_] = latency;
+                }
+
+                latency_cursor_ = (latency_cursor_ + 1) % options_.latency_window;
+            }
+
+            num_requests_ += size;
+            ++num_batches_;
+            ++batch_sizes_[size];
+
+            // NOTE(abi): the futures are fulfilled after the stats are updated, so a caller
+            // holding its result always finds it counted.
+            lock.unlock();
+            deliver(error);
+            lock.lock();
+        }
+    }
+
+    // Gathers the inputs of `batch_` into one matrix and runs it.
+    template <std::floating_point Scalar>
+    auto BasicBatcher<Scalar>::run_batch() -> std::exception_ptr
+    {
+        const std::size_t size = batch_.size();
+        for (std::size_t row{0}; row < size; ++row)
+        {
+            std::ranges::copy(batch_[row].input, inputs_.begin() + (row * num_inputs_));
+        }
+
+        try
+        {
+            session_.forward(std::span<const Scalar>{inputs_}.first(size * num_inputs_), size,
+                             std::span<Scalar>{outputs_}.first(size * num_outputs_));
+        }
+        catch (...)
+        {
+            return std::current_exception();
+        }
+
+        return nullptr;
+    }
+
+    // Hands every request of `batch_` its row of the outputs, or the error of the batch.
+    template <std::floating_point Scalar>
+    auto BasicBatcher<Scalar>::deliver(const std::exception_ptr& error) -> void
+    {
+        for (std::size_t row{0}; row < batch_.size(); ++row)
+        {
+            if (error)
+            {
+                batch_[row].output.set_exception(error);
+                continue;
+            }
+
+            const auto first = outputs_.begin() + (row * num_outputs_);
+            batch_[row].output.set_value({first, first + num_outputs_});
+        }
+
+        batch_.clear();
+    }
+
+    template class BasicBatcher<float>;
+    template class BasicBatcher<double>;
+
+} // namespace axon
@@ -0,0 +1,358 @@
+#include "checkpoint.hpp"
+
+#include "format.hpp"
+#include "mapped_file.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+
+namespace axon
+{
+
+    namespace
+    {
+
+        // Whether `layout`, made for `layer_sizes`, still fits the network and optimizer.
+        template <std::floating_point Scalar>
+        auto layout_matches(const detail::Layout& layout,
+                            const std::vector<std::size_t>& layer_sizes,
+                            const BasicNetwork<Scalar>& network,
+                            const OptimizerState<Scalar>* optimizer) -> bool
+        {
+            const auto& layers = network.get_layers();
+            if (layer_sizes.size() != layers.size() + 1
+                || layer_sizes.front() != layers.front().num_inputs
+                || layout.has_masks == network.get_mask(0).empty()
+                || layout.has_optimizer != (optimizer != nullptr)
+                || (optimizer != nullptr
+                    && layout.num_optimizer_values != optimizer->values.size()))
+            {
+                return false;
+            }
+
+            return std::ranges::equal(layer_sizes | std::views::drop(1), layers, {}, {},
+                                      &BasicNetwork<Scalar>::Layer::num_outputs);
+        }
+
+        // Rebuilds `layout` and `layer_sizes` unless they still fit; returns whether it did.
+        template <std::floating_point Scalar>
+        auto update_layout(const BasicNetwork<Scalar>& network,
+                           const OptimizerState<Scalar>* optimizer, detail::Layout& layout,
+                           std::vector<std::size_t>& layer_sizes) -> bool
+        {
+            if (layout_matches(layout, layer_sizes, network, optimizer))
+            {
+                return false;
+            }
+
+            layer_sizes = detail::layer_sizes_of(network);
+            layout = detail::make_layout(
+                detail::FileKind::checkpoint, layer_sizes, sizeof(Scalar),
+                !network.get_mask(0).empty(),
+                optimizer != nullptr ? std::optional{optimizer->values.size()} : std::nullopt);
+            return true;
+        }
+
+        // Writes the whole training state into `bytes`, which must span `layout.file_bytes`
+        // bytes, zeroed the first time.
+        template <std::floating_point Scalar>
+        auto snapshot(const BasicNetwork<Scalar>& network,
+                      const OptimizerState<Scalar>* optimizer, const TrainingState& state,
+                      const detail::Layout& layout, std::span<std::byte> bytes) -> void
+        {
+            detail::write_network(detail::FileKind::checkpoint, network, layout, bytes);
+            std::memcpy(bytes.data() + layout.state_offset, &state, sizeof(state));
+
+            if (optimizer != nullptr)
+            {
+                const std::array<std::uint64_t, 2> counts{optimizer->num_steps,
+                                                          optimizer->values.size()};
+                std::memcpy(bytes.data() + layout.optimizer_offset, counts.data(),
+                            sizeof(counts));
+                std::memcpy(bytes.data() + layout.optimizer_values, optimizer->values.data(),
+                            optimizer->values.size_bytes());
+            }
+        }
+
+    } // namespace
+
+    namespace detail
+    {
+
+        template <std::floating_point Scalar>
+        auto save_checkpoint(const BasicNetwork<Scalar>& network,
+                             const OptimizerState<Scalar>* optimizer, const TrainingState& state,
+                             const std::filesystem::path& path) -> void
+        {
+            Layout layout;
+            std::vector<std::size_t> layer_sizes;
+            update_layout(network, optimizer, layout, layer_sizes);
+
+            std::vector<std::byte> bytes(layout.file_bytes);
+            snapshot(network, optimizer, state, layout, bytes);
+            seal(bytes);
+            write_file_atomically(path, bytes);
+        }
+
+        template <std::floating_point Scalar>
+        auto restore_checkpoint(const MappedFile& file, BasicNetwork<Scalar>& network,
+                                OptimizerState<Scalar>* optimizer,
+                                serialization::Verification verification) -> TrainingState
+        {
+            const auto bytes = file.bytes();
+            const auto checkpoint = parse(FileKind::checkpoint, bytes, sizeof(Scalar), verification);
+
+            if (checkpoint.layer_sizes != layer_sizes_of(network))
+            {
+                throw std::invalid_argument("The checkpoint was taken from another topology.");
+            }
+
+            if (optimizer != nullptr && !checkpoint.layout.has_optimizer)
+            {
+                throw std::invalid_argument("The checkpoint holds no optimizer state.");
+            }
+
+            auto& layers = network.get_layers();
+            for (std::size_t layer_idx{0}; layer_idx < layers.size(); ++layer_idx)
+            {
+                auto& layer = layers[layer_idx];
+                const auto& blocks = checkpoint.layout.layers[layer_idx];
+
+                const auto read_block = [&](std::size_t offset, std::span<Scalar> values)
+                {
+                    std::ranges::copy(block<Scalar>(bytes, offset, values.size()),
+                                      values.begin());
+                };
+
+                read_block(blocks.weights, layer.weights);
+                read_block(blocks.biases, layer.biases);
+                read_block(blocks.weight_velocity, layer.weight_velocity);
+                read_block(blocks.bias_velocity, layer.bias_velocity);
+            }
+
+            // NOTE(abi): set last, so the sparse copies are rebuilt from the restored weights.
+            std::vector<std::vector<std::uint8_t>> masks;
+            if (checkpoint.layout.has_masks)
+            {
+                for (std::size_t layer_idx{0}; layer_idx < layers.size(); ++layer_idx)
+                {
+                    const auto* mask = reinterpret_cast<const std::uint8_t*>(
+                        bytes.data() + checkpoint.layout.layers[layer_idx].mask);
+                    masks.emplace_back(mask, mask + layers[layer_idx].weights.size());
+                }
+            }
+            network.set_masks(std::move(masks));
+
+            if (optimizer != nullptr)
+            {
+                std::uint64_t num_steps{0};
+                std::memcpy(&num_steps, bytes.data() + checkpoint.layout.optimizer_offset,
+                            sizeof(num_steps));
+                optimizer->num_steps = static_cast<std::size_t>(num_steps);
+                optimizer->values = block<Scalar>(bytes, checkpoint.layout.optimizer_values,
+                                                  checkpoint.layout.num_optimizer_values);
+            }
+
+            TrainingState state;
+            std::memcpy(&state, bytes.data() + checkpoint.layout.state_offset, sizeof(state));
+            return state;
+        }
+
+        template auto save_checkpoint(const BasicNetwork<float>&, const OptimizerState<float>*,
+                                      const TrainingState&, const std::filesystem::path&)
+            -> void;
+        template auto save_checkpoint(const BasicNetwork<double>&, const OptimizerState<double>*,
+                                      const TrainingState&, const std::filesystem::path&)
+            -> void;
+        template auto restore_checkpoint(const MappedFile&, BasicNetwork<float>&,
+                                         OptimizerState<float>*, serialization::Verification)
+            -> TrainingState;
+        template auto restore_checkpoint(const MappedFile&, BasicNetwork<double>&,
+                                         OptimizerState<double>*, serialization::Verification)
+            -> TrainingState;
+
+    } // namespace detail
+
+    template <std::floating_point Scalar>
+    struct BasicCheckpointer<Scalar>::CachedLayout
+    {
+        detail::Layout layout;
+        std::vector<std::size_t> layer_sizes;
+    };
+
+    template <std::floating_point Scalar>
+    BasicCheckpointer<Scalar>::BasicCheckpointer(std::filesystem::path path)
+        : path_(std::move(path))
+    {
+        for (auto& buffer : buffers_)
+        {
+            buffer.layout = std::make_unique<CachedLayout>();
+        }
+
+        writer_ = std::thread([this] { writer_loop(); });
+    }
+
+    template <std::floating_point Scalar>
+    BasicCheckpointer<Scalar>::~BasicCheckpointer()
+    {
+        {
+            const std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+
+        changed_.notify_all();
+        writer_.join();
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicCheckpointer<Scalar>::save(const BasicNetwork<Scalar>& network,
+                                         const OptimizerState<Scalar>* optimizer,
+                                         const TrainingState& state) -> void
+    {
+        Buffer* buffer{nullptr};
+        {
+            const std::lock_guard lock(mutex_);
+            rethrow_error();
+
+            // NOTE(abi): the writer holds at most one buffer, so the other one is either free or
+            // holds a snapshot that has not been picked up yet and is now out of date.
+            for (auto& candidate : buffers_)
+            {
+                if (candidate.state == BufferState::pending)
+                {
+                    ++num_superseded_;
+                    buffer = &candidate;
+                    break;
+                }
+
+                if (candidate.state == BufferState::free && buffer == nullptr)
+                {
+                    buffer = &candidate;
+                }
+            }
+
+            buffer->state = BufferState::filling;
+        }
+
+        try
+        {
+            // NOTE(abi): only a change of topology, pruning or optimizer reallocates, so
+            // steady-state snapshots never allocate.
+            auto& [layout, layer_sizes] = *buffer->layout;
+            if (update_layout(network, optimizer, layout, layer_sizes))
+            {
+                buffer->bytes.assign(layout.file_bytes, std::byte{0});
+            }
+
+            snapshot(network, optimizer, state, layout, buffer->bytes);
+        }
+        catch (...)
+        {
+            const std::lock_guard lock(mutex_);
+            buffer->state = BufferState::free;
+            throw;
+        }
+
+        {
+            const std::lock_guard lock(mutex_);
+            buffer->state = BufferState::pending;
+        }
+
+        changed_.notify_all();
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicCheckpointer<Scalar>::wait() -> void
+    {
+        std::unique_lock lock(mutex_);
+        changed_.wait(lock,
+                      [&]
+                      {
+                          return std::ranges::all_of(buffers_, [](const Buffer& buffer)
+                                                     { return buffer.state == BufferState::free; });
+                      });
+
+        rethrow_error();
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicCheckpointer<Scalar>::get_num_written() const -> std::size_t
+    {
+        const std::lock_guard lock(mutex_);
+        return num_written_;
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicCheckpointer<Scalar>::get_num_superseded() const -> std::size_t
+    {
+        const std::lock_guard lock(mutex_);
+        return num_superseded_;
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicCheckpointer<Scalar>::writer_loop() -> void
+    {
+        std::unique_lock lock(mutex_);
+        while (true)
+        {
+            const auto pending = [&]
+            {
+                return std::ranges::find(buffers_, BufferState::pending, &Buffer::state);
+            };
+
+            changed_.wait(lock, [&] { return stopping_ || pending() != buffers_.end(); });
+
+            const auto buffer = pending();
+            if (buffer == buffers_.end())
+            {
+                return;
+            }
+
+            buffer->state = BufferState::writing;
+            lock.unlock();
+
+            std::exception_ptr error;
+            try
+            {
+                detail::seal(buffer->bytes);
+                write_file_atomically(path_, buffer->bytes);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            buffer->state = BufferState::free;
+            if (error)
+            {
+                error_ = error;
+            }
+            else
+            {
+                ++num_written_;
+            }
+
+            changed_.notify_all();
+        }
+    }
+
+    // Called with the mutex held.
+    template <std::floating_point Scalar>
+    auto BasicCheckpointer<Scalar>::rethrow_error() -> void
+    {
+        if (error_)
+        {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+    template class BasicCheckpointer<float>;
+    template class BasicCheckpointer<double>;
+
+} // namespace axon
@@ -0,0 +1,1094 @@
+#include "conv.hpp"
+
+#include "kernels.hpp"
+#include "layer.hpp"
+#include "scheduler.hpp"
+#include "simd.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace axon
+{
+
+    using kernels::Transpose;
+
+    namespace
+    {
+        // Largest number of input channels for which `automatic` runs 3 x 3 convolutions with
+        // the direct kernel. Past it, the GEMM's register blocking over output channels wins
+        // despite the nine-fold larger im2col matrix: at 16 channels the direct kernel still
+        // wins on 64 x 64 images but loses on 28 x 28 ones.
+        constexpr std::size_t max_direct_channels{8};
+
+        auto check_nchw(const Shape& shape, std::size_t channels) -> void
+        {
+            if (shape.rank() != 4 || shape[0] == 0 || shape[1] != channels)
+            {
+                throw std::invalid_argument("Invalid tensor shape.");
+            }
+        }
+
+        auto check_output(const Shape& shape, const Shape& expected) -> void
+        {
+            if (!(shape == expected))
+            {
+                throw std::invalid_argument("Invalid output tensor shape.");
+            }
+        }
+
+        // Scratch buffers only grow, so repeated passes over the same shapes never allocate.
+        template <typename Scalar>
+        auto reserve(AlignedVector<Scalar>& buffer, std::size_t count) -> Scalar*
+        {
+            if (buffer.size() < count)
+            {
+                buffer.resize(count);
+            }
+
+            return buffer.data();
+        }
+
+        // Writes `value` to every element of the `num_planes` planes of `plane_size` elements
+        // in `planes`, one value per plane of `values`, or zeros without them.
+        template <typename Scalar>
+        auto fill_planes(Scalar* planes, std::size_t num_planes, std::size_t plane_size,
+                         const Scalar* values) -> void
+        {
+            for (std::size_t plane{0}; plane < num_planes; ++plane)
+            {
+                std::fill_n(planes + (plane * plane_size), plane_size,
+                            values == nullptr ? Scalar{0} : values[plane]);
+            }
+        }
+
+        // sums[c] = sum of plane `c` over every sample of an N x C x spatial tensor.
+        template <typename Scalar>
+        auto sum_planes(const Scalar* gradients, std::size_t batch_size, std::size_t channels,
+                        std::size_t spatial, Scalar* sums) -> void
+        {
+            std::fill_n(sums, channels, Scalar{0});
+            for (std::size_t sample{0}; sample < batch_size; ++sample)
+            {
+                for (std::size_t channel{0}; channel < channels; ++channel)
+                {
+                    const Scalar* plane = gradients + (((sample * channels) + channel) * spatial);
+                    Scalar sum{0};
+                    for (std::size_t i{0}; i < spatial; ++i)
+                    {
+                        sum += plane[i];
+                    }
+
+                    sums[channel] += sum;
+                }
+            }
+        }
+
+        // Range of output columns `[begin, end)` whose tap `kx` lands inside an input row of
+        // `width` pixels.
+        struct ColumnRange
+        {
+            std::size_t begin{0};
+            std::size_t end{0};
+        };
+
+        auto valid_columns(std::size_t out_width, std::size_t width, std::size_t kx,
+                           std::size_t stride, std::size_t padding) -> ColumnRange
+        {
+            const std::size_t begin = kx >= padding ? 0 : (padding - kx + stride - 1) / stride;
+            const std::size_t end = width + padding <= kx
+                                        ? 0
+                                        : (width + padding - kx + stride - 1) / stride;
+            return {std::min(begin, out_width), std::min(end, out_width)};
+        }
+
+        // Direct 3 x 3 convolution. Each call computes one output plane of a valid (unpadded)
+        // convolution over `channels` planes of `padded_height x padded_width` that the caller
+        // zero-padded, so the inner loops need no bounds checks. `weights` holds the
+        // `channels x 3 x 3` taps of the output channel.
+
+        template <typename Scalar>
+        auto direct_pixel(const Scalar* base, std::size_t channels, std::size_t plane_size,
+                          std::size_t padded_width, const Scalar* weights, Scalar bias) -> Scalar
+        {
+            Scalar sum = bias;
+            for (std::size_t channel{0}; channel < channels; ++channel)
+            {
+                for (std::size_t ky{0}; ky < 3; ++ky)
+                {
+                    const Scalar* source = base + (channel * plane_size) + (ky * padded_width);
+                    const Scalar* taps = weights + (channel * 9) + (ky * 3);
+                    sum += (taps[0] * source[0]) + (taps[1] * source[1]) + (taps[2] * source[2]);
+                }
+            }
+
+            return sum;
+        }
+
+        template <typename Scalar>
+        auto direct_scalar(const Scalar* planes, std::size_t channels, std::size_t padded_height,
+                           std::size_t padded_width, const Scalar* weights, Scalar bias,
+                           Scalar* output) -> void
+        {
+            const std::size_t out_height = padded_height - 2;
+            const std::size_t out_width = padded_width - 2;
+            const std::size_t plane_size = padded_height * padded_width;
+
+            for (std::size_t oy{0}; oy < out_height; ++oy)
+            {
+                Scalar* row = output + (oy * out_width);
+                std::fill_n(row, out_width, bias);
+                for (std::size_t channel{0}; channel < channels; ++channel)
+                {
+                    for (std::size_t ky{0}; ky < 3; ++ky)
+                    {
+                        const Scalar* source =
+                            planes + (channel * plane_size) + ((oy + ky) * padded_width);
+                        const Scalar* taps = weights + (channel * 9) + (ky * 3);
+                        for (std::size_t ox{0}; ox < out_width; ++ox)
+                        {
+                            row[ox] += (taps[0] * source[ox]) + (taps[1] * source[ox + 1])
+                                       + (taps[2] * source[ox + 2]);
+                        }
+                    }
+                }
+            }
+        }
+
+#if defined(AXON_SIMD_X86)
+
+        // `Count` vectors of adjacent output pixels, each accumulated in its own register so
+        // that the chains of multiply-adds overlap. Always inlined, so the registers survive.
+        template <typename Scalar, std::size_t Count>
+        AXON_SIMD_AVX2 inline auto direct_block_avx2(const Scalar* base, std::size_t channels,
+                                                std::size_t plane_size, std::size_t padded_width,
+                                                const Scalar* weights, Scalar bias,
+                                                Scalar* output) -> void
+        {
+            using Ops = simd::Avx2<Scalar>;
+
+            typename Ops::Vector sums[Count]; // NOLINT(*-avoid-c-arrays)
+            for (std::size_t v{0}; v < Count; ++v)
+            {
+                sums[v] = Ops::broadcast(bias);
+            }
+
+            for (std::size_t channel{0}; channel < channels; ++channel)
+            {
+                for (std::size_t ky{0}; ky < 3; ++ky)
+                {
+                    const Scalar* source = base + (channel * plane_size) + (ky * padded_width);
+                    const Scalar* taps = weights + (channel * 9) + (ky * 3);
+                    for (std::size_t kx{0}; kx < 3; ++kx)
+                    {
+                        const auto tap = Ops::broadcast(taps[kx]);
+                        for (std::size_t v{0}; v < Count; ++v)
+                        {
+                            sums[v] = Ops::fmadd(tap, Ops::load(source + kx + (v * Ops::width)),
+                                                 sums[v]);
+                        }
+                    }
+                }
+            }
+
+            for (std::size_t v{0}; v < Count; ++v)
+            {
+                Ops::store(output + (v * Ops::width), sums[v]);
+            }
+        }
+
+        template <typename Scalar>
+        AXON_TARGET_AVX2 auto direct_avx2(const Scalar* planes, std::size_t channels,
+                                          std::size_t padded_height, std::size_t padded_width,
+                                          const Scalar* weights, Scalar bias, Scalar* output)
+            -> void
+        {
+            using Ops = simd::Avx2<Scalar>;
+
+            const std::size_t out_height = padded_height - 2;
+            const std::size_t out_width = padded_width - 2;
+            const std::size_t plane_size = padded_height * padded_width;
+
+            for (std::size_t oy{0}; oy < out_height; ++oy)
+            {
+                const Scalar* base = planes + (oy * padded_width);
+                Scalar* row = output + (oy * out_width);
+
+                std::size_t ox{0};
+                for (; ox + (4 * Ops::width) <= out_width; ox += 4 * Ops::width)
+                {
+                    direct_block_avx2<Scalar, 4>(base + ox, channels, plane_size, padded_width,
+                                                 weights, bias, row + ox);
+                }
+
+                for (; ox + Ops::width <= out_width; ox += Ops::width)
+                {
+                    direct_block_avx2<Scalar, 1>(base + ox, channels, plane_size, padded_width,
+                                                 weights, bias, row + ox);
+                }
+
+                for (; ox < out_width; ++ox)
+                {
+                    row[ox] =
+                        direct_pixel(base + ox, channels, plane_size, padded_width, weights, bias);
+                }
+            }
+        }
+
+        template <typename Scalar, std::size_t Count>
+        AXON_SIMD_AVX512 inline auto direct_block_avx512(const Scalar* base, std::size_t channels,
+                                                    std::size_t plane_size,
+                                                    std::size_t padded_width,
+                                                    const Scalar* weights, Scalar bias,
+                                                    typename simd::Avx512<Scalar>::Mask tail,
+                                                    Scalar* output) -> void
+        {
+            using Ops = simd::Avx512<Scalar>;
+            constexpr auto full = static_cast<typename Ops::Mask>(~0U);
+
+            typename Ops::Vector sums[Count]; // NOLINT(*-avoid-c-arrays)
+            for (std::size_t v{0}; v < Count; ++v)
+            {
+                sums[v] = Ops::broadcast(bias);
+            }
+
+            for (std::size_t channel{0}; channel < channels; ++channel)
+            {
+                for (std::size_t ky{0}; ky < 3; ++ky)
+                {
+                    const Scalar* source = base + (channel * plane_size) + (ky * padded_width);
+                    const Scalar* taps = weights + (channel * 9) + (ky * 3);
+                    for (std::size_t kx{0}; kx < 3; ++kx)
+                    {
+                        const auto tap = Ops::broadcast(taps[kx]);
+                        for (std::size_t v{0}; v < Count; ++v)
+                        {
+                            const auto mask = v + 1 == Count ? tail : full;
+                            sums[v] = Ops::fmadd(
+                                tap, Ops::load(mask, source + kx + (v * Ops::width)), sums[v]);
+                        }
+                    }
+                }
+            }
+
+            for (std::size_t v{0}; v < Count; ++v)
+            {
+                Ops::store(output + (v * Ops::width), v + 1 == Count ? tail : full, sums[v]);
+            }
+        }
+
+        // NOTE(abi): only the last vector of a block is masked, so a row ending in a partial
+        // vector needs no scalar tail.
+        template <typename Scalar>
+        AXON_TARGET_AVX512 auto direct_avx512(const Scalar* planes, std::size_t channels,
+                                              std::size_t padded_height,
+                                              std::size_t padded_width, const Scalar* weights,
+                                              Scalar bias, Scalar* output) -> void
+        {
+            using Ops = simd::Avx512<Scalar>;
+            constexpr auto full = static_cast<typename Ops::Mask>(~0U);
+
+            const std::size_t out_height = padded_height - 2;
+            const std::size_t out_width = padded_width - 2;
+            const std::size_t plane_size = padded_height * padded_width;
+
+            for (std::size_t oy{0}; oy < out_height; ++oy)
+            {
+                const Scalar* base = planes + (oy * padded_width);
+                Scalar* row = output + (oy * out_width);
+
+                std::size_t ox{0};
+                for (; ox + (4 * Ops::width) <= out_width; ox += 4 * Ops::width)
+                {
+                    direct_block_avx512<Scalar, 4>(base + ox, channels, plane_size, padded_width,
+                                                   weights, bias, full, row + ox);
+                }
+
+                for (; ox < out_width; ox += Ops::width)
+                {
+                    const auto mask = out_width - ox >= Ops::width ? full
+                                                                   : Ops::tail_mask(out_width - ox);
+                    direct_block_avx512<Scalar, 1>(base + ox, channels, plane_size, padded_width,
+                                                   weights, bias, mask, row + ox);
+                }
+            }
+        }
+
+#endif // AXON_SIMD_X86
+
+        template <typename Scalar>
+        using DirectKernel = void (*)(const Scalar*, std::size_t, std::size_t, std::size_t,
+                                      const Scalar*, Scalar, Scalar*);
+
+        template <typename Scalar>
+        auto select_direct() -> DirectKernel<Scalar>
+        {
+#if defined(AXON_SIMD_X86)
+            switch (kernels::get_isa())
+            {
+            case kernels::Isa::avx512:
+                return direct_avx512<Scalar>;
+            case kernels::Isa::avx2:
+                return direct_avx2<Scalar>;
+            case kernels::Isa::scalar:
+                break;
+            }
+#endif
+
+            return direct_scalar<Scalar>;
+        }
+
+        // Copies `num_planes` planes of `height x width` into planes with `padding` zeros on
+        // every side.
+        template <typename Scalar>
+        auto pad_planes(const Scalar* planes, std::size_t num_planes, std::size_t height,
+                        std::size_t width, std::size_t padding, Scalar* padded) -> void
+        {
+            const std::size_t padded_width = width + (2 * padding);
+            const std::size_t padded_size = (height + (2 * padding)) * padded_width;
+
+            Scheduler::instance().parallel_for(
+                num_planes, grain_size(padded_size),
+                [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t plane{begin}; plane < end; ++plane)
+                    {
+                        Scalar* destination = padded + (plane * padded_size);
+                        std::fill_n(destination, padding * padded_width, Scalar{0});
+                        destination += padding * padded_width;
+
+                        const Scalar* source = planes + (plane * height * width);
+                        for (std::size_t y{0}; y < height; ++y)
+                        {
+                            std::fill_n(destination, padding, Scalar{0});
+                            std::copy_n(source + (y * width), width, destination + padding);
+                            std::fill_n(destination + padding + width, padding, Scalar{0});
+                            destination += padded_width;
+                        }
+
+                        std::fill_n(destination, padding * padded_width, Scalar{0});
+                    }
+                });
+        }
+
+        // 3 x 3, stride 1 convolution of a batch of zero-padded images, one task per output
+        // plane. `weights` is `out_channels x channels x 3 x 3`; `biases` may be null.
+        template <typename Scalar>
+        auto direct_conv(const Scalar* padded, std::size_t batch_size, std::size_t channels,
+                         std::size_t padded_height, std::size_t padded_width,
+                         const Scalar* weights, const Scalar* biases, std::size_t out_channels,
+                         Scalar* outputs) -> void
+        {
+            const auto kernel = select_direct<Scalar>();
+            const std::size_t plane_size = padded_height * padded_width;
+            const std::size_t out_size = (padded_height - 2) * (padded_width - 2);
+
+            Scheduler::instance().parallel_for(
+                batch_size * out_channels, grain_size(9 * channels * out_size),
+                [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t task{begin}; task < end; ++task)
+                    {
+                        const std::size_t sample = task / out_channels;
+                        const std::size_t channel = task % out_channels;
+                        kernel(padded + (sample * channels * plane_size), channels,
+                               padded_height, padded_width, weights + (channel * channels * 9),
+                               biases == nullptr ? Scalar{0} : biases[channel],
+                               outputs + (task * out_size));
+                    }
+                });
+        }
+
+    } // namespace
+
+    namespace conv
+    {
+
+        auto output_extent(std::size_t input, std::size_t kernel, std::size_t stride,
+                           std::size_t padding) -> std::size_t
+        {
+            if (kernel == 0 || stride == 0 || input + (2 * padding) < kernel)
+            {
+                throw std::invalid_argument("Kernel does not fit the input.");
+            }
+
+            return ((input + (2 * padding) - kernel) / stride) + 1;
+        }
+
+        auto transpose_extent(std::size_t input, std::size_t kernel, std::size_t stride,
+                              std::size_t padding) -> std::size_t
+        {
+            if (input == 0 || kernel == 0 || stride == 0
+                || ((input - 1) * stride) + kernel <= 2 * padding)
+            {
+                throw std::invalid_argument("Kernel does not fit the input.");
+            }
+
+            return ((input - 1) * stride) + kernel - (2 * padding);
+        }
+
+        auto prefers_direct(const Conv2DOptions& options) -> bool
+        {
+            return options.kernel_size == 3 && options.stride == 1
+                   && options.in_channels <= max_direct_channels;
+        }
+
+        template <std::floating_point Scalar>
+        auto im2col(const Scalar* image, std::size_t channels, std::size_t height,
+                    std::size_t width, std::size_t kernel, std::size_t stride, std::size_t padding,
+                    Scalar* columns) -> void
+        {
+            const std::size_t out_height = output_extent(height, kernel, stride, padding);
+            const std::size_t out_width = output_extent(width, kernel, stride, padding);
+            const std::size_t spatial = out_height * out_width;
+
+            Scheduler::instance().parallel_for(
+                channels * kernel * kernel, grain_size(spatial),
+                [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t row{begin}; row < end; ++row)
+                    {
+                        const std::size_t channel = row / (kernel * kernel);
+                        const std::size_t ky = (row / kernel) % kernel;
+                        const std::size_t kx = row % kernel;
+                        const Scalar* plane = image + (channel * height * width);
+                        const auto [first, last] =
+                            valid_columns(out_width, width, kx, stride, padding);
+
+                        for (std::size_t oy{0}; oy < out_height; ++oy)
+                        {
+                            Scalar* destination = columns + (row * spatial) + (oy * out_width);
+                            const std::size_t y = (oy * stride) + ky;
+                            if (y < padding || y - padding >= height)
+                            {
+                                std::fill_n(destination, out_width, Scalar{0});
+                                continue;
+                            }
+
+                            const Scalar* source = plane + ((y - padding) * width);
+                            std::fill_n(destination, first, Scalar{0});
+                            for (std::size_t ox{first}; ox < last; ++ox)
+                            {
+                                destination[ox] = source[(ox * stride) + kx - padding];
+                            }
+                            std::fill_n(destination + last, out_width - last, Scalar{0});
+                        }
+                    }
+                });
+        }
+
+        template <std::floating_point Scalar>
+        auto col2im(const Scalar* columns, std::size_t channels, std::size_t height,
+                    std::size_t width, std::size_t kernel, std::size_t stride, std::size_t padding,
+                    Scalar* image) -> void
+        {
+            const std::size_t out_height = output_extent(height, kernel, stride, padding);
+            const std::size_t out_width = output_extent(width, kernel, stride, padding);
+            const std::size_t spatial = out_height * out_width;
+
+            // NOTE(abi): rows of the same channel add onto the same plane, so tasks own whole
+            // channels.
+            Scheduler::instance().parallel_for(
+                channels, grain_size(kernel * kernel * spatial),
+                [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t channel{begin}; channel < end; ++channel)
+                    {
+                        Scalar* plane = image + (channel * height * width);
+                        for (std::size_t tap{0}; tap < kernel * kernel; ++tap)
+                        {
+                            const std::size_t ky = tap / kernel;
+                            const std::size_t kx = tap % kernel;
+                            const Scalar* row =
+                                columns + (((channel * kernel * kernel) + tap) * spatial);
+                            const auto [first, last] =
+                                valid_columns(out_width, width, kx, stride, padding);
+
+                            for (std::size_t oy{0}; oy < out_height; ++oy)
+                            {
+                                const std::size_t y = (oy * stride) + ky;
+                                if (y < padding || y - padding >= height)
+                                {
+                                    continue;
+                                }
+
+                                Scalar* destination = plane + ((y - padding) * width);
+                                const Scalar* source = row + (oy * out_width);
+                                for (std::size_t ox{first}; ox < last; ++ox)
+                                {
+                                    destination[(ox * stride) + kx - padding] += source[ox];
+                                }
+                            }
+                        }
+                    }
+                });
+        }
+
+        template auto im2col(const float*, std::size_t, std::size_t, std::size_t, std::size_t,
+                             std::size_t, std::size_t, float*) -> void;
+        template auto im2col(const double*, std::size_t, std::size_t, std::size_t, std::size_t,
+                             std::size_t, std::size_t, double*) -> void;
+        template auto col2im(const float*, std::size_t, std::size_t, std::size_t, std::size_t,
+                             std::size_t, std::size_t, float*) -> void;
+        template auto col2im(const double*, std::size_t, std::size_t, std::size_t, std::size_t,
+                             std::size_t, std::size_t, double*) -> void;
+
+    } // namespace conv
+
+    // Conv2D
+
+    template <std::floating_point Scalar>
+    BasicConv2D<Scalar>::BasicConv2D(const Conv2DOptions& options)
+        : options_(options)
+    {
+        if (options.in_channels == 0 || options.out_channels == 0 || options.kernel_size == 0
+            || options.stride == 0)
+        {
+            throw std::invalid_argument("Invalid convolution options.");
+        }
+
+        parameters_.resize(num_weights() + options.out_channels);
+        gradients_.resize(parameters_.size());
+        randomize(std::span<Scalar>{parameters_});
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicConv2D<Scalar>::set_algorithm(ConvAlgorithm algorithm) -> void
+    {
+        if (algorithm == ConvAlgorithm::direct
+            && (options_.kernel_size != 3 || options_.stride != 1))
+        {
+            throw std::invalid_argument("The direct kernel only runs 3 x 3 at stride 1.");
+        }
+
+        algorithm_ = algorithm;
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicConv2D<Scalar>::output_shape(const Shape& shape) const -> Shape
+    {
+        check_nchw(shape, options_.in_channels);
+        return {shape[0], options_.out_channels,
+                conv::output_extent(shape[2], options_.kernel_size, options_.stride,
+                                    options_.padding),
+                conv::output_extent(shape[3], options_.kernel_size, options_.stride,
+                                    options_.padding)};
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicConv2D<Scalar>::use_direct() const -> bool
+    {
+        return algorithm_ == ConvAlgorithm::direct
+               || (algorithm_ == ConvAlgorithm::automatic && conv::prefers_direct(options_));
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicConv2D<Scalar>::forward(BasicTensorView<const Scalar> inputs,
+                                      BasicTensorView<Scalar> outputs) -> void
+    {
+        const Shape& shape = inputs.shape();
+        check_output(outputs.shape(), output_shape(shape));
+
+        const std::size_t batch_size = shape[0];
+        const std::size_t channels = options_.in_channels;
+        const std::size_t height = shape[2];
+        const std::size_t width = shape[3];
+        const std::size_t kernel = options_.kernel_size;
+        const std::size_t padding = options_.padding;
+        const std::size_t out_channels = options_.out_channels;
+        const std::size_t spatial = outputs.extent(2) * outputs.extent(3);
+        const std::size_t patch = channels * kernel * kernel;
+
+        const Scalar* images = inputs.span().data();
+        Scalar* results = outputs.span().data();
+        const Scalar* weights = parameters_.data();
+        const Scalar* biases = weights + num_weights();
+
+        AXON_TRACE_SCOPE(trace::Phase::forward, "conv2d_forward", -1,
+                         2 * batch_size * out_channels * patch * spatial,
+                         (parameters_.size() + inputs.size() + outputs.size()) * sizeof(Scalar));
+
+        if (use_direct())
+        {
+            const std::size_t padded_height = height + (2 * padding);
+            const std::size_t padded_width = width + (2 * padding);
+            Scalar* padded =
+                reserve(columns_, batch_size * channels * padded_height * padded_width);
+            pad_planes(images, batch_size * channels, height, width, padding, padded);
+            direct_conv(padded, batch_size, channels, padded_height, padded_width, weights,
+                        biases, out_channels, results);
+            return;
+        }
+
+        // NOTE(abi): a 1 x 1 kernel at stride 1 without padding reads the image as it is.
+        const bool pointwise = kernel == 1 && options_.stride == 1 && padding == 0;
+        Scalar* columns = pointwise ? nullptr : reserve(columns_, patch * spatial);
+
+        for (std::size_t sample{0}; sample < batch_size; ++sample)
+        {
+            const Scalar* image = images + (sample * channels * height * width);
+            Scalar* result = results + (sample * out_channels * spatial);
+
+            if (!pointwise)
+            {
+                conv::im2col(image, channels, height, width, kernel, options_.stride, padding,
+                             columns);
+            }
+
+            // Y = W * columns + b, with the biases written first and accumulated onto.
+            fill_planes(result, out_channels, spatial, biases);
+            kernels::gemm(Transpose::no, Transpose::no, out_channels, spatial, patch, Scalar{1},
+                          weights, patch, pointwise ? image : columns, spatial, Scalar{1}, result,
+                          spatial);
+        }
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicConv2D<Scalar>::backward_data(BasicTensorView<const Scalar> output_gradients,
+                                            BasicTensorView<Scalar> input_gradients) -> void
+    {
+        const Shape& shape = input_gradients.shape();
+        check_output(output_gradients.shape(), output_shape(shape));
+
+        const std::size_t batch_size = shape[0];
+        const std::size_t channels = options_.in_channels;
+        const std::size_t height = shape[2];
+        const std::size_t width = shape[3];
+        const std::size_t kernel = options_.kernel_size;
+        const std::size_t padding = options_.padding;
+        const std::size_t out_channels = options_.out_channels;
+        const std::size_t out_height = output_gradients.extent(2);
+        const std::size_t out_width = output_gradients.extent(3);
+        const std::size_t spatial = out_height * out_width;
+        const std::size_t patch = channels * kernel * kernel;
+
+        const Scalar* gradients = output_gradients.span().data();
+        Scalar* results = input_gradients.span().data();
+        const Scalar* weights = parameters_.data();
+
+        AXON_TRACE_SCOPE(trace::Phase::backward, "conv2d_backward_data", -1,
+                         2 * batch_size * out_channels * patch * spatial,
+                         (num_weights() + input_gradients.size() + output_gradients.size())
+                             * sizeof(Scalar));
+
+        // NOTE(abi): at stride 1 the gradient of the inputs is itself a 3 x 3 convolution of
+        // the output gradients, padded by `2 - padding`, with the kernels rotated by 180
+        // degrees and the channel roles swapped.
+        if (use_direct() && padding <= 2)
+        {
+            Scalar* flipped = reserve(flipped_, num_weights());
+            for (std::size_t out{0}; out < out_channels; ++out)
+            {
+                for (std::size_t in{0}; in < channels; ++in)
+                {
+                    for (std::size_t tap{0}; tap < 9; ++tap)
+                    {
+                        flipped[(((in * out_channels) + out) * 9) + tap] =
+                            weights[(((out * channels) + in) * 9) + (8 - tap)];
+                    }
+                }
+            }
+
+            const std::size_t border = 2 - padding;
+            const std::size_t padded_height = out_height + (2 * border);
+            const std::size_t padded_width = out_width + (2 * border);
+            Scalar* padded =
+                reserve(columns_, batch_size * out_channels * padded_height * padded_width);
+            pad_planes(gradients, batch_size * out_channels, out_height, out_width, border,
+                       padded);
+            direct_conv<Scalar>(padded, batch_size, out_channels, padded_height, padded_width,
+                                flipped, nullptr, channels, results);
+            return;
+        }
+
+        const bool pointwise = kernel == 1 && options_.stride == 1 && padding == 0;
+        Scalar* columns = pointwise ? nullptr : reserve(columns_, patch * spatial);
+
+        for (std::size_t sample{0}; sample < batch_size; ++sample)
+        {
+            const Scalar* gradient = gradients + (sample * out_channels * spatial);
+            Scalar* result = results + (sample * channels * height * width);
+
+            // columns = W^T * dY, folded back onto the image.
+            kernels::gemm(Transpose::yes, Transpose::no, patch, spatial, out_channels, Scalar{1},
+                          weights, patch, gradient, spatial, Scalar{0},
+                          pointwise ? result : columns, spatial);
+
+            if (!pointwise)
+            {
+                std::fill_n(result, channels * height * width, Scalar{0});
+                conv::col2im(columns, channels, height, width, kernel, options_.stride, padding,
+                             result);
+            }
+        }
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicConv2D<Scalar>::backward_weights(BasicTensorView<const Scalar> inputs,
+                                               BasicTensorView<const Scalar> output_gradients)
+        -> void
+    {
+        const Shape& shape = inputs.shape();
+        check_output(output_gradients.shape(), output_shape(shape));
+
+        const std::size_t batch_size = shape[0];
+        const std::size_t channels = options_.in_channels;
+        const std::size_t height = shape[2];
+        const std::size_t width = shape[3];
+        const std::size_t kernel = options_.kernel_size;
+        const std::size_t padding = options_.padding;
+        const std::size_t out_channels = options_.out_channels;
+        const std::size_t spatial = output_gradients.extent(2) * output_gradients.extent(3);
+        const std::size_t patch = channels * kernel * kernel;
+
+        const Scalar* images = inputs.span().data();
+        const Scalar* gradients = output_gradients.span().data();
+        Scalar* weight_gradients = gradients_.data();
+
+        AXON_TRACE_SCOPE(trace::Phase::backward, "conv2d_backward_weights", -1,
+                         2 * batch_size * out_channels * patch * spatial,
+                         (gradients_.size() + inputs.size() + output_gradients.size())
+                             * sizeof(Scalar));
+
+        const bool pointwise = kernel == 1 && options_.stride == 1 && padding == 0;
+        Scalar* columns = pointwise ? nullptr : reserve(columns_, patch * spatial);
+
+        for (std::size_t sample{0}; sample < batch_size; ++sample)
+        {
+            const Scalar* image = images + (sample * channels * height * width);
+            if (!pointwise)
+            {
+                conv::im2col(image, channels, height, width, kernel, options_.stride, padding,
+                             columns);
+            }
+
+            // dW += dY * columns^T
+            kernels::gemm(Transpose::no, Transpose::yes, out_channels, patch, spatial, Scalar{1},
+                          gradients + (sample * out_channels * spatial), spatial,
+                          pointwise ? image : columns, spatial,
+                          sample == 0 ? Scalar{0} : Scalar{1}, weight_gradients, patch);
+        }
+
+        sum_planes(gradients, batch_size, out_channels, spatial, weight_gradients + num_weights());
+    }
+
+    // ConvTranspose2D
+
+    template <std::floating_point Scalar>
+    BasicConvTranspose2D<Scalar>::BasicConvTranspose2D(const Conv2DOptions& options)
+        : options_(options)
+    {
+        if (options.in_channels == 0 || options.out_channels == 0 || options.kernel_size == 0
+            || options.stride == 0)
+        {
+            throw std::invalid_argument("Invalid convolution options.");
+        }
+
+        parameters_.resize(num_weights() + options.out_channels);
+        gradients_.resize(parameters_.size());
+        randomize(std::span<Scalar>{parameters_});
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicConvTranspose2D<Scalar>::output_shape(const Shape& shape) const -> Shape
+    {
+        check_nchw(shape, options_.in_channels);
+        return {shape[0], options_.out_channels,
+                conv::transpose_extent(shape[2], options_.kernel_size, options_.stride,
+                                       options_.padding),
+                conv::transpose_extent(shape[3], options_.kernel_size, options_.stride,
+                                       options_.padding)};
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicConvTranspose2D<Scalar>::forward(BasicTensorView<const Scalar> inputs,
+                                               BasicTensorView<Scalar> outputs) -> void
+    {
+        const Shape& shape = inputs.shape();
+        check_output(outputs.shape(), output_shape(shape));
+
+        const std::size_t batch_size = shape[0];
+        const std::size_t channels = options_.in_channels;
+        const std::size_t spatial = shape[2] * shape[3];
+        const std::size_t kernel = options_.kernel_size;
+        const std::size_t out_channels = options_.out_channels;
+        const std::size_t out_height = outputs.extent(2);
+        const std::size_t out_width = outputs.extent(3);
+        const std::size_t patch = out_channels * kernel * kernel;
+
+        const Scalar* images = inputs.span().data();
+        Scalar* results = outputs.span().data();
+        const Scalar* weights = parameters_.data();
+        Scalar* columns = reserve(columns_, patch * spatial);
+
+        AXON_TRACE_SCOPE(trace::Phase::forward, "conv_transpose2d_forward", -1,
+                         2 * batch_size * channels * patch * spatial,
+                         (parameters_.size() + inputs.size() + outputs.size()) * sizeof(Scalar));
+
+        for (std::size_t sample{0}; sample < batch_size; ++sample)
+        {
+            Scalar* result = results + (sample * out_channels * out_height * out_width);
+
+            // columns = W^T * X, scattered onto the biases.
+            kernels::gemm(Transpose::yes, Transpose::no, patch, spatial, channels, Scalar{1},
+                          weights, patch, images + (sample * channels * spatial), spatial,
+                          Scalar{0}, columns, spatial);
+            fill_planes(result, out_channels, out_height * out_width, weights + num_weights());
+            conv::col2im(columns, out_channels, out_height, out_width, kernel, options_.stride,
+                         options_.padding, result);
+        }
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicConvTranspose2D<Scalar>::backward_data(
+        BasicTensorView<const Scalar> output_gradients, BasicTensorView<Scalar> input_gradients)
+        -> void
+    {
+        const Shape& shape = input_gradients.shape();
+        check_output(output_gradients.shape(), output_shape(shape));
+
+        const std::size_t batch_size = shape[0];
+        const std::size_t channels = options_.in_channels;
+        const std::size_t spatial = shape[2] * shape[3];
+        const std::size_t kernel = options_.kernel_size;
+        const std::size_t out_channels = options_.out_channels;
+        const std::size_t out_height = output_gradients.extent(2);
+        const std::size_t out_width = output_gradients.extent(3);
+        const std::size_t patch = out_channels * kernel * kernel;
+
+        const Scalar* gradients = output_gradients.span().data();
+        Scalar* results = input_gradients.span().data();
+        Scalar* columns = reserve(columns_, patch * spatial);
+
+        AXON_TRACE_SCOPE(trace::Phase::backward, "conv_transpose2d_backward_data", -1,
+                         2 * batch_size * channels * patch * spatial,
+                         (num_weights() + input_gradients.size() + output_gradients.size())
+                             * sizeof(Scalar));
+
+        for (std::size_t sample{0}; sample < batch_size; ++sample)
+        {
+            conv::im2col(gradients + (sample * out_channels * out_height * out_width),
+                         out_channels, out_height, out_width, kernel, options_.stride,
+                         options_.padding, columns);
+
+            // dX = W * columns
+            kernels::gemm(Transpose::no, Transpose::no, channels, spatial, patch, Scalar{1},
+                          parameters_.data(), patch, columns, spatial, Scalar{0},
+                          results + (sample * channels * spatial), spatial);
+        }
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicConvTranspose2D<Scalar>::backward_weights(
+        BasicTensorView<const Scalar> inputs, BasicTensorView<const Scalar> output_gradients)
+        -> void
+    {
+        const Shape& shape = inputs.shape();
+        check_output(output_gradients.shape(), output_shape(shape));
+
+        const std::size_t batch_size = shape[0];
+        const std::size_t channels = options_.in_channels;
+        const std::size_t spatial = shape[2] * shape[3];
+        const std::size_t kernel = options_.kernel_size;
+        const std::size_t out_channels = options_.out_channels;
+        const std::size_t out_spatial = output_gradients.extent(2) * output_gradients.extent(3);
+        const std::size_t patch = out_channels * kernel * kernel;
+
+        const Scalar* images = inputs.span().data();
+        const Scalar* gradients = output_gradients.span().data();
+        Scalar* columns = reserve(columns_, patch * spatial);
+
+        AXON_TRACE_SCOPE(trace::Phase::backward, "conv_transpose2d_backward_weights", -1,
+                         2 * batch_size * channels * patch * spatial,
+                         (gradients_.size() + inputs.size() + output_gradients.size())
+                             * sizeof(Scalar));
+
+        for (std::size_t sample{0}; sample < batch_size; ++sample)
+        {
+            conv::im2col(gradients + (sample * out_channels * out_spatial), out_channels,
+                         output_gradients.extent(2), output_gradients.extent(3), kernel,
+                         options_.stride, options_.padding, columns);
+
+            // dW += X * columns^T
+            kernels::gemm(Transpose::no, Transpose::yes, channels, patch, spatial, Scalar{1},
+                          images + (sample * channels * spatial), spatial, columns, spatial,
+                          sample == 0 ? Scalar{0} : Scalar{1}, gradients_.data(), patch);
+        }
+
+        sum_planes(gradients, batch_size, out_channels, out_spatial,
+                   gradients_.data() + num_weights());
+    }
+
+    // Pool2D
+
+    template <std::floating_point Scalar>
+    BasicPool2D<Scalar>::BasicPool2D(const Pool2DOptions& options)
+        : options_(options)
+    {
+        if (options.kernel_size == 0 || options.stride == 0)
+        {
+            throw std::invalid_argument("Invalid pooling options.");
+        }
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicPool2D<Scalar>::output_shape(const Shape& shape) const -> Shape
+    {
+        if (shape.rank() != 4 || shape[0] == 0)
+        {
+            throw std::invalid_argument("Invalid tensor shape.");
+        }
+
+        return {shape[0], shape[1],
+                conv::output_extent(shape[2], options_.kernel_size, options_.stride, 0),
+                conv::output_extent(shape[3], options_.kernel_size, options_.stride, 0)};
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicPool2D<Scalar>::forward(BasicTensorView<const Scalar> inputs,
+                                      BasicTensorView<Scalar> outputs) -> void
+    {
+        const Shape& shape = inputs.shape();
+        check_output(outputs.shape(), output_shape(shape));
+        if (shape[2] * shape[3] > std::numeric_limits<std::uint32_t>::max())
+        {
+            throw std::invalid_argument("Input planes too large to pool.");
+        }
+
+        const std::size_t height = shape[2];
+        const std::size_t width = shape[3];
+        const std::size_t out_height = outputs.extent(2);
+        const std::size_t out_width = outputs.extent(3);
+        const std::size_t kernel = options_.kernel_size;
+        const std::size_t stride = options_.stride;
+        const bool is_max = options_.mode == PoolMode::max;
+
+        const Scalar* planes = inputs.span().data();
+        Scalar* results = outputs.span().data();
+        input_shape_ = shape;
+        if (is_max)
+        {
+            argmax_.resize(outputs.size());
+        }
+
+        AXON_TRACE_SCOPE(trace::Phase::forward, "pool2d_forward", -1,
+                         outputs.size() * kernel * kernel,
+                         (inputs.size() + outputs.size()) * sizeof(Scalar));
+
+        const Scalar scale = Scalar{1} / static_cast<Scalar>(kernel * kernel);
+        Scheduler::instance().parallel_for(
+            shape[0] * shape[1], grain_size(out_height * out_width * kernel * kernel),
+            [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t plane{begin}; plane < end; ++plane)
+                {
+                    const Scalar* input = planes + (plane * height * width);
+                    const std::size_t first = plane * out_height * out_width;
+
+                    for (std::size_t oy{0}; oy < out_height; ++oy)
+                    {
+                        for (std::size_t ox{0}; ox < out_width; ++ox)
+                        {
+                            const std::size_t origin = (oy * stride * width) + (ox * stride);
+                            std::size_t best = origin;
+                            Scalar sum{0};
+                            for (std::size_t ky{0}; ky < kernel; ++ky)
+                            {
+                                for (std::size_t kx{0}; kx < kernel; ++kx)
+                                {
+                                    const std::size_t offset = origin + (ky * width) + kx;
+                                    sum += input[offset];
+                                    best = input[offset] > input[best] ? offset : best;
+                                }
+                            }
+
+                            const std::size_t index = first + (oy * out_width) + ox;
+                            if (is_max)
+                            {
+                                results[index] = input[best];
+                                argmax_[index] = static_cast<std::uint32_t>(best);
+                            }
+                            else
+                            {
+                                results[index] = sum * scale;
+                            }
+                        }
+                    }
+                }
+            });
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicPool2D<Scalar>::backward(BasicTensorView<const Scalar> output_gradients,
+                                       BasicTensorView<Scalar> input_gradients) -> void
+    {
+        const Shape& shape = input_gradients.shape();
+        if (!(shape == input_shape_))
+        {
+            throw std::invalid_argument("Backward pass does not match the forward pass.");
+        }
+
+        check_output(output_gradients.shape(), output_shape(shape));
+
+        const std::size_t width = shape[3];
+        const std::size_t plane_size = shape[2] * width;
+        const std::size_t out_height = output_gradients.extent(2);
+        const std::size_t out_width = output_gradients.extent(3);
+        const std::size_t kernel = options_.kernel_size;
+        const std::size_t stride = options_.stride;
+        const bool is_max = options_.mode == PoolMode::max;
+
+        const Scalar* gradients = output_gradients.span().data();
+        Scalar* results = input_gradients.span().data();
+
+        AXON_TRACE_SCOPE(trace::Phase::backward, "pool2d_backward", -1,
+                         output_gradients.size() * kernel * kernel,
+                         (input_gradients.size() + output_gradients.size()) * sizeof(Scalar));
+
+        const Scalar scale = Scalar{1} / static_cast<Scalar>(kernel * kernel);
+        Scheduler::instance().parallel_for(
+            shape[0] * shape[1], grain_size(out_height * out_width * kernel * kernel),
+            [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t plane{begin}; plane < end; ++plane)
+                {
+                    Scalar* result = results + (plane * plane_size);
+                    std::fill_n(result, plane_size, Scalar{0});
+
+                    const std::size_t first = plane * out_height * out_width;
+                    for (std::size_t oy{0}; oy < out_height; ++oy)
+                    {
+                        for (std::size_t ox{0}; ox < out_width; ++ox)
+                        {
+                            const std::size_t index = first + (oy * out_width) + ox;
+                            if (is_max)
+                            {
+                                result[argmax_[index]] += gradients[index];
+                                continue;
+                            }
+
+                            const Scalar share = gradients[index] * scale;
+                            const std::size_t origin = (oy * stride * width) + (ox * stride);
+                            for (std::size_t ky{0}; ky < kernel; ++ky)
+                            {
+                                for (std::size_t kx{0}; kx < kernel; ++kx)
+                                {
+                                    result[origin + (ky * width) + kx] += share;
+                                }
+                            }
+                        }
+                    }
+                }
+            });
+    }
+
+    template class BasicConv2D<float>;
+    template class BasicConv2D<double>;
+    template class BasicConvTranspose2D<float>;
+    template class BasicConvTranspose2D<double>;
+    template class BasicPool2D<float>;
+    template class BasicPool2D<double>;
+
+} // namespace axon
@@ -0,0 +1,477 @@
+#include "data_loader.hpp"
+
+#include "trace.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace axon
+{
+
+    namespace
+    {
+        using dataset::Header;
+
+        // NOTE(abi): large enough that streaming reads reach sequential disk bandwidth, small
+        // enough to not matter next to the shuffle buffer.
+        constexpr std::size_t stream_buffer_bytes{std::size_t{1} << 20};
+
+        auto validate(const Header& header, std::uintmax_t file_bytes, std::size_t scalar_bytes)
+            -> void
+        {
+            if (header.magic != dataset::magic)
+            {
+                throw std::runtime_error("Not an axon dataset file.");
+            }
+
+            if (header.version != dataset::version)
+            {
+                throw std::runtime_error("Unsupported file version.");
+            }
+
+            if (header.scalar_bytes != scalar_bytes)
+            {
+                throw std::runtime_error("The file stores a different scalar type.");
+            }
+
+            // Bounded so that the size arithmetic below cannot overflow.
+            if (header.num_inputs == 0 || header.num_inputs > file_bytes
+                || header.num_targets > file_bytes)
+            {
+                throw std::runtime_error("Invalid sample shape.");
+            }
+
+            const std::uintmax_t sample_bytes =
+                (header.num_inputs + header.num_targets) * scalar_bytes;
+            const std::uintmax_t payload_bytes = file_bytes - sizeof(Header);
+            if (header.num_samples > payload_bytes / sample_bytes
+                || header.num_samples * sample_bytes != payload_bytes)
+            {
+                throw std::runtime_error("Truncated file.");
+            }
+        }
+
+    } // namespace
+
+    template <std::floating_point Scalar>
+    BasicDatasetWriter<Scalar>::BasicDatasetWriter(const std::filesystem::path& path,
+                                                   std::size_t num_inputs,
+                                                   std::size_t num_targets)
+        : file_(path, std::ios::binary | std::ios::trunc),
+          num_inputs_(num_inputs),
+          num_targets_(num_targets)
+    {
+        if (num_inputs == 0)
+        {
+            throw std::invalid_argument("Samples need at least one input.");
+        }
+
+        if (!file_)
+        {
+            throw std::runtime_error("Cannot create " + path.string() + ".");
+        }
+
+        // NOTE(abi): the sample count is only known in `close`, which rewrites the header.
+        const Header header{};
+        file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    template <std::floating_point Scalar>
+    BasicDatasetWriter<Scalar>::~BasicDatasetWriter()
+    {
+        // Errors are only reported by an explicit `close`.
+        try
+        {
+            close();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicDatasetWriter<Scalar>::append(std::span<const Scalar> inputs,
+                                            std::span<const Scalar> targets) -> void
+    {
+        const std::size_t num_samples = inputs.size() / num_inputs_;
+        if (inputs.size() != num_samples * num_inputs_
+            || targets.size() != num_samples * num_targets_)
+        {
+            throw std::invalid_argument("Mismatched inputs and targets.");
+        }
+
+        if (!file_.is_open())
+        {
+            throw std::logic_error("The dataset file is closed.");
+        }
+
+        for (std::size_t i{0}; i < num_samples; ++i)
+        {
+            file_.write(reinterpret_cast<const char*>(inputs.data() + (i * num_inputs_)),
+                        static_cast<std::streamsize>(num_inputs_ * sizeof(Scalar)));
+            file_.write(reinterpret_cast<const char*>(targets.data() + (i * num_targets_)),
+                        static_cast<std::streamsize>(num_targets_ * sizeof(Scalar)));
+        }
+
+        if (!file_)
+        {
+            throw std::runtime_error("Cannot write the dataset file.");
+        }
+
+        num_samples_ += num_samples;
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicDatasetWriter<Scalar>::close() -> void
+    {
+        if (!file_.is_open())
+        {
+            return;
+        }
+
+        const Header header{
+            .magic = dataset::magic,
+            .version = dataset::version,
+            .scalar_bytes = sizeof(Scalar),
+            .num_inputs = num_inputs_,
+            .num_targets = num_targets_,
+            .num_samples = num_samples_,
+        };
+
+        file_.seekp(0);
+        file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file_.close();
+
+        if (!file_)
+        {
+            throw std::runtime_error("Cannot write the dataset file.");
+        }
+    }
+
+    template <std::floating_point Scalar>
+    BasicDataLoader<Scalar>::BasicDataLoader(const std::filesystem::path& path,
+                                             const DataLoaderOptions& options)
+        : options_(options)
+    {
+        if (options.batch_size == 0 || options.prefetch == 0)
+        {
+            throw std::invalid_argument("Batch size and prefetch depth must be positive.");
+        }
+
+        if (options.mode == dataset::ReadMode::streaming && options.shuffle_buffer == 0)
+        {
+            throw std::invalid_argument("The shuffle buffer must hold at least one sample.");
+        }
+
+        Header header;
+        std::uintmax_t file_bytes{0};
+        if (options.mode == dataset::ReadMode::mapped)
+        {
+            file_ = MappedFile(path);
+            file_bytes = file_.size();
+            if (file_bytes < sizeof(Header))
+            {
+                throw std::runtime_error("Truncated file.");
+            }
+
+            std::memcpy(&header, file_.bytes().data(), sizeof(Header));
+        }
+        else
+        {
+            // NOTE(abi): the buffer has to be installed before the file is opened.
+            stream_buffer_.resize(stream_buffer_bytes);
+            stream_.rdbuf()->pubsetbuf(stream_buffer_.data(),
+                                       static_cast<std::streamsize>(stream_buffer_.size()));
+            stream_.open(path, std::ios::binary);
+            if (!stream_)
+            {
+                throw std::runtime_error("Cannot open " + path.string() + ".");
+            }
+
+            file_bytes = std::filesystem::file_size(path);
+            if (file_bytes < sizeof(Header)
+                || !stream_.read(reinterpret_cast<char*>(&header), sizeof(Header)))
+            {
+                throw std::runtime_error("Truncated file.");
+            }
+        }
+
+        validate(header, file_bytes, sizeof(Scalar));
+        num_inputs_ = static_cast<std::size_t>(header.num_inputs);
+        num_targets_ = static_cast<std::size_t>(header.num_targets);
+        num_samples_ = static_cast<std::size_t>(header.num_samples);
+        sample_bytes_ = (num_inputs_ + num_targets_) * sizeof(Scalar);
+
+        if (options.mode == dataset::ReadMode::streaming)
+        {
+            const std::size_t window = options.shuffle ? options.shuffle_buffer : 1;
+            window_.resize(std::min(window, num_samples_) * sample_bytes_);
+        }
+
+        slots_.resize(options.prefetch);
+        for (auto& slot : slots_)
+        {
+            slot.inputs.resize(options.batch_size * num_inputs_);
+            slot.targets.resize(options.batch_size * num_targets_);
+        }
+
+        prefetcher_ = std::thread([this] { prefetch_loop(); });
+    }
+
+    template <std::floating_point Scalar>
+    BasicDataLoader<Scalar>::~BasicDataLoader()
+    {
+        {
+            const std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+
+        changed_.notify_all();
+        prefetcher_.join();
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicDataLoader<Scalar>::get_num_batches() const -> std::size_t
+    {
+        const std::size_t batch_size = options_.batch_size;
+        return options_.drop_last ? num_samples_ / batch_size
+                                  : (num_samples_ + batch_size - 1) / batch_size;
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicDataLoader<Scalar>::start_epoch(std::uint64_t epoch) -> void
+    {
+        {
+            const std::lock_guard lock(mutex_);
+            ++generation_;
+            epoch_ = epoch;
+            head_ = 0;
+            num_ready_ = 0;
+            in_use_ = false;
+            exhausted_ = false;
+            error_ = nullptr;
+        }
+
+        changed_.notify_all();
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicDataLoader<Scalar>::next() -> std::optional<BasicBatch<Scalar>>
+    {
+        // NOTE(abi): time the training thread spends waiting for the storage.
+        AXON_TRACE_SCOPE(trace::Phase::data_loading, "wait_for_batch");
+
+        std::unique_lock lock(mutex_);
+        if (in_use_)
+        {
+            head_ = (head_ + 1) % slots_.size();
+            --num_ready_;
+            in_use_ = false;
+            changed_.notify_all();
+        }
+
+        changed_.wait(lock, [&] { return num_ready_ > 0 || exhausted_; });
+        if (num_ready_ == 0)
+        {
+            if (error_)
+            {
+                std::rethrow_exception(std::exchange(error_, nullptr));
+            }
+
+            return std::nullopt;
+        }
+
+        in_use_ = true;
+        const Slot& slot = slots_[head_];
+        return BasicBatch<Scalar>{
+            .inputs = {slot.inputs.data(), slot.size * num_inputs_},
+            .targets = {slot.targets.data(), slot.size * num_targets_},
+            .size = slot.size,
+        };
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicDataLoader<Scalar>::reset_source(std::uint64_t epoch) -> void
+    {
+        const auto low = [](std::uint64_t value) { return static_cast<std::uint32_t>(value); };
+        std::seed_seq seed{low(options_.seed), low(options_.seed >> 32), low(epoch),
+                           low(epoch >> 32)};
+        rng_.seed(seed);
+
+        if (options_.mode == dataset::ReadMode::mapped)
+        {
+            // NOTE(abi): every epoch shuffles the identity permutation, so its order does not
+            // depend on the epochs that ran before it.
+            order_.resize(num_samples_);
+            std::iota(order_.begin(), order_.end(), std::size_t{0});
+            if (options_.shuffle)
+            {
+                std::ranges::shuffle(order_, rng_);
+            }
+
+            cursor_ = 0;
+            return;
+        }
+
+        stream_.clear();
+        stream_.seekg(sizeof(Header));
+        num_unread_ = num_samples_;
+        num_buffered_ = 0;
+        while (num_buffered_ * sample_bytes_ < window_.size())
+        {
+            read_sample(window_.data() + (num_buffered_ * sample_bytes_));
+            ++num_buffered_;
+        }
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicDataLoader<Scalar>::fill(Slot& slot) -> std::size_t
+    {
+        AXON_TRACE_SCOPE(trace::Phase::data_loading, "assemble_batch", -1, 0,
+                         2 * options_.batch_size * sample_bytes_);
+
+        std::size_t rows{0};
+        if (options_.mode == dataset::ReadMode::mapped)
+        {
+            const std::byte* samples = file_.bytes().data() + sizeof(Header);
+            for (; rows < options_.batch_size && cursor_ < order_.size(); ++rows, ++cursor_)
+            {
+                copy_sample(samples + (order_[cursor_] * sample_bytes_), slot, rows);
+            }
+        }
+        else
+        {
+            // NOTE(abi): emits a random sample of the window and refills its place with the next
+            // sample of the file. Without shuffling the window holds a single sample, which
+            // degenerates into a sequential read.
+            for (; rows < options_.batch_size && num_buffered_ > 0; ++rows)
+            {
+                std::uniform_int_distribution<std::size_t> pick(0, num_buffered_ - 1);
+                std::byte* sample = window_.data() + (pick(rng_) * sample_bytes_);
+                copy_sample(sample, slot, rows);
+
+                if (num_unread_ > 0)
+                {
+                    read_sample(sample);
+                }
+                else
+                {
+                    --num_buffered_;
+                    std::memmove(sample, window_.data() + (num_buffered_ * sample_bytes_),
+                                 sample_bytes_);
+                }
+            }
+        }
+
+        if (rows < options_.batch_size && options_.drop_last)
+        {
+            rows = 0;
+        }
+
+        slot.size = rows;
+        return rows;
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicDataLoader<Scalar>::read_sample(std::byte* destination) -> void
+    {
+        if (!stream_.read(reinterpret_cast<char*>(destination),
+                          static_cast<std::streamsize>(sample_bytes_)))
+        {
+            throw std::runtime_error("Truncated file.");
+        }
+
+        --num_unread_;
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicDataLoader<Scalar>::copy_sample(const std::byte* sample, Slot& slot,
+                                              std::size_t row) const -> void
+    {
+        const std::size_t input_bytes = num_inputs_ * sizeof(Scalar);
+        std::memcpy(slot.inputs.data() + (row * num_inputs_), sample, input_bytes);
+        std::memcpy(slot.targets.data() + (row * num_targets_), sample + input_bytes,
+                    num_targets_ * sizeof(Scalar));
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicDataLoader<Scalar>::prefetch_loop() -> void
+    {
+        std::unique_lock lock(mutex_);
+        std::uint64_t generation{0};
+        while (true)
+        {
+            changed_.wait(lock,
+                          [&]
+                          {
+                              return stopping_ || generation != generation_
+                                     || (!exhausted_ && num_ready_ < slots_.size());
+                          });
+
+            if (stopping_)
+            {
+                return;
+            }
+
+            const bool restart = generation != generation_;
+            generation = generation_;
+            const std::uint64_t epoch = epoch_;
+            Slot& slot = slots_[(head_ + num_ready_) % slots_.size()];
+            lock.unlock();
+
+            // NOTE(abi): reading and copying happen outside the lock, so the consumer can take
+            // ready batches meanwhile. Results of an abandoned epoch are dropped below.
+            std::size_t rows{0};
+            std::exception_ptr error;
+            try
+            {
+                if (restart)
+                {
+                    reset_source(epoch);
+                }
+                else
+                {
+                    rows = fill(slot);
+                }
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            if (generation != generation_)
+            {
+                continue;
+            }
+
+            if (error)
+            {
+                error_ = error;
+                exhausted_ = true;
+            }
+            else if (!restart)
+            {
+                if (rows == 0)
+                {
+                    exhausted_ = true;
+                }
+                else
+                {
+                    ++num_ready_;
+                }
+            }
+
+            changed_.notify_all();
+        }
+    }
+
+    template class BasicDatasetWriter<float>;
+    template class BasicDatasetWriter<double>;
+    template class BasicDataLoader<float>;
+    template class BasicDataLoader<double>;
+
+} // namespace axon
@@ -0,0 +1,112 @@
+#pragma once
+
+// Forward step of a fully-connected layer, shared by every model type that stores its weights
+// as row-major matrices. Internal to the library.
+
+#include "activation.hpp"
+#include "dispatch.hpp"
+#include "kernels.hpp"
+#include "sparse.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+namespace axon::detail
+{
+
+    // outputs = activation(outputs + biases), row by row, for a batch_size x num_outputs
+    // matrix.
+    template <std::floating_point Scalar>
+    auto bias_activation(std::size_t batch_size, std::size_t num_outputs, const Scalar* biases,
+                         const Activation& activation, activation::MathMode mode,
+                         Scalar* outputs) -> void
+    {
+        for (std::size_t sample{0}; sample < batch_size; ++sample)
+        {
+            Scalar* sample_outputs = outputs + (sample * num_outputs);
+            for (std::size_t out{0}; out < num_outputs; ++out)
+            {
+                sample_outputs[out] += biases[out];
+            }
+        }
+
+        const std::span<Scalar> values{outputs, batch_size * num_outputs};
+        dispatch(activation,
+                 [&](const auto& policy) { policy.template apply<Scalar>(values, values, mode); });
+    }
+
+    // Runs an activation policy as the epilogue of a GEMM.
+    template <typename Policy, std::floating_point Scalar>
+    struct ActivationEpilogue
+    {
+        Policy policy;
+        activation::MathMode mode;
+
+        static auto apply(std::span<Scalar> values, const void* context) -> void
+        {
+            const auto& self = *static_cast<const ActivationEpilogue*>(context);
+            self.policy.template apply<Scalar>(values, values, self.mode);
+        }
+    };
+
+    // outputs = activation(inputs * weights^T + biases), where `inputs` is batch_size x
+    // num_inputs, `weights` is num_outputs x num_inputs and `outputs` is batch_size x
+    // num_outputs. For the built-in activations the biases and the activation run in the
+    // epilogue of the GEMM, on each block of outputs as soon as it is done, so the
+    // pre-activations are never streamed through memory a second time and the activation is
+    // split across the threads with the product. User-supplied callables are never called from
+    // the workers: they run afterwards, serially, over the whole output. Backprop needs only
+    // the activated outputs, which every derivative takes.
+    template <std::floating_point Scalar>
+    auto dense_forward(const Scalar* inputs, std::size_t batch_size, std::size_t num_inputs,
+                       std::size_t num_outputs, const Scalar* weights, const Scalar* biases,
+                       const Activation& activation, activation::MathMode mode, Scalar* outputs)
+        -> void
+    {
+        if (activation.kind == activation::Kind::custom)
+        {
+            kernels::gemm(kernels::Transpose::no, kernels::Transpose::yes, batch_size,
+                          num_outputs, num_inputs, Scalar{1}, inputs, num_inputs, weights,
+                          num_inputs, Scalar{0}, outputs, num_outputs);
+            bias_activation(batch_size, num_outputs, biases, activation, mode, outputs);
+            return;
+        }
+
+        dispatch(activation,
+                 [&]<typename Policy>(const Policy& policy)
+                 {
+                     using Context = ActivationEpilogue<Policy, Scalar>;
+                     const Context context{.policy = policy, .mode = mode};
+
+                     kernels::gemm(kernels::Transpose::no, kernels::Transpose::yes, batch_size,
+                                   num_outputs, num_inputs, Scalar{1}, inputs, num_inputs,
+                                   weights, num_inputs, Scalar{0}, outputs, num_outputs,
+                                   {.bias = biases, .apply = &Context::apply, .context = &context});
+                 });
+    }
+
+    // Same, multiplying by the sparse copy of the weights of a pruned layer.
+    template <std::floating_point Scalar>
+    auto sparse_forward(const Scalar* inputs, std::size_t batch_size,
+                        const BasicSparseWeights<Scalar>& weights, const Scalar* biases,
+                        const Activation& activation, activation::MathMode mode, Scalar* outputs)
+        -> void
+    {
+        sparse::multiply(weights, inputs, batch_size, outputs);
+
+        const std::size_t num_outputs = weights.format == SparseFormat::block
+                                            ? weights.blocks.num_rows
+                                            : weights.csr.num_rows;
+        bias_activation(batch_size, num_outputs, biases, activation, mode, outputs);
+    }
+
+    // Whether a layer with these sparse weights should take the sparse path for a batch.
+    template <std::floating_point Scalar>
+    [[nodiscard]] auto use_sparse(const BasicSparseWeights<Scalar>& weights,
+                                  std::size_t batch_size) -> bool
+    {
+        return weights.format != SparseFormat::dense && batch_size <= sparse::max_batch_size;
+    }
+
+} // namespace axon::detail
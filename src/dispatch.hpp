@@ -0,0 +1,109 @@
+#pragma once
+
+// Per-layer dispatch from the runtime `Activation`/`Criterion` descriptors to the static policy
+// types. Internal to the library.
+
+#include "activation.hpp"
+#include "criterion.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+namespace axon::detail
+{
+
+    // Adapt user-supplied callables to the static policy interface, so the same layer loops
+    // serve both the specialised and the fallback paths. The callables work in double
+    // precision, so narrower scalars are widened around every call.
+    struct RuntimeActivation
+    {
+        const Activation* activation;
+
+        template <std::floating_point Scalar>
+        [[nodiscard]] auto function(Scalar x) const -> Scalar
+        {
+            return static_cast<Scalar>(activation->function(x));
+        }
+
+        template <std::floating_point Scalar>
+        [[nodiscard]] auto derivative(Scalar output) const -> Scalar
+        {
+            return static_cast<Scalar>(activation->derivative(output));
+        }
+
+        template <std::floating_point Scalar>
+        auto apply(std::span<const Scalar> inputs, std::span<Scalar> outputs,
+                   [[maybe_unused]] activation::MathMode mode) const -> void
+        {
+            for (std::size_t i{0}; i < inputs.size(); ++i)
+            {
+                outputs[i] = function(inputs[i]);
+            }
+        }
+
+        template <std::floating_point Scalar>
+        auto apply_derivative(std::span<const Scalar> outputs,
+                              std::span<Scalar> gradients) const -> void
+        {
+            for (std::size_t i{0}; i < outputs.size(); ++i)
+            {
+                gradients[i] *= derivative(outputs[i]);
+            }
+        }
+    };
+
+    struct RuntimeCriterion
+    {
+        const Criterion* criterion;
+
+        template <std::floating_point Scalar>
+        [[nodiscard]] auto function(Scalar target, Scalar output) const -> Scalar
+        {
+            return static_cast<Scalar>(criterion->function(target, output));
+        }
+
+        template <std::floating_point Scalar>
+        [[nodiscard]] auto derivative(Scalar target, Scalar output) const -> Scalar
+        {
+            return static_cast<Scalar>(criterion->derivative(target, output));
+        }
+    };
+
+    // Invokes `body` with the policy matching the activation, once per layer rather than
+    // once per unit.
+    template <typename Body>
+    auto dispatch(const Activation& activation, Body&& body) -> void
+    {
+        switch (activation.kind)
+        {
+        case activation::Kind::linear:
+            return body(activation::Linear{});
+        case activation::Kind::sigmoid:
+            return body(activation::Sigmoid{});
+        case activation::Kind::tanh:
+            return body(activation::Tanh{});
+        case activation::Kind::relu:
+            return body(activation::ReLU{});
+        case activation::Kind::custom:
+            break;
+        }
+
+        body(RuntimeActivation{&activation});
+    }
+
+    template <typename Body>
+    auto dispatch(const Criterion& criterion, Body&& body) -> void
+    {
+        switch (criterion.kind)
+        {
+        case criterion::Kind::mse:
+            return body(criterion::MSE{});
+        case criterion::Kind::custom:
+            break;
+        }
+
+        body(RuntimeCriterion{&criterion});
+    }
+
+} // namespace axon::detail
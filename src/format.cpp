@@ -0,0 +1,222 @@
+#include "format.hpp"
+
+#include <stdexcept>
+
+namespace axon::detail
+{
+
+    namespace
+    {
+        using serialization::block_alignment;
+        using serialization::Header;
+
+        auto make_activation(activation::Kind kind) -> Activation
+        {
+            switch (kind)
+            {
+            case activation::Kind::linear:
+                return Activation::of<activation::Linear>();
+            case activation::Kind::sigmoid:
+                return Activation::of<activation::Sigmoid>();
+            case activation::Kind::tanh:
+                return Activation::of<activation::Tanh>();
+            case activation::Kind::relu:
+                return Activation::of<activation::ReLU>();
+            case activation::Kind::custom:
+                break;
+            }
+
+            throw std::runtime_error("Unknown activation identifier.");
+        }
+
+        auto make_criterion(criterion::Kind kind) -> Criterion
+        {
+            switch (kind)
+            {
+            case criterion::Kind::mse:
+                return Criterion::of<criterion::MSE>();
+            case criterion::Kind::custom:
+                break;
+            }
+
+            throw std::runtime_error("Unknown criterion identifier.");
+        }
+
+    } // namespace
+
+    auto padded(std::size_t bytes) -> std::size_t
+    {
+        return ((bytes + block_alignment - 1) / block_alignment) * block_alignment;
+    }
+
+    auto make_layout(FileKind kind, const std::vector<std::size_t>& layer_sizes,
+                     std::size_t scalar_bytes, bool has_masks,
+                     std::optional<std::size_t> num_optimizer_values) -> Layout
+    {
+        Layout layout;
+        layout.has_masks = has_masks;
+        std::size_t offset =
+            layout.layer_sizes_offset + padded(layer_sizes.size() * sizeof(std::uint64_t));
+
+        if (kind == FileKind::checkpoint)
+        {
+            layout.state_offset = offset;
+            offset += padded(sizeof(TrainingState));
+        }
+
+        for (std::size_t layer_idx{1}; layer_idx < layer_sizes.size(); ++layer_idx)
+        {
+            const std::size_t weight_bytes =
+                padded(layer_sizes[layer_idx - 1] * layer_sizes[layer_idx] * scalar_bytes);
+            const std::size_t bias_bytes = padded(layer_sizes[layer_idx] * scalar_bytes);
+
+            auto& blocks = layout.layers.emplace_back();
+            blocks.weights = offset;
+            blocks.biases = blocks.weights + weight_bytes;
+            offset = blocks.biases + bias_bytes;
+
+            if (kind == FileKind::checkpoint)
+            {
+                blocks.weight_velocity = offset;
+                blocks.bias_velocity = blocks.weight_velocity + weight_bytes;
+                offset = blocks.bias_velocity + bias_bytes;
+            }
+
+            if (has_masks)
+            {
+                blocks.mask = offset;
+                offset += padded(layer_sizes[layer_idx - 1] * layer_sizes[layer_idx]);
+            }
+        }
+
+        if (num_optimizer_values)
+        {
+            layout.has_optimizer = true;
+            layout.optimizer_offset = offset;
+            layout.optimizer_values = offset + block_alignment;
+            layout.num_optimizer_values = *num_optimizer_values;
+            offset = layout.optimizer_values + padded(*num_optimizer_values * scalar_bytes);
+        }
+
+        layout.file_bytes = offset;
+        return layout;
+    }
+
+    auto parse(FileKind kind, std::span<const std::byte> bytes, std::size_t scalar_bytes,
+               serialization::Verification verification) -> ParsedFile
+    {
+        Header header;
+        if (bytes.size() < sizeof(Header))
+        {
+            throw std::runtime_error("Truncated file.");
+        }
+
+        std::memcpy(&header, bytes.data(), sizeof(Header));
+        if (header.magic != (kind == FileKind::model ? serialization::magic : checkpoint_magic))
+        {
+            throw std::runtime_error(kind == FileKind::model ? "Not an axon model file."
+                                                             : "Not an axon checkpoint file.");
+        }
+
+        if (header.version != serialization::version)
+        {
+            throw std::runtime_error("Unsupported file version.");
+        }
+
+        if (header.scalar_bytes != scalar_bytes)
+        {
+            throw std::runtime_error("The file stores a different scalar type.");
+        }
+
+        if (header.flags != 0
+            && (kind == FileKind::model || (header.flags & ~(masks_flag | optimizer_flag)) != 0))
+        {
+            throw std::runtime_error("Unsupported file flags.");
+        }
+
+        if (header.payload_bytes != bytes.size() - sizeof(Header))
+        {
+            throw std::runtime_error("Truncated file.");
+        }
+
+        if (verification == serialization::Verification::checksum
+            && header.checksum != serialization::checksum(bytes.subspan(sizeof(Header))))
+        {
+            throw std::runtime_error("Checksum mismatch.");
+        }
+
+        // NOTE(abi): the layer count is bounded by the file size before anything is allocated
+        // for it, so a corrupted header cannot trigger a huge allocation.
+        constexpr std::size_t min_allowed_layers{2};
+        if (header.num_layer_sizes < min_allowed_layers
+            || header.num_layer_sizes > header.payload_bytes / sizeof(std::uint64_t))
+        {
+            throw std::runtime_error("Invalid topology.");
+        }
+
+        ParsedFile file;
+        file.layer_sizes.resize(header.num_layer_sizes);
+        for (std::size_t i{0}; i < file.layer_sizes.size(); ++i)
+        {
+            std::uint64_t size{0};
+            std::memcpy(&size, bytes.data() + sizeof(Header) + (i * sizeof(size)), sizeof(size));
+
+            // Bounded so that the layout arithmetic below cannot overflow.
+            if (size == 0 || size > header.payload_bytes)
+            {
+                throw std::runtime_error("Invalid topology.");
+            }
+
+            file.layer_sizes[i] = static_cast<std::size_t>(size);
+        }
+
+        for (std::size_t i{1}; i < file.layer_sizes.size(); ++i)
+        {
+            if (file.layer_sizes[i - 1] > header.payload_bytes / file.layer_sizes[i])
+            {
+                throw std::runtime_error("Truncated file.");
+            }
+        }
+
+        const bool has_masks = (header.flags & masks_flag) != 0;
+        std::optional<std::size_t> num_optimizer_values;
+        if ((header.flags & optimizer_flag) != 0)
+        {
+            // NOTE(abi): the value count sits at the start of the last block, whose offset only
+            // depends on the topology.
+            const auto prefix = make_layout(kind, file.layer_sizes, scalar_bytes, has_masks, 0);
+            if (prefix.file_bytes > bytes.size())
+            {
+                throw std::runtime_error("Truncated file.");
+            }
+
+            std::uint64_t count{0};
+            std::memcpy(&count, bytes.data() + prefix.optimizer_offset + sizeof(std::uint64_t),
+                        sizeof(count));
+            if (count > header.payload_bytes / scalar_bytes)
+            {
+                throw std::runtime_error("Truncated file.");
+            }
+
+            num_optimizer_values = static_cast<std::size_t>(count);
+        }
+
+        file.layout =
+            make_layout(kind, file.layer_sizes, scalar_bytes, has_masks, num_optimizer_values);
+        if (file.layout.file_bytes != bytes.size())
+        {
+            throw std::runtime_error("Truncated file.");
+        }
+
+        file.activation = make_activation(static_cast<activation::Kind>(header.activation));
+        file.criterion = make_criterion(static_cast<criterion::Kind>(header.criterion));
+        return file;
+    }
+
+    auto seal(std::span<std::byte> bytes) -> void
+    {
+        const std::uint64_t checksum = serialization::checksum(bytes.subspan(sizeof(Header)));
+        std::memcpy(bytes.data() + offsetof(Header, checksum), &checksum, sizeof(checksum));
+    }
+
+} // namespace axon::detail
@@ -0,0 +1,174 @@
+#pragma once
+
+// Layout, validation and writing of the binary files shared by models and checkpoints (see
+// `serialization.hpp` and `checkpoint.hpp`). Internal to the library.
+
+#include "activation.hpp"
+#include "checkpoint.hpp"
+#include "criterion.hpp"
+#include "network.hpp"
+#include "serialization.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace axon::detail
+{
+
+    enum class FileKind
+    {
+        model,
+        checkpoint,
+    };
+
+    inline constexpr std::array<char, 8> checkpoint_magic{'A', 'X', 'O', 'N', 'C', 'K', 'P', '\0'};
+
+    // Header flags of checkpoints that store pruning masks and optimizer state.
+    inline constexpr std::uint32_t masks_flag{1};
+    inline constexpr std::uint32_t optimizer_flag{2};
+
+    // Byte offsets of the blocks of one weighted layer. Models have no velocity or mask blocks.
+    struct LayerBlocks
+    {
+        std::size_t weights{0};
+        std::size_t biases{0};
+        std::size_t weight_velocity{0};
+        std::size_t bias_velocity{0};
+        std::size_t mask{0}; // pruned checkpoints only
+    };
+
+    // Byte offsets of every block of a file, relative to its start.
+    struct Layout
+    {
+        std::size_t layer_sizes_offset{sizeof(serialization::Header)};
+        std::size_t state_offset{0}; // checkpoints only
+        bool has_masks{false};
+        std::vector<LayerBlocks> layers;
+
+        // Checkpoints with optimizer state end with a block holding the step count and the
+        // number of values as two uint64, followed by the values from `optimizer_values`.
+        bool has_optimizer{false};
+        std::size_t optimizer_offset{0};
+        std::size_t optimizer_values{0};
+        std::size_t num_optimizer_values{0};
+
+        std::size_t file_bytes{0};
+    };
+
+    // Everything recovered from a file besides the parameter blocks.
+    struct ParsedFile
+    {
+        std::vector<std::size_t> layer_sizes;
+        Activation activation;
+        Criterion criterion;
+        Layout layout;
+    };
+
+    [[nodiscard]] auto padded(std::size_t bytes) -> std::size_t;
+
+    // `num_optimizer_values` is empty for checkpoints without optimizer state.
+    [[nodiscard]] auto make_layout(FileKind kind, const std::vector<std::size_t>& layer_sizes,
+                                   std::size_t scalar_bytes, bool has_masks = false,
+                                   std::optional<std::size_t> num_optimizer_values = {})
+        -> Layout;
+
+    // Validates the header and the layout against the size of `bytes`, and the checksum when
+    // requested. Throws `std::runtime_error` on any mismatch.
+    [[nodiscard]] auto parse(FileKind kind, std::span<const std::byte> bytes,
+                             std::size_t scalar_bytes, serialization::Verification verification)
+        -> ParsedFile;
+
+    // Stores the checksum of everything after the header into the header.
+    auto seal(std::span<std::byte> bytes) -> void;
+
+    template <std::floating_point Scalar>
+    [[nodiscard]] auto layer_sizes_of(const BasicNetwork<Scalar>& network)
+        -> std::vector<std::size_t>
+    {
+        const auto& layers = network.get_layers();
+
+        std::vector<std::size_t> layer_sizes{layers.front().num_inputs};
+        for (const auto& layer : layers)
+        {
+            layer_sizes.push_back(layer.num_outputs);
+        }
+
+        return layer_sizes;
+    }
+
+    // Writes the header (without its checksum), the topology and the parameter blocks of
+    // `network` into `bytes`, which must span `layout.file_bytes` zeroed bytes.
+    template <std::floating_point Scalar>
+    auto write_network(FileKind kind, const BasicNetwork<Scalar>& network, const Layout& layout,
+                       std::span<std::byte> bytes) -> void
+    {
+        const auto& activation = network.get_activation();
+        const auto& criterion = network.get_criterion();
+        if (activation.kind == activation::Kind::custom
+            || criterion.kind == criterion::Kind::custom)
+        {
+            throw std::invalid_argument("Custom activations and criteria cannot be saved.");
+        }
+
+        const auto& layers = network.get_layers();
+        const serialization::Header header{
+            .magic = kind == FileKind::model ? serialization::magic : checkpoint_magic,
+            .version = serialization::version,
+            .scalar_bytes = sizeof(Scalar),
+            .activation = static_cast<std::uint32_t>(activation.kind),
+            .criterion = static_cast<std::uint32_t>(criterion.kind),
+            .num_layer_sizes = layers.size() + 1,
+            .payload_bytes = bytes.size() - sizeof(serialization::Header),
+            .flags = (layout.has_masks ? masks_flag : 0)
+                     | (layout.has_optimizer ? optimizer_flag : 0),
+        };
+        std::memcpy(bytes.data(), &header, sizeof(header));
+
+        for (std::size_t i{0}; i <= layers.size(); ++i)
+        {
+            const auto size =
+                static_cast<std::uint64_t>(i == 0 ? layers.front().num_inputs
+                                                  : layers[i - 1].num_outputs);
+            std::memcpy(bytes.data() + layout.layer_sizes_offset + (i * sizeof(size)), &size,
+                        sizeof(size));
+        }
+
+        const auto write_block = [&](std::size_t offset, std::span<const Scalar> values)
+        { std::memcpy(bytes.data() + offset, values.data(), values.size() * sizeof(Scalar)); };
+
+        for (std::size_t layer_idx{0}; layer_idx < layers.size(); ++layer_idx)
+        {
+            const auto& layer = layers[layer_idx];
+            const auto& blocks = layout.layers[layer_idx];
+
+            write_block(blocks.weights, layer.weights);
+            write_block(blocks.biases, layer.biases);
+            if (kind == FileKind::checkpoint)
+            {
+                write_block(blocks.weight_velocity, layer.weight_velocity);
+                write_block(blocks.bias_velocity, layer.bias_velocity);
+            }
+
+            if (layout.has_masks)
+            {
+                const auto mask = network.get_mask(layer_idx);
+                std::memcpy(bytes.data() + blocks.mask, mask.data(), mask.size());
+            }
+        }
+    }
+
+    template <std::floating_point Scalar>
+    [[nodiscard]] auto block(std::span<const std::byte> bytes, std::size_t offset,
+                             std::size_t count) -> std::span<const Scalar>
+    {
+        return {reinterpret_cast<const Scalar*>(bytes.data() + offset), count};
+    }
+
+} // namespace axon::detail
@@ -0,0 +1,93 @@
+#include "inference_session.hpp"
+
+#include "dense.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace axon
+{
+
+    template <std::floating_point Scalar>
+    BasicInferenceSession<Scalar>::BasicInferenceSession(const BasicNetwork<Scalar>& network,
+                                                         std::size_t max_batch_size)
+        : network_(&network),
+          arena_(0, network.get_resource())
+    {
+        for (const auto& layer : network.get_layers())
+        {
+            max_width_ = std::max(max_width_, layer.num_outputs);
+        }
+
+        reserve(std::max<std::size_t>(max_batch_size, 1));
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicInferenceSession<Scalar>::forward(std::span<const Scalar> inputs,
+                                                std::size_t batch_size,
+                                                std::span<Scalar> outputs) -> void
+    {
+        const auto& layers = network_->get_layers();
+        if (batch_size == 0 || inputs.size() != batch_size * layers.front().num_inputs)
+        {
+            throw std::invalid_argument("Invalid number of inputs.");
+        }
+
+        if (outputs.size() != batch_size * layers.back().num_outputs)
+        {
+            throw std::invalid_argument("Invalid output buffer size.");
+        }
+
+        reserve(batch_size);
+
+        const Scalar* layer_inputs = inputs.data();
+        for (std::size_t layer_idx{0}; layer_idx < layers.size(); ++layer_idx)
+        {
+            const auto& layer = layers[layer_idx];
+            const bool is_last = layer_idx + 1 == layers.size();
+            Scalar* layer_outputs = is_last ? outputs.data() : activations_[layer_idx % 2].data();
+
+            AXON_TRACE_SCOPE(trace::Phase::forward, "session_forward", trace::layer_id(layer_idx),
+                             2 * batch_size * layer.weights.size(),
+                             (layer.weights.size()
+                              + (batch_size * (layer.num_inputs + layer.num_outputs)))
+                                 * sizeof(Scalar));
+            if (const auto& sparse = network_->get_sparse_weights(layer_idx);
+                detail::use_sparse(sparse, batch_size))
+            {
+                detail::sparse_forward(layer_inputs, batch_size, sparse, layer.biases.data(),
+                                       network_->get_activation(), network_->get_math_mode(),
+                                       layer_outputs);
+            }
+            else
+            {
+                detail::dense_forward(layer_inputs, batch_size, layer.num_inputs,
+                                      layer.num_outputs, layer.weights.data(),
+                                      layer.biases.data(), network_->get_activation(),
+                                      network_->get_math_mode(), layer_outputs);
+            }
+
+            layer_inputs = layer_outputs;
+        }
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicInferenceSession<Scalar>::reserve(std::size_t batch_size) -> void
+    {
+        if (batch_size <= max_batch_size_)
+        {
+            return;
+        }
+
+        const std::size_t count = batch_size * max_width_;
+        const std::size_t buffer_bytes = padded_size<Scalar>(count) * sizeof(Scalar);
+        arena_.resize(2 * buffer_bytes);
+        activations_ = {arena_.view<Scalar>(0, count), arena_.view<Scalar>(buffer_bytes, count)};
+        max_batch_size_ = batch_size;
+    }
+
+    template class BasicInferenceSession<float>;
+    template class BasicInferenceSession<double>;
+
+} // namespace axon
@@ -0,0 +1,1269 @@
+#include "kernels.hpp"
+
+#include "aligned_allocator.hpp"
+#include "scheduler.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace axon::kernels
+{
+
+    namespace
+    {
+        // NOTE(abi): block sizes follow the usual Goto/BLIS scheme: a packed kc x nr panel of B
+        // stays in L1, the packed mc x kc block of A in L2 and the kc x nc block of B in L3.
+        constexpr std::size_t block_m{96};
+        constexpr std::size_t block_k{256};
+        constexpr std::size_t block_n{1024};
+
+        constexpr std::size_t max_tile_rows{8};
+        constexpr std::size_t max_tile_cols{32};
+
+        // Columns of C that a GEMM task gathers before running the epilogue over them, so that
+        // its call per row is amortized while the rows of a block still fit in L2.
+        constexpr std::size_t epilogue_cols{256};
+
+        // Computes C += alpha * A_panel * B_panel for a full mr x nr tile, where the panels were
+        // laid out by `pack_a`/`pack_b` with depth kc.
+        template <typename Scalar>
+        using MicroKernel = void (*)(std::size_t kc, const Scalar* a, const Scalar* b,
+                                     Scalar alpha, Scalar* c, std::size_t ldc);
+
+        // Computes y += alpha * op(A) * x.
+        template <typename Scalar>
+        using GemvKernel = void (*)(std::size_t m, std::size_t n, Scalar alpha, const Scalar* a,
+                                    std::size_t lda, const Scalar* x, Scalar* y);
+
+        template <typename Scalar>
+        struct KernelTable
+        {
+            std::size_t mr;
+            std::size_t nr;
+            MicroKernel<Scalar> micro_kernel;
+            GemvKernel<Scalar> gemv;
+            GemvKernel<Scalar> gemv_transposed;
+        };
+
+        // Scalar kernels
+
+        constexpr std::size_t scalar_mr{4};
+        constexpr std::size_t scalar_nr{4};
+
+        template <typename Scalar>
+        auto micro_kernel_scalar(std::size_t kc, const Scalar* a, const Scalar* b, Scalar alpha,
+                                 Scalar* c, std::size_t ldc) -> void
+        {
+            std::array<Scalar, scalar_mr * scalar_nr> acc{};
+
+            for (std::size_t kk{0}; kk < kc; ++kk)
+            {
+                for (std::size_t r{0}; r < scalar_mr; ++r)
+                {
+                    const Scalar a_value = a[(kk * scalar_mr) + r];
+                    for (std::size_t col{0}; col < scalar_nr; ++col)
+                    {
+                        acc[(r * scalar_nr) + col] += a_value * b[(kk * scalar_nr) + col];
+                    }
+                }
+            }
+
+            for (std::size_t r{0}; r < scalar_mr; ++r)
+            {
+                for (std::size_t col{0}; col < scalar_nr; ++col)
+                {
+                    c[(r * ldc) + col] += alpha * acc[(r * scalar_nr) + col];
+                }
+            }
+        }
+
+        template <typename Scalar>
+        auto gemv_scalar(std::size_t m, std::size_t n, Scalar alpha, const Scalar* a,
+                         std::size_t lda, const Scalar* x, Scalar* y) -> void
+        {
+            for (std::size_t i{0}; i < m; ++i)
+            {
+                const Scalar* row = a + (i * lda);
+
+                Scalar sum{0};
+                for (std::size_t j{0}; j < n; ++j)
+                {
+                    sum += row[j] * x[j];
+                }
+
+                y[i] += alpha * sum;
+            }
+        }
+
+        template <typename Scalar>
+        auto gemv_transposed_scalar(std::size_t m, std::size_t n, Scalar alpha, const Scalar* a,
+                                    std::size_t lda, const Scalar* x, Scalar* y) -> void
+        {
+            for (std::size_t i{0}; i < m; ++i)
+            {
+                const Scalar* row = a + (i * lda);
+                const Scalar scale = alpha * x[i];
+
+                for (std::size_t j{0}; j < n; ++j)
+                {
+                    y[j] += scale * row[j];
+                }
+            }
+        }
+
+#if defined(AXON_SIMD_X86)
+
+        // AVX2 + FMA kernels. Tiles are 4 rows by two vectors (8 doubles or 16 floats).
+
+        constexpr std::size_t avx2_mr{4};
+
+        template <typename Scalar>
+        constexpr std::size_t avx2_nr{2 * simd::Avx2<Scalar>::width};
+
+        template <typename Scalar>
+        AXON_TARGET_AVX2 auto micro_kernel_avx2(std::size_t kc, const Scalar* a, const Scalar* b,
+                                                Scalar alpha, Scalar* c, std::size_t ldc) -> void
+        {
+            using Ops = simd::Avx2<Scalar>;
+            using Vector = typename Ops::Vector;
+            constexpr std::size_t width{Ops::width};
+
+            Vector c00 = Ops::zero();
+            Vector c01 = Ops::zero();
+            Vector c10 = Ops::zero();
+            Vector c11 = Ops::zero();
+            Vector c20 = Ops::zero();
+            Vector c21 = Ops::zero();
+            Vector c30 = Ops::zero();
+            Vector c31 = Ops::zero();
+
+            for (std::size_t kk{0}; kk < kc; ++kk)
+            {
+                const Vector b0 = Ops::load(b);
+                const Vector b1 = Ops::load(b + width);
+
+                Vector a_value = Ops::broadcast(a[0]);
+                c00 = Ops::fmadd(a_value, b0, c00);
+                c01 = Ops::fmadd(a_value, b1, c01);
+
+                a_value = Ops::broadcast(a[1]);
+                c10 = Ops::fmadd(a_value, b0, c10);
+                c11 = Ops::fmadd(a_value, b1, c11);
+
+                a_value = Ops::broadcast(a[2]);
+                c20 = Ops::fmadd(a_value, b0, c20);
+                c21 = Ops::fmadd(a_value, b1, c21);
+
+                a_value = Ops::broadcast(a[3]);
+                c30 = Ops::fmadd(a_value, b0, c30);
+                c31 = Ops::fmadd(a_value, b1, c31);
+
+                a += avx2_mr;
+                b += avx2_nr<Scalar>;
+            }
+
+            const Vector alpha_vec = Ops::broadcast(alpha);
+
+            Scalar* row = c;
+            Ops::store(row, Ops::fmadd(alpha_vec, c00, Ops::load(row)));
+            Ops::store(row + width, Ops::fmadd(alpha_vec, c01, Ops::load(row + width)));
+
+            row += ldc;
+            Ops::store(row, Ops::fmadd(alpha_vec, c10, Ops::load(row)));
+            Ops::store(row + width, Ops::fmadd(alpha_vec, c11, Ops::load(row + width)));
+
+            row += ldc;
+            Ops::store(row, Ops::fmadd(alpha_vec, c20, Ops::load(row)));
+            Ops::store(row + width, Ops::fmadd(alpha_vec, c21, Ops::load(row + width)));
+
+            row += ldc;
+            Ops::store(row, Ops::fmadd(alpha_vec, c30, Ops::load(row)));
+            Ops::store(row + width, Ops::fmadd(alpha_vec, c31, Ops::load(row + width)));
+        }
+
+        template <typename Scalar>
+        AXON_TARGET_AVX2 auto gemv_avx2(std::size_t m, std::size_t n, Scalar alpha,
+                                        const Scalar* a, std::size_t lda, const Scalar* x,
+                                        Scalar* y) -> void
+        {
+            using Ops = simd::Avx2<Scalar>;
+            using Vector = typename Ops::Vector;
+            constexpr std::size_t width{Ops::width};
+            const std::size_t vector_end = n - (n % width);
+
+            std::size_t i{0};
+            for (; i + 4 <= m; i += 4)
+            {
+                const Scalar* row0 = a + (i * lda);
+                const Scalar* row1 = row0 + lda;
+                const Scalar* row2 = row1 + lda;
+                const Scalar* row3 = row2 + lda;
+
+                Vector acc0 = Ops::zero();
+                Vector acc1 = Ops::zero();
+                Vector acc2 = Ops::zero();
+                Vector acc3 = Ops::zero();
+
+                std::size_t j{0};
+                for (; j < vector_end; j += width)
+                {
+                    const Vector x_vec = Ops::load(x + j);
+                    acc0 = Ops::fmadd(Ops::load(row0 + j), x_vec, acc0);
+                    acc1 = Ops::fmadd(Ops::load(row1 + j), x_vec, acc1);
+                    acc2 = Ops::fmadd(Ops::load(row2 + j), x_vec, acc2);
+                    acc3 = Ops::fmadd(Ops::load(row3 + j), x_vec, acc3);
+                }
+
+                Scalar sum0 = Ops::reduce_add(acc0);
+                Scalar sum1 = Ops::reduce_add(acc1);
+                Scalar sum2 = Ops::reduce_add(acc2);
+                Scalar sum3 = Ops::reduce_add(acc3);
+
+                for (; j < n; ++j)
+                {
+                    sum0 += row0[j] * x[j];
+                    sum1 += row1[j] * x[j];
+                    sum2 += row2[j] * x[j];
+                    sum3 += row3[j] * x[j];
+                }
+
+                y[i] += alpha * sum0;
+                y[i + 1] += alpha * sum1;
+                y[i + 2] += alpha * sum2;
+                y[i + 3] += alpha * sum3;
+            }
+
+            for (; i < m; ++i)
+            {
+                const Scalar* row = a + (i * lda);
+
+                Vector acc = Ops::zero();
+
+                std::size_t j{0};
+                for (; j < vector_end; j += width)
+                {
+                    acc = Ops::fmadd(Ops::load(row + j), Ops::load(x + j), acc);
+                }
+
+                Scalar sum = Ops::reduce_add(acc);
+                for (; j < n; ++j)
+                {
+                    sum += row[j] * x[j];
+                }
+
+                y[i] += alpha * sum;
+            }
+        }
+
+        template <typename Scalar>
+        AXON_TARGET_AVX2 auto gemv_transposed_avx2(std::size_t m, std::size_t n, Scalar alpha,
+                                                   const Scalar* a, std::size_t lda,
+                                                   const Scalar* x, Scalar* y) -> void
+        {
+            using Ops = simd::Avx2<Scalar>;
+            using Vector = typename Ops::Vector;
+            constexpr std::size_t width{Ops::width};
+            const std::size_t vector_end = n - (n % width);
+
+            std::size_t i{0};
+            for (; i + 4 <= m; i += 4)
+            {
+                const Scalar* row0 = a + (i * lda);
+                const Scalar* row1 = row0 + lda;
+                const Scalar* row2 = row1 + lda;
+                const Scalar* row3 = row2 + lda;
+
+                const Scalar scale0 = alpha * x[i];
+                const Scalar scale1 = alpha * x[i + 1];
+                const Scalar scale2 = alpha * x[i + 2];
+                const Scalar scale3 = alpha * x[i + 3];
+
+                const Vector s0 = Ops::broadcast(scale0);
+                const Vector s1 = Ops::broadcast(scale1);
+                const Vector s2 = Ops::broadcast(scale2);
+                const Vector s3 = Ops::broadcast(scale3);
+
+                std::size_t j{0};
+                for (; j < vector_end; j += width)
+                {
+                    Vector y_vec = Ops::load(y + j);
+                    y_vec = Ops::fmadd(s0, Ops::load(row0 + j), y_vec);
+                    y_vec = Ops::fmadd(s1, Ops::load(row1 + j), y_vec);
+                    y_vec = Ops::fmadd(s2, Ops::load(row2 + j), y_vec);
+                    y_vec = Ops::fmadd(s3, Ops::load(row3 + j), y_vec);
+                    Ops::store(y + j, y_vec);
+                }
+
+                for (; j < n; ++j)
+                {
+                    y[j] += (scale0 * row0[j]) + (scale1 * row1[j]) + (scale2 * row2[j])
+                            + (scale3 * row3[j]);
+                }
+            }
+
+            for (; i < m; ++i)
+            {
+                const Scalar* row = a + (i * lda);
+                const Scalar scale = alpha * x[i];
+                const Vector s = Ops::broadcast(scale);
+
+                std::size_t j{0};
+                for (; j < vector_end; j += width)
+                {
+                    Ops::store(y + j, Ops::fmadd(s, Ops::load(row + j), Ops::load(y + j)));
+                }
+
+                for (; j < n; ++j)
+                {
+                    y[j] += scale * row[j];
+                }
+            }
+        }
+
+        // AVX-512 kernels. Tiles are 8 rows by two vectors (16 doubles or 32 floats).
+
+        constexpr std::size_t avx512_mr{8};
+
+        template <typename Scalar>
+        constexpr std::size_t avx512_nr{2 * simd::Avx512<Scalar>::width};
+
+        template <typename Scalar>
+        AXON_TARGET_AVX512 auto micro_kernel_avx512(std::size_t kc, const Scalar* a,
+                                                    const Scalar* b, Scalar alpha, Scalar* c,
+                                                    std::size_t ldc) -> void
+        {
+            using Ops = simd::Avx512<Scalar>;
+            using Vector = typename Ops::Vector;
+            constexpr std::size_t width{Ops::width};
+
+            // NOTE(abi): plain arrays on purpose, std::array would drop the vector alignment
+            // attributes. Fully unrolled, they live in the 16 accumulator registers.
+            Vector lo[avx512_mr]; // NOLINT(*-avoid-c-arrays)
+            Vector hi[avx512_mr]; // NOLINT(*-avoid-c-arrays)
+
+    #pragma GCC unroll 8
+            for (std::size_t r{0}; r < avx512_mr; ++r)
+            {
+                lo[r] = Ops::zero();
+                hi[r] = Ops::zero();
+            }
+
+            for (std::size_t kk{0}; kk < kc; ++kk)
+            {
+                const Vector b0 = Ops::load(b);
+                const Vector b1 = Ops::load(b + width);
+
+    #pragma GCC unroll 8
+                for (std::size_t r{0}; r < avx512_mr; ++r)
+                {
+                    const Vector a_value = Ops::broadcast(a[r]);
+                    lo[r] = Ops::fmadd(a_value, b0, lo[r]);
+                    hi[r] = Ops::fmadd(a_value, b1, hi[r]);
+                }
+
+                a += avx512_mr;
+                b += avx512_nr<Scalar>;
+            }
+
+            const Vector alpha_vec = Ops::broadcast(alpha);
+
+    #pragma GCC unroll 8
+            for (std::size_t r{0}; r < avx512_mr; ++r)
+            {
+                Scalar* row = c + (r * ldc);
+                Ops::store(row, Ops::fmadd(alpha_vec, lo[r], Ops::load(row)));
+                Ops::store(row + width, Ops::fmadd(alpha_vec, hi[r], Ops::load(row + width)));
+            }
+        }
+
+        template <typename Scalar>
+        AXON_TARGET_AVX512 auto gemv_avx512(std::size_t m, std::size_t n, Scalar alpha,
+                                            const Scalar* a, std::size_t lda, const Scalar* x,
+                                            Scalar* y) -> void
+        {
+            using Ops = simd::Avx512<Scalar>;
+            using Vector = typename Ops::Vector;
+            constexpr std::size_t width{Ops::width};
+            const std::size_t vector_end = n - (n % width);
+            const auto mask = Ops::tail_mask(n % width);
+
+            std::size_t i{0};
+            for (; i + 4 <= m; i += 4)
+            {
+                const Scalar* row0 = a + (i * lda);
+                const Scalar* row1 = row0 + lda;
+                const Scalar* row2 = row1 + lda;
+                const Scalar* row3 = row2 + lda;
+
+                Vector acc0 = Ops::zero();
+                Vector acc1 = Ops::zero();
+                Vector acc2 = Ops::zero();
+                Vector acc3 = Ops::zero();
+
+                for (std::size_t j{0}; j < vector_end; j += width)
+                {
+                    const Vector x_vec = Ops::load(x + j);
+                    acc0 = Ops::fmadd(Ops::load(row0 + j), x_vec, acc0);
+                    acc1 = Ops::fmadd(Ops::load(row1 + j), x_vec, acc1);
+                    acc2 = Ops::fmadd(Ops::load(row2 + j), x_vec, acc2);
+                    acc3 = Ops::fmadd(Ops::load(row3 + j), x_vec, acc3);
+                }
+
+                if (mask != 0)
+                {
+                    const Vector x_vec = Ops::load(mask, x + vector_end);
+                    acc0 = Ops::fmadd(Ops::load(mask, row0 + vector_end), x_vec, acc0);
+                    acc1 = Ops::fmadd(Ops::load(mask, row1 + vector_end), x_vec, acc1);
+                    acc2 = Ops::fmadd(Ops::load(mask, row2 + vector_end), x_vec, acc2);
+                    acc3 = Ops::fmadd(Ops::load(mask, row3 + vector_end), x_vec, acc3);
+                }
+
+                y[i] += alpha * Ops::reduce_add(acc0);
+                y[i + 1] += alpha * Ops::reduce_add(acc1);
+                y[i + 2] += alpha * Ops::reduce_add(acc2);
+                y[i + 3] += alpha * Ops::reduce_add(acc3);
+            }
+
+            for (; i < m; ++i)
+            {
+                const Scalar* row = a + (i * lda);
+
+                Vector acc = Ops::zero();
+                for (std::size_t j{0}; j < vector_end; j += width)
+                {
+                    acc = Ops::fmadd(Ops::load(row + j), Ops::load(x + j), acc);
+                }
+
+                if (mask != 0)
+                {
+                    acc = Ops::fmadd(Ops::load(mask, row + vector_end),
+                                     Ops::load(mask, x + vector_end), acc);
+                }
+
+                y[i] += alpha * Ops::reduce_add(acc);
+            }
+        }
+
+        template <typename Scalar>
+        AXON_TARGET_AVX512 auto gemv_transposed_avx512(std::size_t m, std::size_t n, Scalar alpha,
+                                                       const Scalar* a, std::size_t lda,
+                                                       const Scalar* x, Scalar* y) -> void
+        {
+            using Ops = simd::Avx512<Scalar>;
+            using Vector = typename Ops::Vector;
+            constexpr std::size_t width{Ops::width};
+            const std::size_t vector_end = n - (n % width);
+            const auto mask = Ops::tail_mask(n % width);
+
+            std::size_t i{0};
+            for (; i + 4 <= m; i += 4)
+            {
+                const Scalar* row0 = a + (i * lda);
+                const Scalar* row1 = row0 + lda;
+                const Scalar* row2 = row1 + lda;
+                const Scalar* row3 = row2 + lda;
+
+                const Vector s0 = Ops::broadcast(alpha * x[i]);
+                const Vector s1 = Ops::broadcast(alpha * x[i + 1]);
+                const Vector s2 = Ops::broadcast(alpha * x[i + 2]);
+                const Vector s3 = Ops::broadcast(alpha * x[i + 3]);
+
+                for (std::size_t j{0}; j < vector_end; j += width)
+                {
+                    Vector y_vec = Ops::load(y + j);
+                    y_vec = Ops::fmadd(s0, Ops::load(row0 + j), y_vec);
+                    y_vec = Ops::fmadd(s1, Ops::load(row1 + j), y_vec);
+                    y_vec = Ops::fmadd(s2, Ops::load(row2 + j), y_vec);
+                    y_vec = Ops::fmadd(s3, Ops::load(row3 + j), y_vec);
+                    Ops::store(y + j, y_vec);
+                }
+
+                if (mask != 0)
+                {
+                    Scalar* y_tail = y + vector_end;
+                    Vector y_vec = Ops::load(mask, y_tail);
+                    y_vec = Ops::fmadd(s0, Ops::load(mask, row0 + vector_end), y_vec);
+                    y_vec = Ops::fmadd(s1, Ops::load(mask, row1 + vector_end), y_vec);
+                    y_vec = Ops::fmadd(s2, Ops::load(mask, row2 + vector_end), y_vec);
+                    y_vec = Ops::fmadd(s3, Ops::load(mask, row3 + vector_end), y_vec);
+                    Ops::store(y_tail, mask, y_vec);
+                }
+            }
+
+            for (; i < m; ++i)
+            {
+                const Scalar* row = a + (i * lda);
+                const Vector s = Ops::broadcast(alpha * x[i]);
+
+                for (std::size_t j{0}; j < vector_end; j += width)
+                {
+                    Ops::store(y + j, Ops::fmadd(s, Ops::load(row + j), Ops::load(y + j)));
+                }
+
+                if (mask != 0)
+                {
+                    Scalar* y_tail = y + vector_end;
+                    Ops::store(y_tail, mask,
+                               Ops::fmadd(s, Ops::load(mask, row + vector_end),
+                                          Ops::load(mask, y_tail)));
+                }
+            }
+        }
+
+#endif // AXON_SIMD_X86
+
+        template <typename Scalar>
+        constexpr KernelTable<Scalar> scalar_table{
+            .mr = scalar_mr,
+            .nr = scalar_nr,
+            .micro_kernel = micro_kernel_scalar<Scalar>,
+            .gemv = gemv_scalar<Scalar>,
+            .gemv_transposed = gemv_transposed_scalar<Scalar>,
+        };
+
+#if defined(AXON_SIMD_X86)
+        template <typename Scalar>
+        constexpr KernelTable<Scalar> avx2_table{
+            .mr = avx2_mr,
+            .nr = avx2_nr<Scalar>,
+            .micro_kernel = micro_kernel_avx2<Scalar>,
+            .gemv = gemv_avx2<Scalar>,
+            .gemv_transposed = gemv_transposed_avx2<Scalar>,
+        };
+
+        template <typename Scalar>
+        constexpr KernelTable<Scalar> avx512_table{
+            .mr = avx512_mr,
+            .nr = avx512_nr<Scalar>,
+            .micro_kernel = micro_kernel_avx512<Scalar>,
+            .gemv = gemv_avx512<Scalar>,
+            .gemv_transposed = gemv_transposed_avx512<Scalar>,
+        };
+
+        static_assert(avx512_nr<float> <= max_tile_cols);
+#endif
+
+        template <typename Scalar>
+        auto table_for(Isa isa) -> const KernelTable<Scalar>&
+        {
+#if defined(AXON_SIMD_X86)
+            switch (isa)
+            {
+            case Isa::avx512:
+                return avx512_table<Scalar>;
+            case Isa::avx2:
+                return avx2_table<Scalar>;
+            case Isa::scalar:
+                break;
+            }
+#endif
+            static_cast<void>(isa);
+            return scalar_table<Scalar>;
+        }
+
+        // NOTE(abi): one selection covers both scalar types, so `set_isa` switches every kernel
+        // at once.
+        auto active_isa() -> std::atomic<Isa>&
+        {
+            static std::atomic<Isa> isa{detect_isa()};
+            return isa;
+        }
+
+        template <typename Scalar>
+        auto active_table() -> const KernelTable<Scalar>&
+        {
+            return table_for<Scalar>(active_isa().load(std::memory_order_relaxed));
+        }
+
+        // Packing
+
+        template <typename Scalar>
+        [[nodiscard]] auto element(Transpose trans, const Scalar* matrix, std::size_t ld,
+                                   std::size_t row, std::size_t col) -> Scalar
+        {
+            return trans == Transpose::no ? matrix[(row * ld) + col] : matrix[(col * ld) + row];
+        }
+
+        // Copies the mc x kc block of op(A) starting at (row0, col0) into consecutive panels of
+        // mr rows, each stored column by column and zero-padded to a full panel.
+        template <typename Scalar>
+        auto pack_a(Transpose trans, const Scalar* a, std::size_t lda, std::size_t row0,
+                    std::size_t col0, std::size_t mc, std::size_t kc, std::size_t mr,
+                    Scalar* packed) -> void
+        {
+            for (std::size_t panel{0}; panel < mc; panel += mr)
+            {
+                const std::size_t rows = std::min(mr, mc - panel);
+                Scalar* dst = packed + (panel * kc);
+
+                if (trans == Transpose::no)
+                {
+                    for (std::size_t r{0}; r < mr; ++r)
+                    {
+                        if (r >= rows)
+                        {
+                            for (std::size_t kk{0}; kk < kc; ++kk)
+                            {
+                                dst[(kk * mr) + r] = Scalar{0};
+                            }
+                            continue;
+                        }
+
+                        const Scalar* src = a + ((row0 + panel + r) * lda) + col0;
+                        for (std::size_t kk{0}; kk < kc; ++kk)
+                        {
+                            dst[(kk * mr) + r] = src[kk];
+                        }
+                    }
+                }
+                else
+                {
+                    for (std::size_t kk{0}; kk < kc; ++kk)
+                    {
+                        for (std::size_t r{0}; r < mr; ++r)
+                        {
+                            dst[(kk * mr) + r] =
+                                r < rows ? element(trans, a, lda, row0 + panel + r, col0 + kk)
+                                         : Scalar{0};
+                        }
+                    }
+                }
+            }
+        }
+
+        // Copies the kc x nc block of op(B) starting at (row0, col0) into consecutive panels of
+        // nr columns, each stored row by row and zero-padded to a full panel.
+        template <typename Scalar>
+        auto pack_b(Transpose trans, const Scalar* b, std::size_t ldb, std::size_t row0,
+                    std::size_t col0, std::size_t kc, std::size_t nc, std::size_t nr,
+                    Scalar* packed) -> void
+        {
+            for (std::size_t panel{0}; panel < nc; panel += nr)
+            {
+                const std::size_t cols = std::min(nr, nc - panel);
+                Scalar* dst = packed + (panel * kc);
+
+                if (trans == Transpose::no)
+                {
+                    for (std::size_t kk{0}; kk < kc; ++kk)
+                    {
+                        const Scalar* src = b + ((row0 + kk) * ldb) + col0 + panel;
+                        for (std::size_t col{0}; col < nr; ++col)
+                        {
+                            dst[(kk * nr) + col] = col < cols ? src[col] : Scalar{0};
+                        }
+                    }
+                }
+                else
+                {
+                    for (std::size_t col{0}; col < nr; ++col)
+                    {
+                        if (col >= cols)
+                        {
+                            for (std::size_t kk{0}; kk < kc; ++kk)
+                            {
+                                dst[(kk * nr) + col] = Scalar{0};
+                            }
+                            continue;
+                        }
+
+                        const Scalar* src = b + ((col0 + panel + col) * ldb) + row0;
+                        for (std::size_t kk{0}; kk < kc; ++kk)
+                        {
+                            dst[(kk * nr) + col] = src[kk];
+                        }
+                    }
+                }
+            }
+        }
+
+        template <typename Scalar>
+        auto scale_matrix(std::size_t m, std::size_t n, Scalar beta, Scalar* c, std::size_t ldc)
+            -> void
+        {
+            if (beta == Scalar{1})
+            {
+                return;
+            }
+
+            for (std::size_t i{0}; i < m; ++i)
+            {
+                Scalar* row = c + (i * ldc);
+                if (beta == Scalar{0})
+                {
+                    std::fill(row, row + n, Scalar{0});
+                }
+                else
+                {
+                    std::transform(row, row + n, row,
+                                   [beta](Scalar value) { return beta * value; });
+                }
+            }
+        }
+
+        // Per-thread buffer for the packed block of B, shared read-only with the tasks of a GEMM.
+        // NOTE(abi): a thread waiting on its GEMM helps with other pending work, which may be
+        // another GEMM (e.g. from a different training shard) that must not overwrite the block
+        // still being read, so each nesting level gets a buffer of its own.
+        template <typename Scalar>
+        class PackingBuffer
+        {
+        public:
+            PackingBuffer()
+            {
+                if (buffers.size() == depth)
+                {
+                    buffers.push_back(std::make_unique<AlignedVector<Scalar>>(block_k * block_n));
+                }
+                buffer_ = buffers[depth].get();
+                ++depth;
+            }
+
+            ~PackingBuffer()
+            {
+                --depth;
+            }
+
+            PackingBuffer(const PackingBuffer&) = delete;
+            PackingBuffer(PackingBuffer&&) = delete;
+            auto operator=(const PackingBuffer&) -> PackingBuffer& = delete;
+            auto operator=(PackingBuffer&&) -> PackingBuffer& = delete;
+
+            [[nodiscard]] auto get() const -> AlignedVector<Scalar>&
+            {
+                return *buffer_;
+            }
+
+        private:
+            AlignedVector<Scalar>* buffer_;
+
+            inline static thread_local std::vector<std::unique_ptr<AlignedVector<Scalar>>> buffers;
+            inline static thread_local std::size_t depth{0};
+        };
+
+        // Number of columns of y handled by one task of a transposed product.
+        constexpr std::size_t gemv_slice_cols{16};
+
+        // y += alpha * op(A) * x, split across the scheduler once large enough: by rows of A
+        // when it is not transposed, and by slices of the columns of y when it is, so that no
+        // two tasks ever write the same entry.
+        template <typename Scalar>
+        auto run_gemv(const KernelTable<Scalar>& table, Transpose trans, std::size_t m,
+                      std::size_t n, Scalar alpha, const Scalar* a, std::size_t lda,
+                      const Scalar* x, Scalar* y) -> void
+        {
+            if (trans == Transpose::no)
+            {
+                Scheduler::instance().parallel_for(m, grain_size(n),
+                                                   [&](std::size_t begin, std::size_t end)
+                                                   {
+                                                       table.gemv(end - begin, n, alpha,
+                                                                  a + (begin * lda), lda, x,
+                                                                  y + begin);
+                                                   });
+                return;
+            }
+
+            const std::size_t num_slices = (n + gemv_slice_cols - 1) / gemv_slice_cols;
+            Scheduler::instance().parallel_for(
+                num_slices, grain_size(gemv_slice_cols * m),
+                [&](std::size_t begin, std::size_t end)
+                {
+                    const std::size_t first_col = begin * gemv_slice_cols;
+                    const std::size_t last_col = std::min(end * gemv_slice_cols, n);
+                    table.gemv_transposed(m, last_col - first_col, alpha, a + first_col, lda, x,
+                                          y + first_col);
+                });
+        }
+
+        // Applies `epilogue` to the rows x cols block of C at `c`, whose first column is column
+        // `col0` of the whole matrix.
+        template <typename Scalar>
+        auto apply_epilogue(const Epilogue<Scalar>& epilogue, Scalar* c, std::size_t ldc,
+                            std::size_t rows, std::size_t col0, std::size_t cols) -> void
+        {
+            for (std::size_t r{0}; r < rows; ++r)
+            {
+                Scalar* row = c + (r * ldc);
+                if (epilogue.bias != nullptr)
+                {
+                    const Scalar* bias = epilogue.bias + col0;
+                    for (std::size_t col{0}; col < cols; ++col)
+                    {
+                        row[col] += bias[col];
+                    }
+                }
+
+                if (epilogue.apply != nullptr)
+                {
+                    epilogue.apply({row, cols}, epilogue.context);
+                }
+            }
+        }
+
+        template <typename Scalar>
+        auto gemm_impl(Transpose trans_a, Transpose trans_b, std::size_t m, std::size_t n,
+                       std::size_t k, Scalar alpha, const Scalar* a, std::size_t lda,
+                       const Scalar* b, std::size_t ldb, Scalar beta, Scalar* c, std::size_t ldc,
+                       const Epilogue<Scalar>* epilogue = nullptr) -> void
+        {
+            if (m == 0 || n == 0)
+            {
+                return;
+            }
+
+            scale_matrix(m, n, beta, c, ldc);
+
+            if (k == 0 || alpha == Scalar{0})
+            {
+                if (epilogue != nullptr)
+                {
+                    apply_epilogue(*epilogue, c, ldc, m, 0, n);
+                }
+                return;
+            }
+
+            const KernelTable<Scalar>& table = active_table<Scalar>();
+
+            // NOTE(abi): a single row of output is a matrix-vector product in disguise, and
+            // packing would cost as much as the product itself.
+            if (m == 1 && trans_a == Transpose::no)
+            {
+                if (trans_b == Transpose::no)
+                {
+                    run_gemv(table, Transpose::yes, k, n, alpha, b, ldb, a, c);
+                }
+                else
+                {
+                    run_gemv(table, Transpose::no, n, k, alpha, b, ldb, a, c);
+                }
+
+                if (epilogue != nullptr)
+                {
+                    apply_epilogue(*epilogue, c, ldc, 1, 0, n);
+                }
+                return;
+            }
+
+            const std::size_t mr = table.mr;
+            const std::size_t nr = table.nr;
+
+            const PackingBuffer<Scalar> packing_buffer;
+            AlignedVector<Scalar>& packed_b = packing_buffer.get();
+
+            for (std::size_t jc{0}; jc < n; jc += block_n)
+            {
+                const std::size_t nc = std::min(block_n, n - jc);
+                const std::size_t num_panels = (nc + nr - 1) / nr;
+                const std::size_t num_row_blocks = (m + block_m - 1) / block_m;
+
+                for (std::size_t pc{0}; pc < k; pc += block_k)
+                {
+                    const std::size_t kc = std::min(block_k, k - pc);
+                    pack_b(trans_b, b, ldb, pc, jc, kc, nc, nr, packed_b.data());
+
+                    // NOTE(abi): the epilogue runs with the last block of k, on runs of up to
+                    // `epilogue_cols` columns of one row block that a task has just finished,
+                    // while they are still in L2.
+                    const Epilogue<Scalar>* last_epilogue = pc + kc == k ? epilogue : nullptr;
+
+                    // NOTE(abi): the work is split into (row block, column panel) pairs, ordered
+                    // so that a task walking consecutive pairs repacks its block of A only when
+                    // it moves on to the next row block. Every task shares the packed B.
+                    const Scalar* packed_panels = packed_b.data();
+                    const std::size_t panel_cost = std::min(block_m, m) * kc * nr;
+
+                    Scheduler::instance().parallel_for(
+                        num_row_blocks * num_panels, grain_size(panel_cost),
+                        [&](std::size_t begin, std::size_t end)
+                        {
+                            thread_local AlignedVector<Scalar> packed_a(block_m * block_k);
+                            std::size_t packed_block{num_row_blocks};
+
+                            // Columns [run_begin, run_end) of the current row block, done but
+                            // still waiting for the epilogue.
+                            std::size_t run_begin{0};
+                            std::size_t run_end{0};
+                            const auto finish_run = [&]
+                            {
+                                if (run_end > run_begin)
+                                {
+                                    const std::size_t ic = packed_block * block_m;
+                                    apply_epilogue(*last_epilogue, c + (ic * ldc) + jc + run_begin,
+                                                   ldc, std::min(block_m, m - ic),
+                                                   jc + run_begin, run_end - run_begin);
+                                }
+                            };
+
+                            for (std::size_t item{begin}; item < end; ++item)
+                            {
+                                const std::size_t row_block = item / num_panels;
+                                const std::size_t ic = row_block * block_m;
+                                const std::size_t mc = std::min(block_m, m - ic);
+                                const std::size_t jr = (item % num_panels) * nr;
+                                const std::size_t cols = std::min(nr, nc - jr);
+
+                                if (last_epilogue != nullptr
+                                    && (row_block != packed_block || jr != run_end
+                                        || run_end - run_begin >= epilogue_cols))
+                                {
+                                    finish_run();
+                                    run_begin = jr;
+                                }
+                                run_end = jr + cols;
+
+                                if (row_block != packed_block)
+                                {
+                                    pack_a(trans_a, a, lda, ic, pc, mc, kc, mr, packed_a.data());
+                                    packed_block = row_block;
+                                }
+
+                                const Scalar* b_panel = packed_panels + (jr * kc);
+
+                                for (std::size_t ir{0}; ir < mc; ir += mr)
+                                {
+                                    const std::size_t rows = std::min(mr, mc - ir);
+                                    const Scalar* a_panel = packed_a.data() + (ir * kc);
+                                    Scalar* c_tile = c + ((ic + ir) * ldc) + jc + jr;
+
+                                    if (rows == mr && cols == nr)
+                                    {
+                                        table.micro_kernel(kc, a_panel, b_panel, alpha, c_tile,
+                                                           ldc);
+                                        continue;
+                                    }
+
+                                    std::array<Scalar, max_tile_rows * max_tile_cols> tile{};
+                                    table.micro_kernel(kc, a_panel, b_panel, alpha, tile.data(),
+                                                       nr);
+
+                                    for (std::size_t r{0}; r < rows; ++r)
+                                    {
+                                        for (std::size_t col{0}; col < cols; ++col)
+                                        {
+                                            c_tile[(r * ldc) + col] += tile[(r * nr) + col];
+                                        }
+                                    }
+                                }
+                            }
+
+                            if (last_epilogue != nullptr)
+                            {
+                                finish_run();
+                            }
+                        });
+                }
+            }
+        }
+
+        template <typename Scalar>
+        auto gemv_impl(Transpose trans, std::size_t m, std::size_t n, Scalar alpha,
+                       const Scalar* a, std::size_t lda, const Scalar* x, Scalar beta, Scalar* y)
+            -> void
+        {
+            const std::size_t y_size = trans == Transpose::no ? m : n;
+            scale_matrix(1, y_size, beta, y, y_size);
+
+            if (m == 0 || n == 0 || alpha == Scalar{0})
+            {
+                return;
+            }
+
+            run_gemv(active_table<Scalar>(), trans, m, n, alpha, a, lda, x, y);
+        }
+
+
+        // Integer kernels. Each computes c[j] = sum_p a[p] * b[j * ldb + p] for one row of A
+        // against `n` rows of B, four rows of B at a time so that every load of A is reused.
+
+        using Int8Kernel = void (*)(std::size_t n, std::size_t k, const std::uint8_t* a,
+                                    const std::int8_t* b, std::size_t ldb, std::int32_t* c);
+
+        auto dot_u8s8(std::size_t begin, std::size_t end, const std::uint8_t* a,
+                      const std::int8_t* b) -> std::int32_t
+        {
+            std::int32_t sum{0};
+            for (std::size_t p{begin}; p < end; ++p)
+            {
+                sum += static_cast<std::int32_t>(a[p]) * static_cast<std::int32_t>(b[p]);
+            }
+
+            return sum;
+        }
+
+        auto int8_kernel_scalar(std::size_t n, std::size_t k, const std::uint8_t* a,
+                                const std::int8_t* b, std::size_t ldb, std::int32_t* c) -> void
+        {
+            for (std::size_t j{0}; j < n; ++j)
+            {
+                c[j] = dot_u8s8(0, k, a, b + (j * ldb));
+            }
+        }
+
+#if defined(AXON_SIMD_X86)
+
+        // NOTE(abi): without VNNI there is no exact u8 x s8 byte product (`maddubs` saturates
+        // to 16 bits), so both operands are widened to 16 bits and multiplied pairwise instead.
+        AXON_SIMD_AVX2 inline auto madd_u8s8_avx2(__m256i sum, const std::uint8_t* a,
+                                                  const std::int8_t* b) -> __m256i
+        {
+            const __m256i a16 =
+                _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)));
+            const __m256i b16 =
+                _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b)));
+            return _mm256_add_epi32(sum, _mm256_madd_epi16(a16, b16));
+        }
+
+        AXON_SIMD_AVX2 inline auto reduce_add_epi32_avx2(__m256i value) -> std::int32_t
+        {
+            __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(value),
+                                        _mm256_extracti128_si256(value, 1));
+            sum = _mm_add_epi32(sum, _mm_unpackhi_epi64(sum, sum));
+            sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 1));
+            return _mm_cvtsi128_si32(sum);
+        }
+
+        AXON_TARGET_AVX2 auto int8_kernel_avx2(std::size_t n, std::size_t k,
+                                               const std::uint8_t* a, const std::int8_t* b,
+                                               std::size_t ldb, std::int32_t* c) -> void
+        {
+            constexpr std::size_t step{16};
+            const std::size_t k_main = k - (k % step);
+
+            std::size_t j{0};
+            for (; j + 4 <= n; j += 4)
+            {
+                const std::int8_t* b0 = b + (j * ldb);
+                const std::int8_t* b1 = b0 + ldb;
+                const std::int8_t* b2 = b1 + ldb;
+                const std::int8_t* b3 = b2 + ldb;
+
+                __m256i c0 = _mm256_setzero_si256();
+                __m256i c1 = _mm256_setzero_si256();
+                __m256i c2 = _mm256_setzero_si256();
+                __m256i c3 = _mm256_setzero_si256();
+
+                for (std::size_t p{0}; p < k_main; p += step)
+                {
+                    c0 = madd_u8s8_avx2(c0, a + p, b0 + p);
+                    c1 = madd_u8s8_avx2(c1, a + p, b1 + p);
+                    c2 = madd_u8s8_avx2(c2, a + p, b2 + p);
+                    c3 = madd_u8s8_avx2(c3, a + p, b3 + p);
+                }
+
+                c[j] = reduce_add_epi32_avx2(c0) + dot_u8s8(k_main, k, a, b0);
+                c[j + 1] = reduce_add_epi32_avx2(c1) + dot_u8s8(k_main, k, a, b1);
+                c[j + 2] = reduce_add_epi32_avx2(c2) + dot_u8s8(k_main, k, a, b2);
+                c[j + 3] = reduce_add_epi32_avx2(c3) + dot_u8s8(k_main, k, a, b3);
+            }
+
+            for (; j < n; ++j)
+            {
+                const std::int8_t* row = b + (j * ldb);
+
+                __m256i sum = _mm256_setzero_si256();
+                for (std::size_t p{0}; p < k_main; p += step)
+                {
+                    sum = madd_u8s8_avx2(sum, a + p, row + p);
+                }
+
+                c[j] = reduce_add_epi32_avx2(sum) + dot_u8s8(k_main, k, a, row);
+            }
+        }
+
+        // `vpdpbusd` multiplies groups of four u8 x s8 pairs and adds them to each 32-bit lane
+        // in a single instruction, without intermediate saturation.
+        AXON_SIMD_AVX512_VNNI inline auto dpbusd_avx512(__m512i sum, const std::uint8_t* a,
+                                                        const std::int8_t* b) -> __m512i
+        {
+            return _mm512_dpbusd_epi32(sum, _mm512_loadu_si512(a), _mm512_loadu_si512(b));
+        }
+
+        AXON_TARGET_AVX512_VNNI auto int8_kernel_avx512_vnni(std::size_t n, std::size_t k,
+                                                             const std::uint8_t* a,
+                                                             const std::int8_t* b,
+                                                             std::size_t ldb, std::int32_t* c)
+            -> void
+        {
+            constexpr std::size_t step{64};
+            const std::size_t k_main = k - (k % step);
+
+            std::size_t j{0};
+            for (; j + 4 <= n; j += 4)
+            {
+                const std::int8_t* b0 = b + (j * ldb);
+                const std::int8_t* b1 = b0 + ldb;
+                const std::int8_t* b2 = b1 + ldb;
+                const std::int8_t* b3 = b2 + ldb;
+
+                __m512i c0 = _mm512_setzero_si512();
+                __m512i c1 = _mm512_setzero_si512();
+                __m512i c2 = _mm512_setzero_si512();
+                __m512i c3 = _mm512_setzero_si512();
+
+                for (std::size_t p{0}; p < k_main; p += step)
+                {
+                    c0 = dpbusd_avx512(c0, a + p, b0 + p);
+                    c1 = dpbusd_avx512(c1, a + p, b1 + p);
+                    c2 = dpbusd_avx512(c2, a + p, b2 + p);
+                    c3 = dpbusd_avx512(c3, a + p, b3 + p);
+                }
+
+                c[j] = _mm512_reduce_add_epi32(c0) + dot_u8s8(k_main, k, a, b0);
+                c[j + 1] = _mm512_reduce_add_epi32(c1) + dot_u8s8(k_main, k, a, b1);
+                c[j + 2] = _mm512_reduce_add_epi32(c2) + dot_u8s8(k_main, k, a, b2);
+                c[j + 3] = _mm512_reduce_add_epi32(c3) + dot_u8s8(k_main, k, a, b3);
+            }
+
+            for (; j < n; ++j)
+            {
+                const std::int8_t* row = b + (j * ldb);
+
+                __m512i sum = _mm512_setzero_si512();
+                for (std::size_t p{0}; p < k_main; p += step)
+                {
+                    sum = dpbusd_avx512(sum, a + p, row + p);
+                }
+
+                c[j] = _mm512_reduce_add_epi32(sum) + dot_u8s8(k_main, k, a, row);
+            }
+        }
+
+        auto has_avx512_vnni() -> bool
+        {
+            static const bool supported = __builtin_cpu_supports("avx512vnni") != 0;
+            return supported;
+        }
+
+#endif // AXON_SIMD_X86
+
+        // NOTE(abi): VNNI is not part of `Isa`, so the AVX-512 selection only takes the byte
+        // dot-product path on CPUs that have it and otherwise keeps the AVX2 kernel.
+        auto active_int8_kernel() -> Int8Kernel
+        {
+#if defined(AXON_SIMD_X86)
+            switch (get_isa())
+            {
+            case Isa::avx512:
+                return has_avx512_vnni() ? int8_kernel_avx512_vnni : int8_kernel_avx2;
+            case Isa::avx2:
+                return int8_kernel_avx2;
+            case Isa::scalar:
+                break;
+            }
+#endif
+            return int8_kernel_scalar;
+        }
+
+        // Number of columns of C handled by one task of an integer product.
+        constexpr std::size_t int8_slice_cols{64};
+
+    } // namespace
+
+    auto detect_isa() -> Isa
+    {
+#if defined(AXON_SIMD_X86)
+        if (__builtin_cpu_supports("avx512f"))
+        {
+            return Isa::avx512;
+        }
+
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        {
+            return Isa::avx2;
+        }
+#endif
+        return Isa::scalar;
+    }
+
+    auto is_supported(Isa isa) -> bool
+    {
+        return static_cast<int>(isa) <= static_cast<int>(detect_isa());
+    }
+
+    auto get_isa() -> Isa
+    {
+        return active_isa().load(std::memory_order_relaxed);
+    }
+
+    auto set_isa(Isa isa) -> void
+    {
+        if (!is_supported(isa))
+        {
+            throw std::invalid_argument("The requested instruction set is not supported.");
+        }
+
+        active_isa().store(isa, std::memory_order_relaxed);
+    }
+
+    auto gemm(Transpose trans_a, Transpose trans_b, std::size_t m, std::size_t n, std::size_t k,
+              double alpha, const double* a, std::size_t lda, const double* b, std::size_t ldb,
+              double beta, double* c, std::size_t ldc) -> void
+    {
+        gemm_impl(trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
+
+    auto gemm(Transpose trans_a, Transpose trans_b, std::size_t m, std::size_t n, std::size_t k,
+              float alpha, const float* a, std::size_t lda, const float* b, std::size_t ldb,
+              float beta, float* c, std::size_t ldc) -> void
+    {
+        gemm_impl(trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
+
+    auto gemm(Transpose trans_a, Transpose trans_b, std::size_t m, std::size_t n, std::size_t k,
+              double alpha, const double* a, std::size_t lda, const double* b, std::size_t ldb,
+              double beta, double* c, std::size_t ldc, const Epilogue<double>& epilogue) -> void
+    {
+        gemm_impl(trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc, &epilogue);
+    }
+
+    auto gemm(Transpose trans_a, Transpose trans_b, std::size_t m, std::size_t n, std::size_t k,
+              float alpha, const float* a, std::size_t lda, const float* b, std::size_t ldb,
+              float beta, float* c, std::size_t ldc, const Epilogue<float>& epilogue) -> void
+    {
+        gemm_impl(trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc, &epilogue);
+    }
+
+    auto gemv(Transpose trans, std::size_t m, std::size_t n, double alpha, const double* a,
+              std::size_t lda, const double* x, double beta, double* y) -> void
+    {
+        gemv_impl(trans, m, n, alpha, a, lda, x, beta, y);
+    }
+
+    auto gemv(Transpose trans, std::size_t m, std::size_t n, float alpha, const float* a,
+              std::size_t lda, const float* x, float beta, float* y) -> void
+    {
+        gemv_impl(trans, m, n, alpha, a, lda, x, beta, y);
+    }
+
+    auto gemm_u8s8(std::size_t m, std::size_t n, std::size_t k, const std::uint8_t* a,
+                   std::size_t lda, const std::int8_t* b, std::size_t ldb, std::int32_t* c,
+                   std::size_t ldc) -> void
+    {
+        const Int8Kernel kernel = active_int8_kernel();
+        const std::size_t num_slices = (n + int8_slice_cols - 1) / int8_slice_cols;
+
+        // NOTE(abi): tasks cover a slice of one row of C, so a single sample still spreads
+        // across the threads.
+        Scheduler::instance().parallel_for(
+            m * num_slices, grain_size(int8_slice_cols * k),
+            [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t task{begin}; task < end; ++task)
+                {
+                    const std::size_t row = task / num_slices;
+                    const std::size_t first_col = (task % num_slices) * int8_slice_cols;
+                    const std::size_t cols = std::min(int8_slice_cols, n - first_col);
+                    kernel(cols, k, a + (row * lda), b + (first_col * ldb), ldb,
+                           c + (row * ldc) + first_col);
+                }
+            });
+    }
+
+} // namespace axon::kernels
@@ -0,0 +1,45 @@
+#include "layer.hpp"
+
+#include <random>
+
+namespace axon
+{
+
+    namespace
+    {
+        auto get_random_weight() -> double
+        {
+            static std::random_device rd;
+            static std::mt19937 prng(rd());
+            static std::uniform_real_distribution<> distribution(-1.0, 1.0);
+
+            return distribution(prng);
+        }
+
+    } // namespace
+
+    template <std::floating_point Scalar>
+    auto randomize(std::span<Scalar> values) -> void
+    {
+        for (auto& value : values)
+        {
+            value = static_cast<Scalar>(get_random_weight());
+        }
+    }
+
+    template <std::floating_point Scalar>
+    auto randomize(BasicLayer<Scalar>& layer) -> void
+    {
+        randomize(layer.weights);
+        randomize(layer.biases);
+    }
+
+    template auto randomize(std::span<float> values) -> void;
+    template auto randomize(std::span<double> values) -> void;
+    template auto randomize(BasicLayer<float>& layer) -> void;
+    template auto randomize(BasicLayer<double>& layer) -> void;
+
+    template struct BasicLayer<float>;
+    template struct BasicLayer<double>;
+
+} // namespace axon
@@ -0,0 +1,194 @@
+#include "mapped_file.hpp"
+
+#include "aligned_allocator.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #define AXON_HAS_MMAP 1
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#else
+    #include <fstream>
+    #include <new>
+#endif
+
+namespace axon
+{
+
+#if defined(AXON_HAS_MMAP)
+
+    MappedFile::MappedFile(const std::filesystem::path& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Cannot open " + path.string() + ".");
+        }
+
+        struct stat status{};
+        if (::fstat(fd, &status) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("Cannot read the size of " + path.string() + ".");
+        }
+
+        size_ = static_cast<std::size_t>(status.st_size);
+        if (size_ > 0)
+        {
+            void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error("Cannot map " + path.string() + ".");
+            }
+
+            data_ = static_cast<const std::byte*>(mapping);
+        }
+
+        // NOTE(abi): the mapping keeps its own reference to the file.
+        ::close(fd);
+    }
+
+    auto MappedFile::release() noexcept -> void
+    {
+        if (data_ != nullptr)
+        {
+            ::munmap(const_cast<std::byte*>(data_), size_);
+        }
+    }
+
+    auto write_file_atomically(const std::filesystem::path& path,
+                               std::span<const std::byte> bytes) -> void
+    {
+        auto temporary = path;
+        temporary += ".tmp";
+
+        const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Cannot create " + temporary.string() + ".");
+        }
+
+        std::size_t written{0};
+        while (written < bytes.size())
+        {
+            const ::ssize_t result = ::write(fd, bytes.data() + written, bytes.size() - written);
+            if (result < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (result <= 0)
+            {
+                ::close(fd);
+                throw std::runtime_error("Cannot write " + temporary.string() + ".");
+            }
+
+            written += static_cast<std::size_t>(result);
+        }
+
+        // NOTE(abi): without the sync the rename may reach the disk before the data, and a crash
+        // could leave an empty file under the final name.
+        const bool synced = ::fsync(fd) == 0;
+        ::close(fd);
+        if (!synced || ::rename(temporary.c_str(), path.c_str()) != 0)
+        {
+            throw std::runtime_error("Cannot replace " + path.string() + ".");
+        }
+
+        // Persists the rename itself; best effort, as not every file system supports it.
+        const auto directory = path.has_parent_path() ? path.parent_path()
+                                                      : std::filesystem::path{"."};
+        const int directory_fd = ::open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+        if (directory_fd >= 0)
+        {
+            ::fsync(directory_fd);
+            ::close(directory_fd);
+        }
+    }
+
+#else
+
+    MappedFile::MappedFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+        {
+            throw std::runtime_error("Cannot open " + path.string() + ".");
+        }
+
+        size_ = static_cast<std::size_t>(file.tellg());
+        if (size_ > 0)
+        {
+            auto* buffer = static_cast<std::byte*>(
+                ::operator new(size_, std::align_val_t{cache_line_size}));
+            file.seekg(0);
+            if (!file.read(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(size_)))
+            {
+                ::operator delete(buffer, size_, std::align_val_t{cache_line_size});
+                throw std::runtime_error("Cannot read " + path.string() + ".");
+            }
+
+            data_ = buffer;
+        }
+    }
+
+    auto MappedFile::release() noexcept -> void
+    {
+        if (data_ != nullptr)
+        {
+            ::operator delete(const_cast<std::byte*>(data_), size_,
+                              std::align_val_t{cache_line_size});
+        }
+    }
+
+    auto write_file_atomically(const std::filesystem::path& path,
+                               std::span<const std::byte> bytes) -> void
+    {
+        auto temporary = path;
+        temporary += ".tmp";
+
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file.write(reinterpret_cast<const char*>(bytes.data()),
+                            static_cast<std::streamsize>(bytes.size()))
+                || !file.flush())
+            {
+                throw std::runtime_error("Cannot write " + temporary.string() + ".");
+            }
+        }
+
+        std::filesystem::rename(temporary, path);
+    }
+
+#endif
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    MappedFile::~MappedFile()
+    {
+        release();
+    }
+
+    auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile&
+    {
+        if (this != &other)
+        {
+            release();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+
+        return *this;
+    }
+
+} // namespace axon
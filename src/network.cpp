@@ -1,14 +1,85 @@
 #include "network.hpp"
 
+#include "dense.hpp"
+#include "dispatch.hpp"
+#include "kernels.hpp"
+#include "scheduler.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
 #include <stdexcept>
 
 namespace axon
 {
-    constexpr double bias_constant{1.0};
 
-    Network::Network(const std::vector<std::size_t>& layer_sizes, Activation activation,
-                     Criterion criterion)
-        : activation_(std::move(activation)),
+    using detail::dispatch;
+    using kernels::Transpose;
+
+    namespace
+    {
+        template <std::floating_point Scalar>
+        auto layer_inputs(const BasicWorkspace<Scalar>& workspace, std::size_t layer_idx)
+            -> std::span<const Scalar>
+        {
+            return layer_idx == 0 ? workspace.inputs : workspace.layers[layer_idx - 1].outputs;
+        }
+
+        // Weight gradients computed by one block of `train_step` before they are applied. Small
+        // enough for the block to still be in L2 when its weights and velocities are updated,
+        // large enough for the GEMM to amortize packing the layer inputs.
+        constexpr std::size_t fused_block_bytes{std::size_t{1} << 20};
+
+        // Multiply-adds of a dense layer over a batch, counted as two operations, for tracing.
+        template <std::floating_point Scalar>
+        auto dense_flops(const BasicLayer<Scalar>& layer, std::size_t batch_size)
+            -> std::uint64_t
+        {
+            return 2 * batch_size * layer.num_inputs * layer.num_outputs;
+        }
+
+        // Bytes a dense layer must at least move over a batch: its weights, its inputs and its
+        // outputs (or the matching gradients), for tracing.
+        template <std::floating_point Scalar>
+        auto dense_bytes(const BasicLayer<Scalar>& layer, std::size_t batch_size)
+            -> std::uint64_t
+        {
+            return (layer.weights.size() + layer.biases.size()
+                    + (batch_size * (layer.num_inputs + layer.num_outputs)))
+                   * sizeof(Scalar);
+        }
+
+        // Multiply-adds of a pruned layer over a batch, for tracing.
+        template <std::floating_point Scalar>
+        auto sparse_flops(const BasicSparseWeights<Scalar>& weights, std::size_t batch_size)
+            -> std::uint64_t
+        {
+            const std::size_t entries = weights.format == SparseFormat::block
+                                            ? weights.blocks.values.size()
+                                            : weights.csr.values.size();
+            return 2 * batch_size * entries;
+        }
+
+        template <std::floating_point Scalar>
+        auto sparse_bytes(const BasicLayer<Scalar>& layer,
+                          const BasicSparseWeights<Scalar>& weights, std::size_t batch_size)
+            -> std::uint64_t
+        {
+            return sparse::storage_bytes(weights, layer.num_outputs, layer.num_inputs)
+                   + ((layer.biases.size() + (batch_size * (layer.num_inputs + layer.num_outputs)))
+                      * sizeof(Scalar));
+        }
+
+    } // namespace
+
+    template <std::floating_point Scalar>
+    BasicNetwork<Scalar>::BasicNetwork(const std::vector<std::size_t>& layer_sizes,
+                                       Activation activation, Criterion criterion,
+                                       std::pmr::memory_resource* resource)
+        : arena_(0, resource),
+          activation_(std::move(activation)),
           criterion_(std::move(criterion))
     {
         if (constexpr std::size_t min_allowed_layers{2}; layer_sizes.size() < min_allowed_layers)
@@ -17,141 +88,612 @@ namespace axon
                 "The network must have at least an input and output layer.");
         }
 
-        layers_.reserve(layer_sizes.size());
+        activation_.kind = activation_.resolve_kind();
+        criterion_.kind = criterion_.resolve_kind();
 
-        for (std::size_t layer_idx{0}; layer_idx < layer_sizes.size(); ++layer_idx)
+        std::size_t section_bytes{0};
+        layers_.reserve(layer_sizes.size() - 1);
+        for (std::size_t layer_idx{1}; layer_idx < layer_sizes.size(); ++layer_idx)
         {
-            const std::size_t num_neurons = layer_sizes[layer_idx];
-            const std::size_t num_outputs =
-                (layer_idx == layer_sizes.size() - 1) ? 0 : layer_sizes[layer_idx + 1];
+            layers_.emplace_back(layer_sizes[layer_idx - 1], layer_sizes[layer_idx]);
+            section_bytes +=
+                parameter_bytes<Scalar>(layer_sizes[layer_idx - 1], layer_sizes[layer_idx]);
+        }
 
-            layers_.emplace_back();
-            auto& layer = layers_.back();
+        // NOTE(abi): the parameters take the first half of the arena and the velocities the
+        // second, each half laid out layer after layer.
+        arena_.resize(2 * section_bytes);
+        std::size_t parameter_offset{0};
+        std::size_t velocity_offset{section_bytes};
+        for (auto& layer : layers_)
+        {
+            parameter_offset = carve_parameters(arena_, parameter_offset, layer.num_inputs,
+                                                layer.num_outputs, layer.weights, layer.biases);
+            velocity_offset =
+                carve_parameters(arena_, velocity_offset, layer.num_inputs, layer.num_outputs,
+                                 layer.weight_velocity, layer.bias_velocity);
+            randomize(layer);
+        }
 
-            layer.reserve(num_neurons + 1);
+        parameters_ = arena_.view<Scalar>(0, section_bytes / sizeof(Scalar));
+        velocities_ = arena_.view<Scalar>(section_bytes, section_bytes / sizeof(Scalar));
 
-            for (std::size_t neuron_idx{0}; neuron_idx < num_neurons; ++neuron_idx)
-            {
-                if (layer_idx == 0)
-                {
-                    layer.emplace_back(num_outputs, neuron_idx);
-                }
-                else
-                {
-                    layer.emplace_back(num_outputs, neuron_idx, activation_);
-                }
-            }
+        sparse_.resize(layers_.size());
+        workspace_ = make_workspace();
+        workspace_.resize_batch(layers_, 1);
+    }
 
-            // NOTE(abi): bias neuron has no activation.
-            layer.emplace_back(num_outputs, num_neurons);
-            layer.back().set_output(bias_constant);
-        }
+    template <std::floating_point Scalar>
+    BasicNetwork<Scalar>::BasicNetwork(const BasicNetwork& other)
+        : arena_(other.arena_),
+          layers_(other.layers_),
+          workspace_(other.workspace_),
+          activation_(other.activation_),
+          criterion_(other.criterion_),
+          math_mode_(other.math_mode_),
+          error_(other.error_),
+          masks_(other.masks_),
+          sparse_(other.sparse_),
+          sparse_threshold_(other.sparse_threshold_)
+    {
+        rebase(other);
     }
 
-    [[nodiscard]] auto Network::get_output() const -> std::vector<double>
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::operator=(const BasicNetwork& other) -> BasicNetwork&
     {
-        std::vector<double> output;
+        if (this != &other)
+        {
+            arena_ = other.arena_;
+            layers_ = other.layers_;
+            workspace_ = other.workspace_;
+            activation_ = other.activation_;
+            criterion_ = other.criterion_;
+            math_mode_ = other.math_mode_;
+            error_ = other.error_;
+            masks_ = other.masks_;
+            sparse_ = other.sparse_;
+            sparse_threshold_ = other.sparse_threshold_;
+            rebase(other);
+        }
 
-        const auto& output_layer = layers_.back();
-        output.reserve(output_layer.size() - 1);
+        return *this;
+    }
 
-        for (std::size_t i{0}; i < output_layer.size() - 1; ++i)
+    // Points the views copied from `other` at the matching offsets of this network's arena.
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::rebase(const BasicNetwork& other) -> void
+    {
+        parameters_ = arena_.rebase(other.parameters_, other.arena_);
+        velocities_ = arena_.rebase(other.velocities_, other.arena_);
+        for (auto& layer : layers_)
         {
-            output.push_back(output_layer[i].get_output());
+            layer.weights = arena_.rebase(layer.weights, other.arena_);
+            layer.biases = arena_.rebase(layer.biases, other.arena_);
+            layer.weight_velocity = arena_.rebase(layer.weight_velocity, other.arena_);
+            layer.bias_velocity = arena_.rebase(layer.bias_velocity, other.arena_);
         }
+    }
 
-        return output;
+    template <std::floating_point Scalar>
+    [[nodiscard]] auto BasicNetwork<Scalar>::get_output() const -> std::vector<Scalar>
+    {
+        const auto& outputs = workspace_.layers.back().outputs;
+        return {outputs.begin(), outputs.end()};
     }
 
-    auto Network::feed_forward(const std::vector<double>& inputs) -> void
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::get_output(std::span<Scalar> output) const -> void
     {
-        if (inputs.size() != layers_[0].size() - 1)
+        const auto& outputs = workspace_.layers.back().outputs;
+        if (output.size() != outputs.size())
         {
-            throw std::invalid_argument("Invalid number of inputs.");
+            throw std::invalid_argument("Invalid output buffer size.");
         }
 
-        for (std::size_t i{0}; i < inputs.size(); ++i)
+        std::ranges::copy(outputs, output.begin());
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::feed_forward(std::span<const Scalar> inputs) -> void
+    {
+        forward(inputs, 1, workspace_);
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::feed_forward_batch(std::span<const Scalar> inputs,
+                                                  std::size_t batch_size) -> void
+    {
+        forward(inputs, batch_size, workspace_);
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::compute_loss(std::span<const Scalar> targets) -> Scalar
+    {
+        error_ = loss(targets, workspace_);
+        return error_;
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::back_propagate(std::span<const Scalar> targets) -> void
+    {
+        backward(targets, workspace_, Scalar{1} / static_cast<Scalar>(workspace_.batch_size));
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::step(Scalar learning_rate, Scalar momentum) -> void
+    {
+        apply_gradients(workspace_, learning_rate, momentum);
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::make_workspace() const -> Workspace
+    {
+        return Workspace{layers_, arena_.get_resource()};
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::forward(std::span<const Scalar> inputs, std::size_t batch_size,
+                                       Workspace& workspace) const -> void
+    {
+        const std::size_t num_inputs = layers_.front().num_inputs;
+        if (batch_size == 0 || inputs.size() != batch_size * num_inputs)
         {
-            layers_[0][i].set_output(inputs[i]);
+            throw std::invalid_argument("Invalid number of inputs.");
         }
 
-        // NOTE(abi): we skip the bias neurons from the forward pass.
-        for (std::size_t layer_idx{1}; layer_idx < layers_.size(); ++layer_idx)
+        workspace.resize_batch(layers_, batch_size);
+        std::ranges::copy(inputs, workspace.inputs.begin());
+
+        for (std::size_t layer_idx{0}; layer_idx < layers_.size(); ++layer_idx)
         {
-            const auto& prev_layer = layers_[layer_idx - 1];
-            auto& current_layer = layers_[layer_idx];
+            const auto& prev_outputs = layer_inputs(workspace, layer_idx);
+            const auto& layer = layers_[layer_idx];
+            auto& state = workspace.layers[layer_idx];
 
-            for (std::size_t neuron_idx{0}; neuron_idx < current_layer.size() - 1; ++neuron_idx)
+            if (const auto& sparse = sparse_[layer_idx]; detail::use_sparse(sparse, batch_size))
             {
-                current_layer[neuron_idx].feed_forward(prev_layer);
+                AXON_TRACE_SCOPE(trace::Phase::forward, "sparse_forward",
+                                 trace::layer_id(layer_idx), sparse_flops(sparse, batch_size),
+                                 sparse_bytes(layer, sparse, batch_size));
+                detail::sparse_forward(prev_outputs.data(), batch_size, sparse,
+                                       layer.biases.data(), activation_, math_mode_,
+                                       state.outputs.data());
+                continue;
             }
+
+            AXON_TRACE_SCOPE(trace::Phase::forward, "dense_forward", trace::layer_id(layer_idx),
+                             dense_flops(layer, batch_size), dense_bytes(layer, batch_size));
+            detail::dense_forward(prev_outputs.data(), batch_size, layer.num_inputs,
+                                  layer.num_outputs, layer.weights.data(), layer.biases.data(),
+                                  activation_, math_mode_, state.outputs.data());
         }
     }
 
-    auto Network::compute_loss(const std::vector<double>& targets) -> double
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::loss(std::span<const Scalar> targets,
+                                    const Workspace& workspace) const -> Scalar
     {
-        const auto& output_layer = layers_.back();
-        if (targets.size() != output_layer.size() - 1)
+        const auto& outputs = workspace.layers.back().outputs;
+        if (targets.size() != outputs.size())
         {
             throw std::invalid_argument("Invalid number of targets.");
         }
 
-        error_ = 0.0;
+        AXON_TRACE_SCOPE(trace::Phase::loss, "loss", -1, 3 * targets.size(),
+                         2 * targets.size() * sizeof(Scalar));
+
+        // NOTE(abi): summed in double precision, so the mean stays accurate over large float
+        // batches.
+        double error{0.0};
+        dispatch(criterion_,
+                 [&](const auto& policy)
+                 {
+                     for (std::size_t i = 0; i < targets.size(); ++i)
+                     {
+                         error += policy.function(targets[i], outputs[i]);
+                     }
+                 });
+
+        return static_cast<Scalar>(error / static_cast<double>(targets.size()));
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::backward(std::span<const Scalar> targets, Workspace& workspace,
+                                        Scalar gradient_scale) const -> void
+    {
+        output_gradients(targets, workspace);
+
+        for (std::size_t layer_idx{layers_.size() - 1}; layer_idx > 0; --layer_idx)
+        {
+            hidden_gradients(layer_idx, workspace);
+        }
+
+        for (std::size_t layer_idx{0}; layer_idx < layers_.size(); ++layer_idx)
+        {
+            parameter_gradients(layer_idx, workspace, gradient_scale);
+        }
+    }
 
-        for (std::size_t i = 0; i < output_layer.size() - 1; ++i)
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::output_gradients(std::span<const Scalar> targets,
+                                                Workspace& workspace) const -> void
+    {
+        auto& output_state = workspace.layers.back();
+        if (targets.size() != output_state.outputs.size())
         {
-            const double target = targets[i];
-            const double output = output_layer[i].get_output();
-            error_ += criterion_.function(target, output);
+            throw std::invalid_argument("Invalid number of targets.");
         }
 
-        error_ /= static_cast<double>(output_layer.size() - 1);
+        AXON_TRACE_SCOPE(trace::Phase::backward, "output_gradients",
+                         trace::layer_id(layers_.size() - 1), 3 * targets.size(),
+                         3 * targets.size() * sizeof(Scalar));
+
+        dispatch(criterion_,
+                 [&](const auto& policy)
+                 {
+                     for (std::size_t i{0}; i < targets.size(); ++i)
+                     {
+                         output_state.gradients[i] =
+                             policy.derivative(targets[i], output_state.outputs[i]);
+                     }
+                 });
 
+        dispatch(activation_, [&](const auto& policy)
+                 {
+                     policy.template apply_derivative<Scalar>(output_state.outputs,
+                                                              output_state.gradients);
+                 });
+    }
+
+    // Propagates the gradients of layer `layer_idx` to the outputs of the layer below.
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::hidden_gradients(std::size_t layer_idx, Workspace& workspace) const
+        -> void
+    {
+        const std::size_t batch_size = workspace.batch_size;
+        const auto& next_layer = layers_[layer_idx];
+        const auto& next_state = workspace.layers[layer_idx];
+        auto& hidden_state = workspace.layers[layer_idx - 1];
+
+        // G_hidden = G_next * W_next
+        if (const auto& sparse = sparse_[layer_idx]; detail::use_sparse(sparse, batch_size))
+        {
+            AXON_TRACE_SCOPE(trace::Phase::backward, "sparse_hidden_gradients",
+                             trace::layer_id(layer_idx - 1), sparse_flops(sparse, batch_size),
+                             sparse_bytes(next_layer, sparse, batch_size));
+            sparse::multiply_transposed(sparse, next_state.gradients.data(), batch_size,
+                                        hidden_state.gradients.data());
+        }
+        else
+        {
+            AXON_TRACE_SCOPE(trace::Phase::backward, "hidden_gradients",
+                             trace::layer_id(layer_idx - 1), dense_flops(next_layer, batch_size),
+                             dense_bytes(next_layer, batch_size));
+            kernels::gemm(Transpose::no, Transpose::no, batch_size, next_layer.num_inputs,
+                          next_layer.num_outputs, Scalar{1}, next_state.gradients.data(),
+                          next_layer.num_outputs, next_layer.weights.data(),
+                          next_layer.num_inputs, Scalar{0}, hidden_state.gradients.data(),
+                          next_layer.num_inputs);
+        }
+
+        dispatch(activation_, [&](const auto& policy)
+                 {
+                     policy.template apply_derivative<Scalar>(hidden_state.outputs,
+                                                              hidden_state.gradients);
+                 });
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::parameter_gradients(std::size_t layer_idx, Workspace& workspace,
+                                                   Scalar gradient_scale) const -> void
+    {
+        const std::size_t batch_size = workspace.batch_size;
+        const auto& prev_outputs = layer_inputs(workspace, layer_idx);
+        const auto& layer = layers_[layer_idx];
+        auto& state = workspace.layers[layer_idx];
+
+        AXON_TRACE_SCOPE(trace::Phase::backward, "parameter_gradients",
+                         trace::layer_id(layer_idx), dense_flops(layer, batch_size),
+                         dense_bytes(layer, batch_size));
+
+        // dW = scale * G^T * X
+        kernels::gemm(Transpose::yes, Transpose::no, layer.num_outputs, layer.num_inputs,
+                      batch_size, gradient_scale, state.gradients.data(), layer.num_outputs,
+                      prev_outputs.data(), layer.num_inputs, Scalar{0},
+                      state.weight_gradients.data(), layer.num_inputs);
+
+        std::ranges::fill(state.bias_gradients, Scalar{0});
+        for (std::size_t sample{0}; sample < batch_size; ++sample)
+        {
+            const Scalar* sample_gradients = &state.gradients[sample * layer.num_outputs];
+            for (std::size_t out{0}; out < layer.num_outputs; ++out)
+            {
+                state.bias_gradients[out] += sample_gradients[out] * gradient_scale;
+            }
+        }
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::apply_gradients(const Workspace& gradients, Scalar learning_rate,
+                                               Scalar momentum) -> void
+    {
+        // NOTE(abi): reads the parameters, velocities and gradients and writes back the first
+        // two. The biases sit in the same buffers as the weights and behave as weights whose
+        // input is always one.
+        AXON_TRACE_SCOPE(trace::Phase::update, "momentum_update", -1, 3 * parameters_.size(),
+                         5 * parameters_.size() * sizeof(Scalar));
+
+        optimizer::sgd_update<Scalar>(parameters_,
+                                      std::span<const Scalar>{gradients.parameter_gradients},
+                                      velocities_, learning_rate, momentum);
+
+        apply_masks();
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::train_step(std::span<const Scalar> inputs,
+                                          std::span<const Scalar> targets,
+                                          std::size_t batch_size, Scalar learning_rate,
+                                          Scalar momentum) -> Scalar
+    {
+        forward(inputs, batch_size, workspace_);
+        error_ = loss(targets, workspace_);
+        output_gradients(targets, workspace_);
+
+        const Scalar gradient_scale = Scalar{1} / static_cast<Scalar>(batch_size);
+        for (std::size_t layer_idx{layers_.size()}; layer_idx-- > 0;)
+        {
+            // NOTE(abi): the layer below needs the weights as they were in the forward pass.
+            if (layer_idx > 0)
+            {
+                hidden_gradients(layer_idx, workspace_);
+            }
+
+            fused_update(layer_idx, workspace_, gradient_scale, learning_rate, momentum);
+        }
+
+        apply_masks();
         return error_;
     }
 
-    auto Network::back_propagate(const std::vector<double>& targets) -> void
+    // Computes the parameter gradients of a layer one block of weight rows at a time and
+    // applies each block to the weights while it is still in cache. Blocks cover disjoint rows,
+    // so they run in parallel.
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::fused_update(std::size_t layer_idx, Workspace& workspace,
+                                            Scalar gradient_scale, Scalar learning_rate,
+                                            Scalar momentum) -> void
+    {
+        const std::size_t batch_size = workspace.batch_size;
+        const auto& prev_outputs = layer_inputs(workspace, layer_idx);
+        auto& layer = layers_[layer_idx];
+        auto& state = workspace.layers[layer_idx];
+
+        AXON_TRACE_SCOPE(trace::Phase::update, "fused_update", trace::layer_id(layer_idx),
+                         dense_flops(layer, batch_size)
+                             + (4 * (layer.weights.size() + layer.biases.size())),
+                         (4 * (layer.weights.size() + layer.biases.size())
+                          + (batch_size * (layer.num_inputs + layer.num_outputs)))
+                             * sizeof(Scalar));
+
+        const std::size_t row_bytes = layer.num_inputs * sizeof(Scalar);
+        const std::size_t block_rows = std::max<std::size_t>(fused_block_bytes / row_bytes, 1);
+        const std::size_t num_blocks = (layer.num_outputs + block_rows - 1) / block_rows;
+
+        Scheduler::instance().parallel_for(
+            num_blocks, grain_size(block_rows * layer.num_inputs * batch_size),
+            [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t block{begin}; block < end; ++block)
+                {
+                    const std::size_t first_row = block * block_rows;
+                    const std::size_t rows = std::min(block_rows, layer.num_outputs - first_row);
+                    const std::size_t first = first_row * layer.num_inputs;
+                    const std::size_t last = first + (rows * layer.num_inputs);
+
+                    // NOTE(abi): each block owns its rows of the workspace gradients, which
+                    // stay safe to use when the GEMM below nests another block on this thread.
+                    // dW[rows] = scale * G[:, rows]^T * X
+                    kernels::gemm(Transpose::yes, Transpose::no, rows, layer.num_inputs,
+                                  batch_size, gradient_scale, state.gradients.data() + first_row,
+                                  layer.num_outputs, prev_outputs.data(), layer.num_inputs,
+                                  Scalar{0}, state.weight_gradients.data() + first,
+                                  layer.num_inputs);
+
+                    for (std::size_t i{first}; i < last; ++i)
+                    {
+                        auto& velocity = layer.weight_velocity[i];
+                        velocity =
+                            (learning_rate * state.weight_gradients[i]) + (momentum * velocity);
+                        layer.weights[i] -= velocity;
+                    }
+
+                    const std::size_t last_row = first_row + rows;
+                    std::fill(state.bias_gradients.begin() + first_row,
+                              state.bias_gradients.begin() + last_row, Scalar{0});
+                    for (std::size_t sample{0}; sample < batch_size; ++sample)
+                    {
+                        const Scalar* sample_gradients =
+                            &state.gradients[sample * layer.num_outputs];
+                        for (std::size_t out{first_row}; out < last_row; ++out)
+                        {
+                            state.bias_gradients[out] += sample_gradients[out] * gradient_scale;
+                        }
+                    }
+
+                    for (std::size_t out{first_row}; out < last_row; ++out)
+                    {
+                        auto& velocity = layer.bias_velocity[out];
+                        velocity =
+                            (learning_rate * state.bias_gradients[out]) + (momentum * velocity);
+                        layer.biases[out] -= velocity;
+                    }
+                }
+            });
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::prune(double sparsity, std::size_t block_size) -> void
     {
-        // Output layer gradients
-        auto& output_layer = layers_.back();
-        if (targets.size() != output_layer.size() - 1)
+        if (sparsity < 0.0 || sparsity > 1.0)
         {
-            throw std::invalid_argument("Invalid number of targets.");
+            throw std::invalid_argument("The sparsity must lie in [0, 1].");
         }
 
-        for (std::size_t i{0}; i < output_layer.size() - 1; ++i)
+        if (block_size == 0)
         {
-            const double target = targets[i];
-            const double output = output_layer[i].get_output();
-            const double gradient =
-                criterion_.derivative(target, output) * activation_.derivative(output);
-            output_layer[i].set_gradient(gradient);
+            throw std::invalid_argument("The block size must be positive.");
         }
 
-        // Hidden layer gradients
-        for (std::size_t layer_idx = layers_.size() - 2; layer_idx > 0; --layer_idx)
+        masks_.resize(layers_.size());
+        for (std::size_t layer_idx{0}; layer_idx < layers_.size(); ++layer_idx)
         {
-            auto& hidden_layer = layers_[layer_idx];
-            auto& next_layer = layers_[layer_idx + 1];
+            const auto& layer = layers_[layer_idx];
+            auto& mask = masks_[layer_idx];
+            if (mask.empty())
+            {
+                mask.assign(layer.weights.size(), 1);
+            }
 
-            for (std::size_t i{0}; i < hidden_layer.size() - 1; ++i)
+            // NOTE(abi): groups already pruned score below every live one, so they are always
+            // among the pruned and the mask only ever loses weights.
+            const std::size_t groups_per_row = (layer.num_inputs + block_size - 1) / block_size;
+            const std::size_t num_groups = layer.num_outputs * groups_per_row;
+            std::vector<double> scores(num_groups, -1.0);
+            for (std::size_t group{0}; group < num_groups; ++group)
             {
-                hidden_layer[i].compute_hidden_gradient(next_layer);
+                const std::size_t row = group / groups_per_row;
+                const std::size_t first = (row * layer.num_inputs)
+                                          + ((group % groups_per_row) * block_size);
+                const std::size_t last = std::min(first + block_size,
+                                                  (row + 1) * layer.num_inputs);
+                for (std::size_t i{first}; i < last; ++i)
+                {
+                    if (mask[i] != 0)
+                    {
+                        scores[group] = std::max(scores[group], 0.0)
+                                        + std::abs(static_cast<double>(layer.weights[i]));
+                    }
+                }
+            }
+
+            const auto num_pruned = static_cast<std::size_t>(
+                std::llround(sparsity * static_cast<double>(num_groups)));
+            std::vector<std::size_t> order(num_groups);
+            std::iota(order.begin(), order.end(), std::size_t{0});
+            std::nth_element(order.begin(),
+                             order.begin() + static_cast<std::ptrdiff_t>(num_pruned), order.end(),
+                             [&](std::size_t a, std::size_t b) { return scores[a] < scores[b]; });
+
+            for (std::size_t k{0}; k < num_pruned; ++k)
+            {
+                const std::size_t group = order[k];
+                const std::size_t row = group / groups_per_row;
+                const std::size_t first = (row * layer.num_inputs)
+                                          + ((group % groups_per_row) * block_size);
+                const std::size_t last = std::min(first + block_size,
+                                                  (row + 1) * layer.num_inputs);
+                std::fill(mask.begin() + static_cast<std::ptrdiff_t>(first),
+                          mask.begin() + static_cast<std::ptrdiff_t>(last), std::uint8_t{0});
             }
         }
+
+        update_sparse_formats();
     }
 
-    auto Network::step(double learning_rate, double momentum) -> void
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::set_masks(std::vector<std::vector<std::uint8_t>> masks) -> void
     {
-        for (std::size_t layer_idx{layers_.size() - 1}; layer_idx > 0; --layer_idx)
+        if (!masks.empty() && masks.size() != layers_.size())
         {
-            auto& current_layer = layers_[layer_idx];
-            auto& prev_layer = layers_[layer_idx - 1];
+            throw std::invalid_argument("Invalid number of masks.");
+        }
 
-            for (std::size_t i = 0; i < current_layer.size() - 1; ++i)
+        for (std::size_t layer_idx{0}; layer_idx < masks.size(); ++layer_idx)
+        {
+            if (masks[layer_idx].size() != layers_[layer_idx].weights.size())
             {
-                current_layer[i].update_incoming_weights(prev_layer, learning_rate, momentum);
+                throw std::invalid_argument("Invalid mask size.");
             }
         }
+
+        masks_ = std::move(masks);
+        std::ranges::fill(sparse_, SparseWeights{});
+        update_sparse_formats();
     }
+
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::apply_masks() -> void
+    {
+        if (masks_.empty())
+        {
+            return;
+        }
+
+        for (std::size_t layer_idx{0}; layer_idx < layers_.size(); ++layer_idx)
+        {
+            auto& layer = layers_[layer_idx];
+            const auto& mask = masks_[layer_idx];
+
+            // NOTE(abi): the velocities are cleared too, so momentum never carries a pruned
+            // weight away from zero between two calls.
+            for (std::size_t i{0}; i < mask.size(); ++i)
+            {
+                if (mask[i] == 0)
+                {
+                    layer.weights[i] = Scalar{0};
+                    layer.weight_velocity[i] = Scalar{0};
+                }
+            }
+
+            auto& sparse = sparse_[layer_idx];
+            if (sparse.format == SparseFormat::csr)
+            {
+                sparse::gather(sparse.csr, std::span<const Scalar>{layer.weights});
+            }
+            else if (sparse.format == SparseFormat::block)
+            {
+                sparse::gather(sparse.blocks, std::span<const Scalar>{layer.weights});
+            }
+        }
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::set_sparse_threshold(double threshold) -> void
+    {
+        sparse_threshold_ = threshold;
+        update_sparse_formats();
+    }
+
+    // Picks the format of every pruned layer from its mask and rebuilds its sparse copy.
+    template <std::floating_point Scalar>
+    auto BasicNetwork<Scalar>::update_sparse_formats() -> void
+    {
+        for (std::size_t layer_idx{0}; layer_idx < masks_.size(); ++layer_idx)
+        {
+            const auto& layer = layers_[layer_idx];
+            const std::span<const std::uint8_t> mask{masks_[layer_idx]};
+
+            auto& sparse = sparse_[layer_idx];
+            sparse = SparseWeights{};
+            sparse.format = sparse::choose_format(mask, layer.num_outputs, layer.num_inputs,
+                                                  sparse_threshold_);
+            if (sparse.format == SparseFormat::csr)
+            {
+                sparse.csr = sparse::make_csr<Scalar>(mask, layer.num_outputs, layer.num_inputs);
+            }
+            else if (sparse.format == SparseFormat::block)
+            {
+                sparse.blocks =
+                    sparse::make_blocks<Scalar>(mask, layer.num_outputs, layer.num_inputs);
+            }
+        }
+
+        apply_masks();
+    }
+
+    template class BasicNetwork<float>;
+    template class BasicNetwork<double>;
+
 } // namespace axon
@@ -0,0 +1,447 @@
+#include "optimizer.hpp"
+
+#include "kernels.hpp"
+#include "scheduler.hpp"
+#include "simd.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace axon
+{
+
+    namespace
+    {
+        // Parameters updated by one task. A multiple of every vector width, so that only the
+        // last chunk has a tail.
+        constexpr std::size_t update_chunk_size{8192};
+
+        // Rough cost of updating one parameter, in multiply-adds, for the scheduler's grain.
+        constexpr std::size_t update_cost{8};
+
+        // Adam
+
+        template <typename Scalar>
+        auto adam_scalar(Scalar* parameters, const Scalar* gradients, Scalar* first_moments,
+                         Scalar* second_moments, std::size_t count,
+                         const optimizer::AdamStep<Scalar>& step) -> void
+        {
+            for (std::size_t i{0}; i < count; ++i)
+            {
+                const Scalar gradient = gradients[i] + (step.l2 * parameters[i]);
+                const Scalar m = (step.beta1 * first_moments[i])
+                                 + ((Scalar{1} - step.beta1) * gradient);
+                const Scalar v = (step.beta2 * second_moments[i])
+                                 + ((Scalar{1} - step.beta2) * gradient * gradient);
+
+                first_moments[i] = m;
+                second_moments[i] = v;
+                parameters[i] = (step.shrink * parameters[i])
+                                - (step.step_size * m
+                                   / (std::sqrt(step.correction * v) + step.epsilon));
+            }
+        }
+
+        template <typename Scalar>
+        auto rmsprop_scalar(Scalar* parameters, const Scalar* gradients, Scalar* mean_squares,
+                            std::size_t count, const optimizer::RMSpropStep<Scalar>& step)
+            -> void
+        {
+            for (std::size_t i{0}; i < count; ++i)
+            {
+                const Scalar gradient = gradients[i] + (step.l2 * parameters[i]);
+                const Scalar v = (step.alpha * mean_squares[i])
+                                 + ((Scalar{1} - step.alpha) * gradient * gradient);
+
+                mean_squares[i] = v;
+                parameters[i] -= step.learning_rate * gradient / (std::sqrt(v) + step.epsilon);
+            }
+        }
+
+#if defined(AXON_SIMD_X86)
+
+        // AVX2
+
+        template <typename Scalar>
+        AXON_TARGET_AVX2 auto adam_avx2(Scalar* parameters, const Scalar* gradients,
+                                        Scalar* first_moments, Scalar* second_moments,
+                                        std::size_t count, const optimizer::AdamStep<Scalar>& step)
+            -> void
+        {
+            using Ops = simd::Avx2<Scalar>;
+
+            const auto beta1 = Ops::broadcast(step.beta1);
+            const auto beta2 = Ops::broadcast(step.beta2);
+            const auto rest1 = Ops::broadcast(Scalar{1} - step.beta1);
+            const auto rest2 = Ops::broadcast(Scalar{1} - step.beta2);
+            const auto epsilon = Ops::broadcast(step.epsilon);
+            const auto step_size = Ops::broadcast(step.step_size);
+            const auto correction = Ops::broadcast(step.correction);
+            const auto l2 = Ops::broadcast(step.l2);
+            const auto shrink = Ops::broadcast(step.shrink);
+
+            std::size_t i{0};
+            for (; i + Ops::width <= count; i += Ops::width)
+            {
+                const auto p = Ops::load(parameters + i);
+                const auto g = Ops::fmadd(l2, p, Ops::load(gradients + i));
+                const auto m = Ops::fmadd(beta1, Ops::load(first_moments + i), Ops::mul(rest1, g));
+                const auto v = Ops::fmadd(beta2, Ops::load(second_moments + i),
+                                          Ops::mul(Ops::mul(rest2, g), g));
+                const auto denominator = Ops::add(Ops::sqrt(Ops::mul(correction, v)), epsilon);
+
+                Ops::store(first_moments + i, m);
+                Ops::store(second_moments + i, v);
+                Ops::store(parameters + i,
+                           Ops::sub(Ops::mul(shrink, p),
+                                    Ops::div(Ops::mul(step_size, m), denominator)));
+            }
+
+            adam_scalar(parameters + i, gradients + i, first_moments + i, second_moments + i,
+                        count - i, step);
+        }
+
+        template <typename Scalar>
+        AXON_TARGET_AVX2 auto rmsprop_avx2(Scalar* parameters, const Scalar* gradients,
+                                           Scalar* mean_squares, std::size_t count,
+                                           const optimizer::RMSpropStep<Scalar>& step) -> void
+        {
+            using Ops = simd::Avx2<Scalar>;
+
+            const auto alpha = Ops::broadcast(step.alpha);
+            const auto rest = Ops::broadcast(Scalar{1} - step.alpha);
+            const auto epsilon = Ops::broadcast(step.epsilon);
+            const auto learning_rate = Ops::broadcast(step.learning_rate);
+            const auto l2 = Ops::broadcast(step.l2);
+
+            std::size_t i{0};
+            for (; i + Ops::width <= count; i += Ops::width)
+            {
+                const auto p = Ops::load(parameters + i);
+                const auto g = Ops::fmadd(l2, p, Ops::load(gradients + i));
+                const auto v = Ops::fmadd(alpha, Ops::load(mean_squares + i),
+                                          Ops::mul(Ops::mul(rest, g), g));
+                const auto denominator = Ops::add(Ops::sqrt(v), epsilon);
+
+                Ops::store(mean_squares + i, v);
+                Ops::store(parameters + i,
+                           Ops::sub(p, Ops::div(Ops::mul(learning_rate, g), denominator)));
+            }
+
+            rmsprop_scalar(parameters + i, gradients + i, mean_squares + i, count - i, step);
+        }
+
+        // AVX-512. Every block goes through masked loads and stores, which cost the same as
+        // plain ones here, so the tail needs no second copy of the update.
+
+        template <typename Scalar>
+        AXON_TARGET_AVX512 auto adam_avx512(Scalar* parameters, const Scalar* gradients,
+                                            Scalar* first_moments, Scalar* second_moments,
+                                            std::size_t count,
+                                            const optimizer::AdamStep<Scalar>& step) -> void
+        {
+            using Ops = simd::Avx512<Scalar>;
+
+            const auto beta1 = Ops::broadcast(step.beta1);
+            const auto beta2 = Ops::broadcast(step.beta2);
+            const auto rest1 = Ops::broadcast(Scalar{1} - step.beta1);
+            const auto rest2 = Ops::broadcast(Scalar{1} - step.beta2);
+            const auto epsilon = Ops::broadcast(step.epsilon);
+            const auto step_size = Ops::broadcast(step.step_size);
+            const auto correction = Ops::broadcast(step.correction);
+            const auto l2 = Ops::broadcast(step.l2);
+            const auto shrink = Ops::broadcast(step.shrink);
+
+            for (std::size_t i{0}; i < count; i += Ops::width)
+            {
+                const auto mask = count - i >= Ops::width ? static_cast<typename Ops::Mask>(~0U)
+                                                          : Ops::tail_mask(count - i);
+
+                const auto p = Ops::load(mask, parameters + i);
+                const auto g = Ops::fmadd(l2, p, Ops::load(mask, gradients + i));
+                const auto m = Ops::fmadd(beta1, Ops::load(mask, first_moments + i),
+                                          Ops::mul(rest1, g));
+                const auto v = Ops::fmadd(beta2, Ops::load(mask, second_moments + i),
+                                          Ops::mul(Ops::mul(rest2, g), g));
+                const auto denominator = Ops::add(Ops::sqrt(Ops::mul(correction, v)), epsilon);
+
+                Ops::store(first_moments + i, mask, m);
+                Ops::store(second_moments + i, mask, v);
+                Ops::store(parameters + i, mask,
+                           Ops::sub(Ops::mul(shrink, p),
+                                    Ops::div(Ops::mul(step_size, m), denominator)));
+            }
+        }
+
+        template <typename Scalar>
+        AXON_TARGET_AVX512 auto rmsprop_avx512(Scalar* parameters, const Scalar* gradients,
+                                               Scalar* mean_squares, std::size_t count,
+                                               const optimizer::RMSpropStep<Scalar>& step) -> void
+        {
+            using Ops = simd::Avx512<Scalar>;
+
+            const auto alpha = Ops::broadcast(step.alpha);
+            const auto rest = Ops::broadcast(Scalar{1} - step.alpha);
+            const auto epsilon = Ops::broadcast(step.epsilon);
+            const auto learning_rate = Ops::broadcast(step.learning_rate);
+            const auto l2 = Ops::broadcast(step.l2);
+
+            for (std::size_t i{0}; i < count; i += Ops::width)
+            {
+                const auto mask = count - i >= Ops::width ? static_cast<typename Ops::Mask>(~0U)
+                                                          : Ops::tail_mask(count - i);
+
+                const auto p = Ops::load(mask, parameters + i);
+                const auto g = Ops::fmadd(l2, p, Ops::load(mask, gradients + i));
+                const auto v = Ops::fmadd(alpha, Ops::load(mask, mean_squares + i),
+                                          Ops::mul(Ops::mul(rest, g), g));
+                const auto denominator = Ops::add(Ops::sqrt(v), epsilon);
+
+                Ops::store(mean_squares + i, mask, v);
+                Ops::store(parameters + i, mask,
+                           Ops::sub(p, Ops::div(Ops::mul(learning_rate, g), denominator)));
+            }
+        }
+
+#endif // AXON_SIMD_X86
+
+        template <typename Scalar>
+        using AdamKernel = void (*)(Scalar*, const Scalar*, Scalar*, Scalar*, std::size_t,
+                                    const optimizer::AdamStep<Scalar>&);
+
+        template <typename Scalar>
+        using RMSpropKernel = void (*)(Scalar*, const Scalar*, Scalar*, std::size_t,
+                                       const optimizer::RMSpropStep<Scalar>&);
+
+        // NOTE(abi): follows the ISA chosen for the linear algebra kernels, like the fast
+        // activations, so `set_isa` covers the optimizers too.
+        template <typename Scalar>
+        auto select_adam() -> AdamKernel<Scalar>
+        {
+#if defined(AXON_SIMD_X86)
+            switch (kernels::get_isa())
+            {
+            case kernels::Isa::avx512:
+                return adam_avx512<Scalar>;
+            case kernels::Isa::avx2:
+                return adam_avx2<Scalar>;
+            case kernels::Isa::scalar:
+                break;
+            }
+#endif
+
+            return adam_scalar<Scalar>;
+        }
+
+        template <typename Scalar>
+        auto select_rmsprop() -> RMSpropKernel<Scalar>
+        {
+#if defined(AXON_SIMD_X86)
+            switch (kernels::get_isa())
+            {
+            case kernels::Isa::avx512:
+                return rmsprop_avx512<Scalar>;
+            case kernels::Isa::avx2:
+                return rmsprop_avx2<Scalar>;
+            case kernels::Isa::scalar:
+                break;
+            }
+#endif
+
+            return rmsprop_scalar<Scalar>;
+        }
+
+        // Runs `body(begin, count)` over consecutive chunks of `size` parameters.
+        template <typename Body>
+        auto for_each_chunk(std::size_t size, Body&& body) -> void
+        {
+            const std::size_t num_chunks = (size + update_chunk_size - 1) / update_chunk_size;
+            Scheduler::instance().parallel_for(
+                num_chunks, grain_size(update_chunk_size * update_cost),
+                [&](std::size_t begin, std::size_t end)
+                {
+                    const std::size_t first = begin * update_chunk_size;
+                    const std::size_t last = std::min(end * update_chunk_size, size);
+                    body(first, last - first);
+                });
+        }
+
+        // Validates the gradients and sizes `state`, which holds `buffers` values per parameter,
+        // on the first step.
+        template <typename Scalar>
+        auto check_sizes(std::span<Scalar> parameters, std::span<const Scalar> gradients,
+                         AlignedVector<Scalar>& state, std::size_t buffers = 1) -> void
+        {
+            if (gradients.size() != parameters.size())
+            {
+                throw std::invalid_argument("Invalid number of gradients.");
+            }
+
+            if (state.empty())
+            {
+                state.assign(buffers * parameters.size(), Scalar{0});
+            }
+            else if (state.size() != buffers * parameters.size())
+            {
+                throw std::invalid_argument("The optimizer was used with other parameters.");
+            }
+        }
+
+    } // namespace
+
+    namespace optimizer
+    {
+
+        template <std::floating_point Scalar>
+        auto adam_update(std::span<Scalar> parameters, std::span<const Scalar> gradients,
+                         std::span<Scalar> first_moments, std::span<Scalar> second_moments,
+                         const AdamStep<Scalar>& step) -> void
+        {
+            const auto kernel = select_adam<Scalar>();
+            for_each_chunk(parameters.size(),
+                           [&](std::size_t first, std::size_t count)
+                           {
+                               kernel(parameters.data() + first, gradients.data() + first,
+                                      first_moments.data() + first,
+                                      second_moments.data() + first, count, step);
+                           });
+        }
+
+        template <std::floating_point Scalar>
+        auto rmsprop_update(std::span<Scalar> parameters, std::span<const Scalar> gradients,
+                            std::span<Scalar> mean_squares, const RMSpropStep<Scalar>& step)
+            -> void
+        {
+            const auto kernel = select_rmsprop<Scalar>();
+            for_each_chunk(parameters.size(),
+                           [&](std::size_t first, std::size_t count)
+                           {
+                               kernel(parameters.data() + first, gradients.data() + first,
+                                      mean_squares.data() + first, count, step);
+                           });
+        }
+
+        // NOTE(abi): a plain loop; the compiler already vectorizes it with the baseline ISA and
+        // it is bound by memory bandwidth anyway.
+        template <std::floating_point Scalar>
+        auto sgd_update(std::span<Scalar> parameters, std::span<const Scalar> gradients,
+                        std::span<Scalar> velocities, Scalar learning_rate, Scalar momentum)
+            -> void
+        {
+            for_each_chunk(parameters.size(),
+                           [&](std::size_t first, std::size_t count)
+                           {
+                               for (std::size_t i{first}; i < first + count; ++i)
+                               {
+                                   auto& velocity = velocities[i];
+                                   velocity = (learning_rate * gradients[i])
+                                              + (momentum * velocity);
+                                   parameters[i] -= velocity;
+                               }
+                           });
+        }
+
+        template auto adam_update(std::span<float>, std::span<const float>, std::span<float>,
+                                  std::span<float>, const AdamStep<float>&) -> void;
+        template auto adam_update(std::span<double>, std::span<const double>, std::span<double>,
+                                  std::span<double>, const AdamStep<double>&) -> void;
+        template auto rmsprop_update(std::span<float>, std::span<const float>, std::span<float>,
+                                     const RMSpropStep<float>&) -> void;
+        template auto rmsprop_update(std::span<double>, std::span<const double>,
+                                     std::span<double>, const RMSpropStep<double>&) -> void;
+        template auto sgd_update(std::span<float>, std::span<const float>, std::span<float>,
+                                 float, float) -> void;
+        template auto sgd_update(std::span<double>, std::span<const double>, std::span<double>,
+                                 double, double) -> void;
+
+    } // namespace optimizer
+
+    template <std::floating_point Scalar>
+    auto BasicSgd<Scalar>::step(std::span<Scalar> parameters, std::span<const Scalar> gradients)
+        -> void
+    {
+        check_sizes(parameters, gradients, velocities_);
+        ++num_steps_;
+
+        AXON_TRACE_SCOPE(trace::Phase::update, "sgd_update", -1, 3 * parameters.size(),
+                         5 * parameters.size() * sizeof(Scalar));
+        optimizer::sgd_update<Scalar>(parameters, gradients, velocities_,
+                                      static_cast<Scalar>(options_.learning_rate),
+                                      static_cast<Scalar>(options_.momentum));
+    }
+
+    template <std::floating_point Scalar>
+    BasicAdam<Scalar>::BasicAdam(const AdamOptions& options)
+        : learning_rate_(options.learning_rate),
+          beta1_(options.beta1),
+          beta2_(options.beta2),
+          epsilon_(options.epsilon),
+          l2_(options.weight_decay)
+    {
+    }
+
+    template <std::floating_point Scalar>
+    BasicAdam<Scalar>::BasicAdam(const AdamWOptions& options)
+        : learning_rate_(options.learning_rate),
+          beta1_(options.beta1),
+          beta2_(options.beta2),
+          epsilon_(options.epsilon),
+          decoupled_decay_(options.weight_decay)
+    {
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicAdam<Scalar>::step(std::span<Scalar> parameters, std::span<const Scalar> gradients)
+        -> void
+    {
+        check_sizes(parameters, gradients, moments_, 2);
+
+        ++num_steps_;
+        const auto steps = static_cast<double>(num_steps_);
+        const optimizer::AdamStep<Scalar> step{
+            .beta1 = static_cast<Scalar>(beta1_),
+            .beta2 = static_cast<Scalar>(beta2_),
+            .epsilon = static_cast<Scalar>(epsilon_),
+            .step_size = static_cast<Scalar>(learning_rate_ / (1.0 - std::pow(beta1_, steps))),
+            .correction = static_cast<Scalar>(1.0 / (1.0 - std::pow(beta2_, steps))),
+            .l2 = static_cast<Scalar>(l2_),
+            .shrink = static_cast<Scalar>(1.0 - (learning_rate_ * decoupled_decay_)),
+        };
+
+        AXON_TRACE_SCOPE(trace::Phase::update, "adam_update", -1, 12 * parameters.size(),
+                         7 * parameters.size() * sizeof(Scalar));
+        const std::span<Scalar> moments{moments_};
+        optimizer::adam_update<Scalar>(parameters, gradients,
+                                       moments.first(parameters.size()),
+                                       moments.subspan(parameters.size()), step);
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicRMSprop<Scalar>::step(std::span<Scalar> parameters,
+                                    std::span<const Scalar> gradients) -> void
+    {
+        check_sizes(parameters, gradients, mean_squares_);
+        ++num_steps_;
+
+        const optimizer::RMSpropStep<Scalar> step{
+            .learning_rate = static_cast<Scalar>(options_.learning_rate),
+            .alpha = static_cast<Scalar>(options_.alpha),
+            .epsilon = static_cast<Scalar>(options_.epsilon),
+            .l2 = static_cast<Scalar>(options_.weight_decay),
+        };
+
+        AXON_TRACE_SCOPE(trace::Phase::update, "rmsprop_update", -1, 8 * parameters.size(),
+                         5 * parameters.size() * sizeof(Scalar));
+        optimizer::rmsprop_update<Scalar>(parameters, gradients, mean_squares_, step);
+    }
+
+    template class BasicSgd<float>;
+    template class BasicSgd<double>;
+    template class BasicAdam<float>;
+    template class BasicAdam<double>;
+    template class BasicRMSprop<float>;
+    template class BasicRMSprop<double>;
+
+} // namespace axon
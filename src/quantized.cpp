@@ -0,0 +1,327 @@
+#include "quantized.hpp"
+
+#include "dispatch.hpp"
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace axon
+{
+
+    using detail::dispatch;
+
+    namespace
+    {
+        constexpr std::int32_t max_weight_code{127};
+        constexpr std::int32_t max_input_code{255};
+
+        // Widest layer whose 32-bit sums of input and weight code products cannot overflow.
+        constexpr std::size_t max_num_inputs{std::numeric_limits<std::int32_t>::max()
+                                             / (max_input_code * max_weight_code)};
+
+        // Asymmetric parameters covering [min_value, max_value]. The range is widened to include
+        // zero so that zero is represented exactly (e.g. ReLU outputs and the padding).
+        auto input_parameters(float min_value, float max_value) -> quantization::Parameters
+        {
+            min_value = std::min(min_value, 0.0F);
+            max_value = std::max(max_value, 0.0F);
+            if (max_value == min_value)
+            {
+                return {};
+            }
+
+            const float scale = (max_value - min_value) / static_cast<float>(max_input_code);
+            const auto zero_point = static_cast<std::int32_t>(std::nearbyint(-min_value / scale));
+            return {.scale = scale, .zero_point = std::clamp(zero_point, 0, max_input_code)};
+        }
+
+        auto weight_scale(float max_magnitude) -> float
+        {
+            return max_magnitude > 0.0F ? max_magnitude / static_cast<float>(max_weight_code)
+                                        : 1.0F;
+        }
+
+        template <std::floating_point Scalar>
+        auto quantize_layer(const BasicLayer<Scalar>& layer,
+                            quantization::Granularity granularity) -> QuantizedLayer
+        {
+            if (layer.num_inputs > max_num_inputs)
+            {
+                throw std::invalid_argument("Too many inputs for exact 32-bit accumulation.");
+            }
+
+            QuantizedLayer quantized;
+            quantized.num_inputs = layer.num_inputs;
+            quantized.num_outputs = layer.num_outputs;
+            // NOTE(abi): rows padded to whole cache lines keep every row aligned and let the
+            // integer kernels run without a tail; the padding codes are zero.
+            quantized.stride =
+                ((layer.num_inputs + cache_line_size - 1) / cache_line_size) * cache_line_size;
+
+            quantized.weights.assign(quantized.num_outputs * quantized.stride, 0);
+            quantized.weight_scales.resize(quantized.num_outputs);
+            quantized.weight_sums.resize(quantized.num_outputs);
+            quantized.biases.assign(layer.biases.begin(), layer.biases.end());
+
+            const auto row_magnitude = [&](std::size_t out)
+            {
+                float magnitude{0.0F};
+                for (std::size_t in{0}; in < layer.num_inputs; ++in)
+                {
+                    magnitude = std::max(magnitude,
+                                         static_cast<float>(std::abs(layer.weight(out, in))));
+                }
+                return magnitude;
+            };
+
+            float layer_magnitude{0.0F};
+            if (granularity == quantization::Granularity::per_layer)
+            {
+                for (std::size_t out{0}; out < layer.num_outputs; ++out)
+                {
+                    layer_magnitude = std::max(layer_magnitude, row_magnitude(out));
+                }
+            }
+
+            for (std::size_t out{0}; out < layer.num_outputs; ++out)
+            {
+                const float scale =
+                    weight_scale(granularity == quantization::Granularity::per_layer
+                                     ? layer_magnitude
+                                     : row_magnitude(out));
+
+                std::int32_t sum{0};
+                for (std::size_t in{0}; in < layer.num_inputs; ++in)
+                {
+                    const auto code = std::clamp(
+                        static_cast<std::int32_t>(std::nearbyint(
+                            static_cast<float>(layer.weight(out, in)) / scale)),
+                        -max_weight_code, max_weight_code);
+
+                    quantized.weights[(out * quantized.stride) + in] =
+                        static_cast<std::int8_t>(code);
+                    sum += code;
+                }
+
+                quantized.weight_scales[out] = scale;
+                quantized.weight_sums[out] = sum;
+            }
+
+            return quantized;
+        }
+
+        template <std::floating_point Scalar>
+        auto value_range(std::span<const Scalar> values) -> std::pair<float, float>
+        {
+            const auto [min_it, max_it] = std::ranges::minmax_element(values);
+            return {static_cast<float>(*min_it), static_cast<float>(*max_it)};
+        }
+
+    } // namespace
+
+    template <std::floating_point Scalar>
+    QuantizedNetwork::QuantizedNetwork(const BasicNetwork<Scalar>& network,
+                                       std::span<const Scalar> calibration_inputs,
+                                       std::size_t num_samples,
+                                       quantization::Granularity granularity)
+        : activation_(network.get_activation()),
+          math_mode_(network.get_math_mode())
+    {
+        // The calibration pass doubles as the input validation.
+        auto workspace = network.make_workspace();
+        network.forward(calibration_inputs, num_samples, workspace);
+
+        const auto& layers = network.get_layers();
+        layers_.reserve(layers.size());
+        for (std::size_t layer_idx{0}; layer_idx < layers.size(); ++layer_idx)
+        {
+            auto& layer = layers_.emplace_back(quantize_layer(layers[layer_idx], granularity));
+
+            const auto [min_value, max_value] =
+                value_range<Scalar>(layer_idx == 0 ? workspace.inputs
+                                                   : workspace.layers[layer_idx - 1].outputs);
+            layer.input = input_parameters(min_value, max_value);
+        }
+    }
+
+    auto QuantizedNetwork::get_parameter_bytes() const -> std::size_t
+    {
+        std::size_t bytes{0};
+        for (const auto& layer : layers_)
+        {
+            bytes += (layer.weights.size() * sizeof(std::int8_t))
+                     + (layer.weight_scales.size() * sizeof(float))
+                     + (layer.weight_sums.size() * sizeof(std::int32_t))
+                     + (layer.biases.size() * sizeof(float));
+        }
+
+        return bytes;
+    }
+
+    auto QuantizedNetwork::forward(std::span<const float> inputs, std::size_t batch_size,
+                                   std::span<float> outputs) -> void
+    {
+        if (batch_size == 0 || inputs.size() != batch_size * get_num_inputs())
+        {
+            throw std::invalid_argument("Invalid number of inputs.");
+        }
+
+        if (outputs.size() != batch_size * get_num_outputs())
+        {
+            throw std::invalid_argument("Invalid output buffer size.");
+        }
+
+        std::size_t max_stride{0};
+        std::size_t max_outputs{0};
+        for (const auto& layer : layers_)
+        {
+            max_stride = std::max(max_stride, layer.stride);
+            max_outputs = std::max(max_outputs, layer.num_outputs);
+        }
+
+        codes_.resize(batch_size * max_stride);
+        accumulators_.resize(batch_size * max_outputs);
+        for (auto& buffer : activations_)
+        {
+            buffer.resize(batch_size * max_outputs);
+        }
+
+        const float* layer_inputs = inputs.data();
+        for (std::size_t layer_idx{0}; layer_idx < layers_.size(); ++layer_idx)
+        {
+            const auto& layer = layers_[layer_idx];
+            const float inverse_scale = 1.0F / layer.input.scale;
+            const auto zero_point = static_cast<float>(layer.input.zero_point);
+
+            for (std::size_t sample{0}; sample < batch_size; ++sample)
+            {
+                const float* sample_inputs = layer_inputs + (sample * layer.num_inputs);
+                std::uint8_t* sample_codes = &codes_[sample * layer.stride];
+                for (std::size_t in{0}; in < layer.num_inputs; ++in)
+                {
+                    const float code =
+                        std::nearbyint(sample_inputs[in] * inverse_scale) + zero_point;
+                    sample_codes[in] = static_cast<std::uint8_t>(
+                        std::clamp(code, 0.0F, static_cast<float>(max_input_code)));
+                }
+
+                // NOTE(abi): rows of a wider layer may leave stale codes in the padding, which
+                // the zero weight padding cancels anyway; clearing it keeps them deterministic.
+                std::fill(sample_codes + layer.num_inputs, sample_codes + layer.stride,
+                          std::uint8_t{0});
+            }
+
+            kernels::gemm_u8s8(batch_size, layer.num_outputs, layer.stride, codes_.data(),
+                               layer.stride, layer.weights.data(), layer.stride,
+                               accumulators_.data(), layer.num_outputs);
+
+            const bool is_last = layer_idx + 1 == layers_.size();
+            float* layer_outputs = is_last ? outputs.data() : activations_[layer_idx % 2].data();
+            const std::size_t count = batch_size * layer.num_outputs;
+
+            // real = input_scale * weight_scale * sum((x - zero_point) * w) + bias
+            for (std::size_t sample{0}; sample < batch_size; ++sample)
+            {
+                const std::int32_t* sample_sums = &accumulators_[sample * layer.num_outputs];
+                float* sample_outputs = layer_outputs + (sample * layer.num_outputs);
+                for (std::size_t out{0}; out < layer.num_outputs; ++out)
+                {
+                    const std::int32_t sum =
+                        sample_sums[out] - (layer.input.zero_point * layer.weight_sums[out]);
+                    sample_outputs[out] =
+                        (static_cast<float>(sum) * layer.input.scale * layer.weight_scales[out])
+                        + layer.biases[out];
+                }
+            }
+
+            const std::span<float> values{layer_outputs, count};
+            dispatch(activation_, [&](const auto& policy)
+                     { policy.template apply<float>(values, values, math_mode_); });
+
+            layer_inputs = layer_outputs;
+        }
+    }
+
+    template QuantizedNetwork::QuantizedNetwork(const BasicNetwork<float>&, std::span<const float>,
+                                                std::size_t, quantization::Granularity);
+    template QuantizedNetwork::QuantizedNetwork(const BasicNetwork<double>&,
+                                                std::span<const double>, std::size_t,
+                                                quantization::Granularity);
+
+    namespace quantization
+    {
+
+        template <std::floating_point Scalar>
+        auto evaluate(const BasicNetwork<Scalar>& network, QuantizedNetwork& quantized,
+                      std::span<const Scalar> inputs, std::span<const Scalar> targets,
+                      std::size_t num_samples) -> Report
+        {
+            auto workspace = network.make_workspace();
+            network.forward(inputs, num_samples, workspace);
+            const auto& reference = workspace.layers.back().outputs;
+
+            const std::vector<float> narrow_inputs(inputs.begin(), inputs.end());
+            std::vector<float> outputs(reference.size());
+            quantized.forward(narrow_inputs, num_samples, outputs);
+
+            Report report{};
+            report.reference_loss = static_cast<double>(network.loss(targets, workspace));
+
+            const auto& criterion = network.get_criterion();
+            const std::size_t num_outputs = quantized.get_num_outputs();
+            std::size_t agreements{0};
+
+            for (std::size_t sample{0}; sample < num_samples; ++sample)
+            {
+                std::size_t reference_argmax{0};
+                std::size_t quantized_argmax{0};
+
+                for (std::size_t out{0}; out < num_outputs; ++out)
+                {
+                    const std::size_t i = (sample * num_outputs) + out;
+                    const auto expected = static_cast<double>(reference[i]);
+                    const auto actual = static_cast<double>(outputs[i]);
+                    const double error = std::abs(actual - expected);
+
+                    report.max_abs_error = std::max(report.max_abs_error, error);
+                    report.mean_abs_error += error;
+                    report.quantized_loss +=
+                        criterion.function(static_cast<double>(targets[i]), actual);
+
+                    if (reference[i] > reference[(sample * num_outputs) + reference_argmax])
+                    {
+                        reference_argmax = out;
+                    }
+
+                    if (outputs[i] > outputs[(sample * num_outputs) + quantized_argmax])
+                    {
+                        quantized_argmax = out;
+                    }
+                }
+
+                agreements += reference_argmax == quantized_argmax ? 1 : 0;
+            }
+
+            const auto count = static_cast<double>(outputs.size());
+            report.mean_abs_error /= count;
+            report.quantized_loss /= count;
+            report.argmax_agreement =
+                static_cast<double>(agreements) / static_cast<double>(num_samples);
+
+            return report;
+        }
+
+        template auto evaluate(const BasicNetwork<float>&, QuantizedNetwork&,
+                               std::span<const float>, std::span<const float>, std::size_t)
+            -> Report;
+        template auto evaluate(const BasicNetwork<double>&, QuantizedNetwork&,
+                               std::span<const double>, std::span<const double>, std::size_t)
+            -> Report;
+
+    } // namespace quantization
+
+} // namespace axon
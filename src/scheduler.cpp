@@ -0,0 +1,332 @@
+#include "scheduler.hpp"
+
+#include <charconv>
+#include <cstdlib>
+#include <string_view>
+
+namespace axon
+{
+
+    namespace
+    {
+
+        // Scheduler the current thread works for, and its slot there.
+        thread_local const void* current_scheduler{nullptr};
+        thread_local std::size_t current_worker_slot{0};
+
+        // Rounds a thread waiting on a loop looks for work before parking.
+        constexpr std::size_t spins_before_parking{64};
+
+    } // namespace
+
+    Scheduler::Scheduler(std::size_t num_threads)
+        : num_queues_((2 * std::max<std::size_t>(num_threads, 1)) - 1),
+          queues_(std::make_unique<WorkQueue[]>(num_queues_))
+    {
+        const std::size_t num_workers = std::max<std::size_t>(num_threads, 1) - 1;
+
+        workers_.reserve(num_workers);
+        for (std::size_t slot{0}; slot < num_workers; ++slot)
+        {
+            workers_.emplace_back([this, slot] { worker_loop(slot); });
+        }
+    }
+
+    Scheduler::~Scheduler()
+    {
+        {
+            const std::scoped_lock lock{sleep_mutex_};
+            stopping_ = true;
+        }
+        work_available_.notify_all();
+
+        for (auto& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    auto Scheduler::instance() -> Scheduler&
+    {
+        static Scheduler scheduler;
+        return scheduler;
+    }
+
+    auto Scheduler::default_num_threads() -> std::size_t
+    {
+        // NOLINTNEXTLINE(concurrency-mt-unsafe): only read, never written by the library.
+        if (const char* value = std::getenv("AXON_NUM_THREADS"); value != nullptr)
+        {
+            const std::string_view text{value};
+            std::size_t num_threads{0};
+            const auto [end, error] =
+                std::from_chars(text.data(), text.data() + text.size(), num_threads);
+            if (error == std::errc{} && end == text.data() + text.size() && num_threads > 0)
+            {
+                return num_threads;
+            }
+        }
+
+        return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    auto Scheduler::run(std::size_t count, std::size_t grain, Task task, void* context) -> void
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        grain = std::max<std::size_t>(grain, 1);
+        if (workers_.empty() || count <= grain)
+        {
+            task(context, 0, count);
+            return;
+        }
+
+        if (current_scheduler == this)
+        {
+            run_loop(count, grain, task, context, current_worker_slot);
+            return;
+        }
+
+        // NOTE(abi): a thread from outside borrows a deque for its outermost loop, so that two
+        // callers never end up running, and waiting on, each other's ranges.
+        const auto slot = claim_slot();
+        if (!slot)
+        {
+            task(context, 0, count);
+            return;
+        }
+
+        struct Borrowed
+        {
+            WorkQueue& queue;
+            const void* previous_scheduler;
+            std::size_t previous_slot;
+
+            ~Borrowed()
+            {
+                current_scheduler = previous_scheduler;
+                current_worker_slot = previous_slot;
+                queue.claimed.store(false, std::memory_order_release);
+            }
+        };
+
+        const Borrowed borrowed{.queue = queues_[*slot],
+                                .previous_scheduler = current_scheduler,
+                                .previous_slot = current_worker_slot};
+        current_scheduler = this;
+        current_worker_slot = *slot;
+
+        run_loop(count, grain, task, context, *slot);
+    }
+
+    auto Scheduler::run_loop(std::size_t count, std::size_t grain, Task task, void* context,
+                             std::size_t slot) -> void
+    {
+        Loop loop{.task = task,
+                  .context = context,
+                  .grain = grain,
+                  .remaining = count,
+                  .failed = false,
+                  .error = nullptr};
+
+        execute({.loop = &loop, .begin = 0, .end = count}, slot);
+
+        // NOTE(abi): rather than blocking straight away, help with whatever is pending; the
+        // ranges split off this loop are usually still at the back of our own deque. Only once
+        // there has been nothing to take for a while does the thread park, until either the
+        // loop finishes or more work is queued.
+        std::size_t idle_rounds{0};
+        while (loop.remaining.load() != 0)
+        {
+            if (auto range = find_work(slot))
+            {
+                execute(*range, slot);
+                idle_rounds = 0;
+                continue;
+            }
+
+            if (++idle_rounds < spins_before_parking)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock lock{sleep_mutex_};
+            waiting_.fetch_add(1);
+            work_available_.wait(lock, [&]
+                                 { return loop.remaining.load() == 0 || queued_.load() != 0; });
+            waiting_.fetch_sub(1);
+            idle_rounds = 0;
+        }
+
+        if (loop.error)
+        {
+            std::rethrow_exception(loop.error);
+        }
+    }
+
+    auto Scheduler::claim_slot() -> std::optional<std::size_t>
+    {
+        for (std::size_t slot{workers_.size()}; slot < num_queues_; ++slot)
+        {
+            if (!queues_[slot].claimed.exchange(true, std::memory_order_acquire))
+            {
+                return slot;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    auto Scheduler::execute(Range range, std::size_t slot) -> void
+    {
+        Loop& loop = *range.loop;
+
+        // Split off the upper half, on a grain boundary, for as long as someone could steal it.
+        while (range.end - range.begin > loop.grain)
+        {
+            const std::size_t chunks = (range.end - range.begin + loop.grain - 1) / loop.grain;
+            const std::size_t middle = range.begin + ((chunks / 2) * loop.grain);
+
+            if (!push(slot, {.loop = &loop, .begin = middle, .end = range.end}))
+            {
+                break;
+            }
+            range.end = middle;
+        }
+
+        if (!loop.failed.load(std::memory_order_relaxed))
+        {
+            try
+            {
+                loop.task(loop.context, range.begin, range.end);
+            }
+            catch (...)
+            {
+                if (!loop.failed.exchange(true, std::memory_order_relaxed))
+                {
+                    loop.error = std::current_exception();
+                }
+            }
+        }
+
+        // NOTE(abi): this must be the last access to the loop, which lives on the stack of the
+        // thread waiting for it. As in `push`, the count is lowered before `waiting_` is read,
+        // while a waiter does the opposite, so a parked waiter is always woken.
+        const std::size_t size = range.end - range.begin;
+        if (loop.remaining.fetch_sub(size) == size && waiting_.load() != 0)
+        {
+            {
+                const std::scoped_lock lock{sleep_mutex_};
+            }
+            work_available_.notify_all();
+        }
+    }
+
+    auto Scheduler::push(std::size_t slot, const Range& range) -> bool
+    {
+        {
+            WorkQueue& queue = queues_[slot];
+            const std::scoped_lock lock{queue.mutex};
+            if (queue.tail - queue.head == WorkQueue::capacity)
+            {
+                return false;
+            }
+
+            queue.ranges[queue.tail % WorkQueue::capacity] = range;
+            ++queue.tail;
+        }
+
+        // NOTE(abi): `queued_` is raised before `sleeping_` and `waiting_` are read, while a
+        // thread going to sleep does the opposite, so either we see the sleeper or it sees the
+        // work.
+        queued_.fetch_add(1);
+        if (sleeping_.load() != 0 || waiting_.load() != 0)
+        {
+            {
+                const std::scoped_lock lock{sleep_mutex_};
+            }
+            work_available_.notify_one();
+        }
+
+        return true;
+    }
+
+    auto Scheduler::pop(std::size_t slot) -> std::optional<Range>
+    {
+        WorkQueue& queue = queues_[slot];
+        const std::scoped_lock lock{queue.mutex};
+        if (queue.head == queue.tail)
+        {
+            return std::nullopt;
+        }
+
+        --queue.tail;
+        queued_.fetch_sub(1);
+        return queue.ranges[queue.tail % WorkQueue::capacity];
+    }
+
+    auto Scheduler::steal(std::size_t slot) -> std::optional<Range>
+    {
+        for (std::size_t offset{1}; offset < num_queues_; ++offset)
+        {
+            WorkQueue& queue = queues_[(slot + offset) % num_queues_];
+            const std::scoped_lock lock{queue.mutex};
+            if (queue.head == queue.tail)
+            {
+                continue;
+            }
+
+            const Range range = queue.ranges[queue.head % WorkQueue::capacity];
+            ++queue.head;
+            queued_.fetch_sub(1);
+            return range;
+        }
+
+        return std::nullopt;
+    }
+
+    auto Scheduler::find_work(std::size_t slot) -> std::optional<Range>
+    {
+        if (queued_.load() == 0)
+        {
+            return std::nullopt;
+        }
+
+        if (auto range = pop(slot))
+        {
+            return range;
+        }
+
+        return steal(slot);
+    }
+
+    auto Scheduler::worker_loop(std::size_t slot) -> void
+    {
+        current_scheduler = this;
+        current_worker_slot = slot;
+
+        while (true)
+        {
+            if (auto range = find_work(slot))
+            {
+                execute(*range, slot);
+                continue;
+            }
+
+            std::unique_lock lock{sleep_mutex_};
+            sleeping_.fetch_add(1);
+            work_available_.wait(lock, [this] { return stopping_ || queued_.load() != 0; });
+            sleeping_.fetch_sub(1);
+
+            if (stopping_)
+            {
+                return;
+            }
+        }
+    }
+
+} // namespace axon
@@ -0,0 +1,156 @@
+#include "serialization.hpp"
+
+#include "dense.hpp"
+#include "format.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace axon
+{
+
+    namespace serialization
+    {
+
+        auto checksum(std::span<const std::byte> bytes) -> std::uint64_t
+        {
+            constexpr std::uint64_t multiplier{0x9E3779B97F4A7C15};
+            std::uint64_t hash{0xCBF29CE484222325};
+
+            const auto mix = [&](std::uint64_t word)
+            {
+                hash = (hash ^ word) * multiplier;
+                hash ^= hash >> 29;
+            };
+
+            // NOTE(abi): eight bytes per step keeps verification close to memory bandwidth.
+            std::size_t i{0};
+            for (; i + sizeof(std::uint64_t) <= bytes.size(); i += sizeof(std::uint64_t))
+            {
+                std::uint64_t word{0};
+                std::memcpy(&word, bytes.data() + i, sizeof(word));
+                mix(word);
+            }
+
+            if (i < bytes.size())
+            {
+                std::uint64_t word{0};
+                std::memcpy(&word, bytes.data() + i, bytes.size() - i);
+                mix(word);
+            }
+
+            return hash ^ bytes.size();
+        }
+
+        template <std::floating_point Scalar>
+        auto save(const BasicNetwork<Scalar>& network, const std::filesystem::path& path) -> void
+        {
+            const auto layout =
+                detail::make_layout(detail::FileKind::model, detail::layer_sizes_of(network),
+                                    sizeof(Scalar));
+
+            std::vector<std::byte> bytes(layout.file_bytes);
+            detail::write_network(detail::FileKind::model, network, layout, bytes);
+            detail::seal(bytes);
+            write_file_atomically(path, bytes);
+        }
+
+        template <std::floating_point Scalar>
+        auto load(const std::filesystem::path& path, Verification verification)
+            -> BasicNetwork<Scalar>
+        {
+            const MappedFile file(path);
+            const auto bytes = file.bytes();
+            const auto model =
+                detail::parse(detail::FileKind::model, bytes, sizeof(Scalar), verification);
+
+            BasicNetwork<Scalar> network(model.layer_sizes, model.activation, model.criterion);
+            auto& layers = network.get_layers();
+            for (std::size_t layer_idx{0}; layer_idx < layers.size(); ++layer_idx)
+            {
+                auto& layer = layers[layer_idx];
+                const auto& blocks = model.layout.layers[layer_idx];
+                std::ranges::copy(
+                    detail::block<Scalar>(bytes, blocks.weights, layer.weights.size()),
+                    layer.weights.begin());
+                std::ranges::copy(detail::block<Scalar>(bytes, blocks.biases, layer.biases.size()),
+                                  layer.biases.begin());
+            }
+
+            return network;
+        }
+
+        template auto save(const BasicNetwork<float>&, const std::filesystem::path&) -> void;
+        template auto save(const BasicNetwork<double>&, const std::filesystem::path&) -> void;
+        template auto load<float>(const std::filesystem::path&, Verification)
+            -> BasicNetwork<float>;
+        template auto load<double>(const std::filesystem::path&, Verification)
+            -> BasicNetwork<double>;
+
+    } // namespace serialization
+
+    template <std::floating_point Scalar>
+    BasicMappedNetwork<Scalar>::BasicMappedNetwork(const std::filesystem::path& path,
+                                                   serialization::Verification verification)
+        : file_(path)
+    {
+        const auto bytes = file_.bytes();
+        auto model = detail::parse(detail::FileKind::model, bytes, sizeof(Scalar), verification);
+
+        layer_sizes_ = std::move(model.layer_sizes);
+        activation_ = std::move(model.activation);
+        criterion_ = std::move(model.criterion);
+
+        for (std::size_t layer_idx{1}; layer_idx < layer_sizes_.size(); ++layer_idx)
+        {
+            const std::size_t num_inputs = layer_sizes_[layer_idx - 1];
+            const std::size_t num_outputs = layer_sizes_[layer_idx];
+
+            const auto& blocks = model.layout.layers[layer_idx - 1];
+            weights_.push_back(
+                detail::block<Scalar>(bytes, blocks.weights, num_outputs * num_inputs));
+            biases_.push_back(detail::block<Scalar>(bytes, blocks.biases, num_outputs));
+        }
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicMappedNetwork<Scalar>::forward(std::span<const Scalar> inputs,
+                                             std::size_t batch_size, std::span<Scalar> outputs)
+        -> void
+    {
+        if (batch_size == 0 || inputs.size() != batch_size * layer_sizes_.front())
+        {
+            throw std::invalid_argument("Invalid number of inputs.");
+        }
+
+        if (outputs.size() != batch_size * layer_sizes_.back())
+        {
+            throw std::invalid_argument("Invalid output buffer size.");
+        }
+
+        const std::size_t max_outputs = std::ranges::max(layer_sizes_);
+        for (auto& buffer : activations_)
+        {
+            buffer.resize(batch_size * max_outputs);
+        }
+
+        const Scalar* layer_inputs = inputs.data();
+        for (std::size_t layer_idx{0}; layer_idx < weights_.size(); ++layer_idx)
+        {
+            const bool is_last = layer_idx + 1 == weights_.size();
+            Scalar* layer_outputs = is_last ? outputs.data() : activations_[layer_idx % 2].data();
+
+            detail::dense_forward(layer_inputs, batch_size, layer_sizes_[layer_idx],
+                                  layer_sizes_[layer_idx + 1], weights_[layer_idx].data(),
+                                  biases_[layer_idx].data(), activation_, math_mode_,
+                                  layer_outputs);
+
+            layer_inputs = layer_outputs;
+        }
+    }
+
+    template class BasicMappedNetwork<float>;
+    template class BasicMappedNetwork<double>;
+
+} // namespace axon
@@ -0,0 +1,326 @@
+#pragma once
+
+// Thin wrappers over the x86 vector intrinsics, specialised per scalar type so that a kernel can
+// be written once for both `float` and `double`. Internal to the library.
+
+#include <cstddef>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define AXON_SIMD_X86 1
+    #include <immintrin.h>
+#endif
+
+#if defined(AXON_SIMD_X86)
+
+    #define AXON_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #define AXON_TARGET_AVX512 __attribute__((target("avx512f")))
+    #define AXON_TARGET_AVX512_VNNI __attribute__((target("avx512f,avx512vnni")))
+
+    // NOTE(abi): the wrappers must be inlined into kernels compiled for the same target, or every
+    // operation turns into a call that passes vectors through memory.
+    #define AXON_SIMD_AVX2 __attribute__((target("avx2,fma"), always_inline))
+    #define AXON_SIMD_AVX512 __attribute__((target("avx512f"), always_inline))
+    #define AXON_SIMD_AVX512_VNNI __attribute__((target("avx512f,avx512vnni"), always_inline))
+
+namespace axon::simd
+{
+
+    template <typename Scalar>
+    struct Avx2;
+
+    template <typename Scalar>
+    struct Avx512;
+
+    template <>
+    struct Avx2<double>
+    {
+        using Vector = __m256d;
+        static constexpr std::size_t width{4};
+
+        AXON_SIMD_AVX2 static auto zero() -> Vector
+        {
+            return _mm256_setzero_pd();
+        }
+
+        AXON_SIMD_AVX2 static auto broadcast(double value) -> Vector
+        {
+            return _mm256_set1_pd(value);
+        }
+
+        AXON_SIMD_AVX2 static auto load(const double* source) -> Vector
+        {
+            return _mm256_loadu_pd(source);
+        }
+
+        AXON_SIMD_AVX2 static auto store(double* destination, Vector value) -> void
+        {
+            _mm256_storeu_pd(destination, value);
+        }
+
+        // a * b + c
+        AXON_SIMD_AVX2 static auto fmadd(Vector a, Vector b, Vector c) -> Vector
+        {
+            return _mm256_fmadd_pd(a, b, c);
+        }
+
+        AXON_SIMD_AVX2 static auto add(Vector a, Vector b) -> Vector
+        {
+            return _mm256_add_pd(a, b);
+        }
+
+        AXON_SIMD_AVX2 static auto sub(Vector a, Vector b) -> Vector
+        {
+            return _mm256_sub_pd(a, b);
+        }
+
+        AXON_SIMD_AVX2 static auto mul(Vector a, Vector b) -> Vector
+        {
+            return _mm256_mul_pd(a, b);
+        }
+
+        AXON_SIMD_AVX2 static auto div(Vector a, Vector b) -> Vector
+        {
+            return _mm256_div_pd(a, b);
+        }
+
+        AXON_SIMD_AVX2 static auto sqrt(Vector value) -> Vector
+        {
+            return _mm256_sqrt_pd(value);
+        }
+
+        AXON_SIMD_AVX2 static auto reduce_add(Vector value) -> double
+        {
+            const __m128d low = _mm256_castpd256_pd128(value);
+            const __m128d high = _mm256_extractf128_pd(value, 1);
+            const __m128d pair = _mm_add_pd(low, high);
+            return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+        }
+    };
+
+    template <>
+    struct Avx2<float>
+    {
+        using Vector = __m256;
+        static constexpr std::size_t width{8};
+
+        AXON_SIMD_AVX2 static auto zero() -> Vector
+        {
+            return _mm256_setzero_ps();
+        }
+
+        AXON_SIMD_AVX2 static auto broadcast(float value) -> Vector
+        {
+            return _mm256_set1_ps(value);
+        }
+
+        AXON_SIMD_AVX2 static auto load(const float* source) -> Vector
+        {
+            return _mm256_loadu_ps(source);
+        }
+
+        AXON_SIMD_AVX2 static auto store(float* destination, Vector value) -> void
+        {
+            _mm256_storeu_ps(destination, value);
+        }
+
+        AXON_SIMD_AVX2 static auto fmadd(Vector a, Vector b, Vector c) -> Vector
+        {
+            return _mm256_fmadd_ps(a, b, c);
+        }
+
+        AXON_SIMD_AVX2 static auto add(Vector a, Vector b) -> Vector
+        {
+            return _mm256_add_ps(a, b);
+        }
+
+        AXON_SIMD_AVX2 static auto sub(Vector a, Vector b) -> Vector
+        {
+            return _mm256_sub_ps(a, b);
+        }
+
+        AXON_SIMD_AVX2 static auto mul(Vector a, Vector b) -> Vector
+        {
+            return _mm256_mul_ps(a, b);
+        }
+
+        AXON_SIMD_AVX2 static auto div(Vector a, Vector b) -> Vector
+        {
+            return _mm256_div_ps(a, b);
+        }
+
+        AXON_SIMD_AVX2 static auto sqrt(Vector value) -> Vector
+        {
+            return _mm256_sqrt_ps(value);
+        }
+
+        AXON_SIMD_AVX2 static auto reduce_add(Vector value) -> float
+        {
+            const __m128 low = _mm256_castps256_ps128(value);
+            const __m128 high = _mm256_extractf128_ps(value, 1);
+            __m128 sum = _mm_add_ps(low, high);
+            sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+            return _mm_cvtss_f32(_mm_add_ss(sum, _mm_movehdup_ps(sum)));
+        }
+    };
+
+    template <>
+    struct Avx512<double>
+    {
+        using Vector = __m512d;
+        using Mask = __mmask8;
+        static constexpr std::size_t width{8};
+
+        AXON_SIMD_AVX512 static auto zero() -> Vector
+        {
+            return _mm512_setzero_pd();
+        }
+
+        AXON_SIMD_AVX512 static auto broadcast(double value) -> Vector
+        {
+            return _mm512_set1_pd(value);
+        }
+
+        AXON_SIMD_AVX512 static auto load(const double* source) -> Vector
+        {
+            return _mm512_loadu_pd(source);
+        }
+
+        AXON_SIMD_AVX512 static auto store(double* destination, Vector value) -> void
+        {
+            _mm512_storeu_pd(destination, value);
+        }
+
+        // Mask selecting the first `count` lanes, for `count < width`.
+        AXON_SIMD_AVX512 static auto tail_mask(std::size_t count) -> Mask
+        {
+            return static_cast<Mask>((1U << count) - 1U);
+        }
+
+        // Masked-off lanes read as zero and are left untouched on store.
+        AXON_SIMD_AVX512 static auto load(Mask mask, const double* source) -> Vector
+        {
+            return _mm512_maskz_loadu_pd(mask, source);
+        }
+
+        AXON_SIMD_AVX512 static auto store(double* destination, Mask mask, Vector value) -> void
+        {
+            _mm512_mask_storeu_pd(destination, mask, value);
+        }
+
+        AXON_SIMD_AVX512 static auto fmadd(Vector a, Vector b, Vector c) -> Vector
+        {
+            return _mm512_fmadd_pd(a, b, c);
+        }
+
+        AXON_SIMD_AVX512 static auto add(Vector a, Vector b) -> Vector
+        {
+            return _mm512_add_pd(a, b);
+        }
+
+        AXON_SIMD_AVX512 static auto sub(Vector a, Vector b) -> Vector
+        {
+            return _mm512_sub_pd(a, b);
+        }
+
+        AXON_SIMD_AVX512 static auto mul(Vector a, Vector b) -> Vector
+        {
+            return _mm512_mul_pd(a, b);
+        }
+
+        AXON_SIMD_AVX512 static auto div(Vector a, Vector b) -> Vector
+        {
+            return _mm512_div_pd(a, b);
+        }
+
+        AXON_SIMD_AVX512 static auto sqrt(Vector value) -> Vector
+        {
+            return _mm512_sqrt_pd(value);
+        }
+
+        AXON_SIMD_AVX512 static auto reduce_add(Vector value) -> double
+        {
+            return _mm512_reduce_add_pd(value);
+        }
+    };
+
+    template <>
+    struct Avx512<float>
+    {
+        using Vector = __m512;
+        using Mask = __mmask16;
+        static constexpr std::size_t width{16};
+
+        AXON_SIMD_AVX512 static auto zero() -> Vector
+        {
+            return _mm512_setzero_ps();
+        }
+
+        AXON_SIMD_AVX512 static auto broadcast(float value) -> Vector
+        {
+            return _mm512_set1_ps(value);
+        }
+
+        AXON_SIMD_AVX512 static auto load(const float* source) -> Vector
+        {
+            return _mm512_loadu_ps(source);
+        }
+
+        AXON_SIMD_AVX512 static auto store(float* destination, Vector value) -> void
+        {
+            _mm512_storeu_ps(destination, value);
+        }
+
+        AXON_SIMD_AVX512 static auto tail_mask(std::size_t count) -> Mask
+        {
+            return static_cast<Mask>((1U << count) - 1U);
+        }
+
+        AXON_SIMD_AVX512 static auto load(Mask mask, const float* source) -> Vector
+        {
+            return _mm512_maskz_loadu_ps(mask, source);
+        }
+
+        AXON_SIMD_AVX512 static auto store(float* destination, Mask mask, Vector value) -> void
+        {
+            _mm512_mask_storeu_ps(destination, mask, value);
+        }
+
+        AXON_SIMD_AVX512 static auto fmadd(Vector a, Vector b, Vector c) -> Vector
+        {
+            return _mm512_fmadd_ps(a, b, c);
+        }
+
+        AXON_SIMD_AVX512 static auto add(Vector a, Vector b) -> Vector
+        {
+            return _mm512_add_ps(a, b);
+        }
+
+        AXON_SIMD_AVX512 static auto sub(Vector a, Vector b) -> Vector
+        {
+            return _mm512_sub_ps(a, b);
+        }
+
+        AXON_SIMD_AVX512 static auto mul(Vector a, Vector b) -> Vector
+        {
+            return _mm512_mul_ps(a, b);
+        }
+
+        AXON_SIMD_AVX512 static auto div(Vector a, Vector b) -> Vector
+        {
+            return _mm512_div_ps(a, b);
+        }
+
+        AXON_SIMD_AVX512 static auto sqrt(Vector value) -> Vector
+        {
+            return _mm512_sqrt_ps(value);
+        }
+
+        AXON_SIMD_AVX512 static auto reduce_add(Vector value) -> float
+        {
+            return _mm512_reduce_add_ps(value);
+        }
+    };
+
+} // namespace axon::simd
+
+#endif // AXON_SIMD_X86
@@ -0,0 +1,436 @@
+#include "sparse.hpp"
+
+#include "scheduler.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace axon::sparse
+{
+
+    namespace
+    {
+        // Kept weights over occupied blocks above which the block format wins over CSR: below
+        // it the blocks spend more time multiplying zeros than CSR spends on its indices.
+        constexpr double min_block_fill{0.5};
+
+        constexpr std::size_t block_size{BasicBlockSparseMatrix<double>::block_size};
+
+        // Samples sharing each loaded CSR entry in `multiply`.
+        constexpr std::size_t sample_block{4};
+
+        auto check_shape(std::span<const std::uint8_t> mask, std::size_t num_rows,
+                         std::size_t num_cols) -> void
+        {
+            if (mask.size() != num_rows * num_cols)
+            {
+                throw std::invalid_argument("Invalid mask size.");
+            }
+
+            if (mask.size() > std::numeric_limits<std::uint32_t>::max())
+            {
+                throw std::invalid_argument("The matrix is too large for 32-bit indices.");
+            }
+        }
+
+        auto block_is_kept(const std::uint8_t* row, std::size_t column, std::size_t num_cols)
+            -> bool
+        {
+            const std::size_t last = std::min(column + block_size, num_cols);
+            return std::any_of(row + column, row + last, [](std::uint8_t kept) { return kept; });
+        }
+
+        // Multiply-adds of one sparse product over a batch, for the scheduler's grain.
+        auto row_cost(std::size_t num_entries, std::size_t num_rows, std::size_t batch_size)
+            -> std::size_t
+        {
+            return batch_size * ((num_entries / std::max<std::size_t>(num_rows, 1)) + 1);
+        }
+
+    } // namespace
+
+    auto pruning_schedule(std::size_t step, std::size_t num_steps, double final,
+                          double initial) -> double
+    {
+        if (num_steps == 0 || step >= num_steps)
+        {
+            return final;
+        }
+
+        const double remaining =
+            1.0 - (static_cast<double>(step) / static_cast<double>(num_steps));
+        return final + ((initial - final) * remaining * remaining * remaining);
+    }
+
+    auto sparsity(std::span<const std::uint8_t> mask) -> double
+    {
+        if (mask.empty())
+        {
+            return 0.0;
+        }
+
+        const auto pruned = std::ranges::count(mask, std::uint8_t{0});
+        return static_cast<double>(pruned) / static_cast<double>(mask.size());
+    }
+
+    auto block_fill(std::span<const std::uint8_t> mask, std::size_t num_rows,
+                    std::size_t num_cols) -> double
+    {
+        check_shape(mask, num_rows, num_cols);
+
+        std::size_t kept{0};
+        std::size_t capacity{0};
+        for (std::size_t row{0}; row < num_rows; ++row)
+        {
+            const std::uint8_t* row_mask = mask.data() + (row * num_cols);
+            for (std::size_t column{0}; column < num_cols; column += block_size)
+            {
+                if (block_is_kept(row_mask, column, num_cols))
+                {
+                    const std::size_t last = std::min(column + block_size, num_cols);
+                    kept += static_cast<std::size_t>(
+                        std::count_if(row_mask + column, row_mask + last,
+                                      [](std::uint8_t value) { return value != 0; }));
+                    capacity += last - column;
+                }
+            }
+        }
+
+        return capacity == 0 ? 1.0 : static_cast<double>(kept) / static_cast<double>(capacity);
+    }
+
+    auto choose_format(std::span<const std::uint8_t> mask, std::size_t num_rows,
+                       std::size_t num_cols, double threshold) -> SparseFormat
+    {
+        if (mask.empty() || sparsity(mask) < threshold)
+        {
+            return SparseFormat::dense;
+        }
+
+        return block_fill(mask, num_rows, num_cols) >= min_block_fill ? SparseFormat::block
+                                                                      : SparseFormat::csr;
+    }
+
+    template <std::floating_point Scalar>
+    auto make_csr(std::span<const std::uint8_t> mask, std::size_t num_rows,
+                  std::size_t num_cols) -> BasicCsrMatrix<Scalar>
+    {
+        check_shape(mask, num_rows, num_cols);
+
+        BasicCsrMatrix<Scalar> matrix;
+        matrix.num_rows = num_rows;
+        matrix.num_cols = num_cols;
+        matrix.row_offsets.reserve(num_rows + 1);
+        matrix.row_offsets.push_back(0);
+        for (std::size_t row{0}; row < num_rows; ++row)
+        {
+            for (std::size_t column{0}; column < num_cols; ++column)
+            {
+                if (mask[(row * num_cols) + column] != 0)
+                {
+                    matrix.column_indices.push_back(static_cast<std::uint32_t>(column));
+                }
+            }
+
+            matrix.row_offsets.push_back(static_cast<std::uint32_t>(matrix.column_indices.size()));
+        }
+
+        matrix.values.assign(matrix.column_indices.size(), Scalar{0});
+        return matrix;
+    }
+
+    template <std::floating_point Scalar>
+    auto make_blocks(std::span<const std::uint8_t> mask, std::size_t num_rows,
+                     std::size_t num_cols) -> BasicBlockSparseMatrix<Scalar>
+    {
+        check_shape(mask, num_rows, num_cols);
+
+        BasicBlockSparseMatrix<Scalar> matrix;
+        matrix.num_rows = num_rows;
+        matrix.num_cols = num_cols;
+        matrix.row_offsets.reserve(num_rows + 1);
+        matrix.row_offsets.push_back(0);
+        for (std::size_t row{0}; row < num_rows; ++row)
+        {
+            const std::uint8_t* row_mask = mask.data() + (row * num_cols);
+            for (std::size_t column{0}; column < num_cols; column += block_size)
+            {
+                if (block_is_kept(row_mask, column, num_cols))
+                {
+                    matrix.block_columns.push_back(static_cast<std::uint32_t>(column));
+                }
+            }
+
+            matrix.row_offsets.push_back(static_cast<std::uint32_t>(matrix.block_columns.size()));
+        }
+
+        matrix.values.assign(matrix.block_columns.size() * block_size, Scalar{0});
+        return matrix;
+    }
+
+    template <std::floating_point Scalar>
+    auto gather(BasicCsrMatrix<Scalar>& matrix, std::span<const Scalar> dense) -> void
+    {
+        for (std::size_t row{0}; row < matrix.num_rows; ++row)
+        {
+            const Scalar* dense_row = dense.data() + (row * matrix.num_cols);
+            for (std::size_t j{matrix.row_offsets[row]}; j < matrix.row_offsets[row + 1]; ++j)
+            {
+                matrix.values[j] = dense_row[matrix.column_indices[j]];
+            }
+        }
+    }
+
+    // NOTE(abi): copies whole blocks, so pruned entries inside a block must already be zero in
+    // `dense`, which masking the weights guarantees.
+    template <std::floating_point Scalar>
+    auto gather(BasicBlockSparseMatrix<Scalar>& matrix, std::span<const Scalar> dense) -> void
+    {
+        for (std::size_t row{0}; row < matrix.num_rows; ++row)
+        {
+            const Scalar* dense_row = dense.data() + (row * matrix.num_cols);
+            for (std::size_t b{matrix.row_offsets[row]}; b < matrix.row_offsets[row + 1]; ++b)
+            {
+                const std::size_t column = matrix.block_columns[b];
+                const std::size_t width = std::min(block_size, matrix.num_cols - column);
+                std::copy_n(dense_row + column, width, matrix.values.data() + (b * block_size));
+            }
+        }
+    }
+
+    // Rows run in parallel and each row visits every sample, so its indices and values are
+    // read from memory once per batch. Samples go `sample_block` at a time, each loaded entry
+    // feeding that many independent sums.
+    template <std::floating_point Scalar>
+    auto multiply(const BasicCsrMatrix<Scalar>& matrix, const Scalar* inputs,
+                  std::size_t batch_size, Scalar* outputs) -> void
+    {
+        const std::size_t num_rows = matrix.num_rows;
+        const std::size_t num_cols = matrix.num_cols;
+        const std::uint32_t* columns = matrix.column_indices.data();
+        const Scalar* values = matrix.values.data();
+
+        Scheduler::instance().parallel_for(
+            num_rows, grain_size(row_cost(matrix.values.size(), num_rows, batch_size)),
+            [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t row{begin}; row < end; ++row)
+                {
+                    const std::size_t first = matrix.row_offsets[row];
+                    const std::size_t last = matrix.row_offsets[row + 1];
+
+                    std::size_t sample{0};
+                    for (; sample + sample_block <= batch_size; sample += sample_block)
+                    {
+                        const Scalar* x = inputs + (sample * num_cols);
+                        Scalar sums[sample_block]{};
+                        for (std::size_t j{first}; j < last; ++j)
+                        {
+                            const Scalar value = values[j];
+                            const std::size_t column = columns[j];
+                            for (std::size_t s{0}; s < sample_block; ++s)
+                            {
+                                sums[s] += value * x[(s * num_cols) + column];
+                            }
+                        }
+
+                        for (std::size_t s{0}; s < sample_block; ++s)
+                        {
+                            outputs[((sample + s) * num_rows) + row] = sums[s];
+                        }
+                    }
+
+                    for (; sample < batch_size; ++sample)
+                    {
+                        const Scalar* x = inputs + (sample * num_cols);
+                        Scalar sum{0};
+                        for (std::size_t j{first}; j < last; ++j)
+                        {
+                            sum += values[j] * x[columns[j]];
+                        }
+
+                        outputs[(sample * num_rows) + row] = sum;
+                    }
+                }
+            });
+    }
+
+    template <std::floating_point Scalar>
+    auto multiply(const BasicBlockSparseMatrix<Scalar>& matrix, const Scalar* inputs,
+                  std::size_t batch_size, Scalar* outputs) -> void
+    {
+        const std::size_t num_rows = matrix.num_rows;
+        const std::size_t num_cols = matrix.num_cols;
+
+        Scheduler::instance().parallel_for(
+            num_rows, grain_size(row_cost(matrix.values.size(), num_rows, batch_size)),
+            [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t row{begin}; row < end; ++row)
+                {
+                    const std::size_t first = matrix.row_offsets[row];
+                    const std::size_t last = matrix.row_offsets[row + 1];
+
+                    for (std::size_t sample{0}; sample < batch_size; ++sample)
+                    {
+                        const Scalar* x = inputs + (sample * num_cols);
+
+                        // NOTE(abi): one partial sum per lane, so the compiler keeps the whole
+                        // block in a vector register.
+                        Scalar sums[block_size]{};
+                        for (std::size_t b{first}; b < last; ++b)
+                        {
+                            const std::size_t column = matrix.block_columns[b];
+                            const Scalar* w = matrix.values.data() + (b * block_size);
+                            if (column + block_size <= num_cols)
+                            {
+                                for (std::size_t k{0}; k < block_size; ++k)
+                                {
+                                    sums[k] += w[k] * x[column + k];
+                                }
+                            }
+                            else
+                            {
+                                for (std::size_t k{0}; column + k < num_cols; ++k)
+                                {
+                                    sums[k] += w[k] * x[column + k];
+                                }
+                            }
+                        }
+
+                        Scalar sum{0};
+                        for (const Scalar partial : sums)
+                        {
+                            sum += partial;
+                        }
+
+                        outputs[(sample * num_rows) + row] = sum;
+                    }
+                }
+            });
+    }
+
+    // Samples run in parallel, each scattering its gradients into its own output row.
+    template <std::floating_point Scalar>
+    auto multiply_transposed(const BasicCsrMatrix<Scalar>& matrix, const Scalar* gradients,
+                             std::size_t batch_size, Scalar* outputs) -> void
+    {
+        const std::size_t num_rows = matrix.num_rows;
+        const std::size_t num_cols = matrix.num_cols;
+
+        Scheduler::instance().parallel_for(
+            batch_size, grain_size(matrix.values.size() + num_cols),
+            [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t sample{begin}; sample < end; ++sample)
+                {
+                    const Scalar* g = gradients + (sample * num_rows);
+                    Scalar* out = outputs + (sample * num_cols);
+                    std::fill_n(out, num_cols, Scalar{0});
+
+                    for (std::size_t row{0}; row < num_rows; ++row)
+                    {
+                        const Scalar gradient = g[row];
+                        for (std::size_t j{matrix.row_offsets[row]};
+                             j < matrix.row_offsets[row + 1]; ++j)
+                        {
+                            out[matrix.column_indices[j]] += matrix.values[j] * gradient;
+                        }
+                    }
+                }
+            });
+    }
+
+    template <std::floating_point Scalar>
+    auto multiply_transposed(const BasicBlockSparseMatrix<Scalar>& matrix,
+                             const Scalar* gradients, std::size_t batch_size, Scalar* outputs)
+        -> void
+    {
+        const std::size_t num_rows = matrix.num_rows;
+        const std::size_t num_cols = matrix.num_cols;
+
+        Scheduler::instance().parallel_for(
+            batch_size, grain_size(matrix.values.size() + num_cols),
+            [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t sample{begin}; sample < end; ++sample)
+                {
+                    const Scalar* g = gradients + (sample * num_rows);
+                    Scalar* out = outputs + (sample * num_cols);
+                    std::fill_n(out, num_cols, Scalar{0});
+
+                    for (std::size_t row{0}; row < num_rows; ++row)
+                    {
+                        const Scalar gradient = g[row];
+                        for (std::size_t b{matrix.row_offsets[row]};
+                             b < matrix.row_offsets[row + 1]; ++b)
+                        {
+                            const std::size_t column = matrix.block_columns[b];
+                            const Scalar* w = matrix.values.data() + (b * block_size);
+                            const std::size_t width = std::min(block_size, num_cols - column);
+                            for (std::size_t k{0}; k < width; ++k)
+                            {
+                                out[column + k] += w[k] * gradient;
+                            }
+                        }
+                    }
+                }
+            });
+    }
+
+    template <std::floating_point Scalar>
+    auto storage_bytes(const BasicSparseWeights<Scalar>& weights, std::size_t num_rows,
+                       std::size_t num_cols) -> std::size_t
+    {
+        constexpr std::size_t index_bytes{sizeof(std::uint32_t)};
+        switch (weights.format)
+        {
+        case SparseFormat::csr:
+            return ((num_rows + 1) * index_bytes)
+                   + (weights.csr.values.size() * (index_bytes + sizeof(Scalar)));
+        case SparseFormat::block:
+            return ((num_rows + 1) * index_bytes)
+                   + (weights.blocks.block_columns.size() * index_bytes)
+                   + (weights.blocks.values.size() * sizeof(Scalar));
+        case SparseFormat::dense:
+            break;
+        }
+
+        return num_rows * num_cols * sizeof(Scalar);
+    }
+
+    template auto make_csr<float>(std::span<const std::uint8_t>, std::size_t, std::size_t)
+        -> BasicCsrMatrix<float>;
+    template auto make_csr<double>(std::span<const std::uint8_t>, std::size_t, std::size_t)
+        -> BasicCsrMatrix<double>;
+    template auto make_blocks<float>(std::span<const std::uint8_t>, std::size_t, std::size_t)
+        -> BasicBlockSparseMatrix<float>;
+    template auto make_blocks<double>(std::span<const std::uint8_t>, std::size_t, std::size_t)
+        -> BasicBlockSparseMatrix<double>;
+    template auto gather(BasicCsrMatrix<float>&, std::span<const float>) -> void;
+    template auto gather(BasicCsrMatrix<double>&, std::span<const double>) -> void;
+    template auto gather(BasicBlockSparseMatrix<float>&, std::span<const float>) -> void;
+    template auto gather(BasicBlockSparseMatrix<double>&, std::span<const double>) -> void;
+    template auto multiply(const BasicCsrMatrix<float>&, const float*, std::size_t, float*)
+        -> void;
+    template auto multiply(const BasicCsrMatrix<double>&, const double*, std::size_t, double*)
+        -> void;
+    template auto multiply(const BasicBlockSparseMatrix<float>&, const float*, std::size_t,
+                           float*) -> void;
+    template auto multiply(const BasicBlockSparseMatrix<double>&, const double*, std::size_t,
+                           double*) -> void;
+    template auto multiply_transposed(const BasicCsrMatrix<float>&, const float*, std::size_t,
+                                      float*) -> void;
+    template auto multiply_transposed(const BasicCsrMatrix<double>&, const double*, std::size_t,
+                                      double*) -> void;
+    template auto multiply_transposed(const BasicBlockSparseMatrix<float>&, const float*,
+                                      std::size_t, float*) -> void;
+    template auto multiply_transposed(const BasicBlockSparseMatrix<double>&, const double*,
+                                      std::size_t, double*) -> void;
+    template auto storage_bytes(const BasicSparseWeights<float>&, std::size_t, std::size_t)
+        -> std::size_t;
+    template auto storage_bytes(const BasicSparseWeights<double>&, std::size_t, std::size_t)
+        -> std::size_t;
+
+} // namespace axon::sparse
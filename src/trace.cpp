@@ -0,0 +1,235 @@
+#include "trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace axon::trace
+{
+
+    namespace
+    {
+        // Events of one thread. The lock is only contended while `start` or `collect` run.
+        struct ThreadEvents
+        {
+            std::mutex mutex;
+            std::vector<Event> events;
+            std::uint32_t thread{0};
+        };
+
+        struct Registry
+        {
+            std::mutex mutex;
+            std::vector<std::shared_ptr<ThreadEvents>> threads;
+            std::uint64_t origin_ns{0};
+        };
+
+        auto registry() -> Registry&
+        {
+            static Registry instance;
+            return instance;
+        }
+
+        // NOTE(abi): the registry shares ownership, so the events of threads that already
+        // exited (e.g. a finished data loader) are still collected.
+        auto thread_events() -> ThreadEvents&
+        {
+            thread_local const std::shared_ptr<ThreadEvents> events = []
+            {
+                auto& threads = registry();
+                const std::lock_guard lock(threads.mutex);
+
+                auto created = std::make_shared<ThreadEvents>();
+                created->thread = static_cast<std::uint32_t>(threads.threads.size());
+                threads.threads.push_back(created);
+                return created;
+            }();
+
+            return *events;
+        }
+
+        constexpr double ns_per_us{1e3};
+        constexpr double ns_per_ms{1e6};
+
+    } // namespace
+
+    auto to_string(Phase phase) -> std::string_view
+    {
+        switch (phase)
+        {
+        case Phase::forward:
+            return "forward";
+        case Phase::loss:
+            return "loss";
+        case Phase::backward:
+            return "backward";
+        case Phase::update:
+            return "update";
+        case Phase::data_loading:
+            return "data_loading";
+        }
+
+        return "unknown";
+    }
+
+    namespace detail
+    {
+        auto now_ns() -> std::uint64_t
+        {
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch())
+                    .count());
+        }
+
+        auto record(const Event& event) -> void
+        {
+            auto& local = thread_events();
+            const std::lock_guard lock(local.mutex);
+            local.events.push_back(event);
+            local.events.back().thread = local.thread;
+        }
+
+    } // namespace detail
+
+    auto start() -> void
+    {
+        auto& threads = registry();
+        {
+            const std::lock_guard lock(threads.mutex);
+            for (const auto& local : threads.threads)
+            {
+                const std::lock_guard events_lock(local->mutex);
+                local->events.clear();
+            }
+
+            threads.origin_ns = detail::now_ns();
+        }
+
+        detail::recording.store(true, std::memory_order_relaxed);
+    }
+
+    auto stop() -> void
+    {
+        detail::recording.store(false, std::memory_order_relaxed);
+    }
+
+    auto collect() -> std::vector<Event>
+    {
+        std::vector<Event> events;
+
+        auto& threads = registry();
+        const std::lock_guard lock(threads.mutex);
+        for (const auto& local : threads.threads)
+        {
+            const std::lock_guard events_lock(local->mutex);
+            for (auto event : local->events)
+            {
+                // Scopes opened before the current recording started.
+                if (event.begin_ns < threads.origin_ns)
+                {
+                    continue;
+                }
+
+                event.begin_ns -= threads.origin_ns;
+                event.end_ns -= threads.origin_ns;
+                events.push_back(event);
+            }
+        }
+
+        std::ranges::sort(events, {}, &Event::begin_ns);
+        return events;
+    }
+
+    auto write_chrome_trace(const std::filesystem::path& path) -> void
+    {
+        std::ofstream file(path);
+        if (!file)
+        {
+            throw std::runtime_error("Cannot create " + path.string() + ".");
+        }
+
+        // NOTE(abi): event names are identifiers from the library, so they need no escaping.
+        file << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+        bool first{true};
+        for (const auto& event : collect())
+        {
+            file << (first ? "\n" : ",\n") << "{\"name\":\"" << event.name << "\",\"cat\":\""
+                 << to_string(event.phase) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+                 << event.thread << ",\"ts\":" << static_cast<double>(event.begin_ns) / ns_per_us
+                 << ",\"dur\":"
+                 << static_cast<double>(event.end_ns - event.begin_ns) / ns_per_us
+                 << ",\"args\":{\"layer\":" << event.layer << ",\"flops\":" << event.flops
+                 << ",\"bytes\":" << event.bytes << "}}";
+            first = false;
+        }
+
+        file << "\n],\"displayTimeUnit\":\"ns\"}\n";
+        if (!file)
+        {
+            throw std::runtime_error("Cannot write " + path.string() + ".");
+        }
+    }
+
+    auto write_summary(std::ostream& stream) -> void
+    {
+        struct Row
+        {
+            std::size_t calls{0};
+            std::uint64_t ns{0};
+            std::uint64_t flops{0};
+            std::uint64_t bytes{0};
+        };
+
+        std::map<std::pair<Phase, std::int32_t>, Row> rows;
+        std::uint64_t total_ns{0};
+        for (const auto& event : collect())
+        {
+            auto& row = rows[{event.phase, event.layer}];
+            const std::uint64_t ns = event.end_ns - event.begin_ns;
+            ++row.calls;
+            row.ns += ns;
+            row.flops += event.flops;
+            row.bytes += event.bytes;
+            total_ns += ns;
+        }
+
+        const auto flags = stream.flags();
+        const auto precision = stream.precision();
+
+        stream << std::left << std::setw(14) << "phase" << std::right << std::setw(6) << "layer"
+               << std::setw(9) << "calls" << std::setw(12) << "total ms" << std::setw(12)
+               << "mean us" << std::setw(8) << "share" << std::setw(10) << "GFLOP/s"
+               << std::setw(10) << "GB/s" << '\n';
+
+        stream << std::fixed;
+        for (const auto& [key, row] : rows)
+        {
+            const auto [phase, layer] = key;
+            const double ns = static_cast<double>(std::max<std::uint64_t>(row.ns, 1));
+
+            stream << std::left << std::setw(14) << to_string(phase) << std::right
+                   << std::setw(6) << (layer < 0 ? std::string{"-"} : std::to_string(layer))
+                   << std::setw(9) << row.calls << std::setprecision(3) << std::setw(12)
+                   << static_cast<double>(row.ns) / ns_per_ms << std::setw(12)
+                   << static_cast<double>(row.ns) / ns_per_us / static_cast<double>(row.calls)
+                   << std::setprecision(1) << std::setw(7)
+                   << 100.0 * static_cast<double>(row.ns)
+                          / static_cast<double>(std::max<std::uint64_t>(total_ns, 1))
+                   << '%' << std::setprecision(2) << std::setw(10)
+                   << static_cast<double>(row.flops) / ns << std::setw(10)
+                   << static_cast<double>(row.bytes) / ns << '\n';
+        }
+
+        stream.flags(flags);
+        stream.precision(precision);
+    }
+
+} // namespace axon::trace
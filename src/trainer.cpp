@@ -0,0 +1,162 @@
+#include "trainer.hpp"
+
+#include "trace.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace axon
+{
+
+    namespace
+    {
+
+        // Number of gradient entries summed by one reduction task; large enough to amortise the
+        // scheduling, small enough to spread a wide layer across every thread.
+        constexpr std::size_t reduction_chunk_size{4096};
+
+        auto chunk_count(std::size_t size) -> std::size_t
+        {
+            return (size + reduction_chunk_size - 1) / reduction_chunk_size;
+        }
+
+    } // namespace
+
+    template <std::floating_point Scalar>
+    BasicDataParallelTrainer<Scalar>::BasicDataParallelTrainer(BasicNetwork<Scalar>& network,
+                                                               std::size_t num_shards)
+        : network_(network)
+    {
+        num_shards = std::max<std::size_t>(num_shards, 1);
+
+        workspaces_.reserve(num_shards);
+        for (std::size_t i{0}; i < num_shards; ++i)
+        {
+            workspaces_.push_back(network_.make_workspace());
+        }
+        shard_losses_.assign(num_shards, 0.0);
+    }
+
+    template <std::floating_point Scalar>
+    auto BasicDataParallelTrainer<Scalar>::train_batch(std::span<const Scalar> inputs,
+                                                       std::span<const Scalar> targets,
+                                                       std::size_t batch_size,
+                                                       Scalar learning_rate, Scalar momentum)
+        -> Scalar
+    {
+        const Scalar loss = compute_gradients(inputs, targets, batch_size);
+        network_.apply_gradients(workspaces_.front(), learning_rate, momentum);
+        return loss;
+    }
+
+    // Runs every shard and leaves the batch-averaged gradients in the first workspace.
+    template <std::floating_point Scalar>
+    auto BasicDataParallelTrainer<Scalar>::compute_gradients(std::span<const Scalar> inputs,
+                                                             std::span<const Scalar> targets,
+                                                             std::size_t batch_size) -> Scalar
+    {
+        const auto& layers = network_.get_layers();
+        const std::size_t num_inputs = layers.front().num_inputs;
+        const std::size_t num_outputs = layers.back().num_outputs;
+
+        if (batch_size == 0 || inputs.size() != batch_size * num_inputs)
+        {
+            throw std::invalid_argument("Invalid number of inputs.");
+        }
+
+        if (targets.size() != batch_size * num_outputs)
+        {
+            throw std::invalid_argument("Invalid number of targets.");
+        }
+
+        // Contiguous shards whose sizes differ by at most one row.
+        const std::size_t num_shards = std::min(get_num_shards(), batch_size);
+        const std::size_t shard_rows = batch_size / num_shards;
+        const std::size_t extra_rows = batch_size % num_shards;
+        const Scalar gradient_scale = Scalar{1} / static_cast<Scalar>(batch_size);
+
+        const auto train_shard = [&](std::size_t shard)
+        {
+            const std::size_t first_row = (shard * shard_rows) + std::min(shard, extra_rows);
+            const std::size_t rows = shard_rows + (shard < extra_rows ? 1 : 0);
+
+            auto& workspace = workspaces_[shard];
+            const auto shard_targets =
+                targets.subspan(first_row * num_outputs, rows * num_outputs);
+
+            network_.forward(inputs.subspan(first_row * num_inputs, rows * num_inputs), rows,
+                             workspace);
+            shard_losses_[shard] = static_cast<double>(network_.loss(shard_targets, workspace))
+                                   * static_cast<double>(rows);
+            network_.backward(shard_targets, workspace, gradient_scale);
+        };
+
+        // NOTE(abi): user-supplied callables need not be thread-safe, so networks using them
+        // run their shards one after another on the calling thread.
+        if (network_.get_activation().kind == activation::Kind::custom
+            || network_.get_criterion().kind == criterion::Kind::custom)
+        {
+            for (std::size_t shard{0}; shard < num_shards; ++shard)
+            {
+                train_shard(shard);
+            }
+        }
+        else
+        {
+            Scheduler::instance().parallel_for(num_shards, 1,
+                                               [&](std::size_t begin, std::size_t end)
+                                               {
+                                                   for (std::size_t shard{begin}; shard < end;
+                                                        ++shard)
+                                                   {
+                                                       train_shard(shard);
+                                                   }
+                                               });
+        }
+
+        reduce_gradients(num_shards);
+
+        double loss{0.0};
+        for (std::size_t shard{0}; shard < num_shards; ++shard)
+        {
+            loss += shard_losses_[shard];
+        }
+
+        return static_cast<Scalar>(loss / static_cast<double>(batch_size));
+    }
+
+    // Sums the gradients of every shard into the first workspace. Each task owns a disjoint
+    // chunk of the flat gradient buffer, so the threads never write to the same entries.
+    template <std::floating_point Scalar>
+    auto BasicDataParallelTrainer<Scalar>::reduce_gradients(std::size_t num_shards) -> void
+    {
+        if (num_shards == 1)
+        {
+            return;
+        }
+
+        AXON_TRACE_SCOPE(trace::Phase::backward, "reduce_gradients");
+
+        const std::span<Scalar> sum = workspaces_.front().parameter_gradients;
+        Scheduler::instance().parallel_for(
+            chunk_count(sum.size()), 1,
+            [&](std::size_t begin, std::size_t end)
+            {
+                const std::size_t first = begin * reduction_chunk_size;
+                const std::size_t last = std::min(end * reduction_chunk_size, sum.size());
+
+                for (std::size_t shard{1}; shard < num_shards; ++shard)
+                {
+                    const std::span<const Scalar> addend = workspaces_[shard].parameter_gradients;
+                    for (std::size_t i{first}; i < last; ++i)
+                    {
+                        sum[i] += addend[i];
+                    }
+                }
+            });
+    }
+
+    template class BasicDataParallelTrainer<float>;
+    template class BasicDataParallelTrainer<double>;
+
+} // namespace axon
@@ -1,7 +1,9 @@
 #include "activation.hpp"
+#include "kernels.hpp"
 
 #include <gtest/gtest.h>
 #include <cmath>
+#include <vector>
 
 using namespace axon::activation;
 
@@ -67,3 +69,205 @@ TEST(ActivationTest, ReLUDerivativeIsCorrect)
     EXPECT_DOUBLE_EQ(relu_derivative(0.0), 0.0);
     EXPECT_DOUBLE_EQ(relu_derivative(-5.0), 0.0);
 }
+
+TEST(ActivationTest, PoliciesMatchFreeFunctions)
+{
+    for (const double x : {-2.0, -0.5, 0.0, 0.5, 2.0})
+    {
+        EXPECT_DOUBLE_EQ(Linear::function(x), linear(x));
+        EXPECT_DOUBLE_EQ(Sigmoid::function(x), sigmoid(x));
+        EXPECT_DOUBLE_EQ(Tanh::function(x), axon::activation::tanh(x));
+        EXPECT_DOUBLE_EQ(ReLU::function(x), relu(x));
+        EXPECT_DOUBLE_EQ(Sigmoid::derivative(x), sigmoid_derivative(x));
+        EXPECT_DOUBLE_EQ(Tanh::derivative(x), tanh_derivative(x));
+    }
+}
+
+TEST(ActivationTest, OfCarriesPolicyKind)
+{
+    const auto activation = axon::Activation::of<Tanh>();
+
+    EXPECT_EQ(activation.kind, Kind::tanh);
+    EXPECT_EQ(activation.resolve_kind(), Kind::tanh);
+    EXPECT_DOUBLE_EQ(activation.function(0.5), std::tanh(0.5));
+}
+
+TEST(ActivationTest, ResolvesBuiltInFunctionPointers)
+{
+    const axon::Activation activation{.function = sigmoid, .derivative = sigmoid_derivative};
+
+    EXPECT_EQ(activation.kind, Kind::custom);
+    EXPECT_EQ(activation.resolve_kind(), Kind::sigmoid);
+}
+
+TEST(ActivationTest, LambdasStayCustom)
+{
+    const axon::Activation activation{.function = [](double x) { return 2.0 * x; },
+                                      .derivative = [](double) { return 2.0; }};
+
+    EXPECT_EQ(activation.resolve_kind(), Kind::custom);
+}
+
+TEST(ActivationTest, MismatchedDerivativeStaysCustom)
+{
+    const axon::Activation activation{.function = sigmoid, .derivative = tanh_derivative};
+
+    EXPECT_EQ(activation.resolve_kind(), Kind::custom);
+}
+
+namespace
+{
+
+    auto sample_inputs() -> std::vector<double>
+    {
+        std::vector<double> inputs;
+        for (double x{-40.0}; x <= 40.0; x += 0.01)
+        {
+            inputs.push_back(x);
+        }
+
+        for (const double x : {-1000.0, -709.0, -50.0, 50.0, 709.0, 1000.0})
+        {
+            inputs.push_back(x);
+        }
+
+        return inputs;
+    }
+
+} // namespace
+
+TEST(ActivationTest, VectorizedExactMatchesScalar)
+{
+    const auto inputs = sample_inputs();
+    std::vector<double> outputs(inputs.size());
+
+    vectorized::sigmoid(inputs, outputs);
+    for (std::size_t i{0}; i < inputs.size(); ++i)
+    {
+        ASSERT_DOUBLE_EQ(outputs[i], sigmoid(inputs[i]));
+    }
+
+    vectorized::tanh(inputs, outputs);
+    for (std::size_t i{0}; i < inputs.size(); ++i)
+    {
+        ASSERT_DOUBLE_EQ(outputs[i], std::tanh(inputs[i]));
+    }
+
+    vectorized::relu(inputs, outputs);
+    for (std::size_t i{0}; i < inputs.size(); ++i)
+    {
+        ASSERT_DOUBLE_EQ(outputs[i], relu(inputs[i]));
+    }
+
+    vectorized::linear(inputs, outputs);
+    EXPECT_EQ(outputs, inputs);
+}
+
+TEST(ActivationTest, VectorizedFastStaysWithinDocumentedError)
+{
+    using axon::kernels::Isa;
+
+    const auto inputs = sample_inputs();
+    std::vector<double> outputs(inputs.size());
+    const Isa previous_isa = axon::kernels::get_isa();
+
+    for (const Isa isa : {Isa::scalar, Isa::avx2, Isa::avx512})
+    {
+        if (!axon::kernels::is_supported(isa))
+        {
+            continue;
+        }
+
+        axon::kernels::set_isa(isa);
+
+        vectorized::sigmoid(inputs, outputs, MathMode::fast);
+        for (std::size_t i{0}; i < inputs.size(); ++i)
+        {
+            ASSERT_NEAR(outputs[i], sigmoid(inputs[i]), 1e-7) << inputs[i];
+        }
+
+        vectorized::tanh(inputs, outputs, MathMode::fast);
+        for (std::size_t i{0}; i < inputs.size(); ++i)
+        {
+            ASSERT_NEAR(outputs[i], std::tanh(inputs[i]), 2e-7) << inputs[i];
+        }
+    }
+
+    axon::kernels::set_isa(previous_isa);
+}
+
+TEST(ActivationTest, SinglePrecisionFastStaysWithinDocumentedError)
+{
+    using axon::kernels::Isa;
+
+    const auto wide_inputs = sample_inputs();
+    const std::vector<float> inputs(wide_inputs.begin(), wide_inputs.end());
+    std::vector<float> outputs(inputs.size());
+    const Isa previous_isa = axon::kernels::get_isa();
+
+    for (const Isa isa : {Isa::scalar, Isa::avx2, Isa::avx512})
+    {
+        if (!axon::kernels::is_supported(isa))
+        {
+            continue;
+        }
+
+        axon::kernels::set_isa(isa);
+
+        vectorized::sigmoid(inputs, outputs, MathMode::fast);
+        for (std::size_t i{0}; i < inputs.size(); ++i)
+        {
+            ASSERT_NEAR(outputs[i], sigmoid(inputs[i]), 1e-7) << inputs[i];
+        }
+
+        vectorized::tanh(inputs, outputs, MathMode::fast);
+        for (std::size_t i{0}; i < inputs.size(); ++i)
+        {
+            ASSERT_NEAR(outputs[i], std::tanh(static_cast<double>(inputs[i])), 2e-7)
+                << inputs[i];
+        }
+    }
+
+    axon::kernels::set_isa(previous_isa);
+}
+
+TEST(ActivationTest, VectorizedKernelsWorkInPlace)
+{
+    std::vector<double> values = {-1.0, 0.0, 1.0, 2.0, 3.0};
+
+    vectorized::sigmoid(values, values, MathMode::fast);
+
+    EXPECT_NEAR(values[1], 0.5, 1e-7);
+    EXPECT_NEAR(values[2], sigmoid(1.0), 1e-7);
+}
+
+TEST(ActivationTest, VectorizedDerivativesScaleGradients)
+{
+    const std::vector<double> outputs = {-0.5, 0.0, 0.25, 0.75};
+    const std::vector<double> upstream = {1.0, -2.0, 0.5, 3.0};
+
+    auto gradients = upstream;
+    vectorized::sigmoid_derivative(outputs, gradients);
+    for (std::size_t i{0}; i < outputs.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(gradients[i], upstream[i] * sigmoid_derivative(outputs[i]));
+    }
+
+    gradients = upstream;
+    vectorized::tanh_derivative(outputs, gradients);
+    for (std::size_t i{0}; i < outputs.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(gradients[i], upstream[i] * tanh_derivative(outputs[i]));
+    }
+
+    gradients = upstream;
+    vectorized::relu_derivative(outputs, gradients);
+    for (std::size_t i{0}; i < outputs.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(gradients[i], upstream[i] * relu_derivative(outputs[i]));
+    }
+
+    gradients = upstream;
+    vectorized::linear_derivative(outputs, gradients);
+    EXPECT_EQ(gradients, upstream);
+}
@@ -0,0 +1,281 @@
+#include "network.hpp"
+#include "activation.hpp"
+#include "autograd.hpp"
+#include "checkpoint.hpp"
+#include "criterion.hpp"
+#include "inference_session.hpp"
+#include "optimizer.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <vector>
+
+// NOTE(abi): replacing the global allocation functions lets us count every heap allocation made
+// while `counting` is set; the array and nothrow forms forward to these by default.
+namespace
+{
+
+    std::atomic<bool> counting{false};
+    std::atomic<std::size_t> allocations{0};
+    thread_local std::size_t thread_allocations{0};
+
+    auto allocate(std::size_t size, std::size_t alignment) -> void*
+    {
+        if (counting.load(std::memory_order_relaxed))
+        {
+            allocations.fetch_add(1, std::memory_order_relaxed);
+            ++thread_allocations;
+        }
+
+        const std::size_t rounded = ((size + alignment - 1) / alignment) * alignment;
+        void* pointer = alignment <= alignof(std::max_align_t)
+                            ? std::malloc(size == 0 ? 1 : size)
+                            : std::aligned_alloc(alignment, rounded == 0 ? alignment : rounded);
+        if (pointer == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        return pointer;
+    }
+
+    class AllocationCounter
+    {
+    public:
+        AllocationCounter()
+        {
+            allocations.store(0);
+            thread_allocations = 0;
+            counting.store(true);
+        }
+
+        AllocationCounter(const AllocationCounter&) = delete;
+        AllocationCounter(AllocationCounter&&) = delete;
+        auto operator=(const AllocationCounter&) -> AllocationCounter& = delete;
+        auto operator=(AllocationCounter&&) -> AllocationCounter& = delete;
+
+        ~AllocationCounter()
+        {
+            counting.store(false);
+        }
+
+        [[nodiscard]] auto count() const -> std::size_t
+        {
+            return allocations.load();
+        }
+
+        // Allocations made by the thread that created the counter, leaving out those of
+        // background threads such as a checkpoint writer.
+        [[nodiscard]] static auto count_on_this_thread() -> std::size_t
+        {
+            return thread_allocations;
+        }
+    };
+
+} // namespace
+
+auto operator new(std::size_t size) -> void*
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void*
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+auto operator delete(void* pointer) noexcept -> void
+{
+    std::free(pointer);
+}
+
+auto operator delete(void* pointer, [[maybe_unused]] std::align_val_t alignment) noexcept -> void
+{
+    std::free(pointer);
+}
+
+auto operator delete(void* pointer, [[maybe_unused]] std::size_t size) noexcept -> void
+{
+    std::free(pointer);
+}
+
+auto operator delete(void* pointer, [[maybe_unused]] std::size_t size,
+                     [[maybe_unused]] std::align_val_t alignment) noexcept -> void
+{
+    std::free(pointer);
+}
+
+using namespace axon;
+
+class AllocationTest : public ::testing::Test
+{
+protected:
+    Activation activation = Activation::of<activation::Tanh>();
+    Criterion criterion = Criterion::of<criterion::MSE>();
+};
+
+TEST_F(AllocationTest, SteadyStateTrainStepDoesNotAllocate)
+{
+    Network net({4, 32, 16, 2}, activation, criterion);
+
+    std::array<double, 8 * 4> inputs{};
+    std::array<double, 8 * 2> targets{};
+    inputs.fill(0.25);
+    targets.fill(0.5);
+
+    // Warm-up sizes the activation buffers and the kernels' packing buffers.
+    net.feed_forward_batch(inputs, 8);
+    net.compute_loss(targets);
+    net.back_propagate(targets);
+    net.step(0.01, 0.9);
+
+    const AllocationCounter counter;
+    for (int i{0}; i < 3; ++i)
+    {
+        net.feed_forward_batch(inputs, 8);
+        net.compute_loss(targets);
+        net.back_propagate(targets);
+        net.step(0.01, 0.9);
+    }
+
+    EXPECT_EQ(counter.count(), 0);
+}
+
+TEST_F(AllocationTest, SteadyStateTapeStepDoesNotAllocate)
+{
+    Network net({4, 32, 16, 2}, activation, criterion);
+    auto gradients = net.make_workspace();
+    autograd::Tape tape;
+
+    std::array<double, 8 * 4> inputs{};
+    std::array<double, 8 * 2> targets{};
+    inputs.fill(0.25);
+    targets.fill(0.5);
+
+    const auto tape_step = [&]
+    {
+        const auto outputs = autograd::record(tape, net, inputs, 8, gradients);
+        tape.backward(tape.loss(outputs, targets, criterion), 2.0);
+        net.apply_gradients(gradients, 0.01, 0.9);
+    };
+
+    // Warm-up sizes the tape's arena and node list.
+    tape_step();
+
+    const AllocationCounter counter;
+    for (int i{0}; i < 3; ++i)
+    {
+        tape_step();
+    }
+
+    EXPECT_EQ(counter.count(), 0);
+}
+
+TEST_F(AllocationTest, SteadyStateCheckpointDoesNotAllocate)
+{
+    Network net({4, 32, 16, 2}, activation, criterion);
+    Adam adam;
+    const std::vector<double> gradients(net.get_parameters().size(), 0.1);
+    adam.step(net.get_parameters(), gradients);
+
+    const auto path = std::filesystem::temp_directory_path() / "allocation_test.axonckp";
+    {
+        Checkpointer checkpointer(path);
+
+        // Warm-up sizes both snapshot buffers and their layouts.
+        checkpointer.save(net, adam, {});
+        checkpointer.wait();
+        checkpointer.save(net, adam, {});
+        checkpointer.save(net, adam, {});
+        checkpointer.wait();
+
+        const AllocationCounter counter;
+        for (std::uint64_t step{0}; step < 3; ++step)
+        {
+            checkpointer.save(net, adam, {.step = step});
+        }
+
+        EXPECT_EQ(AllocationCounter::count_on_this_thread(), 0);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_F(AllocationTest, SteadyStateInferenceDoesNotAllocate)
+{
+    Network net({4, 32, 16, 2}, activation, criterion);
+
+    const std::array<double, 4> inputs = {0.1, 0.2, 0.3, 0.4};
+    std::array<double, 2> output{};
+
+    net.feed_forward(inputs);
+    net.get_output(output);
+
+    const AllocationCounter counter;
+    for (int i{0}; i < 3; ++i)
+    {
+        net.feed_forward(inputs);
+        net.get_output(output);
+    }
+
+    EXPECT_EQ(counter.count(), 0);
+}
+
+TEST_F(AllocationTest, SteadyStateSessionDoesNotAllocate)
+{
+    const Network net({4, 32, 16, 2}, activation, criterion);
+    InferenceSession session(net, 8);
+
+    std::array<double, 8 * 4> inputs{};
+    std::array<double, 8 * 2> outputs{};
+    inputs.fill(0.25);
+    session.forward(inputs, 8, outputs);
+
+    const AllocationCounter counter;
+    for (std::size_t batch_size{1}; batch_size <= 8; ++batch_size)
+    {
+        session.forward(std::span{inputs}.first(batch_size * 4), batch_size,
+                        std::span{outputs}.first(batch_size * 2));
+    }
+
+    EXPECT_EQ(counter.count(), 0);
+}
+
+TEST_F(AllocationTest, AssigningSameTopologyDoesNotAllocate)
+{
+    const Network source({4, 32, 16, 2}, activation, criterion);
+    Network snapshot({4, 32, 16, 2}, activation, criterion);
+
+    const AllocationCounter counter;
+    snapshot = source;
+
+    EXPECT_EQ(counter.count(), 0);
+    EXPECT_TRUE(std::ranges::equal(snapshot.get_parameters(), source.get_parameters()));
+}
+
+TEST_F(AllocationTest, CounterSeesReturnedOutputVector)
+{
+    Network net({2, 3, 2}, activation, criterion);
+    net.feed_forward(std::array<double, 2>{0.1, 0.2});
+
+    const AllocationCounter counter;
+    const auto output = net.get_output();
+
+    EXPECT_EQ(output.size(), 2);
+    EXPECT_GT(counter.count(), 0);
+}
+
+TEST_F(AllocationTest, GetOutputIntoSpanValidatesSize)
+{
+    Network net({2, 3, 2}, activation, criterion);
+    net.feed_forward(std::array<double, 2>{0.1, 0.2});
+
+    std::array<double, 1> too_small{};
+    EXPECT_THROW(net.get_output(too_small), std::invalid_argument);
+}
@@ -0,0 +1,156 @@
+#include "arena.hpp"
+#include "activation.hpp"
+#include "criterion.hpp"
+#include "network.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+
+using namespace axon;
+
+namespace
+{
+
+    // Forwards to the default resource and counts what goes through it.
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        std::size_t allocations{0};
+        std::size_t live_bytes{0};
+
+    private:
+        auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override
+        {
+            ++allocations;
+            live_bytes += bytes;
+            return std::pmr::get_default_resource()->allocate(bytes, alignment);
+        }
+
+        auto do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment)
+            -> void override
+        {
+            live_bytes -= bytes;
+            std::pmr::get_default_resource()->deallocate(pointer, bytes, alignment);
+        }
+
+        [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+            -> bool override
+        {
+            return this == &other;
+        }
+    };
+
+    template <typename T>
+    auto contains(std::span<const T> outer, std::span<const T> inner) -> bool
+    {
+        return inner.data() >= outer.data()
+               && inner.data() + inner.size() <= outer.data() + outer.size();
+    }
+
+} // namespace
+
+class ArenaTest : public ::testing::Test
+{
+protected:
+    Activation activation = Activation::of<activation::Tanh>();
+    Criterion criterion = Criterion::of<criterion::MSE>();
+};
+
+TEST_F(ArenaTest, CopyDuplicatesContentsFromSameResource)
+{
+    CountingResource resource;
+    Arena arena(256, &resource);
+    std::ranges::fill(arena.view<double>(64, 8), 1.5);
+
+    const Arena copy(arena);
+    EXPECT_EQ(copy.get_resource(), &resource);
+    EXPECT_EQ(resource.allocations, 2);
+    EXPECT_NE(copy.data(), arena.data());
+    EXPECT_TRUE(std::ranges::equal(std::span{copy.data(), copy.size()},
+                                   std::span{arena.data(), arena.size()}));
+}
+
+TEST_F(ArenaTest, ResizeKeepsPrefixAndZeroesTheRest)
+{
+    Arena arena(64);
+    std::ranges::fill(arena.view<float>(0, 16), 2.0F);
+
+    arena.resize(192);
+    const auto values = arena.view<float>(0, 48);
+    EXPECT_TRUE(std::ranges::all_of(values.first(16), [](float value) { return value == 2.0F; }));
+    EXPECT_TRUE(std::ranges::all_of(values.subspan(16), [](float value) { return value == 0.0F; }));
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(arena.data()) % cache_line_size, 0);
+}
+
+TEST_F(ArenaTest, NetworkAllocationsDoNotGrowWithDepth)
+{
+    CountingResource shallow_resource;
+    const Network shallow({4, 8, 2}, activation, criterion, &shallow_resource);
+
+    CountingResource deep_resource;
+    const Network deep({4, 8, 8, 8, 8, 8, 8, 2}, activation, criterion, &deep_resource);
+
+    EXPECT_GT(shallow_resource.allocations, 0);
+    EXPECT_EQ(deep_resource.allocations, shallow_resource.allocations);
+    EXPECT_EQ(deep.get_resource(), &deep_resource);
+}
+
+TEST_F(ArenaTest, NetworkReturnsMemoryToResource)
+{
+    CountingResource resource;
+    {
+        Network net({3, 16, 1}, activation, criterion, &resource);
+        const Network copy = net;
+        net.feed_forward_batch(std::vector<double>(3 * 64, 0.5), 64);
+        EXPECT_GT(resource.live_bytes, 0);
+    }
+
+    EXPECT_EQ(resource.live_bytes, 0);
+}
+
+TEST_F(ArenaTest, FlatViewsCoverEveryLayerAtMatchingOffsets)
+{
+    const Network net({5, 7, 3}, activation, criterion);
+    const auto parameters = net.get_parameters();
+    const auto velocities = net.get_velocities();
+    const auto gradients = std::span<const double>{net.get_workspace().parameter_gradients};
+    ASSERT_EQ(velocities.size(), parameters.size());
+    ASSERT_EQ(gradients.size(), parameters.size());
+
+    for (std::size_t layer_idx{0}; layer_idx < net.get_layers().size(); ++layer_idx)
+    {
+        const auto& layer = net.get_layers()[layer_idx];
+        const auto& state = net.get_workspace().layers[layer_idx];
+        const std::span<const double> weights = layer.weights;
+        EXPECT_TRUE(contains(parameters, weights));
+        EXPECT_TRUE(contains(parameters, std::span<const double>{layer.biases}));
+
+        const auto offset = weights.data() - parameters.data();
+        EXPECT_EQ(layer.weight_velocity.data() - velocities.data(), offset);
+        EXPECT_EQ(state.weight_gradients.data() - gradients.data(), offset);
+        EXPECT_EQ(layer.bias_velocity.data() - velocities.data(),
+                  layer.biases.data() - parameters.data());
+    }
+}
+
+TEST_F(ArenaTest, CopiesAreIndependent)
+{
+    Network net({2, 4, 1}, activation, criterion);
+    const Network copy = net;
+    const std::vector<double> before(copy.get_parameters().begin(),
+                                     copy.get_parameters().end());
+
+    for (int i{0}; i < 3; ++i)
+    {
+        net.train_step(std::vector<double>{0.5, -0.5}, std::vector<double>{0.25}, 1, 0.1, 0.9);
+    }
+
+    EXPECT_TRUE(std::ranges::equal(copy.get_parameters(), before));
+    EXPECT_FALSE(std::ranges::equal(net.get_parameters(), before));
+    EXPECT_TRUE(contains(copy.get_parameters(),
+                         std::span<const double>{copy.get_layers().front().weights}));
+}
@@ -0,0 +1,227 @@
+#include "autograd.hpp"
+#include "activation.hpp"
+#include "criterion.hpp"
+#include "network.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using namespace axon;
+
+namespace
+{
+
+    auto make_values(std::size_t size, double phase) -> std::vector<double>
+    {
+        std::vector<double> values(size);
+        for (std::size_t i{0}; i < values.size(); ++i)
+        {
+            values[i] = 0.5 * std::sin((0.37 * static_cast<double>(i)) + phase);
+        }
+
+        return values;
+    }
+
+} // namespace
+
+class AutogradTest : public ::testing::Test
+{
+protected:
+    Activation tanh = Activation::of<activation::Tanh>();
+    Activation sigmoid = Activation::of<activation::Sigmoid>();
+    Criterion criterion = Criterion::of<criterion::MSE>();
+
+    // Every op on one graph, with `y` feeding two ops so that its gradient accumulates.
+    std::vector<double> a = make_values(3 * 4, 0.1);
+    std::vector<double> b = make_values(4 * 5, 0.2);
+    std::vector<double> bias = make_values(5, 0.3);
+    std::vector<double> scale = make_values(3 * 5, 0.4);
+    std::vector<double> weights = make_values(2 * 5, 0.5);
+    std::vector<double> layer_bias = make_values(2, 0.6);
+    const std::vector<double> offsets = make_values(3 * 5, 0.7);
+    const std::vector<double> targets = make_values(3 * 2, 0.8);
+
+    std::vector<std::vector<double>*> parameters{&a, &b, &bias, &scale, &weights, &layer_bias};
+    std::vector<std::vector<double>> gradients = [this]
+    {
+        std::vector<std::vector<double>> result;
+        for (const auto* values : parameters)
+        {
+            result.emplace_back(values->size());
+        }
+        return result;
+    }();
+
+    auto record(autograd::Tape& tape) -> autograd::Var
+    {
+        const auto pa = tape.parameter(a, gradients[0], 3, 4);
+        const auto pb = tape.parameter(b, gradients[1], 4, 5);
+        const auto pbias = tape.parameter(bias, gradients[2], 1, 5);
+        const auto pscale = tape.parameter(scale, gradients[3], 3, 5);
+        const auto pweights = tape.parameter(weights, gradients[4], 2, 5);
+        const auto player_bias = tape.parameter(layer_bias, gradients[5], 1, 2);
+
+        const auto y = tape.activate(tape.add_bias(tape.matmul(pa, pb), pbias), tanh);
+        const auto z = tape.add(tape.add(tape.multiply(y, pscale), y),
+                                tape.constant(offsets, 3, 5));
+        const auto outputs = tape.linear(z, pweights, player_bias, sigmoid);
+        return tape.loss(outputs, targets, criterion);
+    }
+};
+
+TEST_F(AutogradTest, GradientsMatchFiniteDifferences)
+{
+    autograd::Tape tape;
+    tape.backward(record(tape));
+
+    constexpr double step{1e-6};
+    for (std::size_t p{0}; p < parameters.size(); ++p)
+    {
+        auto& values = *parameters[p];
+        for (std::size_t i{0}; i < values.size(); ++i)
+        {
+            const double original = values[i];
+
+            values[i] = original + step;
+            tape.reset();
+            const double above = tape.value(record(tape))[0];
+
+            values[i] = original - step;
+            tape.reset();
+            const double below = tape.value(record(tape))[0];
+
+            values[i] = original;
+            EXPECT_NEAR(gradients[p][i], (above - below) / (2 * step), 1e-7)
+                << "parameter " << p << " entry " << i;
+        }
+    }
+}
+
+TEST_F(AutogradTest, SeedScalesGradients)
+{
+    autograd::Tape tape;
+    tape.backward(record(tape));
+    const auto unit = gradients;
+
+    tape.backward(record(tape), 3.0);
+    for (std::size_t p{0}; p < gradients.size(); ++p)
+    {
+        for (std::size_t i{0}; i < gradients[p].size(); ++i)
+        {
+            EXPECT_NEAR(gradients[p][i], 3.0 * unit[p][i], 1e-12);
+        }
+    }
+}
+
+TEST_F(AutogradTest, UnreachedParametersGetZeroGradients)
+{
+    autograd::Tape tape;
+    std::vector<double> unused(4, 1.0);
+    std::vector<double> unused_gradients(4, 7.0);
+
+    const auto output = record(tape);
+    const auto other = tape.parameter(unused, unused_gradients, 2, 2);
+    tape.backward(output);
+
+    EXPECT_TRUE(tape.gradient(other).empty());
+    for (const double gradient : unused_gradients)
+    {
+        EXPECT_EQ(gradient, 0.0);
+    }
+}
+
+TEST_F(AutogradTest, RecordingAfterBackwardStartsNewGraph)
+{
+    autograd::Tape tape;
+    const auto loss = record(tape);
+    const std::size_t num_nodes = tape.size();
+    tape.backward(loss);
+
+    // Values and gradients stay readable until the next op.
+    EXPECT_EQ(tape.size(), num_nodes);
+    EXPECT_EQ(tape.gradient(loss).size(), 1);
+
+    const std::size_t capacity = tape.get_capacity();
+    const auto constant = tape.constant(offsets, 3, 5);
+    EXPECT_EQ(constant.index, 0);
+    EXPECT_EQ(tape.size(), 1);
+
+    tape.reset();
+    tape.backward(record(tape));
+    EXPECT_EQ(tape.get_capacity(), capacity);
+}
+
+TEST_F(AutogradTest, ThrowsOnMismatchedShapes)
+{
+    autograd::Tape tape;
+    const auto pa = tape.parameter(a, gradients[0], 3, 4);
+    const auto pscale = tape.parameter(scale, gradients[3], 3, 5);
+
+    EXPECT_THROW(static_cast<void>(tape.matmul(pa, pa)), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(tape.add(pa, pscale)), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(tape.multiply(pa, pscale)), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(tape.add_bias(pa, pscale)), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(tape.loss(pa, targets, criterion)), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(tape.constant(offsets, 2, 2)), std::invalid_argument);
+    EXPECT_THROW(tape.backward(autograd::Var{99}), std::invalid_argument);
+}
+
+TEST_F(AutogradTest, NetworkOnTapeMatchesBackPropagation)
+{
+    Network hand({6, 16, 8, 3}, tanh, criterion);
+    Network taped = hand;
+    auto workspace = taped.make_workspace();
+    autograd::Tape tape;
+
+    const auto inputs = make_values(5 * 6, 0.9);
+    const auto batch_targets = make_values(5 * 3, 1.0);
+
+    for (int step = 0; step < 3; ++step)
+    {
+        hand.feed_forward_batch(inputs, 5);
+        hand.back_propagate(batch_targets);
+        hand.step(0.1, 0.9);
+
+        const auto outputs = autograd::record(tape, taped, inputs, 5, workspace);
+        tape.backward(tape.loss(outputs, batch_targets, criterion), 3.0);
+        taped.apply_gradients(workspace, 0.1, 0.9);
+    }
+
+    const auto expected = hand.get_parameters();
+    const auto actual = taped.get_parameters();
+    for (std::size_t i{0}; i < expected.size(); ++i)
+    {
+        ASSERT_NEAR(actual[i], expected[i], 1e-12) << "at " << i;
+    }
+}
+
+TEST_F(AutogradTest, RecordsSinglePrecisionNetworks)
+{
+    BasicNetwork<float> net({4, 8, 2}, tanh, criterion);
+    auto workspace = net.make_workspace();
+    autograd::BasicTape<float> tape;
+
+    std::vector<float> inputs(3 * 4);
+    std::vector<float> batch_targets(3 * 2);
+    for (std::size_t i{0}; i < inputs.size(); ++i)
+    {
+        inputs[i] = 0.5F * std::sin(0.37F * static_cast<float>(i));
+    }
+    std::ranges::fill(batch_targets, 0.5F);
+
+    net.feed_forward_batch(inputs, 3);
+    net.back_propagate(batch_targets);
+
+    const auto outputs = autograd::record(tape, net, inputs, 3, workspace);
+    tape.backward(tape.loss(outputs, batch_targets, criterion), 2.0F);
+
+    const auto expected = net.get_workspace().parameter_gradients;
+    for (std::size_t i{0}; i < expected.size(); ++i)
+    {
+        EXPECT_NEAR(workspace.parameter_gradients[i], expected[i], 1e-6F) << "at " << i;
+    }
+}
@@ -0,0 +1,145 @@
+#include "batcher.hpp"
+#include "activation.hpp"
+#include "criterion.hpp"
+#include "network.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <future>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace axon;
+using namespace std::chrono_literals;
+
+class BatcherTest : public ::testing::Test
+{
+protected:
+    Activation activation = Activation::of<activation::Tanh>();
+    Criterion criterion = Criterion::of<criterion::MSE>();
+
+    static auto make_input(std::size_t size, double phase) -> std::vector<double>
+    {
+        std::vector<double> input(size);
+        for (std::size_t i{0}; i < size; ++i)
+        {
+            input[i] = std::sin(phase + (0.7 * static_cast<double>(i)));
+        }
+
+        return input;
+    }
+};
+
+TEST_F(BatcherTest, ConcurrentRequestsGetTheirOwnOutputs)
+{
+    const Network net({5, 16, 3}, activation, criterion);
+    Batcher batcher(net, {.max_batch_size = 8, .max_wait = 200us});
+
+    constexpr std::size_t num_clients{6};
+    constexpr std::size_t requests_per_client{40};
+    std::vector<std::jthread> clients;
+    std::vector<std::size_t> mismatches(num_clients, 0);
+    for (std::size_t client{0}; client < num_clients; ++client)
+    {
+        clients.emplace_back(
+            [&, client]
+            {
+                Network reference = net;
+                for (std::size_t i{0}; i < requests_per_client; ++i)
+                {
+                    const auto input =
+                        make_input(5, static_cast<double>((client * requests_per_client) + i));
+                    auto output = batcher.submit(input);
+
+                    reference.feed_forward(input);
+                    const auto expected = reference.get_output();
+                    const auto actual = output.get();
+                    for (std::size_t out{0}; out < expected.size(); ++out)
+                    {
+                        mismatches[client] += std::abs(actual[out] - expected[out]) > 1e-12;
+                    }
+                }
+            });
+    }
+
+    clients.clear();
+    EXPECT_EQ(std::accumulate(mismatches.begin(), mismatches.end(), std::size_t{0}), 0);
+
+    const auto stats = batcher.get_stats();
+    EXPECT_EQ(stats.num_requests, num_clients * requests_per_client);
+    EXPECT_EQ(stats.queue_depth, 0);
+    EXPECT_GE(stats.max_queue_depth, 1);
+    ASSERT_EQ(stats.batch_sizes.size(), 9);
+    EXPECT_EQ(stats.batch_sizes[0], 0);
+
+    std::size_t batched_requests{0};
+    for (std::size_t size{1}; size < stats.batch_sizes.size(); ++size)
+    {
+        batched_requests += size * stats.batch_sizes[size];
+    }
+    EXPECT_EQ(batched_requests, stats.num_requests);
+}
+
+TEST_F(BatcherTest, FullBatchIsDispatchedBeforeDeadline)
+{
+    const Network net({2, 4, 1}, activation, criterion);
+    Batcher batcher(net, {.max_batch_size = 4, .max_wait = 10s});
+
+    const auto started = std::chrono::steady_clock::now();
+    std::vector<std::future<std::vector<double>>> outputs;
+    for (std::size_t i{0}; i < 4; ++i)
+    {
+        outputs.push_back(batcher.submit(make_input(2, static_cast<double>(i))));
+    }
+
+    for (auto& output : outputs)
+    {
+        EXPECT_EQ(output.get().size(), 1);
+    }
+
+    EXPECT_LT(std::chrono::steady_clock::now() - started, 5s);
+    const auto stats = batcher.get_stats();
+    EXPECT_EQ(stats.num_batches, 1);
+    EXPECT_EQ(stats.batch_sizes[4], 1);
+    EXPECT_DOUBLE_EQ(stats.mean_batch_size(), 4.0);
+}
+
+TEST_F(BatcherTest, DeadlineFlushesPartialBatch)
+{
+    const Network net({2, 4, 1}, activation, criterion);
+    Batcher batcher(net, {.max_batch_size = 64, .max_wait = 1ms});
+
+    auto output = batcher.submit(make_input(2, 0.0));
+    ASSERT_EQ(output.wait_for(5s), std::future_status::ready);
+
+    const auto stats = batcher.get_stats();
+    EXPECT_EQ(stats.batch_sizes[1], 1);
+    EXPECT_GE(stats.p50, 1ms);
+    EXPECT_LE(stats.p50, stats.p99);
+    EXPECT_LE(stats.p99, stats.max);
+}
+
+TEST_F(BatcherTest, DestructorServesPendingRequests)
+{
+    const Network net({2, 4, 1}, activation, criterion);
+    std::future<std::vector<double>> output;
+    {
+        Batcher batcher(net, {.max_batch_size = 64, .max_wait = 10s});
+        output = batcher.submit(make_input(2, 0.0));
+    }
+
+    ASSERT_EQ(output.wait_for(0s), std::future_status::ready);
+    EXPECT_EQ(output.get().size(), 1);
+}
+
+TEST_F(BatcherTest, ThrowsOnInvalidArguments)
+{
+    const Network net({2, 4, 1}, activation, criterion);
+    EXPECT_THROW((Batcher{net, {.max_batch_size = 0}}), std::invalid_argument);
+
+    Batcher batcher(net);
+    EXPECT_THROW(static_cast<void>(batcher.submit(make_input(3, 0.0))), std::invalid_argument);
+}
@@ -0,0 +1,246 @@
+#include "checkpoint.hpp"
+#include "activation.hpp"
+#include "criterion.hpp"
+#include "network.hpp"
+#include "optimizer.hpp"
+#include "serialization.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace axon;
+
+class CheckpointTest : public ::testing::Test
+{
+protected:
+    Activation activation = Activation::of<activation::Tanh>();
+    Criterion criterion = Criterion::of<criterion::MSE>();
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path()
+        / (std::string{::testing::UnitTest::GetInstance()->current_test_info()->name()}
+           + ".axonckp");
+
+    static constexpr std::size_t batch_size{4};
+    std::vector<double> inputs = make_values(batch_size * 3, 0.7);
+    std::vector<double> targets = make_values(batch_size * 2, 1.3);
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    static auto make_values(std::size_t size, double frequency) -> std::vector<double>
+    {
+        std::vector<double> values(size);
+        for (std::size_t i{0}; i < size; ++i)
+        {
+            values[i] = 0.5 * std::sin(frequency * static_cast<double>(i));
+        }
+
+        return values;
+    }
+
+    auto train(Network& net, std::size_t num_steps) const -> void
+    {
+        for (std::size_t i{0}; i < num_steps; ++i)
+        {
+            net.feed_forward_batch(inputs, batch_size);
+            net.back_propagate(targets);
+            net.step(0.05, 0.9);
+        }
+    }
+
+    static auto expect_same_parameters(const Network& lhs, const Network& rhs) -> void
+    {
+        ASSERT_EQ(lhs.get_layers().size(), rhs.get_layers().size());
+        for (std::size_t layer_idx{0}; layer_idx < lhs.get_layers().size(); ++layer_idx)
+        {
+            const auto& a = lhs.get_layers()[layer_idx];
+            const auto& b = rhs.get_layers()[layer_idx];
+            EXPECT_TRUE(std::ranges::equal(a.weights, b.weights));
+            EXPECT_TRUE(std::ranges::equal(a.biases, b.biases));
+            EXPECT_TRUE(std::ranges::equal(a.weight_velocity, b.weight_velocity));
+            EXPECT_TRUE(std::ranges::equal(a.bias_velocity, b.bias_velocity));
+        }
+    }
+};
+
+TEST_F(CheckpointTest, ResumedTrainingIsBitExact)
+{
+    Network reference({3, 8, 2}, activation, criterion);
+    train(reference, 5);
+    serialization::save_checkpoint(reference, {.epoch = 1, .step = 5, .seed = 42}, path);
+    train(reference, 5);
+
+    // NOTE(abi): the fresh network starts from different random weights, so matching the
+    // reference proves both the parameters and the momentum velocities were restored.
+    Network resumed({3, 8, 2}, activation, criterion);
+    const auto state = serialization::restore_checkpoint(path, resumed);
+    EXPECT_EQ(state.epoch, 1);
+    EXPECT_EQ(state.step, 5);
+    EXPECT_EQ(state.seed, 42);
+
+    train(resumed, 5);
+    expect_same_parameters(resumed, reference);
+}
+
+TEST_F(CheckpointTest, ResumedAdamTrainingIsBitExact)
+{
+    const auto train_adam = [&](Network& net, Adam& adam, std::size_t num_steps)
+    {
+        for (std::size_t i{0}; i < num_steps; ++i)
+        {
+            net.feed_forward_batch(inputs, batch_size);
+            net.back_propagate(targets);
+            net.step(adam);
+        }
+    };
+
+    Network reference({3, 8, 2}, activation, criterion);
+    Adam reference_adam(AdamWOptions{.learning_rate = 0.01});
+    train_adam(reference, reference_adam, 5);
+    serialization::save_checkpoint(reference, reference_adam, {.step = 5}, path);
+    train_adam(reference, reference_adam, 5);
+
+    // NOTE(abi): a fresh optimizer would restart its moments at zero and its bias correction
+    // at the first step, so matching the reference proves both were restored.
+    Network resumed({3, 8, 2}, activation, criterion);
+    Adam resumed_adam(AdamWOptions{.learning_rate = 0.01});
+    EXPECT_EQ(serialization::restore_checkpoint(path, resumed, resumed_adam).step, 5);
+    EXPECT_EQ(resumed_adam.get_num_steps(), 5);
+
+    train_adam(resumed, resumed_adam, 5);
+    expect_same_parameters(resumed, reference);
+    EXPECT_TRUE(std::ranges::equal(resumed_adam.get_state(), reference_adam.get_state()));
+
+    // A checkpoint taken without an optimizer has none to restore.
+    serialization::save_checkpoint(reference, {}, path);
+    EXPECT_THROW(serialization::restore_checkpoint(path, resumed, resumed_adam),
+                 std::invalid_argument);
+}
+
+TEST_F(CheckpointTest, CheckpointerStoresOptimizerState)
+{
+    BasicNetwork<float> net({3, 5, 2}, activation, criterion);
+    BasicRMSprop<float> rmsprop;
+    const std::vector<float> gradients(net.get_parameters().size(), 0.5F);
+    rmsprop.step(net.get_parameters(), gradients);
+
+    {
+        BasicCheckpointer<float> checkpointer(path);
+        checkpointer.save(net, rmsprop, {});
+    }
+
+    BasicNetwork<float> restored({3, 5, 2}, activation, criterion);
+    BasicRMSprop<float> restored_rmsprop;
+    serialization::restore_checkpoint(path, restored, restored_rmsprop);
+    EXPECT_EQ(restored_rmsprop.get_num_steps(), 1);
+    EXPECT_TRUE(std::ranges::equal(restored_rmsprop.get_state(), rmsprop.get_state()));
+}
+
+TEST_F(CheckpointTest, RestoresPruningMasks)
+{
+    Network reference({3, 8, 2}, activation, criterion);
+    train(reference, 5);
+    reference.prune(0.5);
+    serialization::save_checkpoint(reference, {}, path);
+    train(reference, 5);
+
+    Network resumed({3, 8, 2}, activation, criterion);
+    serialization::restore_checkpoint(path, resumed);
+    for (std::size_t layer_idx{0}; layer_idx < reference.get_layers().size(); ++layer_idx)
+    {
+        EXPECT_TRUE(
+            std::ranges::equal(resumed.get_mask(layer_idx), reference.get_mask(layer_idx)));
+    }
+
+    train(resumed, 5);
+    expect_same_parameters(resumed, reference);
+
+    // An unpruned checkpoint leaves the network it is restored into unpruned.
+    serialization::save_checkpoint(Network({3, 8, 2}, activation, criterion), {}, path);
+    serialization::restore_checkpoint(path, resumed);
+    EXPECT_TRUE(resumed.get_mask(0).empty());
+}
+
+TEST_F(CheckpointTest, CheckpointerWritesLatestSnapshot)
+{
+    BasicNetwork<float> net({3, 5, 2}, activation, criterion);
+    BasicCheckpointer<float> checkpointer(path);
+
+    for (std::uint64_t step{1}; step <= 50; ++step)
+    {
+        net.get_layers().front().biases.front() = static_cast<float>(step);
+        checkpointer.save(net, {.step = step});
+    }
+
+    checkpointer.wait();
+    EXPECT_GE(checkpointer.get_num_written(), 1);
+    EXPECT_EQ(checkpointer.get_num_written() + checkpointer.get_num_superseded(), 50);
+
+    BasicNetwork<float> restored({3, 5, 2}, activation, criterion);
+    const auto state = serialization::restore_checkpoint(path, restored);
+    EXPECT_EQ(state.step, 50);
+    EXPECT_EQ(restored.get_layers().front().biases.front(), 50.0F);
+    EXPECT_TRUE(std::ranges::equal(restored.get_layers().back().weights,
+                                   net.get_layers().back().weights));
+}
+
+TEST_F(CheckpointTest, DestructorFlushesPendingSnapshot)
+{
+    const Network net({2, 4, 1}, activation, criterion);
+    {
+        Checkpointer checkpointer(path);
+        checkpointer.save(net, {.step = 7});
+    }
+
+    Network restored({2, 4, 1}, activation, criterion);
+    EXPECT_EQ(serialization::restore_checkpoint(path, restored).step, 7);
+    expect_same_parameters(restored, net);
+}
+
+TEST_F(CheckpointTest, WriterErrorsSurfaceOnWait)
+{
+    const Network net({2, 4, 1}, activation, criterion);
+    Checkpointer checkpointer(std::filesystem::temp_directory_path() / "missing" / "ckpt");
+
+    checkpointer.save(net, {});
+    EXPECT_THROW(checkpointer.wait(), std::runtime_error);
+    EXPECT_NO_THROW(checkpointer.wait());
+}
+
+TEST_F(CheckpointTest, RejectsMismatchedOrCorruptedCheckpoints)
+{
+    const Network net({3, 8, 2}, activation, criterion);
+    serialization::save_checkpoint(net, {}, path);
+
+    Network other({3, 9, 2}, activation, criterion);
+    EXPECT_THROW(serialization::restore_checkpoint(path, other), std::invalid_argument);
+
+    BasicNetwork<float> narrower({3, 8, 2}, activation, criterion);
+    EXPECT_THROW(serialization::restore_checkpoint(path, narrower), std::runtime_error);
+
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(-1, std::ios::end);
+        file.put('\x7F');
+    }
+
+    Network same({3, 8, 2}, activation, criterion);
+    EXPECT_THROW(serialization::restore_checkpoint(path, same), std::runtime_error);
+}
+
+TEST_F(CheckpointTest, ModelsAndCheckpointsAreNotInterchangeable)
+{
+    Network net({3, 8, 2}, activation, criterion);
+    serialization::save(net, path);
+    EXPECT_THROW(serialization::restore_checkpoint(path, net), std::runtime_error);
+
+    serialization::save_checkpoint(net, {}, path);
+    EXPECT_THROW(MappedNetwork{path}, std::runtime_error);
+}
@@ -0,0 +1,375 @@
+#include "conv.hpp"
+#include "kernels.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace axon;
+
+namespace
+{
+
+    template <typename Scalar>
+    auto fill(std::span<Scalar> values, double phase) -> void
+    {
+        for (std::size_t i{0}; i < values.size(); ++i)
+        {
+            values[i] =
+                static_cast<Scalar>(0.5 * std::sin((0.37 * static_cast<double>(i)) + phase));
+        }
+    }
+
+    template <typename Scalar>
+    auto make_values(const Shape& shape, double phase) -> BasicTensor<Scalar>
+    {
+        BasicTensor<Scalar> tensor(shape);
+        fill(tensor.span(), phase);
+        return tensor;
+    }
+
+    // Input pixel read by output pixel `(oy, ox)` through tap `(ky, kx)`, or false when it
+    // falls in the padding.
+    auto source_pixel(const Conv2DOptions& options, std::size_t height, std::size_t width,
+                      std::size_t oy, std::size_t ox, std::size_t ky, std::size_t kx,
+                      std::size_t& y, std::size_t& x) -> bool
+    {
+        y = (oy * options.stride) + ky;
+        x = (ox * options.stride) + kx;
+        if (y < options.padding || x < options.padding)
+        {
+            return false;
+        }
+
+        y -= options.padding;
+        x -= options.padding;
+        return y < height && x < width;
+    }
+
+    // Runs `visit(n, o, c, oy, ox, y, x, w)` for every multiply of the convolution, where `w` is
+    // the weight index.
+    template <typename Visit>
+    auto for_each_tap(const Conv2DOptions& options, const Shape& input, const Shape& output,
+                      Visit visit) -> void
+    {
+        const std::size_t k = options.kernel_size;
+        for (std::size_t n{0}; n < input[0]; ++n)
+        {
+            for (std::size_t o{0}; o < options.out_channels; ++o)
+            {
+                for (std::size_t oy{0}; oy < output[2]; ++oy)
+                {
+                    for (std::size_t ox{0}; ox < output[3]; ++ox)
+                    {
+                        for (std::size_t c{0}; c < options.in_channels; ++c)
+                        {
+                            for (std::size_t ky{0}; ky < k; ++ky)
+                            {
+                                for (std::size_t kx{0}; kx < k; ++kx)
+                                {
+                                    std::size_t y{0};
+                                    std::size_t x{0};
+                                    if (source_pixel(options, input[2], input[3], oy, ox, ky, kx,
+                                                     y, x))
+                                    {
+                                        visit(n, o, c, oy, ox, y, x,
+                                              (((o * options.in_channels) + c) * k + ky) * k
+                                                  + kx);
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    struct ConvCase
+    {
+        Conv2DOptions options;
+        Shape input;
+    };
+
+    // Odd widths past four vectors exercise the blocked, single-vector and tail paths of the
+    // direct kernel.
+    const std::vector<ConvCase> conv_cases{
+        {{.in_channels = 3, .out_channels = 5, .kernel_size = 3, .stride = 1, .padding = 1},
+         {2, 3, 7, 37}},
+        {{.in_channels = 2, .out_channels = 4, .kernel_size = 3, .stride = 1, .padding = 0},
+         {1, 2, 5, 70}},
+        {{.in_channels = 2, .out_channels = 3, .kernel_size = 3, .stride = 1, .padding = 2},
+         {2, 2, 4, 9}},
+        {{.in_channels = 3, .out_channels = 4, .kernel_size = 3, .stride = 2, .padding = 1},
+         {2, 3, 9, 11}},
+        {{.in_channels = 4, .out_channels = 3, .kernel_size = 1, .stride = 1, .padding = 0},
+         {2, 4, 5, 6}},
+        {{.in_channels = 2, .out_channels = 2, .kernel_size = 5, .stride = 1, .padding = 2},
+         {1, 2, 8, 8}},
+    };
+
+    class ConvTest : public ::testing::TestWithParam<kernels::Isa>
+    {
+    protected:
+        void SetUp() override
+        {
+            if (!kernels::is_supported(GetParam()))
+            {
+                GTEST_SKIP() << "Instruction set not supported by this CPU.";
+            }
+
+            previous_isa_ = kernels::get_isa();
+            kernels::set_isa(GetParam());
+        }
+
+        void TearDown() override
+        {
+            kernels::set_isa(previous_isa_);
+        }
+
+        // Checks every pass of `conv` against the loops above, under each algorithm that
+        // applies.
+        template <typename Scalar>
+        static auto check_passes(const ConvCase& test_case, double tolerance) -> void
+        {
+            const auto& options = test_case.options;
+            BasicConv2D<Scalar> conv(options);
+            fill(conv.get_parameters(), 0.1);
+
+            const auto inputs = make_values<Scalar>(test_case.input, 0.2);
+            const Shape output_shape = conv.output_shape(test_case.input);
+            const auto output_gradients = make_values<Scalar>(output_shape, 0.3);
+            const auto weights = conv.get_weights();
+            const auto biases = conv.get_biases();
+
+            std::vector<double> outputs(output_gradients.size());
+            std::vector<double> input_gradients(inputs.size());
+            std::vector<double> weight_gradients(weights.size());
+            std::vector<double> bias_gradients(biases.size(), 0.0);
+
+            const std::size_t out_plane = output_shape[2] * output_shape[3];
+            for (std::size_t i{0}; i < outputs.size(); ++i)
+            {
+                outputs[i] = biases[(i / out_plane) % options.out_channels];
+                bias_gradients[(i / out_plane) % options.out_channels] +=
+                    output_gradients.span()[i];
+            }
+
+            for_each_tap(options, test_case.input, output_shape,
+                         [&](std::size_t n, std::size_t o, std::size_t c, std::size_t oy,
+                             std::size_t ox, std::size_t y, std::size_t x, std::size_t w)
+                         {
+                             const std::size_t out =
+                                 (((n * options.out_channels) + o) * out_plane)
+                                 + (oy * output_shape[3]) + ox;
+                             const std::size_t in =
+                                 (((n * options.in_channels) + c) * test_case.input[2] + y)
+                                     * test_case.input[3]
+                                 + x;
+                             outputs[out] += weights[w] * inputs.span()[in];
+                             input_gradients[in] += weights[w] * output_gradients.span()[out];
+                             weight_gradients[w] +=
+                                 inputs.span()[in] * output_gradients.span()[out];
+                         });
+
+            std::vector<ConvAlgorithm> algorithms{ConvAlgorithm::im2col};
+            if (options.kernel_size == 3 && options.stride == 1)
+            {
+                algorithms.push_back(ConvAlgorithm::direct);
+            }
+
+            for (const auto algorithm : algorithms)
+            {
+                conv.set_algorithm(algorithm);
+
+                BasicTensor<Scalar> actual_outputs(output_shape);
+                std::fill_n(actual_outputs.data(), actual_outputs.size(), Scalar{7});
+                conv.forward(inputs, actual_outputs);
+                for (std::size_t i{0}; i < outputs.size(); ++i)
+                {
+                    ASSERT_NEAR(actual_outputs.span()[i], outputs[i], tolerance) << "output " << i;
+                }
+
+                BasicTensor<Scalar> actual_input_gradients(test_case.input);
+                std::fill_n(actual_input_gradients.data(), actual_input_gradients.size(),
+                            Scalar{7});
+                conv.backward_data(output_gradients, actual_input_gradients);
+                for (std::size_t i{0}; i < input_gradients.size(); ++i)
+                {
+                    ASSERT_NEAR(actual_input_gradients.span()[i], input_gradients[i], tolerance)
+                        << "input gradient " << i;
+                }
+
+                conv.backward_weights(inputs, output_gradients);
+                for (std::size_t i{0}; i < weight_gradients.size(); ++i)
+                {
+                    ASSERT_NEAR(conv.get_weight_gradients()[i], weight_gradients[i], tolerance)
+                        << "weight gradient " << i;
+                }
+                for (std::size_t i{0}; i < bias_gradients.size(); ++i)
+                {
+                    ASSERT_NEAR(conv.get_bias_gradients()[i], bias_gradients[i], tolerance)
+                        << "bias gradient " << i;
+                }
+            }
+        }
+
+    private:
+        kernels::Isa previous_isa_{kernels::Isa::scalar};
+    };
+
+} // namespace
+
+TEST_P(ConvTest, PassesMatchReference)
+{
+    for (const auto& test_case : conv_cases)
+    {
+        SCOPED_TRACE(test_case.input[3]);
+        check_passes<double>(test_case, 1e-12);
+    }
+}
+
+TEST_P(ConvTest, SinglePrecisionPassesMatchReference)
+{
+    for (const auto& test_case : conv_cases)
+    {
+        SCOPED_TRACE(test_case.input[3]);
+        check_passes<float>(test_case, 1e-4);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllIsas, ConvTest,
+                         ::testing::Values(kernels::Isa::scalar, kernels::Isa::avx2,
+                                           kernels::Isa::avx512));
+
+TEST(ConvTransposeTest, IsTheAdjointOfConvolution)
+{
+    const Conv2DOptions options{
+        .in_channels = 3, .out_channels = 4, .kernel_size = 3, .stride = 2, .padding = 1};
+    Conv2D conv(options);
+    fill(conv.get_parameters(), 0.1);
+
+    // Same weights with the channel roles swapped, and no biases.
+    ConvTranspose2D transpose(
+        {.in_channels = 4, .out_channels = 3, .kernel_size = 3, .stride = 2, .padding = 1});
+    auto parameters = transpose.get_parameters();
+    std::ranges::copy(conv.get_weights(), parameters.begin());
+    std::fill(parameters.begin() + static_cast<std::ptrdiff_t>(conv.get_weights().size()),
+              parameters.end(), 0.0);
+
+    const Shape image_shape{2, 3, 9, 9};
+    const Shape feature_shape = conv.output_shape(image_shape);
+    EXPECT_EQ(transpose.output_shape(feature_shape), image_shape);
+
+    const auto images = make_values<double>(image_shape, 0.2);
+    const auto features = make_values<double>(feature_shape, 0.3);
+
+    // Transpose forward is convolution backward-data, and the other way round.
+    Tensor expected(image_shape);
+    Tensor actual(image_shape);
+    conv.backward_data(features, expected);
+    transpose.forward(features, actual);
+    for (std::size_t i{0}; i < expected.size(); ++i)
+    {
+        ASSERT_NEAR(actual.span()[i], expected.span()[i], 1e-12) << "at " << i;
+    }
+
+    Tensor convolved(feature_shape);
+    Tensor gathered(feature_shape);
+    conv.forward(images, convolved);
+    transpose.backward_data(images, gathered);
+    for (std::size_t i{0}; i < convolved.size(); ++i)
+    {
+        const double bias = conv.get_biases()[(i / 25) % 4];
+        ASSERT_NEAR(gathered.span()[i], convolved.span()[i] - bias, 1e-12) << "at " << i;
+    }
+
+    // Both weight gradients pair every feature with the pixels under its kernel.
+    conv.backward_weights(images, features);
+    transpose.backward_weights(features, images);
+    for (std::size_t i{0}; i < conv.get_weight_gradients().size(); ++i)
+    {
+        ASSERT_NEAR(transpose.get_gradients()[i], conv.get_weight_gradients()[i], 1e-12);
+    }
+
+    double bias_gradient{0.0};
+    for (std::size_t i{0}; i < 9 * 9; ++i)
+    {
+        bias_gradient += images.span()[i] + images.span()[(3 * 9 * 9) + i];
+    }
+    EXPECT_NEAR(transpose.get_gradients()[conv.get_weights().size()], bias_gradient, 1e-12);
+}
+
+TEST(PoolTest, MaxPoolingRoutesGradientsToMaxima)
+{
+    Pool2D pool({.mode = PoolMode::max, .kernel_size = 2, .stride = 2});
+    const Tensor inputs(Shape{1, 1, 3, 4},
+                        std::vector<double>{1, 5, 2, 0, //
+                                            3, 4, 8, 1, //
+                                            9, 9, 9, 9});
+
+    const Shape output_shape = pool.output_shape(inputs.shape());
+    ASSERT_EQ(output_shape, (Shape{1, 1, 1, 2}));
+
+    Tensor outputs(output_shape);
+    pool.forward(inputs, outputs);
+    EXPECT_EQ(outputs(0, 0, 0, 0), 5.0);
+    EXPECT_EQ(outputs(0, 0, 0, 1), 8.0);
+
+    Tensor input_gradients(inputs.shape());
+    pool.backward(Tensor(output_shape, std::vector<double>{0.5, -2.0}), input_gradients);
+    const std::vector<double> expected{0, 0.5, 0, 0, 0, 0, -2.0, 0, 0, 0, 0, 0};
+    for (std::size_t i{0}; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(input_gradients.span()[i], expected[i]) << "at " << i;
+    }
+}
+
+TEST(PoolTest, AveragePoolingSpreadsGradients)
+{
+    Pool2D pool({.mode = PoolMode::average, .kernel_size = 2, .stride = 1});
+    const Tensor inputs(Shape{2, 1, 2, 3}, std::vector<double>{1, 2, 3, 4, 5, 6, //
+                                                               0, 0, 4, 4, 8, 8});
+
+    Tensor outputs(pool.output_shape(inputs.shape()));
+    ASSERT_EQ(outputs.shape(), (Shape{2, 1, 1, 2}));
+    pool.forward(inputs, outputs);
+    EXPECT_EQ(outputs(0, 0, 0, 0), 3.0);
+    EXPECT_EQ(outputs(0, 0, 0, 1), 4.0);
+    EXPECT_EQ(outputs(1, 0, 0, 1), 5.0);
+
+    Tensor input_gradients(inputs.shape());
+    pool.backward(Tensor(outputs.shape(), std::vector<double>{4, 8, 0, 4}), input_gradients);
+    const std::vector<double> expected{1, 3, 2, 1, 3, 2, 0, 1, 1, 0, 1, 1};
+    for (std::size_t i{0}; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(input_gradients.span()[i], expected[i]) << "at " << i;
+    }
+}
+
+TEST(ConvShapeTest, ThrowsOnInvalidShapes)
+{
+    Conv2D conv({.in_channels = 3, .out_channels = 2, .kernel_size = 3});
+    EXPECT_THROW(static_cast<void>(conv.output_shape({1, 2, 8, 8})), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(conv.output_shape({1, 3, 8})), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(conv.output_shape({1, 3, 2, 8})), std::invalid_argument);
+
+    const Tensor inputs(Shape{1, 3, 8, 8});
+    Tensor outputs(Shape{1, 2, 8, 8});
+    EXPECT_THROW(conv.forward(inputs, outputs), std::invalid_argument);
+
+    Tensor strided(Shape{1, 2, 6, 12});
+    EXPECT_THROW(conv.forward(inputs, TensorView{strided}.slice(3, 0, 6)), std::invalid_argument);
+
+    EXPECT_THROW(Conv2D({.in_channels = 0}), std::invalid_argument);
+    Conv2D strided_conv({.in_channels = 1, .out_channels = 1, .kernel_size = 3, .stride = 2});
+    EXPECT_THROW(strided_conv.set_algorithm(ConvAlgorithm::direct), std::invalid_argument);
+
+    Pool2D pool({});
+    Tensor pooled(Shape{1, 3, 4, 4});
+    EXPECT_THROW(pool.backward(pooled, Tensor(Shape{1, 3, 8, 8})), std::invalid_argument);
+}
@@ -40,3 +40,20 @@ TEST(CriterionTest, MSEDerivativeValueIsCorrect)
     EXPECT_DOUBLE_EQ(mse_derivative(1.0, 0.5), -1.0);
     EXPECT_DOUBLE_EQ(mse_derivative(0.0, 1.0), 2.0);
 }
+
+TEST(CriterionTest, MSEPolicyMatchesFreeFunctions)
+{
+    EXPECT_DOUBLE_EQ(MSE::function(1.0, 0.25), mse(1.0, 0.25));
+    EXPECT_DOUBLE_EQ(MSE::derivative(1.0, 0.25), mse_derivative(1.0, 0.25));
+}
+
+TEST(CriterionTest, ResolvesBuiltInFunctionPointers)
+{
+    const axon::Criterion from_pointers{.function = mse, .derivative = mse_derivative};
+    const axon::Criterion custom{.function = [](double t, double o) { return t - o; },
+                                 .derivative = [](double, double) { return -1.0; }};
+
+    EXPECT_EQ(from_pointers.resolve_kind(), Kind::mse);
+    EXPECT_EQ(axon::Criterion::of<MSE>().kind, Kind::mse);
+    EXPECT_EQ(custom.resolve_kind(), Kind::custom);
+}
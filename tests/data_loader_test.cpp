@@ -0,0 +1,183 @@
+#include "data_loader.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using namespace axon;
+
+class DataLoaderTest : public ::testing::TestWithParam<dataset::ReadMode>
+{
+protected:
+    static constexpr std::size_t num_samples{103};
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / make_file_name();
+
+    // Parameterized test names contain a slash.
+    static auto make_file_name() -> std::string
+    {
+        std::string name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        std::ranges::replace(name, '/', '_');
+        return name + ".axondat";
+    }
+
+    // Sample `i` has inputs {i, i + 0.5, i + 0.25} and target {-i}, so every row of a batch
+    // identifies its sample and can be checked for consistency.
+    void SetUp() override
+    {
+        DatasetWriter writer(path, 3, 1);
+        for (std::size_t i{0}; i < num_samples; ++i)
+        {
+            const auto id = static_cast<double>(i);
+            const std::vector<double> inputs{id, id + 0.5, id + 0.25};
+            const std::vector<double> targets{-id};
+            writer.append(inputs, targets);
+        }
+
+        writer.close();
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    // Drains one epoch and returns the sample ids in the order they were served.
+    static auto drain(DataLoader& loader, std::uint64_t epoch) -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> ids;
+        loader.start_epoch(epoch);
+        while (const auto batch = loader.next())
+        {
+            EXPECT_EQ(batch->inputs.size(), batch->size * 3);
+            EXPECT_EQ(batch->targets.size(), batch->size);
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(batch->inputs.data()) % cache_line_size,
+                      0);
+            EXPECT_EQ(batch->input_view().shape(), (Shape{batch->size, 3}));
+            EXPECT_EQ(batch->input_view().data(), batch->inputs.data());
+            EXPECT_EQ(batch->target_view().shape(), (Shape{batch->size, 1}));
+
+            for (std::size_t row{0}; row < batch->size; ++row)
+            {
+                const double id = batch->inputs[row * 3];
+                EXPECT_EQ(batch->inputs[(row * 3) + 1], id + 0.5);
+                EXPECT_EQ(batch->inputs[(row * 3) + 2], id + 0.25);
+                EXPECT_EQ(batch->targets[row], -id);
+                ids.push_back(static_cast<std::size_t>(id));
+            }
+        }
+
+        return ids;
+    }
+
+    [[nodiscard]] auto options(bool shuffle) const -> DataLoaderOptions
+    {
+        return {.batch_size = 10, .shuffle = shuffle, .seed = 7, .mode = GetParam(),
+                .shuffle_buffer = 16};
+    }
+};
+
+TEST_P(DataLoaderTest, UnshuffledEpochFollowsFileOrder)
+{
+    DataLoader loader(path, options(false));
+    EXPECT_EQ(loader.get_num_samples(), num_samples);
+    EXPECT_EQ(loader.get_num_inputs(), 3);
+    EXPECT_EQ(loader.get_num_targets(), 1);
+    EXPECT_EQ(loader.get_num_batches(), 11);
+
+    std::vector<std::size_t> expected(num_samples);
+    std::iota(expected.begin(), expected.end(), std::size_t{0});
+    EXPECT_EQ(drain(loader, 0), expected);
+    EXPECT_EQ(drain(loader, 1), expected);
+}
+
+TEST_P(DataLoaderTest, ShuffledEpochVisitsEverySampleOnce)
+{
+    DataLoader loader(path, options(true));
+
+    const auto first = drain(loader, 0);
+    const auto second = drain(loader, 1);
+    EXPECT_NE(first, second);
+
+    for (auto ids : {first, second})
+    {
+        std::ranges::sort(ids);
+        ASSERT_EQ(ids.size(), num_samples);
+        for (std::size_t i{0}; i < num_samples; ++i)
+        {
+            EXPECT_EQ(ids[i], i);
+        }
+    }
+}
+
+TEST_P(DataLoaderTest, OrderOnlyDependsOnSeedAndEpoch)
+{
+    DataLoader loader(path, options(true));
+    DataLoader resumed(path, options(true));
+
+    const auto expected = drain(loader, 3);
+    drain(loader, 4);
+    EXPECT_EQ(drain(resumed, 3), expected);
+    EXPECT_EQ(drain(loader, 3), expected);
+}
+
+TEST_P(DataLoaderTest, DropLastSkipsPartialBatch)
+{
+    auto settings = options(true);
+    settings.drop_last = true;
+    DataLoader loader(path, settings);
+
+    EXPECT_EQ(loader.get_num_batches(), 10);
+    EXPECT_EQ(drain(loader, 0).size(), 100);
+}
+
+TEST_P(DataLoaderTest, RestartingMidEpochDropsPrefetchedBatches)
+{
+    DataLoader loader(path, options(false));
+
+    loader.start_epoch(0);
+    for (std::size_t i{0}; i < 3; ++i)
+    {
+        ASSERT_TRUE(loader.next().has_value());
+    }
+
+    EXPECT_EQ(drain(loader, 1).front(), 0);
+}
+
+TEST_P(DataLoaderTest, NoBatchesBeforeFirstEpoch)
+{
+    DataLoader loader(path, options(true));
+    EXPECT_FALSE(loader.next().has_value());
+}
+
+TEST_P(DataLoaderTest, RejectsMismatchedOrTruncatedFiles)
+{
+    EXPECT_THROW((BasicDataLoader<float>{path, options(true)}), std::runtime_error);
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+    EXPECT_THROW((DataLoader{path, options(true)}), std::runtime_error);
+
+    EXPECT_THROW((DataLoader{path, {.batch_size = 0}}), std::invalid_argument);
+}
+
+INSTANTIATE_TEST_SUITE_P(ReadModes, DataLoaderTest,
+                         ::testing::Values(dataset::ReadMode::mapped,
+                                           dataset::ReadMode::streaming));
+
+TEST(DatasetWriterTest, RejectsMismatchedSamples)
+{
+    const auto path = std::filesystem::temp_directory_path() / "mismatched.axondat";
+    {
+        BasicDatasetWriter<float> writer(path, 2, 1);
+        const std::vector<float> inputs(4);
+        const std::vector<float> targets(3);
+        EXPECT_THROW(writer.append(inputs, targets), std::invalid_argument);
+    }
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,123 @@
+#include "inference_session.hpp"
+#include "activation.hpp"
+#include "criterion.hpp"
+#include "network.hpp"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+using namespace axon;
+
+class InferenceSessionTest : public ::testing::Test
+{
+protected:
+    Activation activation = Activation::of<activation::Tanh>();
+    Criterion criterion = Criterion::of<criterion::MSE>();
+
+    static auto make_inputs(std::size_t size, double phase) -> std::vector<double>
+    {
+        std::vector<double> inputs(size);
+        for (std::size_t i{0}; i < size; ++i)
+        {
+            inputs[i] = std::sin(phase + (0.3 * static_cast<double>(i)));
+        }
+
+        return inputs;
+    }
+};
+
+TEST_F(InferenceSessionTest, MatchesNetworkForward)
+{
+    Network net({6, 24, 12, 3}, activation, criterion);
+    const auto inputs = make_inputs(6 * 5, 0.0);
+
+    net.feed_forward_batch(inputs, 5);
+    const auto expected = net.get_output();
+
+    InferenceSession session(net);
+    const auto outputs = session.forward(inputs, 5);
+
+    ASSERT_EQ(outputs.size(), expected.size());
+    for (std::size_t i{0}; i < outputs.size(); ++i)
+    {
+        EXPECT_NEAR(outputs[i], expected[i], 1e-12);
+    }
+
+    EXPECT_EQ(session.get_max_batch_size(), 5);
+}
+
+TEST_F(InferenceSessionTest, ConcurrentSessionsShareOneNetwork)
+{
+    const Network net({8, 64, 32, 4}, activation, criterion);
+    constexpr std::size_t num_threads{8};
+    constexpr std::size_t batch_size{3};
+
+    std::vector<std::vector<double>> inputs;
+    std::vector<std::vector<double>> expected;
+    for (std::size_t thread{0}; thread < num_threads; ++thread)
+    {
+        inputs.push_back(make_inputs(8 * batch_size, static_cast<double>(thread)));
+
+        Network reference = net;
+        reference.feed_forward_batch(inputs.back(), batch_size);
+        expected.push_back(reference.get_output());
+    }
+
+    std::vector<std::vector<double>> outputs(num_threads);
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t thread{0}; thread < num_threads; ++thread)
+        {
+            threads.emplace_back(
+                [&, thread]
+                {
+                    InferenceSession session(net, batch_size);
+                    for (int i{0}; i < 50; ++i)
+                    {
+                        outputs[thread] = session.forward(inputs[thread], batch_size);
+                    }
+                });
+        }
+    }
+
+    for (std::size_t thread{0}; thread < num_threads; ++thread)
+    {
+        ASSERT_EQ(outputs[thread].size(), expected[thread].size());
+        for (std::size_t i{0}; i < outputs[thread].size(); ++i)
+        {
+            EXPECT_NEAR(outputs[thread][i], expected[thread][i], 1e-12);
+        }
+    }
+}
+
+TEST_F(InferenceSessionTest, ThrowsOnMismatchedShapes)
+{
+    const Network net({2, 4, 1}, activation, criterion);
+    InferenceSession session(net);
+
+    std::vector<double> outputs(2);
+    EXPECT_THROW(session.forward(std::vector<double>(3), 2), std::invalid_argument);
+    EXPECT_THROW(session.forward(std::vector<double>(4), 0), std::invalid_argument);
+    EXPECT_THROW(session.forward(std::vector<double>(4), 2, std::span<double>{outputs}.first(1)),
+                 std::invalid_argument);
+}
+
+TEST_F(InferenceSessionTest, SinglePrecisionSessionGrowsWithBatch)
+{
+    BasicNetwork<float> net({3, 5, 2}, activation, criterion);
+    BasicInferenceSession<float> session(net);
+
+    const std::vector<float> inputs(3 * 16, 0.5F);
+    net.feed_forward_batch(inputs, 16);
+    const auto expected = net.get_output();
+    const auto outputs = session.forward(inputs, 16);
+
+    EXPECT_EQ(session.get_max_batch_size(), 16);
+    for (std::size_t i{0}; i < outputs.size(); ++i)
+    {
+        EXPECT_NEAR(outputs[i], expected[i], 1e-6F);
+    }
+}
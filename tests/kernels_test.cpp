@@ -0,0 +1,340 @@
+#include "kernels.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace axon::kernels;
+
+namespace
+{
+
+    auto random_matrix(std::size_t size, std::mt19937& rng) -> std::vector<double>
+    {
+        std::uniform_real_distribution<> distribution(-1.0, 1.0);
+
+        std::vector<double> values(size);
+        for (auto& value : values)
+        {
+            value = distribution(rng);
+        }
+
+        return values;
+    }
+
+    auto reference_gemm(Transpose trans_a, Transpose trans_b, std::size_t m, std::size_t n,
+                        std::size_t k, double alpha, const std::vector<double>& a,
+                        const std::vector<double>& b, double beta, std::vector<double>& c) -> void
+    {
+        const std::size_t lda = trans_a == Transpose::no ? k : m;
+        const std::size_t ldb = trans_b == Transpose::no ? n : k;
+
+        for (std::size_t i{0}; i < m; ++i)
+        {
+            for (std::size_t j{0}; j < n; ++j)
+            {
+                double sum{0.0};
+                for (std::size_t p{0}; p < k; ++p)
+                {
+                    const double a_value = trans_a == Transpose::no ? a[(i * lda) + p]
+                                                                    : a[(p * lda) + i];
+                    const double b_value = trans_b == Transpose::no ? b[(p * ldb) + j]
+                                                                    : b[(j * ldb) + p];
+                    sum += a_value * b_value;
+                }
+
+                c[(i * n) + j] = (alpha * sum) + (beta * c[(i * n) + j]);
+            }
+        }
+    }
+
+    auto narrow(const std::vector<double>& values) -> std::vector<float>
+    {
+        return {values.begin(), values.end()};
+    }
+
+    // Runs the test body once per instruction set available on the host.
+    class KernelsTest : public ::testing::TestWithParam<Isa>
+    {
+    protected:
+        void SetUp() override
+        {
+            if (!is_supported(GetParam()))
+            {
+                GTEST_SKIP() << "Instruction set not supported by this CPU.";
+            }
+
+            previous_isa_ = get_isa();
+            set_isa(GetParam());
+        }
+
+        void TearDown() override
+        {
+            set_isa(previous_isa_);
+        }
+
+    private:
+        Isa previous_isa_{Isa::scalar};
+    };
+
+} // namespace
+
+TEST_P(KernelsTest, GemmMatchesReferenceForAllTranspositions)
+{
+    std::mt19937 rng(42);
+
+    const std::vector<std::array<std::size_t, 3>> shapes = {
+        {1, 1, 1}, {1, 7, 5}, {3, 5, 2}, {8, 16, 4}, {13, 29, 31}, {130, 37, 300}, {5, 1100, 9},
+    };
+
+    for (const auto& [m, n, k] : shapes)
+    {
+        for (const auto trans_a : {Transpose::no, Transpose::yes})
+        {
+            for (const auto trans_b : {Transpose::no, Transpose::yes})
+            {
+                const auto a = random_matrix(m * k, rng);
+                const auto b = random_matrix(k * n, rng);
+                auto c = random_matrix(m * n, rng);
+                auto expected = c;
+
+                reference_gemm(trans_a, trans_b, m, n, k, 0.5, a, b, 0.25, expected);
+                gemm(trans_a, trans_b, m, n, k, 0.5, a.data(),
+                     trans_a == Transpose::no ? k : m, b.data(),
+                     trans_b == Transpose::no ? n : k, 0.25, c.data(), n);
+
+                for (std::size_t i{0}; i < c.size(); ++i)
+                {
+                    ASSERT_NEAR(c[i], expected[i], 1e-10) << m << "x" << n << "x" << k;
+                }
+            }
+        }
+    }
+}
+
+TEST_P(KernelsTest, GemmEpilogueRunsOncePerElement)
+{
+    std::mt19937 rng(42);
+
+    // Single rows, edge tiles, several blocks of k and several blocks of n, and no k at all.
+    const std::vector<std::array<std::size_t, 3>> shapes = {
+        {1, 37, 5}, {13, 29, 31}, {130, 37, 300}, {5, 1100, 9}, {4, 6, 0},
+    };
+
+    // Not idempotent, so running it twice on any element shows.
+    const double scale{2.0};
+
+    for (const auto& [m, n, k] : shapes)
+    {
+        const auto a = random_matrix(m * k, rng);
+        const auto b = random_matrix(n * k, rng);
+        const auto bias = random_matrix(n, rng);
+        auto c = random_matrix(m * n, rng);
+        auto expected = c;
+
+        reference_gemm(Transpose::no, Transpose::yes, m, n, k, 1.0, a, b, 0.5, expected);
+        for (std::size_t i{0}; i < expected.size(); ++i)
+        {
+            expected[i] = (scale * (expected[i] + bias[i % n])) + 1.0;
+        }
+
+        const Epilogue<double> epilogue{
+            .bias = bias.data(),
+            .apply =
+                [](std::span<double> values, const void* context)
+            {
+                for (double& value : values)
+                {
+                    value = (*static_cast<const double*>(context) * value) + 1.0;
+                }
+            },
+            .context = &scale,
+        };
+        gemm(Transpose::no, Transpose::yes, m, n, k, 1.0, a.data(), k, b.data(), k, 0.5,
+             c.data(), n, epilogue);
+
+        for (std::size_t i{0}; i < c.size(); ++i)
+        {
+            ASSERT_NEAR(c[i], expected[i], 1e-10) << m << "x" << n << "x" << k << " at " << i;
+        }
+    }
+}
+
+TEST_P(KernelsTest, GemmWithZeroBetaIgnoresPreviousContents)
+{
+    std::vector<double> a = {1.0, 2.0, 3.0, 4.0};
+    std::vector<double> b = {1.0, 0.0, 0.0, 1.0};
+    std::vector<double> c(4, std::numeric_limits<double>::quiet_NaN());
+
+    gemm(Transpose::no, Transpose::no, 2, 2, 2, 1.0, a.data(), 2, b.data(), 2, 0.0, c.data(), 2);
+
+    EXPECT_DOUBLE_EQ(c[0], 1.0);
+    EXPECT_DOUBLE_EQ(c[1], 2.0);
+    EXPECT_DOUBLE_EQ(c[2], 3.0);
+    EXPECT_DOUBLE_EQ(c[3], 4.0);
+}
+
+TEST_P(KernelsTest, GemvMatchesReference)
+{
+    std::mt19937 rng(7);
+
+    for (const std::size_t m : {1, 3, 4, 9, 64})
+    {
+        for (const std::size_t n : {1, 5, 8, 17, 100})
+        {
+            const auto a = random_matrix(m * n, rng);
+            const auto x = random_matrix(n, rng);
+            const auto x_t = random_matrix(m, rng);
+            auto y = random_matrix(m, rng);
+            auto y_t = random_matrix(n, rng);
+            auto expected = y;
+            auto expected_t = y_t;
+
+            reference_gemm(Transpose::no, Transpose::no, m, 1, n, 2.0, a, x, -1.0, expected);
+            reference_gemm(Transpose::yes, Transpose::no, n, 1, m, 2.0, a, x_t, -1.0,
+                           expected_t);
+
+            gemv(Transpose::no, m, n, 2.0, a.data(), n, x.data(), -1.0, y.data());
+            gemv(Transpose::yes, m, n, 2.0, a.data(), n, x_t.data(), -1.0, y_t.data());
+
+            for (std::size_t i{0}; i < m; ++i)
+            {
+                ASSERT_NEAR(y[i], expected[i], 1e-10);
+            }
+
+            for (std::size_t i{0}; i < n; ++i)
+            {
+                ASSERT_NEAR(y_t[i], expected_t[i], 1e-10);
+            }
+        }
+    }
+}
+
+// The single precision kernels are checked against the double reference evaluated on the same
+// (rounded) inputs, so only their own rounding contributes to the error.
+TEST_P(KernelsTest, SinglePrecisionGemmMatchesReference)
+{
+    std::mt19937 rng(42);
+
+    const std::vector<std::array<std::size_t, 3>> shapes = {
+        {1, 1, 1}, {1, 7, 5}, {3, 5, 2}, {9, 33, 4}, {13, 29, 31}, {130, 37, 300}, {5, 1100, 9},
+    };
+
+    for (const auto& [m, n, k] : shapes)
+    {
+        for (const auto trans_a : {Transpose::no, Transpose::yes})
+        {
+            for (const auto trans_b : {Transpose::no, Transpose::yes})
+            {
+                const auto a = narrow(random_matrix(m * k, rng));
+                const auto b = narrow(random_matrix(k * n, rng));
+                auto c = narrow(random_matrix(m * n, rng));
+                std::vector<double> expected(c.begin(), c.end());
+
+                reference_gemm(trans_a, trans_b, m, n, k, 0.5, {a.begin(), a.end()},
+                               {b.begin(), b.end()}, 0.25, expected);
+                gemm(trans_a, trans_b, m, n, k, 0.5F, a.data(),
+                     trans_a == Transpose::no ? k : m, b.data(),
+                     trans_b == Transpose::no ? n : k, 0.25F, c.data(), n);
+
+                const double tolerance = 1e-6 * static_cast<double>(k);
+                for (std::size_t i{0}; i < c.size(); ++i)
+                {
+                    ASSERT_NEAR(c[i], expected[i], tolerance) << m << "x" << n << "x" << k;
+                }
+            }
+        }
+    }
+}
+
+TEST_P(KernelsTest, SinglePrecisionGemvMatchesReference)
+{
+    std::mt19937 rng(7);
+
+    for (const std::size_t m : {1, 3, 4, 9, 64})
+    {
+        for (const std::size_t n : {1, 5, 8, 17, 100})
+        {
+            const auto a = narrow(random_matrix(m * n, rng));
+            const auto x = narrow(random_matrix(n, rng));
+            const auto x_t = narrow(random_matrix(m, rng));
+            auto y = narrow(random_matrix(m, rng));
+            auto y_t = narrow(random_matrix(n, rng));
+            std::vector<double> expected(y.begin(), y.end());
+            std::vector<double> expected_t(y_t.begin(), y_t.end());
+
+            const std::vector<double> a_wide(a.begin(), a.end());
+            reference_gemm(Transpose::no, Transpose::no, m, 1, n, 2.0, a_wide,
+                           {x.begin(), x.end()}, -1.0, expected);
+            reference_gemm(Transpose::yes, Transpose::no, n, 1, m, 2.0, a_wide,
+                           {x_t.begin(), x_t.end()}, -1.0, expected_t);
+
+            gemv(Transpose::no, m, n, 2.0F, a.data(), n, x.data(), -1.0F, y.data());
+            gemv(Transpose::yes, m, n, 2.0F, a.data(), n, x_t.data(), -1.0F, y_t.data());
+
+            for (std::size_t i{0}; i < m; ++i)
+            {
+                ASSERT_NEAR(y[i], expected[i], 1e-4);
+            }
+
+            for (std::size_t i{0}; i < n; ++i)
+            {
+                ASSERT_NEAR(y_t[i], expected_t[i], 1e-4);
+            }
+        }
+    }
+}
+
+TEST_P(KernelsTest, IntegerGemmMatchesReference)
+{
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> unsigned_codes(0, 255);
+    std::uniform_int_distribution<int> signed_codes(-127, 127);
+
+    const std::vector<std::array<std::size_t, 3>> shapes = {
+        {1, 1, 1}, {1, 7, 5}, {3, 5, 64}, {2, 9, 100}, {4, 130, 257}, {1, 3, 1000},
+    };
+
+    for (const auto& [m, n, k] : shapes)
+    {
+        std::vector<std::uint8_t> a(m * k);
+        std::vector<std::int8_t> b(n * k);
+        std::ranges::generate(a, [&] { return static_cast<std::uint8_t>(unsigned_codes(rng)); });
+        std::ranges::generate(b, [&] { return static_cast<std::int8_t>(signed_codes(rng)); });
+
+        // NOTE(abi): the extreme codes make sure no product saturates on the way.
+        a.front() = 255;
+        b.front() = -127;
+
+        std::vector<std::int32_t> c(m * n);
+        gemm_u8s8(m, n, k, a.data(), k, b.data(), k, c.data(), n);
+
+        for (std::size_t i{0}; i < m; ++i)
+        {
+            for (std::size_t j{0}; j < n; ++j)
+            {
+                std::int32_t expected{0};
+                for (std::size_t p{0}; p < k; ++p)
+                {
+                    expected += static_cast<std::int32_t>(a[(i * k) + p]) * b[(j * k) + p];
+                }
+
+                ASSERT_EQ(c[(i * n) + j], expected) << m << "x" << n << "x" << k;
+            }
+        }
+    }
+}
+
+TEST(KernelsDispatchTest, ScalarIsAlwaysSupported)
+{
+    EXPECT_TRUE(is_supported(Isa::scalar));
+    EXPECT_TRUE(is_supported(detect_isa()));
+}
+
+INSTANTIATE_TEST_SUITE_P(AllIsas, KernelsTest,
+                         ::testing::Values(Isa::scalar, Isa::avx2, Isa::avx512));
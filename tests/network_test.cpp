@@ -3,6 +3,10 @@
 #include "criterion.hpp"
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
 
 using namespace axon;
 
@@ -115,3 +119,281 @@ TEST_F(NetworkTest, MultipleOutputsWork)
 
     EXPECT_EQ(output.size(), 3);
 }
+
+TEST_F(NetworkTest, LayersAreStoredAsAlignedMatrices)
+{
+    Network net({3, 5, 2}, activation, criterion);
+
+    const auto& layers = net.get_layers();
+    ASSERT_EQ(layers.size(), 2);
+
+    EXPECT_EQ(layers[0].weights.size(), 3 * 5);
+    EXPECT_EQ(layers[0].biases.size(), 5);
+    EXPECT_EQ(layers[1].weights.size(), 5 * 2);
+    EXPECT_EQ(layers[1].biases.size(), 2);
+
+    for (const auto& layer : layers)
+    {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(layer.weights.data()) % cache_line_size, 0);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(layer.weight_velocity.data()) % cache_line_size,
+                  0);
+    }
+}
+
+TEST_F(NetworkTest, FeedForwardMatchesWeightMatrix)
+{
+    const Activation linear{.function = activation::linear,
+                            .derivative = activation::linear_derivative};
+    Network net({2, 3}, linear, criterion);
+
+    net.feed_forward({0.25, -0.5});
+    const auto output = net.get_output();
+
+    const auto& layer = net.get_layers().front();
+    for (std::size_t out{0}; out < 3; ++out)
+    {
+        const double expected =
+            layer.biases[out] + (layer.weight(out, 0) * 0.25) + (layer.weight(out, 1) * -0.5);
+        EXPECT_NEAR(output[out], expected, 1e-12);
+    }
+}
+
+TEST_F(NetworkTest, StepMovesOutputTowardsTarget)
+{
+    Network net({2, 4, 1}, activation, criterion);
+
+    net.feed_forward({0.5, -0.5});
+    const double initial_loss = net.compute_loss({0.25});
+
+    for (int i{0}; i < 50; ++i)
+    {
+        net.feed_forward({0.5, -0.5});
+        net.compute_loss({0.25});
+        net.back_propagate({0.25});
+        net.step(0.05, 0.5);
+    }
+
+    net.feed_forward({0.5, -0.5});
+    EXPECT_LT(net.compute_loss({0.25}), initial_loss);
+}
+
+TEST_F(NetworkTest, ThrowsOnMismatchedBatchShape)
+{
+    Network net({2, 3, 1}, activation, criterion);
+
+    EXPECT_THROW(net.feed_forward_batch({0.0, 0.0, 0.0}, 2), std::invalid_argument);
+    EXPECT_THROW(net.feed_forward_batch(std::vector<double>{}, 0), std::invalid_argument);
+
+    net.feed_forward_batch({0.1, 0.2, 0.3, 0.4}, 2);
+    EXPECT_THROW(net.back_propagate({0.0}), std::invalid_argument);
+}
+
+TEST_F(NetworkTest, BatchForwardMatchesPerSampleForward)
+{
+    Network net({2, 4, 3}, activation, criterion);
+    const std::vector<double> batch = {0.1, 0.2, -0.3, 0.4, 0.5, -0.6};
+
+    net.feed_forward_batch(batch, 3);
+    const auto batch_output = net.get_output();
+    ASSERT_EQ(batch_output.size(), 3 * 3);
+
+    for (std::size_t sample{0}; sample < 3; ++sample)
+    {
+        net.feed_forward({batch[sample * 2], batch[(sample * 2) + 1]});
+        const auto output = net.get_output();
+
+        for (std::size_t out{0}; out < 3; ++out)
+        {
+            EXPECT_NEAR(batch_output[(sample * 3) + out], output[out], 1e-12);
+        }
+    }
+}
+
+TEST_F(NetworkTest, BatchGradientIsAverageOfSampleGradients)
+{
+    const Network net({2, 3, 2}, activation, criterion);
+    const std::vector<double> inputs = {0.1, 0.2, -0.3, 0.4};
+    const std::vector<double> targets = {0.5, -0.5, 0.0, 0.25};
+
+    Network batched = net;
+    batched.feed_forward_batch(inputs, 2);
+    batched.back_propagate(targets);
+
+    Network first = net;
+    first.feed_forward({inputs[0], inputs[1]});
+    first.back_propagate({targets[0], targets[1]});
+
+    Network second = net;
+    second.feed_forward({inputs[2], inputs[3]});
+    second.back_propagate({targets[2], targets[3]});
+
+    for (std::size_t layer_idx{0}; layer_idx < net.get_layers().size(); ++layer_idx)
+    {
+        const auto& batched_layer = batched.get_workspace().layers[layer_idx];
+        const auto& first_layer = first.get_workspace().layers[layer_idx];
+        const auto& second_layer = second.get_workspace().layers[layer_idx];
+
+        for (std::size_t i{0}; i < batched_layer.weight_gradients.size(); ++i)
+        {
+            const double expected =
+                (first_layer.weight_gradients[i] + second_layer.weight_gradients[i]) / 2.0;
+            EXPECT_NEAR(batched_layer.weight_gradients[i], expected, 1e-12);
+        }
+
+        for (std::size_t i{0}; i < batched_layer.bias_gradients.size(); ++i)
+        {
+            const double expected =
+                (first_layer.bias_gradients[i] + second_layer.bias_gradients[i]) / 2.0;
+            EXPECT_NEAR(batched_layer.bias_gradients[i], expected, 1e-12);
+        }
+    }
+}
+
+TEST_F(NetworkTest, CustomActivationFallbackTrains)
+{
+    const Activation leaky{.function = [](double x) { return x > 0.0 ? x : 0.1 * x; },
+                           .derivative = [](double y) { return y > 0.0 ? 1.0 : 0.1; }};
+    Network net({2, 4, 1}, leaky, criterion);
+
+    net.feed_forward({0.5, -0.5});
+    const double initial_loss = net.compute_loss({0.25});
+
+    for (int i{0}; i < 50; ++i)
+    {
+        net.feed_forward({0.5, -0.5});
+        net.back_propagate({0.25});
+        net.step(0.01, 0.0);
+    }
+
+    net.feed_forward({0.5, -0.5});
+    EXPECT_LT(net.compute_loss({0.25}), initial_loss);
+}
+
+TEST_F(NetworkTest, CustomActivationRunsOnCallingThread)
+{
+    const auto caller = std::this_thread::get_id();
+    std::size_t calls_elsewhere{0};
+    const Activation checked{.function =
+                                 [&](double x)
+                                 {
+                                     calls_elsewhere += std::this_thread::get_id() != caller;
+                                     return std::tanh(x);
+                                 },
+                             .derivative = activation::tanh_derivative};
+
+    // Wide enough for the shared scheduler to split the product when it has several threads.
+    constexpr std::size_t batch_size{130};
+    Network net({70, 300, 1}, checked, criterion);
+    std::vector<double> inputs(batch_size * 70);
+    for (std::size_t i{0}; i < inputs.size(); ++i)
+    {
+        inputs[i] = static_cast<double>((i * 7) % 13) / 13.0;
+    }
+
+    net.feed_forward_batch(inputs, batch_size);
+    EXPECT_EQ(calls_elsewhere, 0);
+}
+
+TEST_F(NetworkTest, FastMathOutputStaysCloseToExact)
+{
+    Network net({3, 16, 2}, activation, criterion);
+    const std::vector<double> inputs = {0.3, -0.7, 0.1, 0.9, 0.2, -0.4};
+
+    net.feed_forward_batch(inputs, 2);
+    const auto exact = net.get_output();
+
+    net.set_math_mode(activation::MathMode::fast);
+    net.feed_forward_batch(inputs, 2);
+    const auto fast = net.get_output();
+
+    for (std::size_t i{0}; i < exact.size(); ++i)
+    {
+        EXPECT_NEAR(fast[i], exact[i], 1e-5);
+    }
+}
+
+TEST_F(NetworkTest, SinglePrecisionNetworkTrains)
+{
+    BasicNetwork<float> net({2, 8, 1}, activation, criterion);
+    const std::vector<float> inputs = {0.0F, 0.0F, 0.0F, 1.0F, 1.0F, 0.0F, 1.0F, 1.0F};
+    const std::vector<float> targets = {-0.5F, 0.5F, 0.5F, -0.5F};
+
+    net.feed_forward_batch(inputs, 4);
+    const float initial_loss = net.compute_loss(targets);
+
+    for (int i{0}; i < 200; ++i)
+    {
+        net.feed_forward_batch(inputs, 4);
+        net.back_propagate(targets);
+        net.step(0.1F, 0.9F);
+    }
+
+    net.feed_forward_batch(inputs, 4);
+    EXPECT_LT(net.compute_loss(targets), initial_loss);
+    EXPECT_EQ(net.get_output().size(), 4);
+}
+
+TEST_F(NetworkTest, TrainStepMatchesSeparatePasses)
+{
+    // NOTE(abi): wide enough for the fused update to split the hidden layer into several blocks.
+    const Network net({40, 300, 3}, activation, criterion);
+    constexpr std::size_t batch_size{5};
+
+    std::vector<double> inputs(40 * batch_size);
+    std::vector<double> targets(3 * batch_size);
+    for (std::size_t i{0}; i < inputs.size(); ++i)
+    {
+        inputs[i] = std::sin(0.37 * static_cast<double>(i));
+    }
+
+    for (std::size_t i{0}; i < targets.size(); ++i)
+    {
+        targets[i] = 0.5 * std::cos(0.61 * static_cast<double>(i));
+    }
+
+    Network fused = net;
+    Network separate = net;
+    for (int i{0}; i < 5; ++i)
+    {
+        const double fused_loss = fused.train_step(inputs, targets, batch_size, 0.05, 0.9);
+
+        separate.feed_forward_batch(inputs, batch_size);
+        const double separate_loss = separate.compute_loss(targets);
+        separate.back_propagate(targets);
+        separate.step(0.05, 0.9);
+
+        EXPECT_NEAR(fused_loss, separate_loss, 1e-12);
+    }
+
+    for (std::size_t layer_idx{0}; layer_idx < net.get_layers().size(); ++layer_idx)
+    {
+        const auto& fused_layer = fused.get_layers()[layer_idx];
+        const auto& separate_layer = separate.get_layers()[layer_idx];
+
+        for (std::size_t i{0}; i < fused_layer.weights.size(); ++i)
+        {
+            EXPECT_NEAR(fused_layer.weights[i], separate_layer.weights[i], 1e-12);
+        }
+
+        for (std::size_t i{0}; i < fused_layer.biases.size(); ++i)
+        {
+            EXPECT_NEAR(fused_layer.biases[i], separate_layer.biases[i], 1e-12);
+        }
+    }
+}
+
+TEST_F(NetworkTest, SinglePrecisionTrainStepReducesLoss)
+{
+    BasicNetwork<float> net({2, 8, 1}, activation, criterion);
+    const std::vector<float> inputs = {0.0F, 0.0F, 0.0F, 1.0F, 1.0F, 0.0F, 1.0F, 1.0F};
+    const std::vector<float> targets = {-0.5F, 0.5F, 0.5F, -0.5F};
+
+    const float initial_loss = net.train_step(inputs, targets, 4, 0.1F, 0.9F);
+    for (int i{0}; i < 200; ++i)
+    {
+        net.train_step(inputs, targets, 4, 0.1F, 0.9F);
+    }
+
+    net.feed_forward_batch(inputs, 4);
+    EXPECT_LT(net.compute_loss(targets), initial_loss);
+}
@@ -0,0 +1,287 @@
+#include "optimizer.hpp"
+#include "activation.hpp"
+#include "criterion.hpp"
+#include "kernels.hpp"
+#include "network.hpp"
+#include "trainer.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace axon;
+
+namespace
+{
+
+    // Spans several update chunks and leaves a tail for every vector width.
+    constexpr std::size_t num_parameters{20'003};
+
+    auto random_values(std::size_t size, std::mt19937& rng) -> std::vector<double>
+    {
+        std::uniform_real_distribution<> distribution(-1.0, 1.0);
+
+        std::vector<double> values(size);
+        for (auto& value : values)
+        {
+            value = distribution(rng);
+        }
+
+        return values;
+    }
+
+    struct ReferenceAdam
+    {
+        AdamWOptions options;
+        double l2{0.0};
+        std::vector<double> m{};
+        std::vector<double> v{};
+        std::size_t t{0};
+
+        auto step(std::vector<double>& parameters, const std::vector<double>& gradients) -> void
+        {
+            m.resize(parameters.size());
+            v.resize(parameters.size());
+            ++t;
+
+            const double c1 = 1.0 - std::pow(options.beta1, static_cast<double>(t));
+            const double c2 = 1.0 - std::pow(options.beta2, static_cast<double>(t));
+            for (std::size_t i{0}; i < parameters.size(); ++i)
+            {
+                const double g = gradients[i] + (l2 * parameters[i]);
+                m[i] = (options.beta1 * m[i]) + ((1.0 - options.beta1) * g);
+                v[i] = (options.beta2 * v[i]) + ((1.0 - options.beta2) * g * g);
+
+                parameters[i] -= options.learning_rate * options.weight_decay * parameters[i];
+                parameters[i] -= options.learning_rate * (m[i] / c1)
+                                 / (std::sqrt(v[i] / c2) + options.epsilon);
+            }
+        }
+    };
+
+    class OptimizerTest : public ::testing::TestWithParam<kernels::Isa>
+    {
+    protected:
+        void SetUp() override
+        {
+            if (!kernels::is_supported(GetParam()))
+            {
+                GTEST_SKIP() << "Instruction set not supported by this CPU.";
+            }
+
+            previous_isa_ = kernels::get_isa();
+            kernels::set_isa(GetParam());
+        }
+
+        void TearDown() override
+        {
+            kernels::set_isa(previous_isa_);
+        }
+
+    private:
+        kernels::Isa previous_isa_{kernels::Isa::scalar};
+    };
+
+} // namespace
+
+TEST_P(OptimizerTest, AdamMatchesReference)
+{
+    std::mt19937 rng(42);
+    auto parameters = random_values(num_parameters, rng);
+    auto expected = parameters;
+
+    Adam adam(AdamOptions{.learning_rate = 0.01, .weight_decay = 0.1});
+    ReferenceAdam reference{.options = {.learning_rate = 0.01, .weight_decay = 0.0}, .l2 = 0.1};
+
+    for (int step = 0; step < 5; ++step)
+    {
+        const auto gradients = random_values(num_parameters, rng);
+        adam.step(parameters, gradients);
+        reference.step(expected, gradients);
+    }
+
+    EXPECT_EQ(adam.get_num_steps(), 5U);
+    for (std::size_t i{0}; i < num_parameters; ++i)
+    {
+        ASSERT_NEAR(parameters[i], expected[i], 1e-12) << "at " << i;
+    }
+}
+
+TEST_P(OptimizerTest, AdamWDecouplesWeightDecay)
+{
+    std::mt19937 rng(7);
+    auto parameters = random_values(num_parameters, rng);
+    auto expected = parameters;
+
+    Adam adamw(AdamWOptions{.learning_rate = 0.01, .weight_decay = 0.05});
+    ReferenceAdam reference{.options = {.learning_rate = 0.01, .weight_decay = 0.05}};
+
+    for (int step = 0; step < 5; ++step)
+    {
+        const auto gradients = random_values(num_parameters, rng);
+        adamw.step(parameters, gradients);
+        reference.step(expected, gradients);
+    }
+
+    for (std::size_t i{0}; i < num_parameters; ++i)
+    {
+        ASSERT_NEAR(parameters[i], expected[i], 1e-12) << "at " << i;
+    }
+}
+
+TEST_P(OptimizerTest, RMSpropMatchesReference)
+{
+    std::mt19937 rng(3);
+    auto parameters = random_values(num_parameters, rng);
+    auto expected = parameters;
+
+    const RMSpropOptions options{.learning_rate = 0.01, .alpha = 0.9, .weight_decay = 0.01};
+    RMSprop rmsprop(options);
+    std::vector<double> mean_squares(num_parameters, 0.0);
+
+    for (int step = 0; step < 5; ++step)
+    {
+        const auto gradients = random_values(num_parameters, rng);
+        rmsprop.step(parameters, gradients);
+
+        for (std::size_t i{0}; i < num_parameters; ++i)
+        {
+            const double g = gradients[i] + (options.weight_decay * expected[i]);
+            mean_squares[i] = (options.alpha * mean_squares[i]) + ((1.0 - options.alpha) * g * g);
+            expected[i] -= options.learning_rate * g
+                           / (std::sqrt(mean_squares[i]) + options.epsilon);
+        }
+    }
+
+    for (std::size_t i{0}; i < num_parameters; ++i)
+    {
+        ASSERT_NEAR(parameters[i], expected[i], 1e-12) << "at " << i;
+    }
+}
+
+TEST_P(OptimizerTest, SinglePrecisionAdamMatchesReference)
+{
+    std::mt19937 rng(11);
+    const auto initial = random_values(num_parameters, rng);
+    std::vector<float> parameters(initial.begin(), initial.end());
+    auto expected = initial;
+
+    BasicAdam<float> adam(AdamWOptions{.learning_rate = 0.01});
+    ReferenceAdam reference{.options = {.learning_rate = 0.01}};
+
+    for (int step = 0; step < 3; ++step)
+    {
+        const auto gradients = random_values(num_parameters, rng);
+        const std::vector<float> narrowed(gradients.begin(), gradients.end());
+        adam.step(parameters, narrowed);
+        reference.step(expected, {narrowed.begin(), narrowed.end()});
+    }
+
+    for (std::size_t i{0}; i < num_parameters; ++i)
+    {
+        ASSERT_NEAR(parameters[i], expected[i], 1e-4) << "at " << i;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllIsas, OptimizerTest,
+                         ::testing::Values(kernels::Isa::scalar, kernels::Isa::avx2,
+                                           kernels::Isa::avx512));
+
+TEST(OptimizerSizeTest, ThrowsOnMismatchedBuffers)
+{
+    std::vector<double> parameters(8, 0.0);
+    const std::vector<double> gradients(8, 1.0);
+    const std::vector<double> too_few(7, 1.0);
+
+    Adam adam;
+    EXPECT_THROW(adam.step(parameters, too_few), std::invalid_argument);
+
+    adam.step(parameters, gradients);
+    std::vector<double> other(16, 0.0);
+    EXPECT_THROW(adam.step(other, std::vector<double>(16, 1.0)), std::invalid_argument);
+}
+
+class NetworkOptimizerTest : public ::testing::Test
+{
+protected:
+    Activation activation = Activation::of<activation::Tanh>();
+    Criterion criterion = Criterion::of<criterion::MSE>();
+
+    const std::vector<double> xor_inputs{0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 1.0, 1.0};
+    const std::vector<double> xor_targets{0.0, 1.0, 1.0, 0.0};
+};
+
+TEST_F(NetworkOptimizerTest, SgdMatchesBuiltInStep)
+{
+    Network expected({2, 8, 1}, activation, criterion);
+    Network net = expected;
+    Sgd sgd(SgdOptions{.learning_rate = 0.1, .momentum = 0.9});
+
+    for (int step = 0; step < 3; ++step)
+    {
+        expected.feed_forward_batch(xor_inputs, 4);
+        expected.back_propagate(xor_targets);
+        expected.step(0.1, 0.9);
+
+        net.feed_forward_batch(xor_inputs, 4);
+        net.back_propagate(xor_targets);
+        net.step(sgd);
+    }
+
+    EXPECT_TRUE(std::ranges::equal(net.get_parameters(), expected.get_parameters()));
+}
+
+TEST_F(NetworkOptimizerTest, AdamLearnsXor)
+{
+    Network net({2, 8, 1}, activation, criterion);
+    Adam adam(AdamOptions{.learning_rate = 0.02});
+
+    net.feed_forward_batch(xor_inputs, 4);
+    const double initial_loss = net.compute_loss(xor_targets);
+
+    double loss{initial_loss};
+    for (int epoch = 0; epoch < 500; ++epoch)
+    {
+        net.feed_forward_batch(xor_inputs, 4);
+        loss = net.compute_loss(xor_targets);
+        net.back_propagate(xor_targets);
+        net.step(adam);
+    }
+
+    EXPECT_LT(loss, 0.01);
+    EXPECT_LT(loss, initial_loss);
+}
+
+TEST_F(NetworkOptimizerTest, TrainerAppliesOptimizer)
+{
+    Network serial({2, 16, 1}, activation, criterion);
+    Network parallel = serial;
+    DataParallelTrainer trainer(parallel, 2);
+    Adam serial_adam(AdamWOptions{.learning_rate = 0.01});
+    Adam parallel_adam(AdamWOptions{.learning_rate = 0.01});
+
+    for (int step = 0; step < 3; ++step)
+    {
+        serial.feed_forward_batch(xor_inputs, 4);
+        const double serial_loss = serial.compute_loss(xor_targets);
+        serial.back_propagate(xor_targets);
+        serial.step(serial_adam);
+
+        const double parallel_loss = trainer.train_batch(std::span<const double>{xor_inputs},
+                                                         std::span<const double>{xor_targets}, 4,
+                                                         parallel_adam);
+        EXPECT_NEAR(parallel_loss, serial_loss, 1e-12);
+    }
+
+    const auto expected = serial.get_parameters();
+    const auto actual = parallel.get_parameters();
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t i{0}; i < expected.size(); ++i)
+    {
+        ASSERT_NEAR(actual[i], expected[i], 1e-9) << "at " << i;
+    }
+}
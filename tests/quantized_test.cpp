@@ -0,0 +1,144 @@
+#include "quantized.hpp"
+#include "activation.hpp"
+#include "criterion.hpp"
+#include "kernels.hpp"
+#include "network.hpp"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using namespace axon;
+
+class QuantizedTest : public ::testing::Test
+{
+protected:
+    Activation activation = Activation::of<activation::Tanh>();
+    Criterion criterion = Criterion::of<criterion::MSE>();
+
+    static auto make_inputs(std::size_t num_samples, std::size_t num_inputs)
+        -> std::vector<double>
+    {
+        std::vector<double> inputs(num_samples * num_inputs);
+        for (std::size_t i{0}; i < inputs.size(); ++i)
+        {
+            inputs[i] = std::sin(0.37 * static_cast<double>(i));
+        }
+
+        return inputs;
+    }
+
+    // Replaces the random initial parameters with a fixed pattern of the same range, so that
+    // accuracy bounds do not depend on the draw.
+    static auto set_fixed_parameters(Network& net) -> void
+    {
+        double phase{0.0};
+        for (auto& layer : net.get_layers())
+        {
+            for (auto& weight : layer.weights)
+            {
+                weight = std::sin(phase += 0.91);
+            }
+
+            for (auto& bias : layer.biases)
+            {
+                bias = std::sin(phase += 0.91);
+            }
+        }
+    }
+};
+
+TEST_F(QuantizedTest, ThrowsOnMismatchedBatchShape)
+{
+    const Network net({3, 8, 2}, activation, criterion);
+    const auto calibration = make_inputs(16, 3);
+    QuantizedNetwork quantized(net, std::span<const double>{calibration}, 16);
+
+    std::vector<float> outputs(2);
+    std::vector<float> wrong_outputs(3);
+    EXPECT_THROW(quantized.forward(std::vector<float>(2), 1, outputs), std::invalid_argument);
+    EXPECT_THROW(quantized.forward(std::vector<float>(3), 1, wrong_outputs),
+                 std::invalid_argument);
+    EXPECT_THROW(QuantizedNetwork(net, std::span<const double>{calibration}, 15),
+                 std::invalid_argument);
+}
+
+TEST_F(QuantizedTest, ThrowsOnLayersTooWideForExactSums)
+{
+    // 255 * 127 * 66311 is the largest sum of code products that fits in an int32_t.
+    const std::vector<double> calibration(66312);
+    const Network widest({66311, 1}, activation, criterion);
+    EXPECT_NO_THROW(QuantizedNetwork(widest, std::span{calibration}.first(66311), 1));
+
+    const Network too_wide({66312, 1}, activation, criterion);
+    EXPECT_THROW(QuantizedNetwork(too_wide, std::span{calibration}, 1), std::invalid_argument);
+}
+
+TEST_F(QuantizedTest, ParametersAreAnEighthOfDoublePrecision)
+{
+    const Network net({256, 128, 10}, activation, criterion);
+    const auto calibration = make_inputs(4, 256);
+    const QuantizedNetwork quantized(net, std::span<const double>{calibration}, 4);
+
+    std::size_t double_bytes{0};
+    for (const auto& layer : net.get_layers())
+    {
+        double_bytes += (layer.weights.size() + layer.biases.size()) * sizeof(double);
+    }
+
+    EXPECT_LT(quantized.get_parameter_bytes() * 7, double_bytes);
+}
+
+TEST_F(QuantizedTest, OutputsStayCloseToReference)
+{
+    Network net({16, 32, 32, 4}, activation, criterion);
+    set_fixed_parameters(net);
+    const auto inputs = make_inputs(64, 16);
+    const std::vector<double> targets(64 * 4, 0.5);
+
+    for (const auto granularity :
+         {quantization::Granularity::per_layer, quantization::Granularity::per_channel})
+    {
+        QuantizedNetwork quantized(net, std::span<const double>{inputs}, 64, granularity);
+        const auto report = quantization::evaluate(net, quantized, std::span<const double>{inputs},
+                                                   std::span<const double>{targets}, 64);
+
+        EXPECT_LT(report.max_abs_error, 0.1);
+        EXPECT_LT(report.mean_abs_error, 0.02);
+        EXPECT_NEAR(report.quantized_loss, report.reference_loss, 0.02);
+        EXPECT_GE(report.argmax_agreement, 0.9);
+    }
+}
+
+TEST_F(QuantizedTest, AllInstructionSetsAgreeExactly)
+{
+    using kernels::Isa;
+
+    const Network net({70, 33, 5}, Activation::of<activation::ReLU>(), criterion);
+    const auto inputs = make_inputs(9, 70);
+    QuantizedNetwork quantized(net, std::span<const double>{inputs}, 9);
+
+    const std::vector<float> narrow_inputs(inputs.begin(), inputs.end());
+    std::vector<float> expected(9 * 5);
+    const Isa previous_isa = kernels::get_isa();
+
+    kernels::set_isa(Isa::scalar);
+    quantized.forward(narrow_inputs, 9, expected);
+
+    for (const Isa isa : {Isa::avx2, Isa::avx512})
+    {
+        if (!kernels::is_supported(isa))
+        {
+            continue;
+        }
+
+        kernels::set_isa(isa);
+
+        std::vector<float> outputs(expected.size());
+        quantized.forward(narrow_inputs, 9, outputs);
+        EXPECT_EQ(outputs, expected);
+    }
+
+    kernels::set_isa(previous_isa);
+}
@@ -0,0 +1,186 @@
+#include "scheduler.hpp"
+#include "kernels.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace axon;
+
+TEST(SchedulerTest, VisitsEveryIndexOnce)
+{
+    Scheduler scheduler(4);
+    std::vector<std::atomic<int>> visits(1000);
+
+    scheduler.parallel_for(visits.size(), 7,
+                           [&](std::size_t begin, std::size_t end)
+                           {
+                               for (std::size_t i{begin}; i < end; ++i)
+                               {
+                                   visits[i].fetch_add(1);
+                               }
+                           });
+
+    for (const auto& count : visits)
+    {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
+TEST(SchedulerTest, RangesRespectGrainSize)
+{
+    Scheduler scheduler(4);
+    std::atomic<std::size_t> short_ranges{0};
+
+    scheduler.parallel_for(1000, 64,
+                           [&](std::size_t begin, std::size_t end)
+                           {
+                               // Only the range holding the last index may be shorter.
+                               if (end - begin < 64 && end != 1000)
+                               {
+                                   short_ranges.fetch_add(1);
+                               }
+                           });
+
+    EXPECT_EQ(short_ranges.load(), 0);
+}
+
+TEST(SchedulerTest, LoopWithinGrainRunsInline)
+{
+    Scheduler scheduler(4);
+    const auto caller = std::this_thread::get_id();
+
+    scheduler.parallel_for(16, 16,
+                           [&](std::size_t begin, std::size_t end)
+                           {
+                               EXPECT_EQ(begin, 0);
+                               EXPECT_EQ(end, 16);
+                               EXPECT_EQ(std::this_thread::get_id(), caller);
+                           });
+}
+
+TEST(SchedulerTest, NestedLoopsComplete)
+{
+    Scheduler scheduler(4);
+    std::atomic<std::size_t> total{0};
+
+    scheduler.parallel_for(8, 1,
+                           [&](std::size_t outer_begin, std::size_t outer_end)
+                           {
+                               for (std::size_t outer{outer_begin}; outer < outer_end; ++outer)
+                               {
+                                   scheduler.parallel_for(
+                                       100, 3,
+                                       [&](std::size_t begin, std::size_t end)
+                                       { total.fetch_add(end - begin); });
+                               }
+                           });
+
+    EXPECT_EQ(total.load(), 800);
+}
+
+TEST(SchedulerTest, ConcurrentCallersRunTheirOwnLoops)
+{
+    // More callers than the scheduler lends deques to, with ranges slow enough for the callers
+    // to park while the workers finish them.
+    Scheduler scheduler(2);
+    constexpr std::size_t num_callers{5};
+    std::vector<std::atomic<std::size_t>> totals(num_callers);
+
+    {
+        std::vector<std::jthread> callers;
+        for (std::size_t caller{0}; caller < num_callers; ++caller)
+        {
+            callers.emplace_back(
+                [&, caller]
+                {
+                    for (int round{0}; round < 4; ++round)
+                    {
+                        scheduler.parallel_for(
+                            16, 1,
+                            [&](std::size_t begin, std::size_t end)
+                            {
+                                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+                                totals[caller].fetch_add(end - begin);
+                            });
+                    }
+                });
+        }
+    }
+
+    for (const auto& total : totals)
+    {
+        EXPECT_EQ(total.load(), 64);
+    }
+}
+
+TEST(SchedulerTest, RethrowsExceptionFromBody)
+{
+    Scheduler scheduler(4);
+
+    EXPECT_THROW(scheduler.parallel_for(64, 1,
+                                        [](std::size_t begin, std::size_t end)
+                                        {
+                                            if (begin <= 13 && 13 < end)
+                                            {
+                                                throw std::runtime_error("failure");
+                                            }
+                                        }),
+                 std::runtime_error);
+
+    // The scheduler stays usable after a failed loop.
+    std::atomic<std::size_t> count{0};
+    scheduler.parallel_for(16, 1,
+                           [&](std::size_t begin, std::size_t end) { count.fetch_add(end - begin); });
+    EXPECT_EQ(count.load(), 16);
+}
+
+TEST(SchedulerTest, GrainSizeKeepsSmallWorkSerial)
+{
+    EXPECT_EQ(grain_size(1), min_task_cost);
+    EXPECT_EQ(grain_size(min_task_cost), 1);
+    EXPECT_EQ(grain_size(0), min_task_cost);
+
+    // NOTE(abi): the XOR network's layers are a handful of multiply-adds per output unit.
+    EXPECT_GT(grain_size(2 * 4), 4);
+}
+
+TEST(SchedulerTest, LargeGemmMatchesReference)
+{
+    // Wide enough for the shared scheduler to split the product when it has several threads.
+    constexpr std::size_t m{130};
+    constexpr std::size_t n{300};
+    constexpr std::size_t k{70};
+
+    std::vector<double> a(m * k);
+    std::vector<double> b(k * n);
+    for (std::size_t i{0}; i < a.size(); ++i)
+    {
+        a[i] = static_cast<double>((i * 7) % 13) - 6.0;
+    }
+    for (std::size_t i{0}; i < b.size(); ++i)
+    {
+        b[i] = static_cast<double>((i * 5) % 11) - 5.0;
+    }
+
+    std::vector<double> c(m * n, 0.0);
+    kernels::gemm(kernels::Transpose::no, kernels::Transpose::no, m, n, k, 1.0, a.data(), k,
+                  b.data(), n, 0.0, c.data(), n);
+
+    for (std::size_t i{0}; i < m; ++i)
+    {
+        for (std::size_t j{0}; j < n; ++j)
+        {
+            double expected{0.0};
+            for (std::size_t p{0}; p < k; ++p)
+            {
+                expected += a[(i * k) + p] * b[(p * n) + j];
+            }
+            EXPECT_DOUBLE_EQ(c[(i * n) + j], expected);
+        }
+    }
+}
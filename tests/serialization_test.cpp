@@ -0,0 +1,143 @@
+#include "serialization.hpp"
+#include "activation.hpp"
+#include "criterion.hpp"
+#include "network.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace axon;
+
+class SerializationTest : public ::testing::Test
+{
+protected:
+    Activation activation = Activation::of<activation::Sigmoid>();
+    Criterion criterion = Criterion::of<criterion::MSE>();
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path()
+        / (std::string{::testing::UnitTest::GetInstance()->current_test_info()->name()}
+           + ".axon");
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    static auto make_inputs(std::size_t size) -> std::vector<double>
+    {
+        std::vector<double> inputs(size);
+        for (std::size_t i{0}; i < size; ++i)
+        {
+            inputs[i] = std::cos(0.7 * static_cast<double>(i));
+        }
+
+        return inputs;
+    }
+
+    // Flips one byte of the file in place.
+    auto corrupt(std::size_t offset) const -> void
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekg(static_cast<std::streamoff>(offset));
+        const char value = static_cast<char>(file.get() ^ 0x5A);
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.put(value);
+    }
+};
+
+TEST_F(SerializationTest, LoadRestoresTopologyAndParameters)
+{
+    const Network net({3, 7, 2}, activation, criterion);
+    serialization::save(net, path);
+
+    const auto loaded = serialization::load<double>(path);
+
+    EXPECT_EQ(loaded.get_activation().kind, activation::Kind::sigmoid);
+    EXPECT_EQ(loaded.get_criterion().kind, criterion::Kind::mse);
+    ASSERT_EQ(loaded.get_layers().size(), net.get_layers().size());
+    for (std::size_t layer_idx{0}; layer_idx < net.get_layers().size(); ++layer_idx)
+    {
+        EXPECT_TRUE(std::ranges::equal(loaded.get_layers()[layer_idx].weights,
+                                       net.get_layers()[layer_idx].weights));
+        EXPECT_TRUE(std::ranges::equal(loaded.get_layers()[layer_idx].biases,
+                                       net.get_layers()[layer_idx].biases));
+    }
+}
+
+TEST_F(SerializationTest, MappedNetworkMatchesOriginal)
+{
+    Network net({5, 33, 9, 3}, activation, criterion);
+    serialization::save(net, path);
+
+    MappedNetwork mapped(path);
+    EXPECT_EQ(mapped.get_layer_sizes(), (std::vector<std::size_t>{5, 33, 9, 3}));
+
+    const auto inputs = make_inputs(4 * 5);
+    net.feed_forward_batch(inputs, 4);
+
+    std::vector<double> outputs(4 * 3);
+    mapped.forward(inputs, 4, outputs);
+    EXPECT_EQ(outputs, net.get_output());
+}
+
+TEST_F(SerializationTest, MappedBlocksAreAlignedInPlace)
+{
+    const BasicNetwork<float> net({6, 10, 1}, activation, criterion);
+    serialization::save(net, path);
+
+    const BasicMappedNetwork<float> mapped(path, serialization::Verification::header);
+    for (std::size_t layer_idx{0}; layer_idx < 2; ++layer_idx)
+    {
+        const auto weights = mapped.get_weights(layer_idx);
+        const auto biases = mapped.get_biases(layer_idx);
+
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(weights.data()) % cache_line_size, 0);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(biases.data()) % cache_line_size, 0);
+        EXPECT_TRUE(std::ranges::equal(weights, net.get_layers()[layer_idx].weights));
+        EXPECT_TRUE(std::ranges::equal(biases, net.get_layers()[layer_idx].biases));
+    }
+}
+
+TEST_F(SerializationTest, RejectsCorruptedFiles)
+{
+    const Network net({4, 8, 2}, activation, criterion);
+    serialization::save(net, path);
+    const auto size = std::filesystem::file_size(path);
+
+    // A flipped weight byte only shows up in the checksum.
+    corrupt(size - 64);
+    EXPECT_THROW(MappedNetwork{path}, std::runtime_error);
+    EXPECT_NO_THROW(MappedNetwork(path, serialization::Verification::header));
+
+    serialization::save(net, path);
+    corrupt(0);
+    EXPECT_THROW(MappedNetwork(path, serialization::Verification::header), std::runtime_error);
+
+    serialization::save(net, path);
+    std::filesystem::resize_file(path, size - 8);
+    EXPECT_THROW(MappedNetwork(path, serialization::Verification::header), std::runtime_error);
+}
+
+TEST_F(SerializationTest, RejectsMismatchedScalarType)
+{
+    const Network net({2, 3, 1}, activation, criterion);
+    serialization::save(net, path);
+
+    EXPECT_THROW(BasicMappedNetwork<float>{path}, std::runtime_error);
+    EXPECT_THROW(serialization::load<float>(path), std::runtime_error);
+}
+
+TEST_F(SerializationTest, CustomActivationCannotBeSaved)
+{
+    const Activation leaky{.function = [](double x) { return x > 0.0 ? x : 0.1 * x; },
+                           .derivative = [](double y) { return y > 0.0 ? 1.0 : 0.1; }};
+    const Network net({2, 3, 1}, leaky, criterion);
+
+    EXPECT_THROW(serialization::save(net, path), std::invalid_argument);
+}
@@ -0,0 +1,333 @@
+#include "sparse.hpp"
+#include "activation.hpp"
+#include "criterion.hpp"
+#include "inference_session.hpp"
+#include "network.hpp"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace axon;
+
+namespace
+{
+
+    // Rows and columns that leave partial blocks and a partial group of samples.
+    constexpr std::size_t num_rows{37};
+    constexpr std::size_t num_cols{53};
+    constexpr std::size_t batch_size{7};
+
+    auto random_values(std::size_t size, std::mt19937& rng) -> std::vector<double>
+    {
+        std::uniform_real_distribution<> distribution(-1.0, 1.0);
+
+        std::vector<double> values(size);
+        for (auto& value : values)
+        {
+            value = distribution(rng);
+        }
+
+        return values;
+    }
+
+    auto random_mask(std::size_t size, double keep, std::mt19937& rng) -> std::vector<std::uint8_t>
+    {
+        std::bernoulli_distribution distribution(keep);
+
+        std::vector<std::uint8_t> mask(size);
+        for (auto& kept : mask)
+        {
+            kept = distribution(rng) ? 1 : 0;
+        }
+
+        return mask;
+    }
+
+    auto masked(std::vector<double> values, const std::vector<std::uint8_t>& mask)
+        -> std::vector<double>
+    {
+        for (std::size_t i{0}; i < values.size(); ++i)
+        {
+            values[i] = mask[i] != 0 ? values[i] : 0.0;
+        }
+
+        return values;
+    }
+
+    // Checks both products of a sparse matrix against the dense `weights` it was built from.
+    template <typename Matrix>
+    auto expect_matches_dense(const Matrix& matrix, const std::vector<double>& weights,
+                              std::mt19937& rng) -> void
+    {
+        const auto inputs = random_values(batch_size * num_cols, rng);
+        std::vector<double> outputs(batch_size * num_rows);
+        sparse::multiply(matrix, inputs.data(), batch_size, outputs.data());
+
+        for (std::size_t sample{0}; sample < batch_size; ++sample)
+        {
+            for (std::size_t row{0}; row < num_rows; ++row)
+            {
+                double expected{0.0};
+                for (std::size_t col{0}; col < num_cols; ++col)
+                {
+                    expected += weights[(row * num_cols) + col] * inputs[(sample * num_cols) + col];
+                }
+
+                EXPECT_NEAR(outputs[(sample * num_rows) + row], expected, 1e-12);
+            }
+        }
+
+        const auto gradients = random_values(batch_size * num_rows, rng);
+        std::vector<double> propagated(batch_size * num_cols, 1.0);
+        sparse::multiply_transposed(matrix, gradients.data(), batch_size, propagated.data());
+
+        for (std::size_t sample{0}; sample < batch_size; ++sample)
+        {
+            for (std::size_t col{0}; col < num_cols; ++col)
+            {
+                double expected{0.0};
+                for (std::size_t row{0}; row < num_rows; ++row)
+                {
+                    expected +=
+                        gradients[(sample * num_rows) + row] * weights[(row * num_cols) + col];
+                }
+
+                EXPECT_NEAR(propagated[(sample * num_cols) + col], expected, 1e-12);
+            }
+        }
+    }
+
+} // namespace
+
+TEST(SparseTest, CsrProductsMatchDense)
+{
+    std::mt19937 rng(42);
+    const auto mask = random_mask(num_rows * num_cols, 0.2, rng);
+    const auto weights = masked(random_values(num_rows * num_cols, rng), mask);
+
+    auto matrix = sparse::make_csr<double>(mask, num_rows, num_cols);
+    sparse::gather(matrix, std::span<const double>{weights});
+
+    EXPECT_EQ(matrix.values.size(), num_rows * num_cols - std::ranges::count(mask, 0));
+    expect_matches_dense(matrix, weights, rng);
+}
+
+TEST(SparseTest, BlockProductsMatchDense)
+{
+    std::mt19937 rng(7);
+    const auto mask = random_mask(num_rows * num_cols, 0.1, rng);
+    const auto weights = masked(random_values(num_rows * num_cols, rng), mask);
+
+    auto matrix = sparse::make_blocks<double>(mask, num_rows, num_cols);
+    sparse::gather(matrix, std::span<const double>{weights});
+
+    expect_matches_dense(matrix, weights, rng);
+}
+
+TEST(SparseTest, ChoosesFormatFromSparsityAndStructure)
+{
+    std::mt19937 rng(3);
+    const auto scattered = random_mask(num_rows * num_cols, 0.1, rng);
+    EXPECT_EQ(sparse::choose_format(scattered, num_rows, num_cols, 0.8), SparseFormat::csr);
+    EXPECT_EQ(sparse::choose_format(scattered, num_rows, num_cols, 0.95), SparseFormat::dense);
+    EXPECT_EQ(sparse::choose_format({}, num_rows, num_cols, 0.0), SparseFormat::dense);
+
+    // Only the first block of every row survives.
+    std::vector<std::uint8_t> blocked(num_rows * num_cols, 0);
+    for (std::size_t row{0}; row < num_rows; ++row)
+    {
+        std::fill_n(blocked.begin() + static_cast<std::ptrdiff_t>(row * num_cols), 8, 1);
+    }
+
+    EXPECT_DOUBLE_EQ(sparse::block_fill(blocked, num_rows, num_cols), 1.0);
+    EXPECT_EQ(sparse::choose_format(blocked, num_rows, num_cols, 0.8), SparseFormat::block);
+}
+
+TEST(SparseTest, PruningScheduleRisesToFinalSparsity)
+{
+    EXPECT_DOUBLE_EQ(sparse::pruning_schedule(0, 10, 0.9), 0.0);
+    EXPECT_DOUBLE_EQ(sparse::pruning_schedule(10, 10, 0.9), 0.9);
+    EXPECT_DOUBLE_EQ(sparse::pruning_schedule(20, 10, 0.9), 0.9);
+
+    double previous{0.0};
+    for (std::size_t step{1}; step <= 10; ++step)
+    {
+        const double sparsity = sparse::pruning_schedule(step, 10, 0.9);
+        EXPECT_GT(sparsity, previous);
+        previous = sparsity;
+    }
+}
+
+class PruningTest : public ::testing::Test
+{
+protected:
+    Activation activation = Activation::of<activation::Tanh>();
+    Criterion criterion = Criterion::of<criterion::MSE>();
+
+    static auto make_batch(std::size_t size, std::size_t width) -> std::vector<double>
+    {
+        std::vector<double> values(size * width);
+        for (std::size_t i{0}; i < values.size(); ++i)
+        {
+            values[i] = 0.5 * std::sin(0.37 * static_cast<double>(i));
+        }
+
+        return values;
+    }
+
+    static auto expect_pruned_weights_zero(const Network& net) -> void
+    {
+        for (std::size_t layer_idx{0}; layer_idx < net.get_layers().size(); ++layer_idx)
+        {
+            const auto mask = net.get_mask(layer_idx);
+            const auto& weights = net.get_layers()[layer_idx].weights;
+            for (std::size_t i{0}; i < mask.size(); ++i)
+            {
+                if (mask[i] == 0)
+                {
+                    ASSERT_EQ(weights[i], 0.0) << "layer " << layer_idx << " weight " << i;
+                }
+            }
+        }
+    }
+};
+
+TEST_F(PruningTest, ThrowsOnInvalidArguments)
+{
+    Network net({4, 8, 2}, activation, criterion);
+    EXPECT_THROW(net.prune(1.5), std::invalid_argument);
+    EXPECT_THROW(net.prune(0.5, 0), std::invalid_argument);
+
+    const std::vector<std::uint8_t> first(32, 1);
+    EXPECT_THROW(net.set_masks({first}), std::invalid_argument);
+    EXPECT_THROW(net.set_masks({first, std::vector<std::uint8_t>(8, 1)}), std::invalid_argument);
+}
+
+TEST_F(PruningTest, PrunesSmallestWeightsIteratively)
+{
+    Network net({64, 48, 4}, activation, criterion);
+    const Network original = net;
+
+    net.prune(0.5);
+    const std::vector<std::uint8_t> first(net.get_mask(0).begin(), net.get_mask(0).end());
+    EXPECT_NEAR(sparse::sparsity(first), 0.5, 1e-3);
+
+    // Every kept weight is at least as large as every pruned one.
+    double largest_pruned{0.0};
+    double smallest_kept{1e9};
+    const auto& weights = original.get_layers()[0].weights;
+    for (std::size_t i{0}; i < first.size(); ++i)
+    {
+        if (first[i] != 0)
+        {
+            smallest_kept = std::min(smallest_kept, std::abs(weights[i]));
+        }
+        else
+        {
+            largest_pruned = std::max(largest_pruned, std::abs(weights[i]));
+        }
+    }
+    EXPECT_LE(largest_pruned, smallest_kept);
+
+    net.prune(0.9);
+    const auto second = net.get_mask(0);
+    EXPECT_NEAR(sparse::sparsity(second), 0.9, 1e-3);
+    for (std::size_t i{0}; i < first.size(); ++i)
+    {
+        EXPECT_FALSE(first[i] == 0 && second[i] != 0) << "weight " << i << " was restored";
+    }
+
+    EXPECT_EQ(net.get_sparse_weights(0).format, SparseFormat::csr);
+    expect_pruned_weights_zero(net);
+}
+
+TEST_F(PruningTest, UpdatesKeepPrunedWeightsZero)
+{
+    Network net({16, 32, 8, 1}, activation, criterion);
+    net.prune(0.85);
+
+    const auto inputs = make_batch(8, 16);
+    const auto targets = make_batch(8, 1);
+    Adam adam(AdamOptions{.learning_rate = 0.01});
+
+    for (int step = 0; step < 3; ++step)
+    {
+        net.feed_forward_batch(inputs, 8);
+        net.back_propagate(targets);
+        net.step(0.1, 0.9);
+        expect_pruned_weights_zero(net);
+
+        net.train_step(inputs, targets, 8, 0.1, 0.9);
+        expect_pruned_weights_zero(net);
+
+        net.feed_forward_batch(inputs, 8);
+        net.back_propagate(targets);
+        net.step(adam);
+        expect_pruned_weights_zero(net);
+    }
+}
+
+TEST_F(PruningTest, SparseExecutionMatchesDense)
+{
+    for (const std::size_t block_size : {std::size_t{1}, std::size_t{8}})
+    {
+        Network sparse_net({40, 64, 24, 3}, activation, criterion);
+        sparse_net.prune(0.9, block_size);
+        ASSERT_NE(sparse_net.get_sparse_weights(0).format, SparseFormat::dense);
+        EXPECT_EQ(sparse_net.get_sparse_weights(1).format,
+                  block_size == 1 ? SparseFormat::csr : SparseFormat::block);
+
+        Network dense_net = sparse_net;
+        dense_net.set_sparse_threshold(2.0);
+        ASSERT_EQ(dense_net.get_sparse_weights(0).format, SparseFormat::dense);
+
+        const auto inputs = make_batch(5, 40);
+        const auto targets = make_batch(5, 3);
+        for (auto* net : {&sparse_net, &dense_net})
+        {
+            net->feed_forward_batch(inputs, 5);
+            net->back_propagate(targets);
+        }
+
+        const auto sparse_outputs = sparse_net.get_output();
+        const auto dense_outputs = dense_net.get_output();
+        for (std::size_t i{0}; i < dense_outputs.size(); ++i)
+        {
+            EXPECT_NEAR(sparse_outputs[i], dense_outputs[i], 1e-12);
+        }
+
+        // The hidden gradients flow through the sparse transposed product.
+        sparse_net.step(0.1, 0.0);
+        dense_net.step(0.1, 0.0);
+        const auto sparse_parameters = sparse_net.get_parameters();
+        const auto dense_parameters = dense_net.get_parameters();
+        for (std::size_t i{0}; i < dense_parameters.size(); ++i)
+        {
+            ASSERT_NEAR(sparse_parameters[i], dense_parameters[i], 1e-12) << "at " << i;
+        }
+
+        // Sessions read the same sparse copies.
+        InferenceSession session(sparse_net, 5);
+        const auto session_outputs = session.forward(inputs, 5);
+        sparse_net.feed_forward_batch(inputs, 5);
+        const auto updated_outputs = sparse_net.get_output();
+        for (std::size_t i{0}; i < updated_outputs.size(); ++i)
+        {
+            EXPECT_NEAR(session_outputs[i], updated_outputs[i], 1e-12);
+        }
+    }
+}
+
+TEST_F(PruningTest, SparseStorageShrinksWithSparsity)
+{
+    Network net({256, 256}, activation, criterion);
+    net.prune(0.9);
+
+    const std::size_t dense_bytes = 256 * 256 * sizeof(double);
+    const std::size_t sparse_bytes = sparse::storage_bytes(net.get_sparse_weights(0), 256, 256);
+    EXPECT_LT(sparse_bytes, dense_bytes / 5);
+}
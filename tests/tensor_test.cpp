@@ -0,0 +1,265 @@
+#include "tensor.hpp"
+#include "activation.hpp"
+#include "criterion.hpp"
+#include "inference_session.hpp"
+#include "network.hpp"
+#include "trainer.hpp"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace axon;
+
+namespace
+{
+
+    // 2 x 3 x 4 tensor whose element (i, j, k) holds 100 * i + 10 * j + k.
+    auto make_indexed() -> Tensor
+    {
+        Tensor tensor(Shape{2, 3, 4});
+        for (std::size_t i{0}; i < 2; ++i)
+        {
+            for (std::size_t j{0}; j < 3; ++j)
+            {
+                for (std::size_t k{0}; k < 4; ++k)
+                {
+                    tensor(i, j, k) = static_cast<double>((100 * i) + (10 * j) + k);
+                }
+            }
+        }
+
+        return tensor;
+    }
+
+} // namespace
+
+TEST(TensorTest, OwnsRowMajorAlignedStorage)
+{
+    const Tensor tensor = make_indexed();
+    EXPECT_EQ(tensor.rank(), 3);
+    EXPECT_EQ(tensor.size(), 24);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(tensor.data()) % cache_line_size, 0);
+
+    const auto view = tensor.view();
+    EXPECT_EQ(view.stride(0), 12);
+    EXPECT_EQ(view.stride(1), 4);
+    EXPECT_EQ(view.stride(2), 1);
+    EXPECT_TRUE(view.is_contiguous());
+    EXPECT_EQ(tensor.span()[(1 * 12) + (2 * 4) + 3], 123.0);
+
+    EXPECT_THROW(Tensor(Shape{2, 2}, std::vector<double>(3)), std::invalid_argument);
+    EXPECT_THROW(Shape({1, 1, 1, 1, 1, 1, 1}), std::invalid_argument);
+}
+
+TEST(TensorTest, ViewsShareStorage)
+{
+    Tensor tensor = make_indexed();
+    const TensorView view = tensor;
+
+    const auto sample = view[1];
+    ASSERT_EQ(sample.rank(), 2);
+    EXPECT_EQ(sample(2, 3), 123.0);
+
+    sample(0, 0) = -1.0;
+    EXPECT_EQ(tensor(1, 0, 0), -1.0);
+    EXPECT_EQ(sample.data(), tensor.data() + 12);
+
+    // Mutable views convert to read-only ones.
+    const ConstTensorView read_only = sample;
+    EXPECT_EQ(read_only(0, 0), -1.0);
+}
+
+TEST(TensorTest, SlicesSubRanges)
+{
+    const Tensor tensor = make_indexed();
+    const ConstTensorView view = tensor;
+
+    const auto batch = view.batch(1, 2);
+    EXPECT_EQ(batch.shape(), (Shape{1, 3, 4}));
+    EXPECT_TRUE(batch.is_contiguous());
+    EXPECT_EQ(batch.span().front(), 100.0);
+
+    const auto columns = view.slice(2, 1, 3);
+    EXPECT_EQ(columns.shape(), (Shape{2, 3, 2}));
+    EXPECT_FALSE(columns.is_contiguous());
+    EXPECT_EQ(columns(1, 2, 0), 121.0);
+    EXPECT_EQ(columns(0, 1, 1), 12.0);
+    EXPECT_THROW(static_cast<void>(columns.span()), std::invalid_argument);
+
+    EXPECT_THROW(static_cast<void>(view.slice(2, 3, 5)), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(view.slice(3, 0, 1)), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(view[2]), std::out_of_range);
+}
+
+TEST(TensorTest, ReshapesContiguousViews)
+{
+    const Tensor tensor = make_indexed();
+    const ConstTensorView view = tensor;
+
+    const auto matrix = view.reshape({6, 4});
+    EXPECT_EQ(matrix.data(), tensor.data());
+    EXPECT_EQ(matrix(5, 3), 123.0);
+
+    EXPECT_THROW(static_cast<void>(view.reshape({5, 5})), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(view.transpose().reshape({24})), std::invalid_argument);
+
+    // A batch slice stays contiguous and reshapes.
+    EXPECT_EQ(view.batch(1, 2).reshape({12})(11), 123.0);
+}
+
+TEST(TensorTest, TransposesWithoutCopying)
+{
+    const Tensor tensor = make_indexed();
+    const ConstTensorView view = tensor;
+
+    const auto transposed = view.transpose();
+    EXPECT_EQ(transposed.shape(), (Shape{2, 4, 3}));
+    EXPECT_EQ(transposed.data(), tensor.data());
+    EXPECT_EQ(transposed(1, 3, 2), 123.0);
+    EXPECT_EQ(transposed(0, 1, 2), 21.0);
+
+    const auto swapped = view.transpose(0, 2);
+    EXPECT_EQ(swapped.shape(), (Shape{4, 3, 2}));
+    EXPECT_EQ(swapped(3, 2, 1), 123.0);
+
+    EXPECT_THROW(static_cast<void>(view.transpose(0, 3)), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(view[0][0].transpose()), std::invalid_argument);
+}
+
+TEST(TensorTest, CopyMaterializesStridedViews)
+{
+    const Tensor tensor = make_indexed();
+    const ConstTensorView view = tensor;
+
+    const Tensor transposed(view.transpose());
+    ASSERT_EQ(transposed.shape(), (Shape{2, 4, 3}));
+    for (std::size_t i{0}; i < 2; ++i)
+    {
+        for (std::size_t j{0}; j < 4; ++j)
+        {
+            for (std::size_t k{0}; k < 3; ++k)
+            {
+                EXPECT_EQ(transposed(i, j, k), tensor(i, k, j));
+            }
+        }
+    }
+
+    // Strided destination.
+    Tensor target(Shape{4, 3});
+    copy(view[1], target.view().transpose());
+    EXPECT_EQ(target(3, 2), 123.0);
+    EXPECT_EQ(target(1, 0), 101.0);
+
+    EXPECT_THROW(copy(view, target.view()), std::invalid_argument);
+}
+
+TEST(TensorTest, ResizeKeepsCapacity)
+{
+    Tensor tensor(Shape{8, 16});
+    const double* data = tensor.data();
+
+    tensor.resize({4, 16});
+    EXPECT_EQ(tensor.size(), 64);
+    tensor.resize({8, 16});
+    EXPECT_EQ(tensor.data(), data);
+
+    tensor.reshape({128});
+    EXPECT_EQ(tensor.rank(), 1);
+    EXPECT_THROW(tensor.reshape({3}), std::invalid_argument);
+}
+
+class TensorNetworkTest : public ::testing::Test
+{
+protected:
+    Activation activation = Activation::of<activation::Tanh>();
+    Criterion criterion = Criterion::of<criterion::MSE>();
+
+    static auto make_values(const Shape& shape) -> Tensor
+    {
+        Tensor tensor(shape);
+        for (std::size_t i{0}; i < tensor.size(); ++i)
+        {
+            tensor.span()[i] = 0.5 * std::sin(0.37 * static_cast<double>(i));
+        }
+
+        return tensor;
+    }
+};
+
+TEST_F(TensorNetworkTest, ImagesFeedNetworkWithoutFlattening)
+{
+    Network net({12, 8, 2}, activation, criterion);
+    const Tensor images = make_values({6, 3, 4});
+    const Tensor targets = make_values({6, 2});
+
+    Network reference = net;
+    reference.feed_forward_batch(images.span(), 6);
+    reference.back_propagate(targets.span());
+    reference.step(0.1, 0.9);
+
+    net.feed_forward_batch(images);
+    const auto outputs = net.get_output_view();
+    EXPECT_EQ(outputs.shape(), (Shape{6, 2}));
+    EXPECT_EQ(outputs.data(), net.get_workspace().layers.back().outputs.data());
+    EXPECT_NEAR(net.compute_loss(targets), reference.compute_loss(targets.span()), 1e-15);
+    net.back_propagate(targets);
+    net.step(0.1, 0.9);
+
+    const auto expected = reference.get_parameters();
+    const auto actual = net.get_parameters();
+    for (std::size_t i{0}; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(actual[i], expected[i]);
+    }
+
+    EXPECT_THROW(net.feed_forward_batch(ConstTensorView{images}.transpose()),
+                 std::invalid_argument);
+    EXPECT_THROW(net.feed_forward_batch(ConstTensorView{}), std::invalid_argument);
+}
+
+TEST_F(TensorNetworkTest, BatchSlicesTrainInPlace)
+{
+    Network net({5, 4, 1}, activation, criterion);
+    Network reference = net;
+    const Tensor inputs = make_values({8, 5});
+    const Tensor targets = make_values({8, 1});
+    const ConstTensorView input_view = inputs;
+    const ConstTensorView target_view = targets;
+
+    for (std::size_t begin{0}; begin < 8; begin += 4)
+    {
+        const double loss = net.train_step(input_view.batch(begin, begin + 4),
+                                           target_view.batch(begin, begin + 4), 0.1, 0.9);
+        const double expected =
+            reference.train_step(inputs.span().subspan(begin * 5, 20),
+                                 targets.span().subspan(begin, 4), 4, 0.1, 0.9);
+        EXPECT_EQ(loss, expected);
+    }
+
+    DataParallelTrainer trainer(net, 2);
+    DataParallelTrainer reference_trainer(reference, 2);
+    EXPECT_EQ(trainer.train_batch(inputs, targets, 0.1, 0.9),
+              reference_trainer.train_batch(inputs.span(), targets.span(), 8, 0.1, 0.9));
+}
+
+TEST_F(TensorNetworkTest, SessionWritesOutputTensor)
+{
+    const Network net({12, 8, 2}, activation, criterion);
+    InferenceSession session(net, 4);
+    const Tensor images = make_values({4, 3, 4});
+
+    Tensor outputs(Shape{4, 2});
+    session.forward(images, outputs);
+
+    const auto expected = session.forward(std::vector<double>(images.span().begin(),
+                                                              images.span().end()),
+                                          4);
+    for (std::size_t i{0}; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(outputs.span()[i], expected[i]);
+    }
+}
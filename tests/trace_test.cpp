@@ -0,0 +1,148 @@
+#include "trace.hpp"
+#include "activation.hpp"
+#include "autograd.hpp"
+#include "criterion.hpp"
+#include "network.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace axon;
+
+class TraceTest : public ::testing::Test
+{
+protected:
+    Network net{{4, 6, 3}, Activation::of<activation::Tanh>(), Criterion::of<criterion::MSE>()};
+    std::vector<double> inputs = std::vector<double>(2 * 4, 0.5);
+    std::vector<double> targets = std::vector<double>(2 * 3, 0.25);
+
+    void TearDown() override
+    {
+        trace::stop();
+    }
+
+    auto train_step() -> void
+    {
+        net.feed_forward_batch(inputs, 2);
+        net.compute_loss(targets);
+        net.back_propagate(targets);
+        net.step(0.1, 0.9);
+    }
+
+    static auto count(const std::vector<trace::Event>& events, trace::Phase phase,
+                      std::int32_t layer) -> std::ptrdiff_t
+    {
+        return std::ranges::count_if(events, [&](const trace::Event& event)
+                                     { return event.phase == phase && event.layer == layer; });
+    }
+};
+
+TEST_F(TraceTest, RecordsEveryPhaseOfEveryLayer)
+{
+    if (!trace::enabled)
+    {
+        GTEST_SKIP() << "Built without AXON_ENABLE_TRACING.";
+    }
+
+    trace::start();
+    train_step();
+    trace::stop();
+
+    const auto events = trace::collect();
+    for (std::int32_t layer{0}; layer < 2; ++layer)
+    {
+        EXPECT_EQ(count(events, trace::Phase::forward, layer), 1);
+    }
+
+    // `step` updates every layer in one pass over the flat parameter buffer.
+    EXPECT_EQ(count(events, trace::Phase::update, -1), 1);
+
+    // Parameter gradients of both layers, the hidden gradients of the first and the output
+    // gradients of the last.
+    EXPECT_EQ(count(events, trace::Phase::backward, 0), 2);
+    EXPECT_EQ(count(events, trace::Phase::backward, 1), 2);
+    EXPECT_EQ(count(events, trace::Phase::loss, -1), 1);
+
+    const auto forward = std::ranges::find(events, trace::Phase::forward, &trace::Event::phase);
+    EXPECT_EQ(forward->flops, 2 * 2 * 4 * 6);
+    EXPECT_TRUE(std::ranges::is_sorted(events, {}, &trace::Event::begin_ns));
+    for (const auto& event : events)
+    {
+        EXPECT_LE(event.begin_ns, event.end_ns);
+    }
+}
+
+TEST_F(TraceTest, TapeRecordsOneEventPerLayerAndPass)
+{
+    if (!trace::enabled)
+    {
+        GTEST_SKIP() << "Built without AXON_ENABLE_TRACING.";
+    }
+
+    autograd::Tape tape;
+    auto gradients = net.make_workspace();
+
+    trace::start();
+    const auto outputs = autograd::record(tape, net, inputs, 2, gradients);
+    tape.backward(tape.loss(outputs, targets, net.get_criterion()));
+    trace::stop();
+
+    // One forward and one backward event per layer, and none outside them, so that the
+    // summary rows add up to the time spent in the tape.
+    const auto events = trace::collect();
+    for (std::int32_t layer{0}; layer < 2; ++layer)
+    {
+        EXPECT_EQ(count(events, trace::Phase::forward, layer), 1);
+        EXPECT_EQ(count(events, trace::Phase::backward, layer), 1);
+    }
+    EXPECT_EQ(count(events, trace::Phase::backward, -1), 0);
+}
+
+TEST_F(TraceTest, RecordsNothingOutsideRecording)
+{
+    trace::start();
+    trace::stop();
+    train_step();
+
+    EXPECT_TRUE(trace::collect().empty());
+}
+
+TEST_F(TraceTest, StartDiscardsPreviousEvents)
+{
+    trace::start();
+    train_step();
+    trace::start();
+    trace::stop();
+
+    EXPECT_TRUE(trace::collect().empty());
+}
+
+TEST_F(TraceTest, ExportsChromeTraceAndSummary)
+{
+    trace::start();
+    train_step();
+    trace::stop();
+
+    const auto path = std::filesystem::temp_directory_path() / "axon_trace.json";
+    trace::write_chrome_trace(path);
+
+    std::ifstream file(path);
+    const std::string json{std::istreambuf_iterator<char>{file}, {}};
+    std::filesystem::remove(path);
+
+    EXPECT_TRUE(json.starts_with("{\"traceEvents\":["));
+    EXPECT_TRUE(json.ends_with("}\n"));
+    EXPECT_EQ(json.find("\"ph\":\"X\"") != std::string::npos, trace::enabled);
+
+    std::ostringstream summary;
+    trace::write_summary(summary);
+    EXPECT_TRUE(summary.str().starts_with("phase"));
+    EXPECT_EQ(summary.str().find("forward") != std::string::npos, trace::enabled);
+}
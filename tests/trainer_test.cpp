@@ -0,0 +1,163 @@
+#include "trainer.hpp"
+#include "activation.hpp"
+#include "criterion.hpp"
+#include "network.hpp"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+using namespace axon;
+
+class TrainerTest : public ::testing::Test
+{
+protected:
+    Activation activation = Activation::of<activation::Tanh>();
+    Criterion criterion = Criterion::of<criterion::MSE>();
+
+    static auto make_batch(std::size_t batch_size, std::vector<double>& inputs,
+                           std::vector<double>& targets) -> void
+    {
+        inputs.clear();
+        targets.clear();
+        for (std::size_t i{0}; i < batch_size; ++i)
+        {
+            const double x = -1.0 + (2.0 * static_cast<double>(i) / static_cast<double>(batch_size));
+            inputs.insert(inputs.end(), {x, 0.5 * x});
+            targets.push_back(0.8 * std::sin(3.0 * x));
+        }
+    }
+};
+
+TEST_F(TrainerTest, ThrowsOnMismatchedBatchShape)
+{
+    Network net({2, 4, 1}, activation, criterion);
+    DataParallelTrainer trainer(net, 2);
+
+    EXPECT_THROW(trainer.train_batch({0.0, 0.0, 0.0}, {0.0}, 1), std::invalid_argument);
+    EXPECT_THROW(trainer.train_batch({0.0, 0.0}, {0.0, 0.0}, 1), std::invalid_argument);
+}
+
+TEST_F(TrainerTest, ParallelStepMatchesSerialStep)
+{
+    Network serial({2, 16, 8, 1}, activation, criterion);
+    Network parallel = serial;
+    DataParallelTrainer trainer(parallel, 4);
+
+    std::vector<double> inputs;
+    std::vector<double> targets;
+    // NOTE(abi): an odd batch size leaves the shards unevenly sized.
+    make_batch(37, inputs, targets);
+
+    for (int step = 0; step < 3; ++step)
+    {
+        serial.feed_forward_batch(inputs, 37);
+        const double serial_loss = serial.compute_loss(targets);
+        serial.back_propagate(targets);
+        serial.step(0.05, 0.9);
+
+        const double parallel_loss = trainer.train_batch(inputs, targets, 37, 0.05, 0.9);
+        EXPECT_NEAR(parallel_loss, serial_loss, 1e-12);
+    }
+
+    const auto& serial_layers = serial.get_layers();
+    const auto& parallel_layers = parallel.get_layers();
+    for (std::size_t layer_idx{0}; layer_idx < serial_layers.size(); ++layer_idx)
+    {
+        for (std::size_t i{0}; i < serial_layers[layer_idx].weights.size(); ++i)
+        {
+            EXPECT_NEAR(parallel_layers[layer_idx].weights[i],
+                        serial_layers[layer_idx].weights[i], 1e-12);
+        }
+
+        for (std::size_t i{0}; i < serial_layers[layer_idx].biases.size(); ++i)
+        {
+            EXPECT_NEAR(parallel_layers[layer_idx].biases[i], serial_layers[layer_idx].biases[i],
+                        1e-12);
+        }
+    }
+}
+
+TEST_F(TrainerTest, CustomActivationRunsOnCallingThread)
+{
+    const auto caller = std::this_thread::get_id();
+    std::size_t calls_elsewhere{0};
+    const auto probe = [&] { calls_elsewhere += std::this_thread::get_id() != caller; };
+    const Activation checked{.function =
+                                 [&](double x)
+                                 {
+                                     probe();
+                                     return std::tanh(x);
+                                 },
+                             .derivative =
+                                 [&](double y)
+                                 {
+                                     probe();
+                                     return 1.0 - (y * y);
+                                 }};
+
+    Network net({2, 16, 8, 1}, checked, criterion);
+    DataParallelTrainer trainer(net, 4);
+
+    std::vector<double> inputs;
+    std::vector<double> targets;
+    make_batch(37, inputs, targets);
+    trainer.train_batch(inputs, targets, 37, 0.05, 0.9);
+
+    EXPECT_EQ(calls_elsewhere, 0);
+}
+
+TEST_F(TrainerTest, BatchSmallerThanThreadCountTrains)
+{
+    Network net({2, 4, 1}, activation, criterion);
+    DataParallelTrainer trainer(net, 8);
+
+    const std::vector<double> inputs{0.5, -0.5};
+    const std::vector<double> targets{0.3};
+
+    const double initial_loss = trainer.train_batch(inputs, targets, 1, 0.1);
+    double loss = initial_loss;
+    for (int step = 0; step < 50; ++step)
+    {
+        loss = trainer.train_batch(inputs, targets, 1, 0.1);
+    }
+
+    EXPECT_LT(loss, initial_loss);
+}
+
+TEST_F(TrainerTest, SinglePrecisionParallelStepMatchesSerialStep)
+{
+    BasicNetwork<float> serial({2, 16, 8, 1}, activation, criterion);
+    BasicNetwork<float> parallel = serial;
+    BasicDataParallelTrainer<float> trainer(parallel, 4);
+
+    std::vector<double> wide_inputs;
+    std::vector<double> wide_targets;
+    make_batch(37, wide_inputs, wide_targets);
+    const std::vector<float> inputs(wide_inputs.begin(), wide_inputs.end());
+    const std::vector<float> targets(wide_targets.begin(), wide_targets.end());
+
+    for (int step = 0; step < 3; ++step)
+    {
+        serial.feed_forward_batch(inputs, 37);
+        const float serial_loss = serial.compute_loss(targets);
+        serial.back_propagate(targets);
+        serial.step(0.05F, 0.9F);
+
+        const float parallel_loss = trainer.train_batch(inputs, targets, 37, 0.05F, 0.9F);
+        EXPECT_NEAR(parallel_loss, serial_loss, 1e-5);
+    }
+
+    const auto& serial_layers = serial.get_layers();
+    const auto& parallel_layers = parallel.get_layers();
+    for (std::size_t layer_idx{0}; layer_idx < serial_layers.size(); ++layer_idx)
+    {
+        for (std::size_t i{0}; i < serial_layers[layer_idx].weights.size(); ++i)
+        {
+            EXPECT_NEAR(parallel_layers[layer_idx].weights[i],
+                        serial_layers[layer_idx].weights[i], 1e-5);
+        }
+    }
+}